@@ -25,6 +25,7 @@
 #include "RegPolynomials.h"
 #include "SimVars.h"
 #include "Tables.h"
+#include "TraceRecorder.hpp"
 #include "common.h"
 
 #define DEFAULT_AIRCRAFT_REGISTRATION "ASX320"
@@ -37,6 +38,13 @@ class FadecGauge {
   SimulationData simulationData = {};
   SimulationDataLivery simulationDataLivery = {};
 
+  // always-on trace of the update - written to the work folder when A32NX_TRACE_DUMP changes
+  TraceRecorder traceRecorder{"FadecGauge"};
+  TraceNameId traceUpdateId = 0;
+  TraceNameId traceReadDataId = 0;
+  TraceNameId traceEngineControlId = 0;
+  ID traceDumpId = 0;
+
   /// <summary>
   /// Initializes the connection to SimConnect
   /// </summary>
@@ -127,6 +135,12 @@ class FadecGauge {
     isConnected = true;
     simConnectRequestData();
 
+    traceUpdateId = traceRecorder.addName("FadecGauge::onUpdate()");
+    traceReadDataId = traceRecorder.addName("simConnectReadData");
+    traceEngineControlId = traceRecorder.addName("EngineControl::update()");
+    traceDumpId = register_named_variable("A32NX_TRACE_DUMP");
+    traceRecorder.setTriggerValue(get_named_variable_value(traceDumpId));
+
     return true;
   }
 
@@ -136,9 +150,17 @@ class FadecGauge {
   /// <returns>True if successful, false otherwise.</returns>
   bool onUpdate(double deltaTime) {
     if (isConnected == true) {
+      TraceScope updateScope{traceRecorder, traceUpdateId};
+
       // read simulation data from simconnect
+      {
+        TraceScope scope{traceRecorder, traceReadDataId};
+        simConnectReadData();
+      }
+
+      // write the trace of the last seconds when requested - also in pause
+      traceRecorder.dumpOnTrigger(get_named_variable_value(traceDumpId));
 
-      simConnectReadData();
       // detect pause
       if ((simulationData.simulationTime == previousSimulationTime) || (simulationData.simulationTime < 0.2)) {
         // pause detected -> return
@@ -149,6 +171,7 @@ class FadecGauge {
       // store previous simulation time
       previousSimulationTime = simulationData.simulationTime;
       // update engines
+      TraceScope scope{traceRecorder, traceEngineControlId};
       EngineControlInstance.update(calculatedSampleTime, simulationData.simulationTime);
     }
 
@@ -83,6 +83,7 @@ clang++ \
   -I "${MSFS_SDK}/SimConnect SDK/include" \
   -I "${COMMON_DIR}/src" \
   -I "${COMMON_DIR}/src/inih" \
+  -I "${COMMON_DIR}/../cpp-msfs-framework/lib" \
   -I "${DIR}/src/interface" \
   "${DIR}/src/interface/SimConnectInterface.cpp" \
   -I "${DIR}/src/busStructures" \
@@ -136,6 +137,8 @@ clang++ \
   "${DIR}/src/Arinc429.cpp" \
   "${DIR}/src/Arinc429Utils.cpp" \
   "${COMMON_DIR}/src/LocalVariable.cpp" \
+  "${COMMON_DIR}/src/FlightDataRecorderColumnar.cpp" \
+  "${COMMON_DIR}/src/FlightDataRecorderWriter.cpp" \
   "${COMMON_DIR}/src/InterpolatingLookupTable.cpp" \
   "${DIR}/src/SpoilersHandler.cpp" \
   "${COMMON_DIR}/src/ThrottleAxisMapping.cpp" \
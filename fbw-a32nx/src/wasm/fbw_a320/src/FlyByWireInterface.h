@@ -13,10 +13,12 @@
 #include "FlightDataRecorder.h"
 #include "InterpolatingLookupTable.h"
 #include "LocalVariable.h"
+#include "ModelSnapshot.h"
 #include "RateLimiter.h"
 #include "SimConnectInterface.h"
 #include "SpoilersHandler.h"
 #include "ThrottleAxisMapping.h"
+#include "TraceRecorder.hpp"
 #include "elac/Elac.h"
 #include "fac/Fac.h"
 #include "failures/FailuresConsumer.h"
@@ -27,6 +29,14 @@
 #include "utils/HysteresisNode.h"
 #include "utils/SRFlipFlop.h"
 
+// the generated autopilot models are plain state without pointers
+template <>
+inline constexpr bool isModelSnapshotOptIn<AutopilotStateMachineModelClass> = true;
+template <>
+inline constexpr bool isModelSnapshotOptIn<AutopilotLawsModelClass> = true;
+template <>
+inline constexpr bool isModelSnapshotOptIn<AutothrustModelClass> = true;
+
 class FlyByWireInterface {
  public:
   bool connect();
@@ -35,6 +45,11 @@ class FlyByWireInterface {
 
   bool update(double sampleTime);
 
+  // saves the state of the flight control computers, the autopilot and the autothrust, e.g. to rewind an approach
+  void saveComputersSnapshot();
+  // restores the last saved state, returns false if no state has been saved
+  bool restoreComputersSnapshot();
+
  private:
   const std::string CONFIGURATION_FILEPATH = "\\work\\ModelConfiguration.ini";
 
@@ -96,6 +111,7 @@ class FlyByWireInterface {
   bool enableRudder2AxisMode = false;
 
   bool clientDataEnabled = false;
+  bool clientDataDeltaEnabled = false;
 
   bool last_fd1_active = false;
   bool last_fd2_active = false;
@@ -158,6 +174,46 @@ class FlyByWireInterface {
   base_fac_analog_outputs facsAnalogOutputs[2] = {};
   base_fac_bus facsBusOutputs[2] = {};
 
+  // the outputs of the last frame are inputs of the other computers and models, so they are part of the state
+  struct ComputersSnapshot {
+    ModelSnapshot<Elac> elacs[2];
+    ModelSnapshot<base_elac_discrete_outputs[2]> elacsDiscreteOutputs;
+    ModelSnapshot<base_elac_analog_outputs[2]> elacsAnalogOutputs;
+    ModelSnapshot<base_elac_out_bus[2]> elacsBusOutputs;
+
+    ModelSnapshot<Sec> secs[3];
+    ModelSnapshot<base_sec_discrete_outputs[3]> secsDiscreteOutputs;
+    ModelSnapshot<base_sec_analog_outputs[3]> secsAnalogOutputs;
+    ModelSnapshot<base_sec_out_bus[3]> secsBusOutputs;
+
+    ModelSnapshot<Fcdc> fcdcs[2];
+    ModelSnapshot<FcdcDiscreteOutputs[2]> fcdcsDiscreteOutputs;
+    ModelSnapshot<base_fcdc_bus[2]> fcdcsBusOutputs;
+
+    ModelSnapshot<Fac> facs[2];
+    ModelSnapshot<base_fac_discrete_outputs[2]> facsDiscreteOutputs;
+    ModelSnapshot<base_fac_analog_outputs[2]> facsAnalogOutputs;
+    ModelSnapshot<base_fac_bus[2]> facsBusOutputs;
+
+    ModelSnapshot<AutopilotStateMachineModelClass> autopilotStateMachine;
+    ModelSnapshot<AutopilotStateMachineModelClass::ExternalInputs_AutopilotStateMachine_T> autopilotStateMachineInput;
+    ModelSnapshot<ap_raw_laws_input> autopilotStateMachineOutput;
+
+    ModelSnapshot<AutopilotLawsModelClass> autopilotLaws;
+    ModelSnapshot<AutopilotLawsModelClass::ExternalInputs_AutopilotLaws_T> autopilotLawsInput;
+    ModelSnapshot<ap_raw_output> autopilotLawsOutput;
+
+    ModelSnapshot<AutothrustModelClass> autoThrust;
+    ModelSnapshot<AutothrustModelClass::ExternalInputs_Autothrust_T> autoThrustInput;
+    ModelSnapshot<athr_output> autoThrustOutput;
+  };
+  // only allocated with the first snapshot
+  std::unique_ptr<ComputersSnapshot> computersSnapshot;
+  std::unique_ptr<LocalVariable> idComputersSnapshotSave;
+  std::unique_ptr<LocalVariable> idComputersSnapshotRestore;
+  double lastComputersSnapshotSaveTrigger = 0;
+  double lastComputersSnapshotRestoreTrigger = 0;
+
   InterpolatingLookupTable throttleLookupTable;
 
   RadioReceiver radioReceiver;
@@ -188,6 +244,59 @@ class FlyByWireInterface {
   std::unique_ptr<LocalVariable> idExternalOverride;
 
   std::unique_ptr<LocalVariable> idFdrEvent;
+  std::unique_ptr<LocalVariable> idFdrFrameBudget;
+  std::unique_ptr<LocalVariable> idFdrProcessingTime;
+  std::unique_ptr<LocalVariable> idFdrPendingFrames;
+  std::unique_ptr<LocalVariable> idFdrRingOverflowCount;
+
+  // always-on trace of the update stages - written to the work folder when A32NX_TRACE_DUMP changes
+  enum TraceStage : TraceNameId {
+    TRACE_UPDATE,
+    TRACE_FAILURES,
+    TRACE_READ_DATA,
+    TRACE_PERFORMANCE_MONITORING,
+    TRACE_RADIO_RECEIVER,
+    TRACE_FCU_INITIALIZATION,
+    TRACE_ALTIMETER_SETTING,
+    TRACE_AUTOPILOT_STATE_MACHINE,
+    TRACE_AUTOPILOT_LAWS,
+    TRACE_FLY_BY_WIRE,
+    TRACE_AUTOTHRUST,
+    TRACE_SENSORS,
+    TRACE_ELAC,
+    TRACE_SEC,
+    TRACE_FAC,
+    TRACE_FCDC,
+    TRACE_ADDITIONAL_DATA,
+    TRACE_FLIGHT_DATA_RECORDER,
+    TRACE_WRITE_LOCAL_VARIABLES,
+    TRACE_STAGE_COUNT
+  };
+  static constexpr const char* TRACE_STAGE_NAMES[TRACE_STAGE_COUNT] = {"FlyByWireInterface::update()",
+                                                                      "failures",
+                                                                      "readDataAndLocalVariables",
+                                                                      "performanceMonitoring",
+                                                                      "radioReceiver",
+                                                                      "fcuInitialization",
+                                                                      "altimeterSetting",
+                                                                      "autopilotStateMachine",
+                                                                      "autopilotLaws",
+                                                                      "flyByWire",
+                                                                      "autothrust",
+                                                                      "sensors",
+                                                                      "elac",
+                                                                      "sec",
+                                                                      "fac",
+                                                                      "fcdc",
+                                                                      "additionalData",
+                                                                      "flightDataRecorder",
+                                                                      "writeLocalVariables"};
+  TraceRecorder traceRecorder{"FlyByWire"};
+  std::unique_ptr<LocalVariable> idTraceDump;
+  std::unique_ptr<LocalVariable> idLocalVariableReadCount;
+  std::unique_ptr<LocalVariable> idLocalVariableReadTime;
+  std::unique_ptr<LocalVariable> idLocalVariableWriteCount;
+  std::unique_ptr<LocalVariable> idLocalVariableWriteTime;
 
   std::unique_ptr<LocalVariable> idSideStickPositionX;
   std::unique_ptr<LocalVariable> idSideStickPositionY;
@@ -581,6 +690,8 @@ class FlyByWireInterface {
 
   bool handleFcuInitialization(double sampleTime);
 
+  void handleComputersSnapshotRequests();
+
   bool readDataAndLocalVariables(double sampleTime);
 
   bool updatePerformanceMonitoring(double sampleTime);
@@ -29,7 +29,7 @@ void Elac::initSelfTests(bool viaPushButton) {
 }
 
 // Main update cycle. Surface position through parameters here is temporary.
-void Elac::update(double deltaTime, double simulationTime, bool faultActive, bool isPowered) {
+void Elac::update(double deltaTime, [[maybe_unused]] double simulationTime, bool faultActive, bool isPowered) {
   monitorPowerSupply(deltaTime, isPowered);
   monitorButtonStatus();
 
@@ -8,6 +8,7 @@
 #include "../utils/HysteresisNode.h"
 #include "../utils/PulseNode.h"
 #include "../utils/SRFlipFlop.h"
+#include "ModelSnapshot.h"
 
 class Elac {
  public:
@@ -40,22 +41,22 @@ class Elac {
 
   // Model
   ElacComputer elacComputer;
-  elac_outputs modelOutputs;
+  elac_outputs modelOutputs = {};
 
   // Computer Self-monitoring vars
-  bool monitoringHealthy;
+  bool monitoringHealthy = false;
 
-  bool prevEngageButtonWasPressed;
+  bool prevEngageButtonWasPressed = false;
 
   // Power Supply monitoring
-  double powerSupplyOutageTime;
+  double powerSupplyOutageTime = 0;
 
-  bool powerSupplyFault;
+  bool powerSupplyFault = false;
 
   // Selftest vars
-  double selfTestTimer;
+  double selfTestTimer = 0;
 
-  bool selfTestComplete;
+  bool selfTestComplete = false;
 
   // Constants
   const bool isUnit1;
@@ -64,3 +65,7 @@ class Elac {
   const double shortSelfTestDuration = 1;
   const double longSelfTestDuration = 3;
 };
+
+// the generated model and the monitoring members are plain state without pointers
+template <>
+inline constexpr bool isModelSnapshotOptIn<Elac> = true;
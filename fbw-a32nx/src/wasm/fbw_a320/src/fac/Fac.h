@@ -5,6 +5,7 @@
 #include "../utils/PulseNode.h"
 #include "../utils/SRFlipFlop.h"
 #include "FacIO.h"
+#include "ModelSnapshot.h"
 
 class Fac {
  public:
@@ -35,26 +36,26 @@ class Fac {
 
   // Model
   FacComputer facComputer;
-  fac_outputs modelOutputs;
+  fac_outputs modelOutputs = {};
 
   // Computer Self-monitoring vars
-  bool facHealthy;
+  bool facHealthy = false;
 
   SRFlipFlop facHealthyFlipFlop = SRFlipFlop(false);
 
   PulseNode pushbuttonPulse = PulseNode(true);
 
   // Power Supply monitoring
-  double powerSupplyOutageTime;
+  double powerSupplyOutageTime = 0;
 
-  bool longPowerFailure;
+  bool longPowerFailure = false;
 
-  bool shortPowerFailure;
+  bool shortPowerFailure = false;
 
   // Selftest vars
-  double selfTestTimer;
+  double selfTestTimer = 0;
 
-  bool selfTestComplete;
+  bool selfTestComplete = false;
 
   // Constants
   const bool isUnit1;
@@ -63,3 +64,7 @@ class Fac {
   const double shortPowerFailureTime = 0.01;
   const double selfTestDuration = 10;
 };
+
+// the generated model and the monitoring members are plain state without pointers
+template <>
+inline constexpr bool isModelSnapshotOptIn<Fac> = true;
@@ -73,7 +73,7 @@ void Fcdc::updateSelfTest(double deltaTime) {
   }
 }
 
-LateralLaw Fcdc::getLateralLawStatusFromBits(bool bit1, bool bit2, bool bit3) {
+LateralLaw Fcdc::getLateralLawStatusFromBits(bool bit1, bool bit2, [[maybe_unused]] bool bit3) {
   if (bit1) {
     return LateralLaw::NormalLaw;
   } else if (bit2) {
@@ -389,14 +389,15 @@ void Fcdc::computeActiveSystemLaws() {
 }
 
 void Fcdc::computeSidestickPriorityLights(double deltaTime) {
-  bool leftSidestickDisabledRoll;
-  bool rightSidestickDisabledRoll;
-  bool leftSidestickDisabledPitch;
-  bool rightSidestickDisabledPitch;
-  bool leftSidestickPriorityLockedRoll;
-  bool rightSidestickPriorityLockedRoll;
-  bool leftSidestickPriorityLockedPitch;
-  bool rightSidestickPriorityLockedPitch;
+  // No computer may be engaged in an axis, in which case no sidestick is disabled or locked in this axis.
+  bool leftSidestickDisabledRoll = false;
+  bool rightSidestickDisabledRoll = false;
+  bool leftSidestickDisabledPitch = false;
+  bool rightSidestickDisabledPitch = false;
+  bool leftSidestickPriorityLockedRoll = false;
+  bool rightSidestickPriorityLockedRoll = false;
+  bool leftSidestickPriorityLockedPitch = false;
+  bool rightSidestickPriorityLockedPitch = false;
 
   // Compute if a sidestick has lost priority (per computer). Use the computer that is engaged in the respective axis.
   if (elac1EngagedInRoll) {
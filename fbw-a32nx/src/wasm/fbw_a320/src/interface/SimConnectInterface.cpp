@@ -1,5 +1,6 @@
 #include "SimConnectInterface.h"
 #include <cmath>
+#include <cstring>
 #include <iostream>
 #include <map>
 #include <vector>
@@ -96,6 +97,10 @@ void SimConnectInterface::disconnect() {
     unregister_key_event_handler_EX1(static_cast<GAUGE_KEY_EVENT_HANDLER_EX1>(processKeyEvent), NULL);
     // info message
     std::cout << "WASM: Disconnecting..." << std::endl;
+    // print client data statistics
+    if (clientDataEnabled) {
+      printClientDataStatistics();
+    }
     // close connection
     SimConnect_Close(hSimConnect);
     // set flag
@@ -107,6 +112,21 @@ void SimConnectInterface::disconnect() {
   }
 }
 
+void SimConnectInterface::setClientDataDeltaEnabled(bool enabled) {
+  clientDataDeltaEnabled = enabled;
+}
+
+void SimConnectInterface::printClientDataStatistics() {
+  for (size_t id = 0; id < clientDataStates.size(); id++) {
+    const ClientDataStatistics& statistics = clientDataStates[id].statistics;
+    if (statistics.sentCount == 0 && statistics.skippedCount == 0) {
+      continue;
+    }
+    std::cout << "WASM: Client data " << id << ": sent " << statistics.sentCount << " (" << statistics.sentBytes << " bytes), skipped "
+              << statistics.skippedCount << " (" << statistics.skippedBytes << " bytes)" << std::endl;
+  }
+}
+
 void SimConnectInterface::setSampleTime(double sampleTime) {
   this->sampleTime = sampleTime;
 }
@@ -1831,7 +1851,7 @@ void SimConnectInterface::processEventWithOneParam(const DWORD eventId, const DW
     }
 
     case Events::A32NX_FCU_SPD_SET: {
-      idFcuEventSetSPEED->set(static_cast<long>(data0));
+      idFcuEventSetSPEED->setImmediate(static_cast<long>(data0));
       execute_calculator_code("(>H:A320_Neo_FCU_SPEED_SET)", nullptr, nullptr, nullptr);
       std::cout << "WASM: event triggered: A32NX_FCU_SPD_SET: " << static_cast<long>(data0) << std::endl;
       break;
@@ -1875,7 +1895,7 @@ void SimConnectInterface::processEventWithOneParam(const DWORD eventId, const DW
     }
 
     case Events::A32NX_FCU_HDG_SET: {
-      idFcuEventSetHDG->set(static_cast<long>(data0));
+      idFcuEventSetHDG->setImmediate(static_cast<long>(data0));
       execute_calculator_code("(>H:A320_Neo_FCU_HDG_SET)", nullptr, nullptr, nullptr);
       std::cout << "WASM: event triggered: A32NX_FCU_HDG_SET: " << static_cast<long>(data0) << std::endl;
       break;
@@ -2033,7 +2053,7 @@ void SimConnectInterface::processEventWithOneParam(const DWORD eventId, const DW
     }
 
     case Events::A32NX_FCU_VS_SET: {
-      idFcuEventSetVS->set(static_cast<long>(data0));
+      idFcuEventSetVS->setImmediate(static_cast<long>(data0));
       execute_calculator_code("(>H:A320_Neo_FCU_VS_SET) (>H:A320_Neo_CDU_VS)", nullptr, nullptr, nullptr);
       std::cout << "WASM: event triggered: A32NX_FCU_VS_SET: " << static_cast<long>(data0) << std::endl;
       break;
@@ -2868,6 +2888,22 @@ bool SimConnectInterface::sendClientData(SIMCONNECT_DATA_DEFINITION_ID id, DWORD
     return true;
   }
 
+  // ids of areas with several instances are computed from an index, they have to stay within the enum
+  if (id >= clientDataStates.size()) {
+    std::cout << "WASM: Tried to write unknown client data id " << id << "!" << std::endl;
+    return false;
+  }
+
+  // in delta mode skip the write if the data is unchanged - readers keep the last written data
+  ClientDataState& state = clientDataStates[id];
+  if (clientDataDeltaEnabled && state.skippedSinceSent < CLIENT_DATA_DELTA_REFRESH_INTERVAL && state.lastSent.size() == size &&
+      std::memcmp(state.lastSent.data(), data, size) == 0) {
+    state.skippedSinceSent++;
+    state.statistics.skippedCount++;
+    state.statistics.skippedBytes += size;
+    return true;
+  }
+
   // set output data
   HRESULT result = SimConnect_SetClientData(hSimConnect, id, id, SIMCONNECT_CLIENT_DATA_SET_FLAG_DEFAULT, 0, size, data);
 
@@ -2877,6 +2913,14 @@ bool SimConnectInterface::sendClientData(SIMCONNECT_DATA_DEFINITION_ID id, DWORD
     return false;
   }
 
+  // remember the written data - the buffer is only allocated by the first write
+  if (clientDataDeltaEnabled) {
+    state.lastSent.assign(static_cast<char*>(data), static_cast<char*>(data) + size);
+  }
+  state.skippedSinceSent = 0;
+  state.statistics.sentCount++;
+  state.statistics.sentBytes += size;
+
   // success
   return true;
 }
@@ -2,6 +2,8 @@
 
 #include <MSFS/Legacy/gauges.h>
 #include <SimConnect.h>
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -177,6 +179,20 @@ class SimConnectInterface {
     SIM_RATE_SET,
   };
 
+  /**
+   * Byte counters of a client data area written by this interface.
+   */
+  struct ClientDataStatistics {
+    // number of writes sent to the sim
+    uint64_t sentCount = 0;
+    // number of writes skipped because the data was unchanged (delta mode only)
+    uint64_t skippedCount = 0;
+    // number of bytes sent to the sim
+    uint64_t sentBytes = 0;
+    // number of bytes not sent because the data was unchanged (delta mode only)
+    uint64_t skippedBytes = 0;
+  };
+
   SimConnectInterface() = default;
 
   ~SimConnectInterface() = default;
@@ -201,6 +217,17 @@ class SimConnectInterface {
 
   void disconnect();
 
+  /**
+   * Enables the delta mode for client data: a client data area is only written if its data has
+   * changed since the last write. Readers keep the last written data, so the unchanged data is
+   * still available to them. Unchanged data is sent again after CLIENT_DATA_DELTA_REFRESH_INTERVAL
+   * skipped writes for readers which started late.
+   * @param enabled true to enable the delta mode
+   */
+  void setClientDataDeltaEnabled(bool enabled);
+
+  void printClientDataStatistics();
+
   void setSampleTime(double sampleTime);
 
   bool requestData();
@@ -337,8 +364,23 @@ class SimConnectInterface {
     FMGC_2_B_BUS,
     LOCAL_VARIABLES,
     LOCAL_VARIABLES_AUTOTHRUST,
+    CLIENT_DATA_COUNT,
+  };
+
+  /**
+   * The state of a client data area written by this interface.
+   */
+  struct ClientDataState {
+    // the data of the last write - only kept in delta mode
+    std::vector<char> lastSent;
+    // the number of consecutive writes skipped because the data was unchanged
+    uint64_t skippedSinceSent = 0;
+    ClientDataStatistics statistics;
   };
 
+  // in delta mode unchanged client data is sent again after this number of skipped writes
+  static constexpr uint64_t CLIENT_DATA_DELTA_REFRESH_INTERVAL = 100;
+
   bool isConnected = false;
   HANDLE hSimConnect = 0;
 
@@ -348,6 +390,9 @@ class SimConnectInterface {
   double maxSimulationRate = 0;
   bool limitSimulationRateByPerformance = true;
   bool clientDataEnabled = false;
+  bool clientDataDeltaEnabled = false;
+  // one state per area of the ClientData enum, indexed by its id
+  std::array<ClientDataState, CLIENT_DATA_COUNT> clientDataStates;
 
   int elacDisabled = -1;
   int secDisabled = -1;
@@ -26,7 +26,7 @@ void Sec::initSelfTests() {
 void Sec::clearMemory() {}
 
 // Main update cycle. Surface position through parameters here is temporary.
-void Sec::update(double deltaTime, double simulationTime, bool faultActive, bool isPowered) {
+void Sec::update(double deltaTime, [[maybe_unused]] double simulationTime, bool faultActive, bool isPowered) {
   monitorPowerSupply(deltaTime, isPowered);
 
   updateSelfTest(deltaTime);
@@ -7,6 +7,7 @@
 #include "../utils/ConfirmNode.h"
 #include "../utils/PulseNode.h"
 #include "../utils/SRFlipFlop.h"
+#include "ModelSnapshot.h"
 
 class Sec {
  public:
@@ -37,26 +38,26 @@ class Sec {
 
   // Model
   SecComputer secComputer;
-  sec_outputs modelOutputs;
+  sec_outputs modelOutputs = {};
 
   // Computer Self-monitoring vars
-  bool monitoringHealthy;
+  bool monitoringHealthy = false;
 
-  bool cpuStopped;
+  bool cpuStopped = false;
 
   SRFlipFlop cpuStoppedFlipFlop = SRFlipFlop(true);
 
   PulseNode resetPulseNode = PulseNode(false);
 
   // Power Supply monitoring
-  double powerSupplyOutageTime;
+  double powerSupplyOutageTime = 0;
 
-  bool powerSupplyFault;
+  bool powerSupplyFault = false;
 
   // Selftest vars
-  double selfTestTimer;
+  double selfTestTimer = 0;
 
-  bool selfTestComplete;
+  bool selfTestComplete = false;
 
   // Constants
   const bool isUnit1;
@@ -65,3 +66,7 @@ class Sec {
   const double minimumPowerOutageTimeForFailure = 0.02;
   const double selfTestDuration = 4;
 };
+
+// the generated model and the monitoring members are plain state without pointers
+template <>
+inline constexpr bool isModelSnapshotOptIn<Sec> = true;
@@ -79,6 +79,7 @@ clang++ \
   -I "${MSFS_SDK}/SimConnect SDK/include" \
   -I "${COMMON_DIR}/fbw_common/src" \
   -I "${COMMON_DIR}/fbw_common/src/inih" \
+  -I "${COMMON_DIR}/cpp-msfs-framework/lib" \
   -I "${DIR}/src/interface" \
   "${DIR}/src/interface/SimConnectInterface.cpp" \
   -I "${DIR}/src/prim" \
@@ -129,6 +130,8 @@ clang++ \
   "${DIR}/src/Arinc429.cpp" \
   "${DIR}/src/Arinc429Utils.cpp" \
   "${COMMON_DIR}/fbw_common/src/LocalVariable.cpp" \
+  "${COMMON_DIR}/fbw_common/src/FlightDataRecorderColumnar.cpp" \
+  "${COMMON_DIR}/fbw_common/src/FlightDataRecorderWriter.cpp" \
   "${COMMON_DIR}/fbw_common/src/InterpolatingLookupTable.cpp" \
   "${DIR}/src/SpoilersHandler.cpp" \
   "${COMMON_DIR}/fbw_common/src/ThrottleAxisMapping.cpp" \
@@ -1,7 +1,10 @@
 #include "Arinc429.h"
 
+// A word starts as zero data with the FailureWarning SSM (the encoding of 0) until it is set. In the sim this
+// is what a bus built bit by bit with setBit() now sends for the bits it does not set, and what a word that is
+// never set reports, where both used to be undefined.
 template <typename T>
-Arinc429Word<T>::Arinc429Word() {}
+Arinc429Word<T>::Arinc429Word() : rawSsm(0), rawData(0) {}
 
 template <typename T>
 void Arinc429Word<T>::setFromSimVar(double simVar) {
@@ -1,41 +1,28 @@
 #pragma once
 
-#include <fstream>
-
 #include "AdditionalData.h"
 #include "EngineData.h"
+#include "FlightDataRecorderFields.h"
+#include "FlightDataRecorderWriter.h"
 #include "model/AutopilotLaws.h"
 #include "model/AutopilotStateMachine.h"
 #include "model/Autothrust.h"
-#include "zlib/zfstream.h"
 
-class FlightDataRecorder {
+// The A380X part of the flight data recorder: it hands the structs listed in FlightDataRecorderFields.h to the
+// writer, which does the recording.
+class FlightDataRecorder : public FlightDataRecorderWriter {
  public:
   // IMPORTANT: this constant needs to increased with every interface change
-  const uint64_t INTERFACE_VERSION = 24;
+  const uint64_t INTERFACE_VERSION = 27;
 
   void initialize();
 
   void update(AutopilotStateMachineModelClass* autopilotStateMachine,
+              const ap_sm_input& autopilotStateMachineInput,
               AutopilotLawsModelClass* autopilotLaws,
+              const ap_laws_input& autopilotLawsInput,
               Autothrust* autoThrust,
+              const athr_in& autoThrustInput,
               const EngineData& engineData,
               const AdditionalData& additionalData);
-
-  void terminate();
-
- private:
-  const std::string CONFIGURATION_FILEPATH = "\\work\\FlightDataRecorder.ini";
-
-  bool isEnabled = false;
-  int sampleCounter = false;
-  int maximumSampleCounter = 0;
-  int maximumFileCount = 0;
-  std::shared_ptr<gzofstream> fileStream;
-
-  void manageFlightDataRecorderFiles();
-
-  std::string getFlightDataRecorderFilename();
-
-  void cleanUpFlightDataRecorderFiles();
 };
@@ -0,0 +1,816 @@
+#pragma once
+
+#include "AdditionalData.h"
+#include "EngineData.h"
+#include "FlightDataRecorderSchema.h"
+#include "model/AutopilotLaws_types.h"
+#include "model/AutopilotStateMachine_types.h"
+#include "model/Autothrust_types.h"
+
+// Fields of the recorded structs in the order they are written to the csv file. A field that is not listed here
+// is not recorded in the columnar layout, which writes one column per listed field only. The row layout writes
+// the whole structs, so there an unlisted field is part of the recorded frame but not decoded by the converter.
+
+inline constexpr FdrField FDR_FIELDS_AP_SM[] = {
+    FDR_FIELD(ap_sm_output, time.dt),
+    FDR_FIELD(ap_sm_output, time.simulation_time),
+    FDR_FIELD(ap_sm_output, data.aircraft_position.lat),
+    FDR_FIELD(ap_sm_output, data.aircraft_position.lon),
+    FDR_FIELD(ap_sm_output, data.aircraft_position.alt),
+    FDR_FIELD(ap_sm_output, data.Theta_deg),
+    FDR_FIELD(ap_sm_output, data.Phi_deg),
+    FDR_FIELD(ap_sm_output, data.qk_deg_s),
+    FDR_FIELD(ap_sm_output, data.rk_deg_s),
+    FDR_FIELD(ap_sm_output, data.pk_deg_s),
+    FDR_FIELD(ap_sm_output, data.V_ias_kn),
+    FDR_FIELD(ap_sm_output, data.V_tas_kn),
+    FDR_FIELD(ap_sm_output, data.V_mach),
+    FDR_FIELD(ap_sm_output, data.V_gnd_kn),
+    FDR_FIELD(ap_sm_output, data.alpha_deg),
+    FDR_FIELD(ap_sm_output, data.beta_deg),
+    FDR_FIELD(ap_sm_output, data.H_ft),
+    FDR_FIELD(ap_sm_output, data.H_ind_ft),
+    FDR_FIELD(ap_sm_output, data.H_radio_ft),
+    FDR_FIELD(ap_sm_output, data.H_dot_ft_min),
+    FDR_FIELD(ap_sm_output, data.Psi_magnetic_deg),
+    FDR_FIELD(ap_sm_output, data.Psi_magnetic_track_deg),
+    FDR_FIELD(ap_sm_output, data.Psi_true_deg),
+    FDR_FIELD(ap_sm_output, data.bx_m_s2),
+    FDR_FIELD(ap_sm_output, data.by_m_s2),
+    FDR_FIELD(ap_sm_output, data.bz_m_s2),
+    FDR_FIELD(ap_sm_output, data.nav_valid),
+    FDR_FIELD(ap_sm_output, data.nav_loc_deg),
+    FDR_FIELD(ap_sm_output, data.nav_dme_valid),
+    FDR_FIELD(ap_sm_output, data.nav_dme_nmi),
+    FDR_FIELD(ap_sm_output, data.nav_loc_valid),
+    FDR_FIELD(ap_sm_output, data.nav_loc_magvar_deg),
+    FDR_FIELD(ap_sm_output, data.nav_loc_error_deg),
+    FDR_FIELD(ap_sm_output, data.nav_loc_position.lat),
+    FDR_FIELD(ap_sm_output, data.nav_loc_position.lon),
+    FDR_FIELD(ap_sm_output, data.nav_loc_position.alt),
+    FDR_FIELD(ap_sm_output, data.nav_e_loc_valid),
+    FDR_FIELD(ap_sm_output, data.nav_e_loc_error_deg),
+    FDR_FIELD(ap_sm_output, data.nav_gs_valid),
+    FDR_FIELD(ap_sm_output, data.nav_gs_error_deg),
+    FDR_FIELD(ap_sm_output, data.nav_gs_position.lat),
+    FDR_FIELD(ap_sm_output, data.nav_gs_position.lon),
+    FDR_FIELD(ap_sm_output, data.nav_gs_position.alt),
+    FDR_FIELD(ap_sm_output, data.nav_e_gs_valid),
+    FDR_FIELD(ap_sm_output, data.nav_e_gs_error_deg),
+    FDR_FIELD(ap_sm_output, data.flight_guidance_xtk_nmi),
+    FDR_FIELD(ap_sm_output, data.flight_guidance_tae_deg),
+    FDR_FIELD(ap_sm_output, data.flight_guidance_phi_deg),
+    FDR_FIELD(ap_sm_output, data.flight_guidance_phi_limit_deg),
+    FDR_FIELD(ap_sm_output, data.flight_phase),
+    FDR_FIELD(ap_sm_output, data.V2_kn),
+    FDR_FIELD(ap_sm_output, data.VAPP_kn),
+    FDR_FIELD(ap_sm_output, data.VLS_kn),
+    FDR_FIELD(ap_sm_output, data.is_flight_plan_available),
+    FDR_FIELD(ap_sm_output, data.altitude_constraint_ft),
+    FDR_FIELD(ap_sm_output, data.thrust_reduction_altitude),
+    FDR_FIELD(ap_sm_output, data.thrust_reduction_altitude_go_around),
+    FDR_FIELD(ap_sm_output, data.acceleration_altitude),
+    FDR_FIELD(ap_sm_output, data.acceleration_altitude_engine_out),
+    FDR_FIELD(ap_sm_output, data.acceleration_altitude_go_around),
+    FDR_FIELD(ap_sm_output, data.cruise_altitude),
+    FDR_FIELD(ap_sm_output, data.on_ground),
+    FDR_FIELD(ap_sm_output, data.zeta_deg),
+    FDR_FIELD(ap_sm_output, data.throttle_lever_1_pos),
+    FDR_FIELD(ap_sm_output, data.throttle_lever_2_pos),
+    FDR_FIELD(ap_sm_output, data.flaps_handle_index),
+    FDR_FIELD(ap_sm_output, data.total_weight_kg),
+    FDR_FIELD(ap_sm_output, data_computed.time_since_touchdown),
+    FDR_FIELD(ap_sm_output, data_computed.time_since_lift_off),
+    FDR_FIELD(ap_sm_output, data_computed.time_since_SRS),
+    FDR_FIELD(ap_sm_output, data_computed.H_fcu_in_selection),
+    FDR_FIELD(ap_sm_output, data_computed.H_constraint_valid),
+    FDR_FIELD(ap_sm_output, data_computed.Psi_fcu_in_selection),
+    FDR_FIELD(ap_sm_output, data_computed.gs_convergent_towards_beam),
+    FDR_FIELD(ap_sm_output, data_computed.V_fcu_in_selection),
+    FDR_FIELD(ap_sm_output, input.FD_active),
+    FDR_FIELD(ap_sm_output, input.AP_1_push),
+    FDR_FIELD(ap_sm_output, input.AP_2_push),
+    FDR_FIELD(ap_sm_output, input.AP_DISCONNECT_push),
+    FDR_FIELD(ap_sm_output, input.HDG_push),
+    FDR_FIELD(ap_sm_output, input.HDG_pull),
+    FDR_FIELD(ap_sm_output, input.ALT_push),
+    FDR_FIELD(ap_sm_output, input.ALT_pull),
+    FDR_FIELD(ap_sm_output, input.VS_push),
+    FDR_FIELD(ap_sm_output, input.VS_pull),
+    FDR_FIELD(ap_sm_output, input.LOC_push),
+    FDR_FIELD(ap_sm_output, input.APPR_push),
+    FDR_FIELD(ap_sm_output, input.EXPED_push),
+    FDR_FIELD_NAMED(ap_sm_output, "input.V_c_kn", input.V_fcu_kn),
+    FDR_FIELD(ap_sm_output, input.Psi_fcu_deg),
+    FDR_FIELD(ap_sm_output, input.H_fcu_ft),
+    FDR_FIELD(ap_sm_output, input.H_constraint_ft),
+    FDR_FIELD(ap_sm_output, input.H_dot_fcu_fpm),
+    FDR_FIELD(ap_sm_output, input.FPA_fcu_deg),
+    FDR_FIELD(ap_sm_output, input.TRK_FPA_mode),
+    FDR_FIELD(ap_sm_output, input.DIR_TO_trigger),
+    FDR_FIELD(ap_sm_output, input.is_FLX_active),
+    FDR_FIELD(ap_sm_output, input.Slew_trigger),
+    FDR_FIELD(ap_sm_output, input.MACH_mode),
+    FDR_FIELD(ap_sm_output, input.ATHR_engaged),
+    FDR_FIELD(ap_sm_output, input.is_SPEED_managed),
+    FDR_FIELD(ap_sm_output, input.FDR_event),
+    FDR_FIELD(ap_sm_output, input.FM_requested_vertical_mode),
+    FDR_FIELD(ap_sm_output, input.FM_H_c_ft),
+    FDR_FIELD(ap_sm_output, input.FM_H_dot_c_fpm),
+    FDR_FIELD(ap_sm_output, input.FM_rnav_appr_selected),
+    FDR_FIELD(ap_sm_output, input.FM_final_des_can_engage),
+    FDR_FIELD(ap_sm_output, input.TCAS_mode_available),
+    FDR_FIELD(ap_sm_output, input.TCAS_advisory_state),
+    FDR_FIELD(ap_sm_output, input.TCAS_advisory_target_min_fpm),
+    FDR_FIELD(ap_sm_output, input.TCAS_advisory_target_max_fpm),
+    FDR_FIELD(ap_sm_output, lateral.armed.NAV),
+    FDR_FIELD(ap_sm_output, lateral.armed.LOC),
+    FDR_FIELD(ap_sm_output, lateral.condition.NAV),
+    FDR_FIELD(ap_sm_output, lateral.condition.LOC_CPT),
+    FDR_FIELD(ap_sm_output, lateral.condition.LOC_TRACK),
+    FDR_FIELD(ap_sm_output, lateral.condition.LAND),
+    FDR_FIELD(ap_sm_output, lateral.condition.FLARE),
+    FDR_FIELD(ap_sm_output, lateral.condition.ROLL_OUT),
+    FDR_FIELD(ap_sm_output, lateral.condition.GA_TRACK),
+    FDR_FIELD(ap_sm_output, lateral.output.mode),
+    FDR_FIELD(ap_sm_output, lateral.output.mode_reversion),
+    FDR_FIELD(ap_sm_output, lateral.output.mode_reversion_TRK_FPA),
+    FDR_FIELD(ap_sm_output, lateral.output.law),
+    FDR_FIELD(ap_sm_output, lateral.output.Psi_c_deg),
+    FDR_FIELD(ap_sm_output, lateral_previous.armed.NAV),
+    FDR_FIELD(ap_sm_output, lateral_previous.armed.LOC),
+    FDR_FIELD(ap_sm_output, lateral_previous.condition.NAV),
+    FDR_FIELD(ap_sm_output, lateral_previous.condition.LOC_CPT),
+    FDR_FIELD(ap_sm_output, lateral_previous.condition.LOC_TRACK),
+    FDR_FIELD(ap_sm_output, lateral_previous.condition.LAND),
+    FDR_FIELD(ap_sm_output, lateral_previous.condition.FLARE),
+    FDR_FIELD(ap_sm_output, lateral_previous.condition.ROLL_OUT),
+    FDR_FIELD(ap_sm_output, lateral_previous.condition.GA_TRACK),
+    FDR_FIELD(ap_sm_output, lateral_previous.output.mode),
+    FDR_FIELD(ap_sm_output, lateral_previous.output.mode_reversion),
+    FDR_FIELD(ap_sm_output, lateral_previous.output.mode_reversion_TRK_FPA),
+    FDR_FIELD(ap_sm_output, lateral_previous.output.law),
+    FDR_FIELD(ap_sm_output, lateral_previous.output.Psi_c_deg),
+    FDR_FIELD(ap_sm_output, vertical.armed.ALT),
+    FDR_FIELD(ap_sm_output, vertical.armed.ALT_CST),
+    FDR_FIELD(ap_sm_output, vertical.armed.CLB),
+    FDR_FIELD(ap_sm_output, vertical.armed.DES),
+    FDR_FIELD(ap_sm_output, vertical.armed.FINAL_DES),
+    FDR_FIELD(ap_sm_output, vertical.armed.GS),
+    FDR_FIELD(ap_sm_output, vertical.armed.TCAS),
+    FDR_FIELD(ap_sm_output, vertical.condition.ALT),
+    FDR_FIELD(ap_sm_output, vertical.condition.ALT_CPT),
+    FDR_FIELD(ap_sm_output, vertical.condition.ALT_CST),
+    FDR_FIELD(ap_sm_output, vertical.condition.ALT_CST_CPT),
+    FDR_FIELD(ap_sm_output, vertical.condition.CLB),
+    FDR_FIELD(ap_sm_output, vertical.condition.DES),
+    FDR_FIELD(ap_sm_output, vertical.condition.FINAL_DES),
+    FDR_FIELD(ap_sm_output, vertical.condition.GS_CPT),
+    FDR_FIELD(ap_sm_output, vertical.condition.GS_TRACK),
+    FDR_FIELD(ap_sm_output, vertical.condition.LAND),
+    FDR_FIELD(ap_sm_output, vertical.condition.FLARE),
+    FDR_FIELD(ap_sm_output, vertical.condition.ROLL_OUT),
+    FDR_FIELD(ap_sm_output, vertical.condition.SRS),
+    FDR_FIELD(ap_sm_output, vertical.condition.SRS_GA),
+    FDR_FIELD(ap_sm_output, vertical.condition.THR_RED),
+    FDR_FIELD(ap_sm_output, vertical.condition.H_fcu_active),
+    FDR_FIELD(ap_sm_output, vertical.condition.TCAS),
+    FDR_FIELD(ap_sm_output, vertical.output.mode),
+    FDR_FIELD(ap_sm_output, vertical.output.mode_autothrust),
+    FDR_FIELD(ap_sm_output, vertical.output.mode_reversion),
+    FDR_FIELD(ap_sm_output, vertical.output.law),
+    FDR_FIELD(ap_sm_output, vertical.output.H_c_ft),
+    FDR_FIELD(ap_sm_output, vertical.output.H_dot_c_fpm),
+    FDR_FIELD(ap_sm_output, vertical.output.FPA_c_deg),
+    FDR_FIELD(ap_sm_output, vertical.output.V_c_kn),
+    FDR_FIELD(ap_sm_output, vertical.output.mode_reversion_target_fpm),
+    FDR_FIELD(ap_sm_output, vertical.output.mode_reversion_TRK_FPA),
+    FDR_FIELD(ap_sm_output, vertical.output.ALT_soft_mode_active),
+    FDR_FIELD(ap_sm_output, vertical.output.EXPED_mode_active),
+    FDR_FIELD(ap_sm_output, vertical.output.FD_disconnect),
+    FDR_FIELD(ap_sm_output, vertical.output.TCAS_sub_mode),
+    FDR_FIELD(ap_sm_output, vertical.output.TCAS_sub_mode_compatible),
+    FDR_FIELD(ap_sm_output, vertical.output.TCAS_message_disarm),
+    FDR_FIELD(ap_sm_output, vertical.output.TCAS_message_RA_inhibit),
+    FDR_FIELD(ap_sm_output, vertical.output.TCAS_message_TRK_FPA_deselection),
+    FDR_FIELD(ap_sm_output, vertical_previous.armed.ALT),
+    FDR_FIELD(ap_sm_output, vertical_previous.armed.ALT_CST),
+    FDR_FIELD(ap_sm_output, vertical_previous.armed.CLB),
+    FDR_FIELD(ap_sm_output, vertical_previous.armed.DES),
+    FDR_FIELD(ap_sm_output, vertical_previous.armed.FINAL_DES),
+    FDR_FIELD(ap_sm_output, vertical_previous.armed.GS),
+    FDR_FIELD(ap_sm_output, vertical_previous.armed.TCAS),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.ALT),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.ALT_CPT),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.ALT_CST),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.ALT_CST_CPT),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.CLB),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.DES),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.FINAL_DES),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.GS_CPT),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.GS_TRACK),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.LAND),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.FLARE),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.ROLL_OUT),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.SRS),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.SRS_GA),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.THR_RED),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.H_fcu_active),
+    FDR_FIELD(ap_sm_output, vertical_previous.condition.TCAS),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.mode),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.mode_autothrust),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.mode_reversion),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.law),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.H_c_ft),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.H_dot_c_fpm),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.FPA_c_deg),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.V_c_kn),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.mode_reversion_target_fpm),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.mode_reversion_TRK_FPA),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.ALT_soft_mode_active),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.EXPED_mode_active),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.FD_disconnect),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.TCAS_sub_mode),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.TCAS_sub_mode_compatible),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.TCAS_message_disarm),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.TCAS_message_RA_inhibit),
+    FDR_FIELD(ap_sm_output, vertical_previous.output.TCAS_message_TRK_FPA_deselection),
+    FDR_FIELD(ap_sm_output, output.enabled_AP1),
+    FDR_FIELD(ap_sm_output, output.enabled_AP2),
+    FDR_FIELD(ap_sm_output, output.lateral_law),
+    FDR_FIELD(ap_sm_output, output.lateral_mode),
+    FDR_FIELD(ap_sm_output, output.lateral_mode_armed),
+    FDR_FIELD(ap_sm_output, output.vertical_law),
+    FDR_FIELD(ap_sm_output, output.vertical_mode),
+    FDR_FIELD(ap_sm_output, output.vertical_mode_armed),
+    FDR_FIELD(ap_sm_output, output.mode_reversion_lateral),
+    FDR_FIELD(ap_sm_output, output.mode_reversion_vertical),
+    FDR_FIELD(ap_sm_output, output.mode_reversion_vertical_target_fpm),
+    FDR_FIELD(ap_sm_output, output.mode_reversion_TRK_FPA),
+    FDR_FIELD(ap_sm_output, output.mode_reversion_triple_click),
+    FDR_FIELD(ap_sm_output, output.mode_reversion_fma),
+    FDR_FIELD(ap_sm_output, output.speed_protection_mode),
+    FDR_FIELD(ap_sm_output, output.autothrust_mode),
+    FDR_FIELD(ap_sm_output, output.Psi_c_deg),
+    FDR_FIELD(ap_sm_output, output.H_c_ft),
+    FDR_FIELD(ap_sm_output, output.H_dot_c_fpm),
+    FDR_FIELD(ap_sm_output, output.FPA_c_deg),
+    FDR_FIELD(ap_sm_output, output.V_c_kn),
+    FDR_FIELD(ap_sm_output, output.ALT_soft_mode_active),
+    FDR_FIELD(ap_sm_output, output.EXPED_mode_active),
+    FDR_FIELD(ap_sm_output, output.FD_disconnect),
+    FDR_FIELD_NAMED(ap_sm_output, "output.TCAS_message_disarm)", output.TCAS_message_disarm),
+    FDR_FIELD_NAMED(ap_sm_output, "output.TCAS_message_RA_inhibit)", output.TCAS_message_RA_inhibit),
+    FDR_FIELD_NAMED(ap_sm_output, "output.TCAS_message_TRK_FPA_deselection)", output.TCAS_message_TRK_FPA_deselection),
+};
+
+inline constexpr FdrField FDR_FIELDS_AP_LAW[] = {
+    FDR_FIELD(ap_raw_output, ap_on),
+    FDR_FIELD(ap_raw_output, Phi_loc_c),
+    FDR_FIELD(ap_raw_output, Nosewheel_c),
+    FDR_FIELD(ap_raw_output, flight_director.Theta_c_deg),
+    FDR_FIELD(ap_raw_output, flight_director.Phi_c_deg),
+    FDR_FIELD(ap_raw_output, flight_director.Beta_c_deg),
+    FDR_FIELD(ap_raw_output, autopilot.Theta_c_deg),
+    FDR_FIELD(ap_raw_output, autopilot.Phi_c_deg),
+    FDR_FIELD(ap_raw_output, autopilot.Beta_c_deg),
+    FDR_FIELD(ap_raw_output, flare_law.condition_Flare),
+    FDR_FIELD(ap_raw_output, flare_law.H_dot_radio_fpm),
+    FDR_FIELD(ap_raw_output, flare_law.H_dot_c_fpm),
+    FDR_FIELD(ap_raw_output, flare_law.delta_Theta_H_dot_deg),
+    FDR_FIELD(ap_raw_output, flare_law.delta_Theta_bx_deg),
+    FDR_FIELD(ap_raw_output, flare_law.delta_Theta_bz_deg),
+    FDR_FIELD(ap_raw_output, flare_law.delta_Theta_beta_c_deg),
+};
+
+inline constexpr FdrField FDR_FIELDS_ATHR[] = {
+    FDR_FIELD(athr_out, time.dt),
+    FDR_FIELD(athr_out, time.simulation_time),
+    FDR_FIELD(athr_out, data.nz_g),
+    FDR_FIELD(athr_out, data.Theta_deg),
+    FDR_FIELD(athr_out, data.Phi_deg),
+    FDR_FIELD(athr_out, data.V_ias_kn),
+    FDR_FIELD(athr_out, data.V_tas_kn),
+    FDR_FIELD(athr_out, data.V_mach),
+    FDR_FIELD(athr_out, data.V_gnd_kn),
+    FDR_FIELD(athr_out, data.alpha_deg),
+    FDR_FIELD(athr_out, data.H_ft),
+    FDR_FIELD(athr_out, data.H_ind_ft),
+    FDR_FIELD(athr_out, data.H_radio_ft),
+    FDR_FIELD(athr_out, data.H_dot_fpm),
+    FDR_FIELD(athr_out, data.ax_m_s2),
+    FDR_FIELD(athr_out, data.ay_m_s2),
+    FDR_FIELD(athr_out, data.az_m_s2),
+    FDR_FIELD(athr_out, data.bx_m_s2),
+    FDR_FIELD(athr_out, data.by_m_s2),
+    FDR_FIELD(athr_out, data.bz_m_s2),
+    FDR_FIELD(athr_out, data.Psi_magnetic_deg),
+    FDR_FIELD(athr_out, data.Psi_magnetic_track_deg),
+    FDR_FIELD(athr_out, data.on_ground),
+    FDR_FIELD(athr_out, data.flap_handle_index),
+    FDR_FIELD(athr_out, data.is_engine_operative_1),
+    FDR_FIELD(athr_out, data.is_engine_operative_2),
+    FDR_FIELD(athr_out, data.is_engine_operative_3),
+    FDR_FIELD(athr_out, data.is_engine_operative_4),
+    FDR_FIELD(athr_out, data.commanded_engine_N1_1_percent),
+    FDR_FIELD(athr_out, data.commanded_engine_N1_2_percent),
+    FDR_FIELD(athr_out, data.commanded_engine_N1_3_percent),
+    FDR_FIELD(athr_out, data.commanded_engine_N1_4_percent),
+    FDR_FIELD(athr_out, data.engine_N1_1_percent),
+    FDR_FIELD(athr_out, data.engine_N1_2_percent),
+    FDR_FIELD(athr_out, data.engine_N1_3_percent),
+    FDR_FIELD(athr_out, data.engine_N1_4_percent),
+    FDR_FIELD(athr_out, data.TAT_degC),
+    FDR_FIELD(athr_out, data.OAT_degC),
+    FDR_FIELD(athr_out, data.ISA_degC),
+    FDR_FIELD(athr_out, data.ambient_density_kg_per_m3),
+    FDR_FIELD(athr_out, data_computed.TLA_in_active_range),
+    FDR_FIELD(athr_out, data_computed.is_FLX_active),
+    FDR_FIELD(athr_out, data_computed.ATHR_push),
+    FDR_FIELD(athr_out, data_computed.ATHR_disabled),
+    FDR_FIELD(athr_out, data_computed.time_since_touchdown),
+    FDR_FIELD(athr_out, data_computed.alpha_floor_inhibited),
+    FDR_FIELD(athr_out, input.ATHR_push),
+    FDR_FIELD(athr_out, input.ATHR_disconnect),
+    FDR_FIELD(athr_out, input.TLA_1_deg),
+    FDR_FIELD(athr_out, input.TLA_2_deg),
+    FDR_FIELD(athr_out, input.TLA_3_deg),
+    FDR_FIELD(athr_out, input.TLA_4_deg),
+    FDR_FIELD(athr_out, input.V_c_kn),
+    FDR_FIELD(athr_out, input.V_LS_kn),
+    FDR_FIELD(athr_out, input.V_MAX_kn),
+    FDR_FIELD(athr_out, input.thrust_limit_REV_percent),
+    FDR_FIELD(athr_out, input.thrust_limit_IDLE_percent),
+    FDR_FIELD(athr_out, input.thrust_limit_CLB_percent),
+    FDR_FIELD(athr_out, input.thrust_limit_MCT_percent),
+    FDR_FIELD(athr_out, input.thrust_limit_FLEX_percent),
+    FDR_FIELD(athr_out, input.thrust_limit_TOGA_percent),
+    FDR_FIELD(athr_out, input.flex_temperature_degC),
+    FDR_FIELD(athr_out, input.mode_requested),
+    FDR_FIELD(athr_out, input.is_mach_mode_active),
+    FDR_FIELD(athr_out, input.alpha_floor_condition),
+    FDR_FIELD(athr_out, input.is_approach_mode_active),
+    FDR_FIELD(athr_out, input.is_SRS_TO_mode_active),
+    FDR_FIELD(athr_out, input.is_SRS_GA_mode_active),
+    FDR_FIELD(athr_out, input.is_LAND_mode_active),
+    FDR_FIELD(athr_out, input.thrust_reduction_altitude),
+    FDR_FIELD(athr_out, input.thrust_reduction_altitude_go_around),
+    FDR_FIELD(athr_out, input.flight_phase),
+    FDR_FIELD(athr_out, input.is_alt_soft_mode_active),
+    FDR_FIELD(athr_out, input.is_anti_ice_wing_active),
+    FDR_FIELD(athr_out, input.is_anti_ice_engine_1_active),
+    FDR_FIELD(athr_out, input.is_anti_ice_engine_2_active),
+    FDR_FIELD(athr_out, input.is_air_conditioning_1_active),
+    FDR_FIELD(athr_out, input.is_air_conditioning_2_active),
+    FDR_FIELD(athr_out, input.FD_active),
+    FDR_FIELD(athr_out, input.ATHR_reset_disable),
+    FDR_FIELD(athr_out, input.is_TCAS_active),
+    FDR_FIELD(athr_out, input.target_TCAS_RA_rate_fpm),
+    FDR_FIELD(athr_out, output.sim_throttle_lever_1_pos),
+    FDR_FIELD(athr_out, output.sim_throttle_lever_2_pos),
+    FDR_FIELD(athr_out, output.sim_throttle_lever_3_pos),
+    FDR_FIELD(athr_out, output.sim_throttle_lever_4_pos),
+    FDR_FIELD(athr_out, output.sim_thrust_mode_1),
+    FDR_FIELD(athr_out, output.sim_thrust_mode_2),
+    FDR_FIELD(athr_out, output.sim_thrust_mode_3),
+    FDR_FIELD(athr_out, output.sim_thrust_mode_4),
+    FDR_FIELD(athr_out, output.N1_TLA_1_percent),
+    FDR_FIELD(athr_out, output.N1_TLA_2_percent),
+    FDR_FIELD(athr_out, output.N1_TLA_3_percent),
+    FDR_FIELD(athr_out, output.N1_TLA_4_percent),
+    FDR_FIELD(athr_out, output.is_in_reverse_1),
+    FDR_FIELD(athr_out, output.is_in_reverse_2),
+    FDR_FIELD(athr_out, output.is_in_reverse_3),
+    FDR_FIELD(athr_out, output.is_in_reverse_4),
+    FDR_FIELD(athr_out, output.thrust_limit_type),
+    FDR_FIELD(athr_out, output.thrust_limit_percent),
+    FDR_FIELD(athr_out, output.N1_c_1_percent),
+    FDR_FIELD(athr_out, output.N1_c_2_percent),
+    FDR_FIELD(athr_out, output.N1_c_3_percent),
+    FDR_FIELD(athr_out, output.N1_c_4_percent),
+    FDR_FIELD(athr_out, output.status),
+    FDR_FIELD(athr_out, output.mode),
+    FDR_FIELD(athr_out, output.mode_message),
+    FDR_FIELD(athr_out, output.thrust_lever_warning_flex),
+    FDR_FIELD(athr_out, output.thrust_lever_warning_toga),
+};
+
+inline constexpr FdrField FDR_FIELDS_ENGINE[] = {
+    FDR_FIELD(EngineData, simOnGround),
+    FDR_FIELD(EngineData, generalEngineElapsedTime_1),
+    FDR_FIELD(EngineData, generalEngineElapsedTime_2),
+    FDR_FIELD(EngineData, standardAtmTemperature),
+    FDR_FIELD(EngineData, turbineEngineCorrectedFuelFlow_1),
+    FDR_FIELD(EngineData, turbineEngineCorrectedFuelFlow_2),
+    FDR_FIELD(EngineData, fuelTankCapacityAuxLeft),
+    FDR_FIELD(EngineData, fuelTankCapacityAuxRight),
+    FDR_FIELD(EngineData, fuelTankCapacityMainLeft),
+    FDR_FIELD(EngineData, fuelTankCapacityMainRight),
+    FDR_FIELD(EngineData, fuelTankCapacityCenter),
+    FDR_FIELD(EngineData, fuelTankQuantityAuxLeft),
+    FDR_FIELD(EngineData, fuelTankQuantityAuxRight),
+    FDR_FIELD(EngineData, fuelTankQuantityMainLeft),
+    FDR_FIELD(EngineData, fuelTankQuantityMainRight),
+    FDR_FIELD(EngineData, fuelTankQuantityCenter),
+    FDR_FIELD(EngineData, fuelTankQuantityTotal),
+    FDR_FIELD(EngineData, fuelWeightPerGallon),
+    FDR_FIELD(EngineData, engineEngine1N2),
+    FDR_FIELD(EngineData, engineEngine2N2),
+    FDR_FIELD(EngineData, engineEngine1N1),
+    FDR_FIELD(EngineData, engineEngine2N1),
+    FDR_FIELD(EngineData, engineEngineIdleN1),
+    FDR_FIELD(EngineData, engineEngineIdleN2),
+    FDR_FIELD(EngineData, engineEngineIdleFF),
+    FDR_FIELD(EngineData, engineEngineIdleEGT),
+    FDR_FIELD(EngineData, engineEngine1EGT),
+    FDR_FIELD(EngineData, engineEngine2EGT),
+    FDR_FIELD(EngineData, engineEngine1Oil),
+    FDR_FIELD(EngineData, engineEngine2Oil),
+    FDR_FIELD(EngineData, engineEngine1TotalOil),
+    FDR_FIELD(EngineData, engineEngine2TotalOil),
+    FDR_FIELD(EngineData, engineEngine1FF),
+    FDR_FIELD(EngineData, engineEngine2FF),
+    FDR_FIELD(EngineData, engineEngine1PreFF),
+    FDR_FIELD(EngineData, engineEngine2PreFF),
+    FDR_FIELD(EngineData, engineEngineImbalance),
+    FDR_FIELD(EngineData, engineFuelUsedLeft),
+    FDR_FIELD(EngineData, engineFuelUsedRight),
+    FDR_FIELD(EngineData, engineFuelLeftPre),
+    FDR_FIELD(EngineData, engineFuelRightPre),
+    FDR_FIELD(EngineData, engineFuelAuxLeftPre),
+    FDR_FIELD(EngineData, engineFuelAuxRightPre),
+    FDR_FIELD(EngineData, engineFuelCenterPre),
+    FDR_FIELD(EngineData, engineEngineCycleTime),
+    FDR_FIELD(EngineData, engineEngine1State),
+    FDR_FIELD(EngineData, engineEngine2State),
+    FDR_FIELD(EngineData, engineEngine1Timer),
+    FDR_FIELD(EngineData, engineEngine2Timer),
+};
+
+inline constexpr FdrField FDR_FIELDS_ADDITIONAL[] = {
+    FDR_FIELD(AdditionalData, master_warning_active),
+    FDR_FIELD(AdditionalData, master_caution_active),
+    FDR_FIELD(AdditionalData, park_brake_lever_pos),
+    FDR_FIELD(AdditionalData, brake_pedal_left_pos),
+    FDR_FIELD(AdditionalData, brake_pedal_right_pos),
+    FDR_FIELD(AdditionalData, brake_left_sim_pos),
+    FDR_FIELD(AdditionalData, brake_right_sim_pos),
+    FDR_FIELD(AdditionalData, autobrake_armed_mode),
+    FDR_FIELD(AdditionalData, autobrake_decel_light),
+    FDR_FIELD(AdditionalData, spoilers_handle_pos),
+    FDR_FIELD(AdditionalData, spoilers_armed),
+    FDR_FIELD(AdditionalData, spoilers_handle_sim_pos),
+    FDR_FIELD(AdditionalData, ground_spoilers_active),
+    FDR_FIELD(AdditionalData, flaps_handle_percent),
+    FDR_FIELD(AdditionalData, flaps_handle_index),
+    FDR_FIELD(AdditionalData, flaps_handle_configuration_index),
+    FDR_FIELD(AdditionalData, flaps_handle_sim_index),
+    FDR_FIELD(AdditionalData, gear_handle_pos),
+    FDR_FIELD(AdditionalData, hydraulic_green_pressure),
+    FDR_FIELD(AdditionalData, hydraulic_blue_pressure),
+    FDR_FIELD(AdditionalData, hydraulic_yellow_pressure),
+    FDR_FIELD(AdditionalData, throttle_lever_1_pos),
+    FDR_FIELD(AdditionalData, throttle_lever_2_pos),
+    FDR_FIELD(AdditionalData, corrected_engine_N1_1_percent),
+    FDR_FIELD(AdditionalData, corrected_engine_N1_2_percent),
+    FDR_FIELD(AdditionalData, assistanceTakeoffEnabled),
+    FDR_FIELD(AdditionalData, assistanceLandingEnabled),
+    FDR_FIELD(AdditionalData, aiAutoTrimActive),
+    FDR_FIELD(AdditionalData, aiControlsActive),
+    FDR_FIELD(AdditionalData, realisticTillerEnabled),
+    FDR_FIELD(AdditionalData, tillerHandlePosition),
+    FDR_FIELD(AdditionalData, noseWheelPosition),
+    FDR_FIELD(AdditionalData, syncFoEfisEnabled),
+    FDR_FIELD(AdditionalData, ls1Active),
+    FDR_FIELD(AdditionalData, ls2Active),
+    FDR_FIELD(AdditionalData, IsisLsActive),
+    FDR_FIELD(AdditionalData, wingAntiIce),
+    FDR_FIELD(AdditionalData, inputElevator),
+    FDR_FIELD(AdditionalData, inputAileron),
+    FDR_FIELD(AdditionalData, inputRudder),
+    FDR_FIELD(AdditionalData, simulation_rate),
+    FDR_FIELD(AdditionalData, wasPaused),
+    FDR_FIELD(AdditionalData, slew_on),
+    FDR_FIELD(AdditionalData, ice_structure_percent),
+    FDR_FIELD(AdditionalData, ambient_pressure_mbar),
+    FDR_FIELD(AdditionalData, ambient_wind_velocity_kn),
+    FDR_FIELD(AdditionalData, ambient_wind_direction_deg),
+    FDR_FIELD(AdditionalData, total_air_temperature_celsius),
+    FDR_FIELD(AdditionalData, failuresActive),
+    FDR_FIELD(AdditionalData, alpha_floor_condition),
+    FDR_FIELD(AdditionalData, high_aoa_protection),
+};
+
+// The inputs of the models are recorded completely, so that the models can be replayed offline from a recording.
+
+inline constexpr FdrField FDR_FIELDS_AP_SM_IN[] = {
+    FDR_FIELD(ap_sm_input, time.dt),
+    FDR_FIELD(ap_sm_input, time.simulation_time),
+    FDR_FIELD(ap_sm_input, data.aircraft_position.lat),
+    FDR_FIELD(ap_sm_input, data.aircraft_position.lon),
+    FDR_FIELD(ap_sm_input, data.aircraft_position.alt),
+    FDR_FIELD(ap_sm_input, data.Theta_deg),
+    FDR_FIELD(ap_sm_input, data.Phi_deg),
+    FDR_FIELD(ap_sm_input, data.q_rad_s),
+    FDR_FIELD(ap_sm_input, data.r_rad_s),
+    FDR_FIELD(ap_sm_input, data.p_rad_s),
+    FDR_FIELD(ap_sm_input, data.V_ias_kn),
+    FDR_FIELD(ap_sm_input, data.V_tas_kn),
+    FDR_FIELD(ap_sm_input, data.V_mach),
+    FDR_FIELD(ap_sm_input, data.V_gnd_kn),
+    FDR_FIELD(ap_sm_input, data.alpha_deg),
+    FDR_FIELD(ap_sm_input, data.beta_deg),
+    FDR_FIELD(ap_sm_input, data.H_ft),
+    FDR_FIELD(ap_sm_input, data.H_ind_ft),
+    FDR_FIELD(ap_sm_input, data.H_radio_ft),
+    FDR_FIELD(ap_sm_input, data.H_dot_ft_min),
+    FDR_FIELD(ap_sm_input, data.Psi_magnetic_deg),
+    FDR_FIELD(ap_sm_input, data.Psi_magnetic_track_deg),
+    FDR_FIELD(ap_sm_input, data.Psi_true_deg),
+    FDR_FIELD(ap_sm_input, data.bx_m_s2),
+    FDR_FIELD(ap_sm_input, data.by_m_s2),
+    FDR_FIELD(ap_sm_input, data.bz_m_s2),
+    FDR_FIELD(ap_sm_input, data.nav_valid),
+    FDR_FIELD(ap_sm_input, data.nav_loc_deg),
+    FDR_FIELD(ap_sm_input, data.nav_gs_deg),
+    FDR_FIELD(ap_sm_input, data.nav_dme_valid),
+    FDR_FIELD(ap_sm_input, data.nav_dme_nmi),
+    FDR_FIELD(ap_sm_input, data.nav_loc_valid),
+    FDR_FIELD(ap_sm_input, data.nav_loc_magvar_deg),
+    FDR_FIELD(ap_sm_input, data.nav_loc_error_deg),
+    FDR_FIELD(ap_sm_input, data.nav_loc_position.lat),
+    FDR_FIELD(ap_sm_input, data.nav_loc_position.lon),
+    FDR_FIELD(ap_sm_input, data.nav_loc_position.alt),
+    FDR_FIELD(ap_sm_input, data.nav_gs_valid),
+    FDR_FIELD(ap_sm_input, data.nav_gs_error_deg),
+    FDR_FIELD(ap_sm_input, data.nav_gs_position.lat),
+    FDR_FIELD(ap_sm_input, data.nav_gs_position.lon),
+    FDR_FIELD(ap_sm_input, data.nav_gs_position.alt),
+    FDR_FIELD(ap_sm_input, data.flight_guidance_xtk_nmi),
+    FDR_FIELD(ap_sm_input, data.flight_guidance_tae_deg),
+    FDR_FIELD(ap_sm_input, data.flight_guidance_phi_deg),
+    FDR_FIELD(ap_sm_input, data.flight_guidance_phi_limit_deg),
+    FDR_FIELD(ap_sm_input, data.flight_phase),
+    FDR_FIELD(ap_sm_input, data.V2_kn),
+    FDR_FIELD(ap_sm_input, data.VAPP_kn),
+    FDR_FIELD(ap_sm_input, data.VLS_kn),
+    FDR_FIELD(ap_sm_input, data.VMAX_kn),
+    FDR_FIELD(ap_sm_input, data.is_flight_plan_available),
+    FDR_FIELD(ap_sm_input, data.altitude_constraint_ft),
+    FDR_FIELD(ap_sm_input, data.thrust_reduction_altitude),
+    FDR_FIELD(ap_sm_input, data.thrust_reduction_altitude_go_around),
+    FDR_FIELD(ap_sm_input, data.acceleration_altitude),
+    FDR_FIELD(ap_sm_input, data.acceleration_altitude_engine_out),
+    FDR_FIELD(ap_sm_input, data.acceleration_altitude_go_around),
+    FDR_FIELD(ap_sm_input, data.acceleration_altitude_go_around_engine_out),
+    FDR_FIELD(ap_sm_input, data.cruise_altitude),
+    FDR_FIELD(ap_sm_input, data.gear_strut_compression_1),
+    FDR_FIELD(ap_sm_input, data.gear_strut_compression_2),
+    FDR_FIELD(ap_sm_input, data.zeta_pos),
+    FDR_FIELD(ap_sm_input, data.throttle_lever_1_pos),
+    FDR_FIELD(ap_sm_input, data.throttle_lever_2_pos),
+    FDR_FIELD(ap_sm_input, data.flaps_handle_index),
+    FDR_FIELD(ap_sm_input, data.is_engine_operative_1),
+    FDR_FIELD(ap_sm_input, data.is_engine_operative_2),
+    FDR_FIELD(ap_sm_input, data.altimeter_setting_left_mbar),
+    FDR_FIELD(ap_sm_input, data.altimeter_setting_right_mbar),
+    FDR_FIELD(ap_sm_input, data.total_weight_kg),
+    FDR_FIELD(ap_sm_input, input.FD_active),
+    FDR_FIELD(ap_sm_input, input.AP_ENGAGE_push),
+    FDR_FIELD(ap_sm_input, input.AP_1_push),
+    FDR_FIELD(ap_sm_input, input.AP_2_push),
+    FDR_FIELD(ap_sm_input, input.AP_DISCONNECT_push),
+    FDR_FIELD(ap_sm_input, input.HDG_push),
+    FDR_FIELD(ap_sm_input, input.HDG_pull),
+    FDR_FIELD(ap_sm_input, input.ALT_push),
+    FDR_FIELD(ap_sm_input, input.ALT_pull),
+    FDR_FIELD(ap_sm_input, input.VS_push),
+    FDR_FIELD(ap_sm_input, input.VS_pull),
+    FDR_FIELD(ap_sm_input, input.LOC_push),
+    FDR_FIELD(ap_sm_input, input.APPR_push),
+    FDR_FIELD(ap_sm_input, input.EXPED_push),
+    FDR_FIELD(ap_sm_input, input.V_fcu_kn),
+    FDR_FIELD(ap_sm_input, input.Psi_fcu_deg),
+    FDR_FIELD(ap_sm_input, input.H_fcu_ft),
+    FDR_FIELD(ap_sm_input, input.H_constraint_ft),
+    FDR_FIELD(ap_sm_input, input.H_dot_fcu_fpm),
+    FDR_FIELD(ap_sm_input, input.FPA_fcu_deg),
+    FDR_FIELD(ap_sm_input, input.TRK_FPA_mode),
+    FDR_FIELD(ap_sm_input, input.DIR_TO_trigger),
+    FDR_FIELD(ap_sm_input, input.is_FLX_active),
+    FDR_FIELD(ap_sm_input, input.Slew_trigger),
+    FDR_FIELD(ap_sm_input, input.MACH_mode),
+    FDR_FIELD(ap_sm_input, input.ATHR_engaged),
+    FDR_FIELD(ap_sm_input, input.is_SPEED_managed),
+    FDR_FIELD(ap_sm_input, input.FDR_event),
+    FDR_FIELD(ap_sm_input, input.Phi_loc_c),
+    FDR_FIELD(ap_sm_input, input.FM_requested_vertical_mode),
+    FDR_FIELD(ap_sm_input, input.FM_H_c_ft),
+    FDR_FIELD(ap_sm_input, input.FM_H_dot_c_fpm),
+    FDR_FIELD(ap_sm_input, input.FM_rnav_appr_selected),
+    FDR_FIELD(ap_sm_input, input.FM_final_des_can_engage),
+    FDR_FIELD(ap_sm_input, input.TCAS_mode_fail),
+    FDR_FIELD(ap_sm_input, input.TCAS_mode_available),
+    FDR_FIELD(ap_sm_input, input.TCAS_advisory_state),
+    FDR_FIELD(ap_sm_input, input.TCAS_advisory_target_min_fpm),
+    FDR_FIELD(ap_sm_input, input.TCAS_advisory_target_max_fpm),
+    FDR_FIELD(ap_sm_input, input.condition_Flare),
+};
+
+inline constexpr FdrField FDR_FIELDS_AP_LAW_IN[] = {
+    FDR_FIELD(ap_laws_input, time.dt),
+    FDR_FIELD(ap_laws_input, time.simulation_time),
+    FDR_FIELD(ap_laws_input, data.aircraft_position.lat),
+    FDR_FIELD(ap_laws_input, data.aircraft_position.lon),
+    FDR_FIELD(ap_laws_input, data.aircraft_position.alt),
+    FDR_FIELD(ap_laws_input, data.Theta_deg),
+    FDR_FIELD(ap_laws_input, data.Phi_deg),
+    FDR_FIELD(ap_laws_input, data.q_rad_s),
+    FDR_FIELD(ap_laws_input, data.r_rad_s),
+    FDR_FIELD(ap_laws_input, data.p_rad_s),
+    FDR_FIELD(ap_laws_input, data.V_ias_kn),
+    FDR_FIELD(ap_laws_input, data.V_tas_kn),
+    FDR_FIELD(ap_laws_input, data.V_mach),
+    FDR_FIELD(ap_laws_input, data.V_gnd_kn),
+    FDR_FIELD(ap_laws_input, data.alpha_deg),
+    FDR_FIELD(ap_laws_input, data.beta_deg),
+    FDR_FIELD(ap_laws_input, data.H_ft),
+    FDR_FIELD(ap_laws_input, data.H_ind_ft),
+    FDR_FIELD(ap_laws_input, data.H_radio_ft),
+    FDR_FIELD(ap_laws_input, data.H_dot_ft_min),
+    FDR_FIELD(ap_laws_input, data.Psi_magnetic_deg),
+    FDR_FIELD(ap_laws_input, data.Psi_magnetic_track_deg),
+    FDR_FIELD(ap_laws_input, data.Psi_true_deg),
+    FDR_FIELD(ap_laws_input, data.bx_m_s2),
+    FDR_FIELD(ap_laws_input, data.by_m_s2),
+    FDR_FIELD(ap_laws_input, data.bz_m_s2),
+    FDR_FIELD(ap_laws_input, data.nav_valid),
+    FDR_FIELD(ap_laws_input, data.nav_loc_deg),
+    FDR_FIELD(ap_laws_input, data.nav_gs_deg),
+    FDR_FIELD(ap_laws_input, data.nav_dme_valid),
+    FDR_FIELD(ap_laws_input, data.nav_dme_nmi),
+    FDR_FIELD(ap_laws_input, data.nav_loc_valid),
+    FDR_FIELD(ap_laws_input, data.nav_loc_magvar_deg),
+    FDR_FIELD(ap_laws_input, data.nav_loc_error_deg),
+    FDR_FIELD(ap_laws_input, data.nav_loc_position.lat),
+    FDR_FIELD(ap_laws_input, data.nav_loc_position.lon),
+    FDR_FIELD(ap_laws_input, data.nav_loc_position.alt),
+    FDR_FIELD(ap_laws_input, data.nav_gs_valid),
+    FDR_FIELD(ap_laws_input, data.nav_gs_error_deg),
+    FDR_FIELD(ap_laws_input, data.nav_gs_position.lat),
+    FDR_FIELD(ap_laws_input, data.nav_gs_position.lon),
+    FDR_FIELD(ap_laws_input, data.nav_gs_position.alt),
+    FDR_FIELD(ap_laws_input, data.flight_guidance_xtk_nmi),
+    FDR_FIELD(ap_laws_input, data.flight_guidance_tae_deg),
+    FDR_FIELD(ap_laws_input, data.flight_guidance_phi_deg),
+    FDR_FIELD(ap_laws_input, data.flight_guidance_phi_limit_deg),
+    FDR_FIELD(ap_laws_input, data.flight_phase),
+    FDR_FIELD(ap_laws_input, data.V2_kn),
+    FDR_FIELD(ap_laws_input, data.VAPP_kn),
+    FDR_FIELD(ap_laws_input, data.VLS_kn),
+    FDR_FIELD(ap_laws_input, data.VMAX_kn),
+    FDR_FIELD(ap_laws_input, data.is_flight_plan_available),
+    FDR_FIELD(ap_laws_input, data.altitude_constraint_ft),
+    FDR_FIELD(ap_laws_input, data.thrust_reduction_altitude),
+    FDR_FIELD(ap_laws_input, data.thrust_reduction_altitude_go_around),
+    FDR_FIELD(ap_laws_input, data.acceleration_altitude),
+    FDR_FIELD(ap_laws_input, data.acceleration_altitude_engine_out),
+    FDR_FIELD(ap_laws_input, data.acceleration_altitude_go_around),
+    FDR_FIELD(ap_laws_input, data.acceleration_altitude_go_around_engine_out),
+    FDR_FIELD(ap_laws_input, data.cruise_altitude),
+    FDR_FIELD(ap_laws_input, data.gear_strut_compression_1),
+    FDR_FIELD(ap_laws_input, data.gear_strut_compression_2),
+    FDR_FIELD(ap_laws_input, data.zeta_pos),
+    FDR_FIELD(ap_laws_input, data.throttle_lever_1_pos),
+    FDR_FIELD(ap_laws_input, data.throttle_lever_2_pos),
+    FDR_FIELD(ap_laws_input, data.flaps_handle_index),
+    FDR_FIELD(ap_laws_input, data.is_engine_operative_1),
+    FDR_FIELD(ap_laws_input, data.is_engine_operative_2),
+    FDR_FIELD(ap_laws_input, data.altimeter_setting_left_mbar),
+    FDR_FIELD(ap_laws_input, data.altimeter_setting_right_mbar),
+    FDR_FIELD(ap_laws_input, data.total_weight_kg),
+    FDR_FIELD(ap_laws_input, input.enabled_AP1),
+    FDR_FIELD(ap_laws_input, input.enabled_AP2),
+    FDR_FIELD(ap_laws_input, input.lateral_law),
+    FDR_FIELD(ap_laws_input, input.lateral_mode),
+    FDR_FIELD(ap_laws_input, input.lateral_mode_armed),
+    FDR_FIELD(ap_laws_input, input.vertical_law),
+    FDR_FIELD(ap_laws_input, input.vertical_mode),
+    FDR_FIELD(ap_laws_input, input.vertical_mode_armed),
+    FDR_FIELD(ap_laws_input, input.mode_reversion_lateral),
+    FDR_FIELD(ap_laws_input, input.mode_reversion_vertical),
+    FDR_FIELD(ap_laws_input, input.mode_reversion_vertical_target_fpm),
+    FDR_FIELD(ap_laws_input, input.mode_reversion_TRK_FPA),
+    FDR_FIELD(ap_laws_input, input.mode_reversion_triple_click),
+    FDR_FIELD(ap_laws_input, input.mode_reversion_fma),
+    FDR_FIELD(ap_laws_input, input.speed_protection_mode),
+    FDR_FIELD(ap_laws_input, input.autothrust_mode),
+    FDR_FIELD(ap_laws_input, input.Psi_c_deg),
+    FDR_FIELD(ap_laws_input, input.H_c_ft),
+    FDR_FIELD(ap_laws_input, input.H_dot_c_fpm),
+    FDR_FIELD(ap_laws_input, input.FPA_c_deg),
+    FDR_FIELD(ap_laws_input, input.V_c_kn),
+    FDR_FIELD(ap_laws_input, input.ALT_soft_mode_active),
+    FDR_FIELD(ap_laws_input, input.ALT_cruise_mode_active),
+    FDR_FIELD(ap_laws_input, input.EXPED_mode_active),
+    FDR_FIELD(ap_laws_input, input.FD_disconnect),
+    FDR_FIELD(ap_laws_input, input.FD_connect),
+    FDR_FIELD(ap_laws_input, input.TCAS_message_disarm),
+    FDR_FIELD(ap_laws_input, input.TCAS_message_RA_inhibit),
+    FDR_FIELD(ap_laws_input, input.TCAS_message_TRK_FPA_deselection),
+};
+
+inline constexpr FdrField FDR_FIELDS_ATHR_IN[] = {
+    FDR_FIELD(athr_in, time.dt),
+    FDR_FIELD(athr_in, time.simulation_time),
+    FDR_FIELD(athr_in, data.nz_g),
+    FDR_FIELD(athr_in, data.Theta_deg),
+    FDR_FIELD(athr_in, data.Phi_deg),
+    FDR_FIELD(athr_in, data.V_ias_kn),
+    FDR_FIELD(athr_in, data.V_tas_kn),
+    FDR_FIELD(athr_in, data.V_mach),
+    FDR_FIELD(athr_in, data.V_gnd_kn),
+    FDR_FIELD(athr_in, data.alpha_deg),
+    FDR_FIELD(athr_in, data.H_ft),
+    FDR_FIELD(athr_in, data.H_ind_ft),
+    FDR_FIELD(athr_in, data.H_radio_ft),
+    FDR_FIELD(athr_in, data.H_dot_fpm),
+    FDR_FIELD(athr_in, data.bx_m_s2),
+    FDR_FIELD(athr_in, data.by_m_s2),
+    FDR_FIELD(athr_in, data.bz_m_s2),
+    FDR_FIELD(athr_in, data.Psi_magnetic_deg),
+    FDR_FIELD(athr_in, data.Psi_magnetic_track_deg),
+    FDR_FIELD(athr_in, data.gear_strut_compression_1),
+    FDR_FIELD(athr_in, data.gear_strut_compression_2),
+    FDR_FIELD(athr_in, data.flap_handle_index),
+    FDR_FIELD(athr_in, data.is_engine_operative_1),
+    FDR_FIELD(athr_in, data.is_engine_operative_2),
+    FDR_FIELD(athr_in, data.is_engine_operative_3),
+    FDR_FIELD(athr_in, data.is_engine_operative_4),
+    FDR_FIELD(athr_in, data.commanded_engine_N1_1_percent),
+    FDR_FIELD(athr_in, data.commanded_engine_N1_2_percent),
+    FDR_FIELD(athr_in, data.commanded_engine_N1_3_percent),
+    FDR_FIELD(athr_in, data.commanded_engine_N1_4_percent),
+    FDR_FIELD(athr_in, data.engine_N1_1_percent),
+    FDR_FIELD(athr_in, data.engine_N1_2_percent),
+    FDR_FIELD(athr_in, data.engine_N1_3_percent),
+    FDR_FIELD(athr_in, data.engine_N1_4_percent),
+    FDR_FIELD(athr_in, data.corrected_engine_N1_1_percent),
+    FDR_FIELD(athr_in, data.corrected_engine_N1_2_percent),
+    FDR_FIELD(athr_in, data.corrected_engine_N1_3_percent),
+    FDR_FIELD(athr_in, data.corrected_engine_N1_4_percent),
+    FDR_FIELD(athr_in, data.TAT_degC),
+    FDR_FIELD(athr_in, data.OAT_degC),
+    FDR_FIELD(athr_in, data.ambient_density_kg_per_m3),
+    FDR_FIELD(athr_in, input.ATHR_push),
+    FDR_FIELD(athr_in, input.ATHR_disconnect),
+    FDR_FIELD(athr_in, input.TLA_1_deg),
+    FDR_FIELD(athr_in, input.TLA_2_deg),
+    FDR_FIELD(athr_in, input.TLA_3_deg),
+    FDR_FIELD(athr_in, input.TLA_4_deg),
+    FDR_FIELD(athr_in, input.V_c_kn),
+    FDR_FIELD(athr_in, input.V_LS_kn),
+    FDR_FIELD(athr_in, input.V_MAX_kn),
+    FDR_FIELD(athr_in, input.thrust_limit_REV_percent),
+    FDR_FIELD(athr_in, input.thrust_limit_IDLE_percent),
+    FDR_FIELD(athr_in, input.thrust_limit_CLB_percent),
+    FDR_FIELD(athr_in, input.thrust_limit_MCT_percent),
+    FDR_FIELD(athr_in, input.thrust_limit_FLEX_percent),
+    FDR_FIELD(athr_in, input.thrust_limit_TOGA_percent),
+    FDR_FIELD(athr_in, input.flex_temperature_degC),
+    FDR_FIELD(athr_in, input.mode_requested),
+    FDR_FIELD(athr_in, input.is_mach_mode_active),
+    FDR_FIELD(athr_in, input.alpha_floor_condition),
+    FDR_FIELD(athr_in, input.is_approach_mode_active),
+    FDR_FIELD(athr_in, input.is_SRS_TO_mode_active),
+    FDR_FIELD(athr_in, input.is_SRS_GA_mode_active),
+    FDR_FIELD(athr_in, input.is_LAND_mode_active),
+    FDR_FIELD(athr_in, input.thrust_reduction_altitude),
+    FDR_FIELD(athr_in, input.thrust_reduction_altitude_go_around),
+    FDR_FIELD(athr_in, input.flight_phase),
+    FDR_FIELD(athr_in, input.is_alt_soft_mode_active),
+    FDR_FIELD(athr_in, input.is_anti_ice_wing_active),
+    FDR_FIELD(athr_in, input.is_anti_ice_engine_1_active),
+    FDR_FIELD(athr_in, input.is_anti_ice_engine_2_active),
+    FDR_FIELD(athr_in, input.is_air_conditioning_1_active),
+    FDR_FIELD(athr_in, input.is_air_conditioning_2_active),
+    FDR_FIELD(athr_in, input.FD_active),
+    FDR_FIELD(athr_in, input.ATHR_reset_disable),
+    FDR_FIELD(athr_in, input.is_TCAS_active),
+    FDR_FIELD(athr_in, input.target_TCAS_RA_rate_fpm),
+};
+
+// recorded structs in the order they are written per frame
+inline constexpr FdrStruct FDR_STRUCTS[] = {
+    makeFdrStruct<ap_sm_output>("ap_sm", FDR_FIELDS_AP_SM),
+    makeFdrStruct<ap_raw_output>("ap_law", FDR_FIELDS_AP_LAW),
+    makeFdrStruct<athr_out>("athr", FDR_FIELDS_ATHR),
+    makeFdrStruct<EngineData>("engine", FDR_FIELDS_ENGINE),
+    makeFdrStruct<AdditionalData>("data", FDR_FIELDS_ADDITIONAL),
+    makeFdrStruct<ap_sm_input>("ap_sm_in", FDR_FIELDS_AP_SM_IN),
+    makeFdrStruct<ap_laws_input>("ap_law_in", FDR_FIELDS_AP_LAW_IN),
+    makeFdrStruct<athr_in>("athr_in", FDR_FIELDS_ATHR_IN),
+};
+
+// number of leading structs of FDR_STRUCTS that were recorded before interface version 27 added the model inputs
+inline constexpr size_t FDR_STRUCT_COUNT_WITHOUT_INPUTS = 5;
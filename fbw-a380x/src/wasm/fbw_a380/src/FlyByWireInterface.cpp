@@ -14,6 +14,19 @@ bool FlyByWireInterface::connect() {
   // setup local variables
   setupLocalVariables();
 
+  // local variables are written in one pass at the end of each update
+  LocalVariable::setDeferredWrites(true);
+
+  // register the trace names in the order of the trace stages
+  for (const char* name : TRACE_STAGE_NAMES) {
+    traceRecorder.addName(name);
+  }
+  traceRecorder.setTriggerValue(idTraceDump->get(true));
+
+  // a trigger left over from before a reload must not save or restore on the first update
+  lastComputersSnapshotSaveTrigger = idComputersSnapshotSave->get(true);
+  lastComputersSnapshotRestoreTrigger = idComputersSnapshotRestore->get(true);
+
   // load configuration
   loadConfiguration();
 
@@ -60,102 +73,166 @@ void FlyByWireInterface::disconnect() {
   // delete throttle axis mapping -> due to usage of shared_ptr no delete call is needed
   throttleAxis.clear();
 
-  // unregister local variables
+  // write pending local variables and unregister them
+  LocalVariable::writeAll();
   unregister_all_named_vars();
 }
 
 bool FlyByWireInterface::update(double sampleTime) {
+  TraceScope updateScope{traceRecorder, TRACE_UPDATE};
   bool result = true;
 
   // update failures handler
-  failuresConsumer.update();
+  {
+    TraceScope scope{traceRecorder, TRACE_FAILURES};
+    failuresConsumer.update();
+  }
 
   // get data & inputs
-  result &= readDataAndLocalVariables(sampleTime);
+  {
+    TraceScope scope{traceRecorder, TRACE_READ_DATA};
+    result &= readDataAndLocalVariables(sampleTime);
+  }
+
+  // write the trace of the last seconds when requested - also in pause or slew
+  traceRecorder.dumpOnTrigger(idTraceDump->get());
 
-  // update performance monitoring
-  result &= updatePerformanceMonitoring(sampleTime);
+  // save or restore the state of the computers when requested - also in pause or slew
+  handleComputersSnapshotRequests();
 
-  // handle simulation rate reduction
-  result &= handleSimulationRate(sampleTime);
+  // update performance monitoring and handle simulation rate reduction
+  {
+    TraceScope scope{traceRecorder, TRACE_PERFORMANCE_MONITORING};
+    result &= updatePerformanceMonitoring(sampleTime);
+    result &= handleSimulationRate(sampleTime);
+  }
 
   // update radio receivers
-  result &= updateRadioReceiver(sampleTime);
+  {
+    TraceScope scope{traceRecorder, TRACE_RADIO_RECEIVER};
+    result &= updateRadioReceiver(sampleTime);
+  }
 
   // handle initialization
-  result &= handleFcuInitialization(calculatedSampleTime);
+  {
+    TraceScope scope{traceRecorder, TRACE_FCU_INITIALIZATION};
+    result &= handleFcuInitialization(calculatedSampleTime);
+  }
 
   // do not process laws in pause or slew
   if (simConnectInterface.getSimData().slew_on) {
     wasInSlew = true;
+    TraceScope scope{traceRecorder, TRACE_WRITE_LOCAL_VARIABLES};
+    LocalVariable::writeAll();
     return result;
   } else if (pauseDetected || simConnectInterface.getSimData().cameraState >= 10.0) {
+    TraceScope scope{traceRecorder, TRACE_WRITE_LOCAL_VARIABLES};
+    LocalVariable::writeAll();
     return result;
   }
 
   // update altimeter setting
-  result &= updateAltimeterSetting(calculatedSampleTime);
+  {
+    TraceScope scope{traceRecorder, TRACE_ALTIMETER_SETTING};
+    result &= updateAltimeterSetting(calculatedSampleTime);
+  }
 
   // update autopilot state machine
-  result &= updateAutopilotStateMachine(calculatedSampleTime);
+  {
+    TraceScope scope{traceRecorder, TRACE_AUTOPILOT_STATE_MACHINE};
+    result &= updateAutopilotStateMachine(calculatedSampleTime);
+  }
 
   // update autopilot laws
-  result &= updateAutopilotLaws(calculatedSampleTime);
+  {
+    TraceScope scope{traceRecorder, TRACE_AUTOPILOT_LAWS};
+    result &= updateAutopilotLaws(calculatedSampleTime);
+  }
 
   // update fly-by-wire
-  result &= updateFlyByWire(calculatedSampleTime);
+  {
+    TraceScope scope{traceRecorder, TRACE_FLY_BY_WIRE};
+    result &= updateFlyByWire(calculatedSampleTime);
+  }
 
   // get throttle data and process it
-  result &= updateAutothrust(calculatedSampleTime);
-
-  for (int i = 0; i < 3; i++) {
-    result &= updateRa(i);
+  {
+    TraceScope scope{traceRecorder, TRACE_AUTOTHRUST};
+    result &= updateAutothrust(calculatedSampleTime);
   }
 
-  for (int i = 0; i < 2; i++) {
-    result &= updateLgciu(i);
-  }
+  {
+    TraceScope scope{traceRecorder, TRACE_SENSORS};
+    for (int i = 0; i < 3; i++) {
+      result &= updateRa(i);
+    }
 
-  for (int i = 0; i < 2; i++) {
-    result &= updateSfcc(i);
-  }
+    for (int i = 0; i < 2; i++) {
+      result &= updateLgciu(i);
+    }
 
-  for (int i = 0; i < 3; i++) {
-    result &= updateAdirs(i);
-  }
+    for (int i = 0; i < 2; i++) {
+      result &= updateSfcc(i);
+    }
 
-  for (int i = 0; i < 3; i++) {
-    result &= updatePrim(calculatedSampleTime, i);
+    for (int i = 0; i < 3; i++) {
+      result &= updateAdirs(i);
+    }
   }
 
-  for (int i = 0; i < 3; i++) {
-    result &= updateSec(calculatedSampleTime, i);
+  {
+    TraceScope scope{traceRecorder, TRACE_PRIM};
+    for (int i = 0; i < 3; i++) {
+      result &= updatePrim(calculatedSampleTime, i);
+    }
   }
 
-  for (int i = 0; i < 2; i++) {
-    result &= updateFac(calculatedSampleTime, i);
+  {
+    TraceScope scope{traceRecorder, TRACE_SEC};
+    for (int i = 0; i < 3; i++) {
+      result &= updateSec(calculatedSampleTime, i);
+    }
   }
 
-  // for (int i = 0; i < 2; i++) {
-  //   result &= updateFcdc(calculatedSampleTime, i);
-  // }
+  {
+    TraceScope scope{traceRecorder, TRACE_FAC};
+    for (int i = 0; i < 2; i++) {
+      result &= updateFac(calculatedSampleTime, i);
+    }
 
-  result &= updateServoSolenoidStatus();
+    // for (int i = 0; i < 2; i++) {
+    //   result &= updateFcdc(calculatedSampleTime, i);
+    // }
 
-  // update additional recording data
-  result &= updateAdditionalData(calculatedSampleTime);
+    result &= updateServoSolenoidStatus();
+  }
 
-  // update engine data
-  result &= updateEngineData(calculatedSampleTime);
+  {
+    TraceScope scope{traceRecorder, TRACE_ADDITIONAL_DATA};
 
-  // update spoilers
-  result &= updateSpoilers(calculatedSampleTime);
+    // update additional recording data
+    result &= updateAdditionalData(calculatedSampleTime);
 
-  // update FO side with FO Sync ON
-  result &= updateFoSide(calculatedSampleTime);
+    // update engine data
+    result &= updateEngineData(calculatedSampleTime);
+
+    // update spoilers
+    result &= updateSpoilers(calculatedSampleTime);
+
+    // update FO side with FO Sync ON
+    result &= updateFoSide(calculatedSampleTime);
+  }
 
   // update flight data recorder
-  flightDataRecorder.update(&autopilotStateMachine, &autopilotLaws, &autoThrust, engineData, additionalData);
+  {
+    TraceScope scope{traceRecorder, TRACE_FLIGHT_DATA_RECORDER};
+    flightDataRecorder.update(&autopilotStateMachine, autopilotStateMachineInput.in, &autopilotLaws, autopilotLawsInput.in, &autoThrust,
+                              autoThrustInput.in, engineData, additionalData);
+  }
+  idFdrFrameBudget->set(flightDataRecorder.getFrameBudgetMicroseconds());
+  idFdrProcessingTime->set(flightDataRecorder.getLastProcessingTimeMicroseconds());
+  idFdrPendingFrames->set(static_cast<double>(flightDataRecorder.getPendingFrameCount()));
+  idFdrRingOverflowCount->set(static_cast<double>(flightDataRecorder.getRingOverflowCount()));
 
   // if default AP is on -> disconnect it
   if (simConnectInterface.getSimData().autopilot_master_on) {
@@ -165,6 +242,12 @@ bool FlyByWireInterface::update(double sampleTime) {
   // reset was in slew flag
   wasInSlew = false;
 
+  // write all changed local variables
+  {
+    TraceScope scope{traceRecorder, TRACE_WRITE_LOCAL_VARIABLES};
+    LocalVariable::writeAll();
+  }
+
   // return result
   return result;
 }
@@ -305,6 +388,25 @@ void FlyByWireInterface::setupLocalVariables() {
   // register L variable for FDR event
   idFdrEvent = std::make_unique<LocalVariable>("A32NX_DFDR_EVENT_ON");
 
+  // register L variables for FDR monitoring
+  idFdrFrameBudget = std::make_unique<LocalVariable>("A32NX_FDR_FRAME_BUDGET_US");
+  idFdrProcessingTime = std::make_unique<LocalVariable>("A32NX_FDR_PROCESSING_TIME_US");
+  idFdrPendingFrames = std::make_unique<LocalVariable>("A32NX_FDR_PENDING_FRAMES");
+  idFdrRingOverflowCount = std::make_unique<LocalVariable>("A32NX_FDR_RING_OVERFLOW_COUNT");
+
+  // register L variable to request a trace file - incremented by the user or tools
+  idTraceDump = std::make_unique<LocalVariable>("A32NX_TRACE_DUMP");
+
+  // register L variables to save and restore the state of the computers - incremented by tools
+  idComputersSnapshotSave = std::make_unique<LocalVariable>("A32NX_FBW_SNAPSHOT_SAVE");
+  idComputersSnapshotRestore = std::make_unique<LocalVariable>("A32NX_FBW_SNAPSHOT_RESTORE");
+
+  // register L variables for monitoring the batched local variable reads and writes
+  idLocalVariableReadCount = std::make_unique<LocalVariable>("A32NX_LVAR_READ_COUNT");
+  idLocalVariableReadTime = std::make_unique<LocalVariable>("A32NX_LVAR_READ_TIME_US");
+  idLocalVariableWriteCount = std::make_unique<LocalVariable>("A32NX_LVAR_WRITE_COUNT");
+  idLocalVariableWriteTime = std::make_unique<LocalVariable>("A32NX_LVAR_WRITE_TIME_US");
+
   // register L variables for the sidestick
   idSideStickPositionX = std::make_unique<LocalVariable>("A32NX_SIDESTICK_POSITION_X");
   idSideStickPositionY = std::make_unique<LocalVariable>("A32NX_SIDESTICK_POSITION_Y");
@@ -826,6 +928,91 @@ bool FlyByWireInterface::handleFcuInitialization(double sampleTime) {
   return true;
 }
 
+void FlyByWireInterface::handleComputersSnapshotRequests() {
+  const double saveTrigger = idComputersSnapshotSave->get();
+  if (saveTrigger != lastComputersSnapshotSaveTrigger) {
+    lastComputersSnapshotSaveTrigger = saveTrigger;
+    saveComputersSnapshot();
+  }
+
+  const double restoreTrigger = idComputersSnapshotRestore->get();
+  if (restoreTrigger != lastComputersSnapshotRestoreTrigger) {
+    lastComputersSnapshotRestoreTrigger = restoreTrigger;
+    if (!restoreComputersSnapshot()) {
+      std::cout << "WASM: no snapshot of the computers to restore" << std::endl;
+    }
+  }
+}
+
+void FlyByWireInterface::saveComputersSnapshot() {
+  if (!computersSnapshot) {
+    computersSnapshot = std::make_unique<ComputersSnapshot>();
+  }
+  ComputersSnapshot& snapshot = *computersSnapshot;
+
+  for (int i = 0; i < 3; i++) {
+    snapshot.prims[i].save(prims[i]);
+    snapshot.secs[i].save(secs[i]);
+  }
+  for (int i = 0; i < 2; i++) {
+    snapshot.facs[i].save(facs[i]);
+  }
+  snapshot.primsDiscreteOutputs.save(primsDiscreteOutputs);
+  snapshot.primsAnalogOutputs.save(primsAnalogOutputs);
+  snapshot.primsBusOutputs.save(primsBusOutputs);
+  snapshot.secsDiscreteOutputs.save(secsDiscreteOutputs);
+  snapshot.secsAnalogOutputs.save(secsAnalogOutputs);
+  snapshot.secsBusOutputs.save(secsBusOutputs);
+  snapshot.facsDiscreteOutputs.save(facsDiscreteOutputs);
+  snapshot.facsAnalogOutputs.save(facsAnalogOutputs);
+  snapshot.facsBusOutputs.save(facsBusOutputs);
+
+  snapshot.autopilotStateMachine.save(autopilotStateMachine);
+  snapshot.autopilotStateMachineInput.save(autopilotStateMachineInput);
+  snapshot.autopilotStateMachineOutput.save(autopilotStateMachineOutput);
+  snapshot.autopilotLaws.save(autopilotLaws);
+  snapshot.autopilotLawsInput.save(autopilotLawsInput);
+  snapshot.autopilotLawsOutput.save(autopilotLawsOutput);
+  snapshot.autoThrust.save(autoThrust);
+  snapshot.autoThrustInput.save(autoThrustInput);
+  snapshot.autoThrustOutput.save(autoThrustOutput);
+}
+
+bool FlyByWireInterface::restoreComputersSnapshot() {
+  if (!computersSnapshot) {
+    return false;
+  }
+  const ComputersSnapshot& snapshot = *computersSnapshot;
+
+  for (int i = 0; i < 3; i++) {
+    snapshot.prims[i].restore(prims[i]);
+    snapshot.secs[i].restore(secs[i]);
+  }
+  for (int i = 0; i < 2; i++) {
+    snapshot.facs[i].restore(facs[i]);
+  }
+  snapshot.primsDiscreteOutputs.restore(primsDiscreteOutputs);
+  snapshot.primsAnalogOutputs.restore(primsAnalogOutputs);
+  snapshot.primsBusOutputs.restore(primsBusOutputs);
+  snapshot.secsDiscreteOutputs.restore(secsDiscreteOutputs);
+  snapshot.secsAnalogOutputs.restore(secsAnalogOutputs);
+  snapshot.secsBusOutputs.restore(secsBusOutputs);
+  snapshot.facsDiscreteOutputs.restore(facsDiscreteOutputs);
+  snapshot.facsAnalogOutputs.restore(facsAnalogOutputs);
+  snapshot.facsBusOutputs.restore(facsBusOutputs);
+
+  snapshot.autopilotStateMachine.restore(autopilotStateMachine);
+  snapshot.autopilotStateMachineInput.restore(autopilotStateMachineInput);
+  snapshot.autopilotStateMachineOutput.restore(autopilotStateMachineOutput);
+  snapshot.autopilotLaws.restore(autopilotLaws);
+  snapshot.autopilotLawsInput.restore(autopilotLawsInput);
+  snapshot.autopilotLawsOutput.restore(autopilotLawsOutput);
+  snapshot.autoThrust.restore(autoThrust);
+  snapshot.autoThrustInput.restore(autoThrustInput);
+  snapshot.autoThrustOutput.restore(autoThrustOutput);
+  return true;
+}
+
 bool FlyByWireInterface::readDataAndLocalVariables(double sampleTime) {
   // set sample time
   simConnectInterface.setSampleTime(sampleTime);
@@ -858,6 +1045,10 @@ bool FlyByWireInterface::readDataAndLocalVariables(double sampleTime) {
 
   // update all local variables
   LocalVariable::readAll();
+  idLocalVariableReadCount->set(static_cast<double>(LocalVariable::getReadAllStatistics().count));
+  idLocalVariableReadTime->set(LocalVariable::getReadAllStatistics().timeMicroseconds);
+  idLocalVariableWriteCount->set(static_cast<double>(LocalVariable::getWriteAllStatistics().count));
+  idLocalVariableWriteTime->set(LocalVariable::getWriteAllStatistics().timeMicroseconds);
 
   // FM thrust reduction/acceleration ARINC words
   fmThrustReductionAltitude->setFromSimVar(idFmgcThrustReductionAltitude->get());
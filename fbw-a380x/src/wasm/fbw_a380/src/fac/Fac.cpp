@@ -14,7 +14,7 @@ Fac::Fac(const Fac& obj) : isUnit1(obj.isUnit1) {
 void Fac::clearMemory() {}
 
 // Main update cycle. Surface position through parameters here is temporary.
-void Fac::update(double deltaTime, double simulationTime, bool faultActive, bool isPowered) {
+void Fac::update(double deltaTime, [[maybe_unused]] double simulationTime, bool faultActive, bool isPowered) {
   monitorPowerSupply(deltaTime, isPowered);
 
   updateSelfTest(deltaTime);
@@ -4,6 +4,7 @@
 #include "../model/FacComputer.h"
 #include "../utils/PulseNode.h"
 #include "../utils/SRFlipFlop.h"
+#include "ModelSnapshot.h"
 
 class Fac {
  public:
@@ -62,3 +63,7 @@ class Fac {
   const double shortPowerFailureTime = 0.01;
   const double selfTestDuration = 10;
 };
+
+// the generated model and the monitoring members are plain state without pointers
+template <>
+inline constexpr bool isModelSnapshotOptIn<Fac> = true;
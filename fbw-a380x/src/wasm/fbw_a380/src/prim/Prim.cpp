@@ -31,7 +31,7 @@ void Prim::initSelfTests(bool viaPushButton) {
 }
 
 // Main update cycle. Surface position through parameters here is temporary.
-void Prim::update(double deltaTime, double simulationTime, bool faultActive, bool isPowered) {
+void Prim::update(double deltaTime, [[maybe_unused]] double simulationTime, bool faultActive, bool isPowered) {
   monitorPowerSupply(deltaTime, isPowered);
   monitorButtonStatus();
 
@@ -5,6 +5,7 @@
 #include "../utils/HysteresisNode.h"
 #include "../utils/PulseNode.h"
 #include "../utils/SRFlipFlop.h"
+#include "ModelSnapshot.h"
 
 class Prim {
  public:
@@ -63,3 +64,7 @@ class Prim {
   const double shortSelfTestDuration = 1;
   const double longSelfTestDuration = 3;
 };
+
+// the generated model and the monitoring members are plain state without pointers
+template <>
+inline constexpr bool isModelSnapshotOptIn<Prim> = true;
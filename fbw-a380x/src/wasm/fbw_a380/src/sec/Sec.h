@@ -4,6 +4,7 @@
 #include "../utils/ConfirmNode.h"
 #include "../utils/PulseNode.h"
 #include "../utils/SRFlipFlop.h"
+#include "ModelSnapshot.h"
 
 class Sec {
  public:
@@ -63,3 +64,7 @@ class Sec {
   const double minimumPowerOutageTimeForFailure = 0.02;
   const double selfTestDuration = 4;
 };
+
+// the generated model and the monitoring members are plain state without pointers
+template <>
+inline constexpr bool isModelSnapshotOptIn<Sec> = true;
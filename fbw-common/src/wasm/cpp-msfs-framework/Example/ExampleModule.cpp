@@ -198,6 +198,8 @@ bool ExampleModule::initialize() {
   // StreamingClientDataAreaVariable receiving test
   streamReveicerDataPtr = dataManager->make_streamingclientdataarea_var<char>("STREAM RECEIVER DATA");
   streamReveicerDataPtr->setSkipChangeCheck(true);
+  // the callback is called after all data of the tick has been received - keep the last complete transfer readable
+  streamReveicerDataPtr->setDoubleBuffered(true);
   streamReveicerDataPtr->addCallback([&]() {
     streamReceiverTimerEnd =
         std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - streamReceiverTimerStart);
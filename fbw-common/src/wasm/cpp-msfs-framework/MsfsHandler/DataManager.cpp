@@ -1,6 +1,8 @@
 // Copyright (c) 2023 FlyByWire Simulations
 // SPDX-License-Identifier: GPL-3.0
 
+#include <chrono>
+
 #include "DataManager.h"
 #include "MsfsHandler.h"
 #include "SimconnectExceptionStrings.h"
@@ -12,7 +14,7 @@ bool DataManager::initialize(HANDLE simConnectHandle) {
   return true;
 }
 
-bool DataManager::preUpdate([[maybe_unused]] sGaugeDrawData* pData) const {
+bool DataManager::preUpdate([[maybe_unused]] sGaugeDrawData* pData) {
   LOG_TRACE("DataManager::preUpdate()");
 
   if (!isInitialized) {
@@ -23,26 +25,48 @@ bool DataManager::preUpdate([[maybe_unused]] sGaugeDrawData* pData) const {
   // get current time stamp and tick counter
   const FLOAT64 timeStamp = msfsHandlerPtr->getTimeStamp();
   const UINT64 tickCounter = msfsHandlerPtr->getTickCounter();
-
-  // get all variables set to automatically read
-  for (const auto& var : variables) {
-    if (var.second->isAutoRead()) {
-      var.second->updateFromSim(timeStamp, tickCounter);
+  ManagedDataObjectBase::setCurrentTick(timeStamp, tickCounter);
+
+  // rebuild the update lists if variables have been added or update modes have changed
+  refreshUpdateLists();
+
+  // collect the variables which are due for a read in this tick - variables which are not due
+  // are served from their cache which only resets their changed flag and lazy variables are
+  // read when they are first requested
+  dueReads.clear();
+  for (CacheableVariable* var : autoReadVariables) {
+    if (var->isLazy()) {
+      continue;
+    }
+    if (var->isUpdateFromSimDue(timeStamp, tickCounter)) {
+      dueReads.push_back(var);
+    } else {
+      var->updateFromSim(timeStamp, tickCounter);
     }
   }
 
+  // read all due variables from the sim in one pass
+  const auto readStart = std::chrono::steady_clock::now();
+  for (CacheableVariable* var : dueReads) {
+    var->updateFromSim(timeStamp, tickCounter);
+  }
+  lastReadCount = dueReads.size();
+  lastReadTimeMicroseconds = std::chrono::duration<FLOAT64, std::micro>(std::chrono::steady_clock::now() - readStart).count();
+
   // request all data definitions set to automatically read
-  for (const auto& simObject : simObjects) {
-    if (simObject.second->isAutoRead()) {
-      if (!simObject.second->requestUpdateFromSim(timeStamp, tickCounter)) {
-        LOG_ERROR("DataManager::preUpdate(): requestUpdateFromSim() failed for " + simObject.second->getName());
-      }
+  for (SimObjectBase* simObject : autoReadSimObjects) {
+    if (!simObject->requestUpdateFromSim(timeStamp, tickCounter)) {
+      LOG_ERROR("DataManager::preUpdate(): requestUpdateFromSim() failed for " + simObject->getName());
     }
   }
 
   // get requested sim object data
   getRequestedData();
 
+  // notify the listeners of all data objects which have changed since the last tick - once per
+  // data object no matter how often it changed
+  ManagedDataObjectBase::deliverChangeNotifications(changeNotificationQueue);
+
   LOG_TRACE("DataManager::preUpdate() - done");
   return true;
 }
@@ -56,7 +80,7 @@ bool DataManager::update([[maybe_unused]] sGaugeDrawData* pData) const {
   return true;
 }
 
-bool DataManager::postUpdate([[maybe_unused]] sGaugeDrawData* pData) const {
+bool DataManager::postUpdate([[maybe_unused]] sGaugeDrawData* pData) {
   LOG_TRACE("DataManager::postUpdate()");
 
   if (!isInitialized) {
@@ -64,32 +88,63 @@ bool DataManager::postUpdate([[maybe_unused]] sGaugeDrawData* pData) const {
     return false;
   }
 
-  // write all variables set to automatically write
-  for (const auto& var : variables) {
-    if (var.second->isAutoWrite()) {
-      var.second->updateToSim();
+  // modules may have changed update modes during their update
+  refreshUpdateLists();
+
+  // collect the variables set to automatically write which have been changed
+  dueWrites.clear();
+  for (CacheableVariable* var : autoWriteVariables) {
+    if (var->isDirty()) {
+      dueWrites.push_back(var);
     }
   }
 
+  // write all changed variables to the sim in one pass
+  const auto writeStart = std::chrono::steady_clock::now();
+  for (CacheableVariable* var : dueWrites) {
+    var->updateToSim();
+  }
+  lastWriteCount = dueWrites.size();
+  lastWriteTimeMicroseconds = std::chrono::duration<FLOAT64, std::micro>(std::chrono::steady_clock::now() - writeStart).count();
+
   // write all data definitions set to automatically write
-  for (const auto& ddv : simObjects) {
-    if (ddv.second->isAutoWrite()) {
-      if (!ddv.second->writeDataToSim()) {
-        LOG_ERROR("DataManager::postUpdate(): updateDataToSim() failed for " + ddv.second->getName());
-      }
+  for (SimObjectBase* simObject : autoWriteSimObjects) {
+    if (!simObject->writeDataToSim()) {
+      LOG_ERROR("DataManager::postUpdate(): updateDataToSim() failed for " + simObject->getName());
     }
   }
 
+  // report and demote auto read variables which have not been consumed
+  checkVariableConsumption();
+
   LOG_TRACE("DataManager::postUpdate() - done");
   return true;
 }
 
 bool DataManager::shutdown() {
   isInitialized = false;
+  autoReadVariables.clear();
+  autoWriteVariables.clear();
+  manualVariables.clear();
+  autoReadSimObjects.clear();
+  autoWriteSimObjects.clear();
+  dueReads.clear();
+  dueWrites.clear();
+  unconsumedVariables.clear();
+  consumptionCheckBuffer.clear();
+  ManagedDataObjectBase::discardChangeNotifications(changeNotificationQueue);
+  detachChangeNotificationQueue();
+  variableIndices.clear();
   variables.clear();
+  simObjectsByRequestId.clear();
   simObjects.clear();
   clientEvents.clear();
-  LOG_INFO("DataManager::shutdown()");
+  keyEventCallbacks.clear();
+  // the arena releases its blocks once the modules released their pointers as well
+  LOG_INFO("DataManager::shutdown() - registry arena: " + std::to_string(registryArena.getAllocationCount()) + " allocations (" +
+           std::to_string(registryArena.getLiveAllocationCount()) + " still alive), " +
+           std::to_string(registryArena.getAllocatedBytes()) + " of " + std::to_string(registryArena.getReservedBytes()) + " bytes in " +
+           std::to_string(registryArena.getBlockCount()) + " blocks");
   return true;
 }
 
@@ -101,6 +156,12 @@ void DataManager::getRequestedData() const {
   }
 }
 
+void DataManager::setConsumptionTracking(UINT64 windowTicks, bool demoteUnconsumed) {
+  consumptionWindowTicks = windowTicks;
+  isDemotingUnconsumedVariables = demoteUnconsumed;
+  nextConsumptionCheckTick = msfsHandlerPtr->getTickCounter() + windowTicks;
+}
+
 // =================================================================================================
 // Generators / make_ functions
 // =================================================================================================
@@ -120,27 +181,29 @@ NamedVariablePtr DataManager::make_named_var(const std::string& varName,
   // Check which update method and frequency to use - if two variables are the same
   // then use the update method and frequency of the automated one with faster
   // update frequency
-  const auto pair = variables.find(uniqueName);
-  if (pair != variables.end()) {
-    if (!pair->second->isAutoRead() && (updateMode & UpdateMode::AUTO_READ)) {
-      pair->second->setAutoRead(true);
+  const auto pair = variableIndices.find(uniqueName);
+  if (pair != variableIndices.end()) {
+    const CacheableVariablePtr& existing = variables[pair->second];
+    if (!existing->isAutoRead() && (updateMode & UpdateMode::AUTO_READ)) {
+      existing->setAutoRead(true);
     }
-    if (pair->second->getMaxAgeTime() > maxAgeTime) {
-      pair->second->setMaxAgeTime(maxAgeTime);
+    if (existing->getMaxAgeTime() > maxAgeTime) {
+      existing->setMaxAgeTime(maxAgeTime);
     }
-    if (pair->second->getMaxAgeTicks() > maxAgeTicks) {
-      pair->second->setMaxAgeTicks(maxAgeTicks);
+    if (existing->getMaxAgeTicks() > maxAgeTicks) {
+      existing->setMaxAgeTicks(maxAgeTicks);
     }
-    if (!pair->second->isAutoWrite() & (updateMode & UpdateMode::AUTO_WRITE)) {
-      pair->second->setAutoWrite(true);
+    if (!existing->isAutoWrite() && (updateMode & UpdateMode::AUTO_WRITE)) {
+      existing->setAutoWrite(true);
     }
-    LOG_DEBUG("DataManager::make_named_var(): already exists: " + pair->second->str());
-    return std::dynamic_pointer_cast<NamedVariable>(pair->second);
+    LOG_DEBUG("DataManager::make_named_var(): already exists: " + existing->str());
+    return std::dynamic_pointer_cast<NamedVariable>(existing);
   }
 
-  // Create new var and store it in the map
-  NamedVariablePtr var = NamedVariablePtr(new NamedVariable(varName, unit, updateMode, maxAgeTime, maxAgeTicks));
-  variables[uniqueName] = var;
+  // Create new var and store it in the registry
+  NamedVariablePtr var = makeSharedInArena<NamedVariable>(
+      registryArena, [&](void* memory) { return new (memory) NamedVariable(varName, unit, updateMode, maxAgeTime, maxAgeTicks); });
+  registerVariable(uniqueName, var);
 
   LOG_DEBUG("DataManager::make_named_var(): created variable " + var->str());
   return var;
@@ -163,31 +226,32 @@ AircraftVariablePtr DataManager::make_aircraft_var(const std::string& varName,
   // Check if variable already exists
   // Check which update method and frequency to use - if two variables are the same
   // use the update method and frequency of the automated one with faster update frequency
-  const auto pair = variables.find(uniqueName);
-  if (pair != variables.end()) {
-    if (!pair->second->isAutoRead() && (updateMode & UpdateMode::AUTO_READ)) {
-      pair->second->setAutoRead(true);
+  const auto pair = variableIndices.find(uniqueName);
+  if (pair != variableIndices.end()) {
+    const CacheableVariablePtr& existing = variables[pair->second];
+    if (!existing->isAutoRead() && (updateMode & UpdateMode::AUTO_READ)) {
+      existing->setAutoRead(true);
     }
-    if (pair->second->getMaxAgeTime() > maxAgeTime) {
-      pair->second->setMaxAgeTime(maxAgeTime);
+    if (existing->getMaxAgeTime() > maxAgeTime) {
+      existing->setMaxAgeTime(maxAgeTime);
     }
-    if (pair->second->getMaxAgeTicks() > maxAgeTicks) {
-      pair->second->setMaxAgeTicks(maxAgeTicks);
+    if (existing->getMaxAgeTicks() > maxAgeTicks) {
+      existing->setMaxAgeTicks(maxAgeTicks);
     }
-    if (!pair->second->isAutoWrite() & (updateMode & UpdateMode::AUTO_WRITE)) {
-      pair->second->setAutoWrite(true);
+    if (!existing->isAutoWrite() && (updateMode & UpdateMode::AUTO_WRITE)) {
+      existing->setAutoWrite(true);
     }
-    LOG_DEBUG("DataManager::make_aircraft_var(): already exists: " + pair->second->str());
-    return std::dynamic_pointer_cast<AircraftVariable>(pair->second);
+    LOG_DEBUG("DataManager::make_aircraft_var(): already exists: " + existing->str());
+    return std::dynamic_pointer_cast<AircraftVariable>(existing);
   }
 
-  // Create new var and store it in the map
-  AircraftVariablePtr var =
-      setterEventName.empty()
-          ? AircraftVariablePtr(new AircraftVariable(varName, index, setterEvent, unit, updateMode, maxAgeTime, maxAgeTicks))
-          : AircraftVariablePtr(
-                new AircraftVariable(varName, index, std::move(setterEventName), unit, updateMode, maxAgeTime, maxAgeTicks));
-  variables[uniqueName] = var;
+  // Create new var and store it in the registry
+  AircraftVariablePtr var = makeSharedInArena<AircraftVariable>(registryArena, [&](void* memory) {
+    return setterEventName.empty()
+               ? new (memory) AircraftVariable(varName, index, setterEvent, unit, updateMode, maxAgeTime, maxAgeTicks)
+               : new (memory) AircraftVariable(varName, index, std::move(setterEventName), unit, updateMode, maxAgeTime, maxAgeTicks);
+  });
+  registerVariable(uniqueName, var);
 
   LOG_DEBUG("DataManager::make_aircraft_var(): created variable " + var->str());
   return var;
@@ -198,15 +262,20 @@ ClientEventPtr DataManager::make_client_event(const std::string& clientEventName
                                               SIMCONNECT_NOTIFICATION_GROUP_ID notificationGroupId) {
   // find existing event instance for this event
   for (const auto& event : clientEvents) {
-    if (event.second->getClientEventName() == clientEventName) {
-      LOG_DEBUG("DataManager::make_event(): already exists: " + event.second->str());
-      return event.second;
+    if (event != nullptr && event->getClientEventName() == clientEventName) {
+      LOG_DEBUG("DataManager::make_event(): already exists: " + event->str());
+      return event;
     }
   }
 
   // create a new event instance
-  ClientEventPtr clientEvent = ClientEventPtr(new ClientEvent(hSimConnect, clientEventIDGen.getNextId(), clientEventName));
-  clientEvents[clientEvent->getClientEventId()] = clientEvent;
+  ClientEventPtr clientEvent = makeSharedInArena<ClientEvent>(
+      registryArena, [&](void* memory) { return new (memory) ClientEvent(hSimConnect, clientEventIDGen.getNextId(), clientEventName); });
+  const SIMCONNECT_CLIENT_EVENT_ID eventId = clientEvent->getClientEventId();
+  if (eventId >= clientEvents.size()) {
+    clientEvents.resize(eventId + 1);
+  }
+  clientEvents[eventId] = clientEvent;
   if (registerToSim) {
     clientEvent->mapToSimEvent();
   }
@@ -222,33 +291,36 @@ ClientEventPtr DataManager::make_client_event(const std::string& clientEventName
 // =================================================================================================
 
 KeyEventCallbackID DataManager::addKeyEventCallback(KeyEventID keyEventId, const KeyEventCallbackFunction& callback) {
-  auto id = keyEventCallbackIDGen.getNextId();
-  if (!keyEventCallbacks.contains(keyEventId)) {
-    keyEventCallbacks.insert({keyEventId, {{id, callback}}});
-  } else {
-    keyEventCallbacks[keyEventId].insert({id, callback});
+  // grow the table to include the key event id
+  if (keyEventCallbacks.empty()) {
+    keyEventCallbacksBaseId = keyEventId;
   }
+  while (keyEventId < keyEventCallbacksBaseId) {
+    keyEventCallbacks.emplace_front();
+    keyEventCallbacksBaseId--;
+  }
+  while (keyEventId - keyEventCallbacksBaseId >= keyEventCallbacks.size()) {
+    keyEventCallbacks.emplace_back();
+  }
+
+  KeyEventCallbackList& callbacks = keyEventCallbacks[keyEventId - keyEventCallbacksBaseId];
+  const auto id = keyEventCallbackIDGen.getNextId();
+  callbacks.add(id, callback);
   LOG_DEBUG("Added callback to key event " + std::to_string(keyEventId) + " with ID " + std::to_string(id) + " and " +
-            std::to_string(keyEventCallbacks[keyEventId].size()) + " callbacks");
+            std::to_string(callbacks.getSize()) + " callbacks");
   return id;
 }
 
-// FIXME: Double check if this is correct
 bool DataManager::removeKeyEventCallback(KeyEventID keyEventId, KeyEventCallbackID callbackId) {
-  const auto eventPair = keyEventCallbacks.find(keyEventId);
-  if (eventPair != keyEventCallbacks.end()) {
-    const auto callbackPair = eventPair->second.find(callbackId);
-    if (callbackPair != eventPair->second.end()) {
-      eventPair->second.erase(callbackPair);
+  if (keyEventId >= keyEventCallbacksBaseId && keyEventId - keyEventCallbacksBaseId < keyEventCallbacks.size()) {
+    KeyEventCallbackList& callbacks = keyEventCallbacks[keyEventId - keyEventCallbacksBaseId];
+    if (callbacks.remove(callbackId)) {
       LOG_DEBUG("Removed callback from key event " + std::to_string(keyEventId) + " with ID " + std::to_string(callbackId) + " and " +
-                std::to_string(eventPair->second.size()) + " callbacks left");
-      if (eventPair->second.empty()) {
-        keyEventCallbacks.erase(eventPair);
-      }
+                std::to_string(callbacks.getSize()) + " callbacks left");
       return true;
     }
   }
-  LOG_WARN("Failed to remove callback from key event" + std::to_string(keyEventId) + "with ID " + std::to_string(callbackId));
+  LOG_WARN("Failed to remove callback from key event " + std::to_string(keyEventId) + " with ID " + std::to_string(callbackId));
   return false;
 }
 
@@ -266,11 +338,10 @@ bool DataManager::sendKeyEvent(KeyEventID keyEventId, DWORD param0, DWORD param1
 }
 
 void DataManager::processKeyEvent(KeyEventID keyEventId, UINT32 evdata0, UINT32 evdata1, UINT32 evdata2, UINT32 evdata3, UINT32 evdata4) {
-  const auto eventPair = keyEventCallbacks.find(keyEventId);
-  if (eventPair != keyEventCallbacks.end()) {
-    for (const auto& callbackPair : eventPair->second) {
-      callbackPair.second(evdata0, evdata1, evdata2, evdata3, evdata4);
-    }
+  // unsigned arithmetic - ids below the base id wrap around and fail the bounds check
+  const std::size_t index = keyEventId - keyEventCallbacksBaseId;
+  if (index < keyEventCallbacks.size()) {
+    keyEventCallbacks[index](evdata0, evdata1, evdata2, evdata3, evdata4);
   }
 }
 
@@ -278,6 +349,114 @@ void DataManager::processKeyEvent(KeyEventID keyEventId, UINT32 evdata0, UINT32
 // Private methods
 // =================================================================================================
 
+void DataManager::registerVariable(const std::string& uniqueName, const CacheableVariablePtr& var) {
+  variableIndices[uniqueName] = variables.size();
+  variables.push_back(var);
+  var->setChangeNotificationQueue(&changeNotificationQueue);
+  isUpdateListsDirty = true;
+}
+
+void DataManager::registerSimObject(const SimObjectBasePtr& simObject) {
+  const SIMCONNECT_DATA_REQUEST_ID requestId = simObject->getRequestId();
+  if (requestId >= simObjectsByRequestId.size()) {
+    simObjectsByRequestId.resize(requestId + 1, nullptr);
+  }
+  simObjectsByRequestId[requestId] = simObject.get();
+  simObjects.push_back(simObject);
+  simObject->setChangeNotificationQueue(&changeNotificationQueue);
+  isUpdateListsDirty = true;
+}
+
+void DataManager::detachChangeNotificationQueue() {
+  for (const auto& var : variables) {
+    var->setChangeNotificationQueue(nullptr);
+  }
+  for (const auto& simObject : simObjects) {
+    simObject->setChangeNotificationQueue(nullptr);
+  }
+}
+
+void DataManager::refreshUpdateLists() {
+  const UINT64 generation = ManagedDataObjectBase::getUpdateModeGeneration();
+  if (!isUpdateListsDirty && updateListsGeneration == generation) {
+    return;
+  }
+
+  autoReadVariables.clear();
+  autoWriteVariables.clear();
+  manualVariables.clear();
+  for (const auto& var : variables) {
+    if (var->isAutoRead()) {
+      autoReadVariables.push_back(var.get());
+    }
+    if (var->isAutoWrite()) {
+      autoWriteVariables.push_back(var.get());
+    }
+    if (!var->isAutoRead() && !var->isAutoWrite()) {
+      manualVariables.push_back(var.get());
+    }
+  }
+
+  autoReadSimObjects.clear();
+  autoWriteSimObjects.clear();
+  for (const auto& simObject : simObjects) {
+    if (simObject->isAutoRead()) {
+      autoReadSimObjects.push_back(simObject.get());
+    }
+    if (simObject->isAutoWrite()) {
+      autoWriteSimObjects.push_back(simObject.get());
+    }
+  }
+
+  // reserve the per tick lists so collecting the due variables never allocates
+  dueReads.reserve(autoReadVariables.size());
+  dueWrites.reserve(autoWriteVariables.size());
+
+  isUpdateListsDirty = false;
+  updateListsGeneration = generation;
+  LOG_DEBUG("DataManager::refreshUpdateLists(): " + std::to_string(autoReadVariables.size()) + " auto read, " +
+            std::to_string(autoWriteVariables.size()) + " auto write and " + std::to_string(manualVariables.size()) +
+            " manual variables, " + std::to_string(autoReadSimObjects.size()) + " auto read and " +
+            std::to_string(autoWriteSimObjects.size()) + " auto write sim objects");
+}
+
+void DataManager::checkVariableConsumption() {
+  const UINT64 tickCounter = msfsHandlerPtr->getTickCounter();
+  if (consumptionWindowTicks == 0 || tickCounter < nextConsumptionCheckTick) {
+    return;
+  }
+  nextConsumptionCheckTick = tickCounter + consumptionWindowTicks;
+
+  // variables with callbacks are consumed by their callbacks
+  std::vector<CacheableVariable*>& unconsumed = consumptionCheckBuffer;
+  unconsumed.clear();
+  for (CacheableVariable* var : autoReadVariables) {
+    if (!var->isLazy() && !var->hasCallbacks() && var->getConsumedTickStamp() + consumptionWindowTicks <= tickCounter) {
+      unconsumed.push_back(var);
+    }
+  }
+
+  // only report if the set of unconsumed variables has changed
+  if (unconsumed != unconsumedVariables) {
+    std::string names{};
+    for (const CacheableVariable* var : unconsumed) {
+      names += (names.empty() ? "" : ", ") + var->getName();
+    }
+    LOG_INFO("DataManager: " + std::to_string(unconsumed.size()) + " auto read variables not consumed in the last " +
+             std::to_string(consumptionWindowTicks) + " ticks: " + names);
+  }
+  unconsumedVariables.swap(unconsumed);
+
+  // demoted variables are still read on demand if they are consumed again later
+  if (isDemotingUnconsumedVariables) {
+    for (CacheableVariable* var : unconsumedVariables) {
+      var->setLazy(true);
+      LOG_INFO("DataManager: demoted variable " + var->getName() + " to lazy read");
+    }
+    unconsumedVariables.clear();
+  }
+}
+
 void DataManager::processDispatchMessage(SIMCONNECT_RECV* pRecv, [[maybe_unused]] DWORD* cbData) const {
   switch (pRecv->dwID) {
     case SIMCONNECT_RECV_ID_SIMOBJECT_DATA:  // fallthrough
@@ -318,27 +497,25 @@ void DataManager::processDispatchMessage(SIMCONNECT_RECV* pRecv, [[maybe_unused]
 
 void DataManager::processSimObjectData(SIMCONNECT_RECV* pData) const {
   const auto pSimobjectData = reinterpret_cast<const SIMCONNECT_RECV_SIMOBJECT_DATA*>(pData);
-  const auto pair = simObjects.find(pSimobjectData->dwRequestID);
-  if (pair != simObjects.end()) {
-    pair->second->processSimData(pData, msfsHandlerPtr->getTimeStamp(), msfsHandlerPtr->getTickCounter());
+  const SIMCONNECT_DATA_REQUEST_ID requestId = pSimobjectData->dwRequestID;
+  if (requestId < simObjectsByRequestId.size() && simObjectsByRequestId[requestId] != nullptr) {
+    simObjectsByRequestId[requestId]->processSimData(pData, msfsHandlerPtr->getTimeStamp(), msfsHandlerPtr->getTickCounter());
     return;
   }
   LOG_ERROR("DataManager::processSimObjectData() - unknown request id: " + std::to_string(pSimobjectData->dwRequestID));
 }
 
 void DataManager::processEvent(const SIMCONNECT_RECV_EVENT* pRecv) const {
-  const auto pair = clientEvents.find(pRecv->uEventID);
-  if (pair != clientEvents.end()) {
-    pair->second->processEvent(pRecv->dwData);
+  if (pRecv->uEventID < clientEvents.size() && clientEvents[pRecv->uEventID] != nullptr) {
+    clientEvents[pRecv->uEventID]->processEvent(pRecv->dwData);
     return;
   }
   LOG_WARN("DataManager::processEvent() - unknown event id: " + std::to_string(pRecv->uEventID));
 }
 
 void DataManager::processEvent(const SIMCONNECT_RECV_EVENT_EX1* pRecv) const {
-  const auto pair = clientEvents.find(pRecv->uEventID);
-  if (pair != clientEvents.end()) {
-    pair->second->processEvent(pRecv->dwData0, pRecv->dwData1, pRecv->dwData2, pRecv->dwData3, pRecv->dwData4);
+  if (pRecv->uEventID < clientEvents.size() && clientEvents[pRecv->uEventID] != nullptr) {
+    clientEvents[pRecv->uEventID]->processEvent(pRecv->dwData0, pRecv->dwData1, pRecv->dwData2, pRecv->dwData3, pRecv->dwData4);
     return;
   }
   LOG_WARN("DataManager::processEvent() - unknown event id: " + std::to_string(pRecv->uEventID));
@@ -5,15 +5,19 @@
 #define FLYBYWIRE_DATAMANAGER_H
 
 #include <cstdint>
-#include <map>
+#include <deque>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include <MSFS/Legacy/gauges.h>
 #include <MSFS/MSFS.h>
 #include <SimConnect.h>
 
+#include "CallbackList.hpp"
 #include "IDGenerator.h"
+#include "MonotonicArena.hpp"
 #include "SimUnits.h"
 #include "logging.h"
 #include "simple_assert.h"
@@ -21,6 +25,7 @@
 #include "AircraftVariable.h"
 #include "ClientDataAreaVariable.hpp"
 #include "DataDefinitionVariable.hpp"
+#include "DeltaClientDataAreaVariable.hpp"
 #include "NamedVariable.h"
 #include "StreamingClientDataAreaVariable.hpp"
 #include "UpdateMode.h"
@@ -38,6 +43,8 @@ template <typename T>
 using DataDefinitionVariablePtr = std::shared_ptr<DataDefinitionVariable<T>>;
 template <typename T>
 using ClientDataAreaVariablePtr = std::shared_ptr<ClientDataAreaVariable<T>>;
+template <typename T>
+using DeltaClientDataAreaVariablePtr = std::shared_ptr<DeltaClientDataAreaVariable<T>>;
 template <typename T, std::size_t ChunkSize>
 using StreamingClientDataAreaVariablePtr = std::shared_ptr<StreamingClientDataAreaVariable<T, ChunkSize>>;
 
@@ -47,12 +54,15 @@ using KeyEventID = ID32;
 // Used for callback registration to allow removal of callbacks
 using KeyEventCallbackID = UINT64;
 
+// Callback list type for key events
+using KeyEventCallbackList = CallbackList<void(DWORD param0, DWORD param1, DWORD param2, DWORD param3, DWORD param4)>;
+
 /**
- * Defines a callback function for a key event
+ * Defines a callback function for a key event - stored without heap allocation, see InplaceFunction
  * @param number of parameters to use
  * @param parameters 0-4 to pass to the callback function
  */
-using KeyEventCallbackFunction = std::function<void(DWORD param0, DWORD param1, DWORD param2, DWORD param3, DWORD param4)>;
+using KeyEventCallbackFunction = KeyEventCallbackList::Function;
 
 /**
  * @brief The DataManager class is responsible for managing all variables and events.
@@ -73,22 +83,84 @@ class DataManager {
   // Handle to the simconnect instance.
   HANDLE hSimConnect{};
 
-  // A map of all registered variables.
-  // Map over the variable name to quickly find the variable.
-  // De-duplication of variables happens via this map. So each aspect of a variable needs to be
-  // part of the unique name - e.g. the index or unit.
-  std::map<std::string, CacheableVariablePtr> variables{};
-
-  // A map of all registered SimObjects.
-  // Map over the request id to quickly find the SimObject.
-  std::map<SIMCONNECT_DATA_REQUEST_ID, SimObjectBasePtr> simObjects{};
+  // Memory of the registered variables, SimObjects and events and their shared pointer control
+  // blocks. Declared before all registries so it is destroyed after them.
+  MonotonicArena registryArena{};
 
-  // A map of all registered events.
-  // Map over the event id to quickly find the event - make creating an event a bit less efficient.
-  std::map<SIMCONNECT_CLIENT_EVENT_ID, ClientEventPtr> clientEvents{};
+  // All registered variables in the order of registration. Owns the variables.
+  std::vector<CacheableVariablePtr> variables{};
 
-  // Map of callback vectors to be called when a key event is triggered in the sim.
-  std::map<KeyEventID, std::map<KeyEventCallbackID, KeyEventCallbackFunction>> keyEventCallbacks{};
+  // Index into the variables vector over the unique variable name. Only used during registration.
+  // De-duplication of variables happens via this map. So each aspect of a variable needs to be
+  // part of the unique name - e.g. the index or unit.
+  std::unordered_map<std::string, std::size_t> variableIndices{};
+
+  // All registered SimObjects in the order of registration. Owns the SimObjects.
+  std::vector<SimObjectBasePtr> simObjects{};
+
+  // SimObjects indexed by their request id. Request ids are generated consecutively by
+  // dataReqIDGen so this is a dense array and a lookup is a single index operation.
+  std::vector<SimObjectBase*> simObjectsByRequestId{};
+
+  // Contiguous lists of the variables and SimObjects which are automatically read or written
+  // and of the variables which are only updated manually. A variable with AUTO_READ_WRITE is in
+  // both auto lists. The lists are rebuilt when an object is registered or when the update mode
+  // of any object changes so the per frame loops only touch objects that need updating.
+  std::vector<CacheableVariable*> autoReadVariables{};
+  std::vector<CacheableVariable*> autoWriteVariables{};
+  std::vector<CacheableVariable*> manualVariables{};
+  std::vector<SimObjectBase*> autoReadSimObjects{};
+  std::vector<SimObjectBase*> autoWriteSimObjects{};
+
+  // The variables which are read or written in the current tick. Collecting them first keeps the
+  // calls to the sim in one tight loop which is measured for the read and write statistics.
+  std::vector<CacheableVariable*> dueReads{};
+  std::vector<CacheableVariable*> dueWrites{};
+
+  // Statistics of the last automatic read and write pass.
+  std::size_t lastReadCount = 0;
+  std::size_t lastWriteCount = 0;
+  FLOAT64 lastReadTimeMicroseconds = 0.0;
+  FLOAT64 lastWriteTimeMicroseconds = 0.0;
+
+  // The number of ticks an auto read variable must not have been consumed to be reported as
+  // unconsumed. 0 disables the consumption tracking.
+  UINT64 consumptionWindowTicks = 600;
+
+  // Flag to indicate that unconsumed auto read variables are demoted to lazy reads.
+  bool isDemotingUnconsumedVariables = false;
+
+  // The tick of the next consumption check.
+  UINT64 nextConsumptionCheckTick = 0;
+
+  // The auto read variables found unconsumed in the last consumption check.
+  std::vector<CacheableVariable*> unconsumedVariables{};
+
+  // Buffer for the consumption check - swapped with unconsumedVariables so the check does not allocate.
+  std::vector<CacheableVariable*> consumptionCheckBuffer{};
+
+  // Flag to indicate that an object has been registered since the update lists were built.
+  bool isUpdateListsDirty = true;
+
+  // The update mode generation the update lists were built for.
+  // @see ManagedDataObjectBase::getUpdateModeGeneration()
+  UINT64 updateListsGeneration = 0;
+
+  // The coalesced change notifications of the registered data objects, delivered in preUpdate().
+  // @see ManagedDataObjectBase::setCoalescedNotification()
+  ChangeNotificationQueue changeNotificationQueue{};
+
+  // All registered events indexed by their event id. Event ids are generated consecutively by
+  // clientEventIDGen so this is a dense array and a lookup is a single index operation.
+  std::vector<ClientEventPtr> clientEvents{};
+
+  // Callbacks to be called when a key event is triggered in the sim indexed by the key event id
+  // minus keyEventCallbacksBaseId. Key event ids are a compact range (see KEY_ events in gauges.h)
+  // so dispatching a key event is a bounds check and an index operation - important for axis
+  // events which arrive many times per frame. A deque is used as it can grow at both ends without
+  // moving the callback lists, which may happen while a callback is running.
+  std::deque<KeyEventCallbackList> keyEventCallbacks{};
+  KeyEventID keyEventCallbacksBaseId = 0;
 
   // Flag to indicate if the data manager is initialized.
   bool isInitialized = false;
@@ -112,7 +184,7 @@ class DataManager {
   DataManager(DataManager&&) = delete;                  // no move constructor
   DataManager& operator=(DataManager&&) = delete;       // no move assignment
 
-  ~DataManager() = default;
+  ~DataManager() { detachChangeNotificationQueue(); }
 
   // ===============================================================================================
   // Sim Loop Methods
@@ -133,7 +205,7 @@ class DataManager {
    * @param pData Pointer to the data structure of gauge pre-draw event
    * @return true if successful, false otherwise
    */
-  bool preUpdate([[maybe_unused]] sGaugeDrawData* pData) const;
+  bool preUpdate([[maybe_unused]] sGaugeDrawData* pData);
 
   /**
    * @brief Called by the MsfsHandler update() method.
@@ -148,7 +220,7 @@ class DataManager {
    * @param pData Pointer to the data structure of gauge pre-draw event
    * @return true if successful, false otherwise
    */
-  bool postUpdate(sGaugeDrawData* pData) const;
+  bool postUpdate(sGaugeDrawData* pData);
 
   /**
    * @brief Called by the MsfsHandler shutdown() method.<br/>
@@ -266,9 +338,11 @@ class DataManager {
                                                                      UpdateMode updateMode = UpdateMode::NO_AUTO_UPDATE,
                                                                      FLOAT64 maxAgeTime = 0.0,
                                                                      UINT64 maxAgeTicks = 0) {
-    DataDefinitionVariablePtr<T> var = DataDefinitionVariablePtr<T>(new DataDefinitionVariable<T>(
-        hSimConnect, name, dataDefinitions, dataDefIDGen.getNextId(), dataReqIDGen.getNextId(), updateMode, maxAgeTime, maxAgeTicks));
-    simObjects.insert({var->getRequestId(), var});
+    DataDefinitionVariablePtr<T> var = makeSharedInArena<DataDefinitionVariable<T>>(registryArena, [&](void* memory) {
+      return new (memory) DataDefinitionVariable<T>(hSimConnect, name, dataDefinitions, dataDefIDGen.getNextId(), dataReqIDGen.getNextId(),
+                                                    updateMode, maxAgeTime, maxAgeTicks);
+    });
+    registerSimObject(var);
     LOG_DEBUG("DataManager::make_datadefinition_var(): " + name);
     return var;
   }
@@ -298,14 +372,52 @@ class DataManager {
                                                                      UpdateMode updateMode = UpdateMode::NO_AUTO_UPDATE,
                                                                      FLOAT64 maxAgeTime = 0.0,
                                                                      UINT64 maxAgeTicks = 0) {
-    ClientDataAreaVariablePtr<T> var = ClientDataAreaVariablePtr<T>(
-        new ClientDataAreaVariable<T>(hSimConnect, clientDataName, clientDataIDGen.getNextId(), dataDefIDGen.getNextId(),
-                                      dataReqIDGen.getNextId(), sizeof(T), updateMode, maxAgeTime, maxAgeTicks));
-    simObjects.insert({var->getRequestId(), var});
+    ClientDataAreaVariablePtr<T> var = makeSharedInArena<ClientDataAreaVariable<T>>(registryArena, [&](void* memory) {
+      return new (memory) ClientDataAreaVariable<T>(hSimConnect, clientDataName, clientDataIDGen.getNextId(), dataDefIDGen.getNextId(),
+                                                    dataReqIDGen.getNextId(), sizeof(T), updateMode, maxAgeTime, maxAgeTicks);
+    });
+    registerSimObject(var);
     LOG_DEBUG("DataManager::make_datadefinition_var(): " + clientDataName);
     return var;
   }
 
+  /**
+   * @brief Creates a new delta client data area variable and adds it to the list of managed variables.
+   *
+   * A DeltaClientDataAreaVariable is similar to a ClientDataAreaVariable but only sends the changed
+   * byte ranges of the data struct - or nothing if the data struct has not changed. The reader
+   * applies the changes in place. Writer and reader must both use a DeltaClientDataAreaVariable.
+   *
+   * @tparam T the data struct type - must be trivially copyable
+   * @param clientDataName String containing the client data area name. This is the name that another
+   *                      client will use to specify the data area. The name is not case-sensitive.
+   *                      If the name requested is already in use by another addon, a error will be
+   *                      printed to the console.
+   * @param updateMode optional DataManager update mode of the variable (default=UpdateMode::NO_AUTO_UPDATE)
+   * @param maxAgeTime optional maximum age of the variable in seconds (default=0)
+   * @param maxAgeTicks optional maximum age of the variable in ticks (default=0)
+   * @return A shared pointer to the variable
+   */
+  template <typename T>
+  [[nodiscard]] DeltaClientDataAreaVariablePtr<T> make_deltaclientdataarea_var(const std::string& clientDataName,
+                                                                               UpdateMode updateMode = UpdateMode::NO_AUTO_UPDATE,
+                                                                               FLOAT64 maxAgeTime = 0.0,
+                                                                               UINT64 maxAgeTicks = 0) {
+    const SIMCONNECT_CLIENT_DATA_ID clientDataId = clientDataIDGen.getNextId();
+    const SIMCONNECT_CLIENT_DATA_DEFINITION_ID clientDataDefinitionId = dataDefIDGen.getNextId();
+    typename DeltaClientDataAreaVariable<T>::BucketDefinitionIds bucketDefinitionIds{};
+    for (auto& bucketDefinitionId : bucketDefinitionIds) {
+      bucketDefinitionId = dataDefIDGen.getNextId();
+    }
+    DeltaClientDataAreaVariablePtr<T> var = makeSharedInArena<DeltaClientDataAreaVariable<T>>(registryArena, [&](void* memory) {
+      return new (memory) DeltaClientDataAreaVariable<T>(hSimConnect, clientDataName, clientDataId, clientDataDefinitionId,
+                                                         bucketDefinitionIds, dataReqIDGen.getNextId(), updateMode, maxAgeTime, maxAgeTicks);
+    });
+    registerSimObject(var);
+    LOG_DEBUG("DataManager::make_deltaclientdataarea_var(): " + clientDataName);
+    return var;
+  }
+
   /**
    * @brief Creates a new streaming client data area variable and adds it to the list of managed variables.
    *
@@ -343,10 +455,12 @@ class DataManager {
       FLOAT64 maxAgeTime = 0.0,
       UINT64 maxAgeTicks = 0) {
     StreamingClientDataAreaVariablePtr<T, ChunkSize> var =
-        StreamingClientDataAreaVariablePtr<T, ChunkSize>(new StreamingClientDataAreaVariable<T, ChunkSize>(
-            hSimConnect, clientDataName, clientDataIDGen.getNextId(), dataDefIDGen.getNextId(), dataReqIDGen.getNextId(), updateMode,
-            maxAgeTime, maxAgeTicks));
-    simObjects.insert({var->getRequestId(), var});
+        makeSharedInArena<StreamingClientDataAreaVariable<T, ChunkSize>>(registryArena, [&](void* memory) {
+          return new (memory) StreamingClientDataAreaVariable<T, ChunkSize>(hSimConnect, clientDataName, clientDataIDGen.getNextId(),
+                                                                            dataDefIDGen.getNextId(), dataReqIDGen.getNextId(), updateMode,
+                                                                            maxAgeTime, maxAgeTicks);
+        });
+    registerSimObject(var);
     LOG_DEBUG("DataManager::make_clientdataarea_buffered_var(): " + clientDataName);
     return var;
   }
@@ -512,11 +626,103 @@ class DataManager {
    */
   [[nodiscard]] HANDLE getSimConnectHandle() const { return hSimConnect; };
 
+  /**
+   * @return the number of registered variables
+   */
+  [[nodiscard]] std::size_t getVariableCount() const { return variables.size(); }
+
+  /**
+   * @return the number of variables which are automatically read from the sim in preUpdate()
+   */
+  [[nodiscard]] std::size_t getAutoReadVariableCount() const { return autoReadVariables.size(); }
+
+  /**
+   * @return the number of variables which are automatically written to the sim in postUpdate()
+   */
+  [[nodiscard]] std::size_t getAutoWriteVariableCount() const { return autoWriteVariables.size(); }
+
+  /**
+   * @return the number of registered SimObjects
+   */
+  [[nodiscard]] std::size_t getSimObjectCount() const { return simObjects.size(); }
+
+  /**
+   * @return the arena holding the registered variables, SimObjects and events
+   */
+  [[nodiscard]] const MonotonicArena& getRegistryArena() const { return registryArena; }
+
+  /**
+   * Configures the tracking of auto read variables which are not consumed (get() or hasChanged())
+   * by any module. The check runs every windowTicks ticks and logs the variables which have not
+   * been consumed during the window. Variables with callbacks are never reported.
+   * @param windowTicks the number of ticks a variable must not have been consumed, 0 to disable
+   * @param demoteUnconsumed if true unconsumed variables are demoted to lazy reads so they are
+   *                         only read from the sim when they are consumed again
+   */
+  void setConsumptionTracking(UINT64 windowTicks, bool demoteUnconsumed);
+
+  /**
+   * @return the auto read variables which have not been consumed in the last consumption check.
+   *         Empty if unconsumed variables are demoted.
+   */
+  [[nodiscard]] const std::vector<CacheableVariable*>& getUnconsumedVariables() const { return unconsumedVariables; }
+
+  /**
+   * @return the number of variables read from the sim in the last preUpdate()
+   */
+  [[nodiscard]] std::size_t getLastReadCount() const { return lastReadCount; }
+
+  /**
+   * @return the time in microseconds spent reading variables from the sim in the last preUpdate()
+   */
+  [[nodiscard]] FLOAT64 getLastReadTimeMicroseconds() const { return lastReadTimeMicroseconds; }
+
+  /**
+   * @return the number of variables written to the sim in the last postUpdate()
+   */
+  [[nodiscard]] std::size_t getLastWriteCount() const { return lastWriteCount; }
+
+  /**
+   * @return the time in microseconds spent writing variables to the sim in the last postUpdate()
+   */
+  [[nodiscard]] FLOAT64 getLastWriteTimeMicroseconds() const { return lastWriteTimeMicroseconds; }
+
  private:
   // =================================================================================================
   // Private methods
   // =================================================================================================
 
+  /**
+   * Stores a new variable and marks the update lists for rebuilding.
+   * @param uniqueName the unique name used for de-duplication
+   * @param var the variable to store
+   */
+  void registerVariable(const std::string& uniqueName, const CacheableVariablePtr& var);
+
+  /**
+   * Stores a new SimObject and marks the update lists for rebuilding.
+   * @param simObject the SimObject to store
+   */
+  void registerSimObject(const SimObjectBasePtr& simObject);
+
+  /**
+   * Removes the change notification queue of this DataManager from all registered data objects
+   * as they may outlive it.
+   */
+  void detachChangeNotificationQueue();
+
+  /**
+   * Rebuilds the auto read, auto write and manual update lists if an object has been registered
+   * or the update mode of any object has changed since they were last built.
+   */
+  void refreshUpdateLists();
+
+  /**
+   * Reports the auto read variables which have not been consumed within the consumption window
+   * and demotes them to lazy reads if configured.
+   */
+  void checkVariableConsumption();
+
   /**
    * This is called everytime we receive a message from the sim in getRequestedData().
    * @param pRecv
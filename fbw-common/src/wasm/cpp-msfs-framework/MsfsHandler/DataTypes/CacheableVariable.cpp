@@ -8,7 +8,17 @@
 #include "logging.h"
 #include "math_utils.hpp"
 
+void CacheableVariable::updateLazyFromSim() const {
+  if (lazy && !dirty && isUpdateFromSimDue(getCurrentTimeStamp(), getCurrentTickCounter())) {
+    // Reading on demand only refreshes the cache of the variable. The variables are always
+    // created non-const by the DataManager so casting away the constness is safe.
+    const_cast<CacheableVariable*>(this)->updateFromSim(getCurrentTimeStamp(), getCurrentTickCounter());
+  }
+}
+
 FLOAT64 CacheableVariable::get() const {
+  markConsumed();
+  updateLazyFromSim();
   if (cachedValue.has_value()) {
     if (dirty) {
       LOG_WARN("CacheableVariable::get() called on " + name + " but the value is dirty");
@@ -20,7 +30,7 @@ FLOAT64 CacheableVariable::get() const {
 }
 
 FLOAT64 CacheableVariable::updateFromSim(FLOAT64 timeStamp, UINT64 tickCounter) {
-  if (cachedValue.has_value() && !needsUpdateFromSim(timeStamp, tickCounter)) {
+  if (!isUpdateFromSimDue(timeStamp, tickCounter)) {
     setChanged(false);
     LOG_TRACE("CacheableVariable::updateFromSim() - from cache " + this->name + " " + str());
     return cachedValue.value();
@@ -42,6 +52,11 @@ FLOAT64 CacheableVariable::readFromSim() {
   return cachedValue.value();
 }
 
+bool CacheableVariable::hasChanged() const {
+  updateLazyFromSim();
+  return ManagedDataObjectBase::hasChanged();
+}
+
 void CacheableVariable::set(FLOAT64 value) {
   if (cachedValue.has_value() && helper::Math::almostEqual(value, cachedValue.value(), epsilon)) {
     return;
@@ -60,6 +60,18 @@ class CacheableVariable : public ManagedDataObjectBase {
    */
   ID dataID = -1;
 
+  /**
+   * Flag to indicate that the variable is only read from the sim the first time its value is
+   * requested with get() in a tick instead of by the DataManager's preUpdate().
+   */
+  bool lazy = false;
+
+
+  /**
+   * Reads a lazy variable from the sim if this is the first request of its value in the current
+   * tick (considering the max age) and the value is not dirty.
+   */
+  void updateLazyFromSim() const;
 
   /**
    * Constructor
@@ -82,6 +94,9 @@ class CacheableVariable : public ManagedDataObjectBase {
   /**
    * Returns the cached value or the default value (FLOAT64{}) if the cache is empty.<p/>
    *
+   * For a lazy variable the value is read from the sim if this is the first call in the current
+   * tick (considering the max age) and the value is not dirty.<p/>
+   *
    * Prints an error to std::cerr if the cache is empty.<p/>
    *
    * If the value has been set by the set() method since the last read from the sim (is dirty)
@@ -91,6 +106,14 @@ class CacheableVariable : public ManagedDataObjectBase {
    */
   [[nodiscard]] FLOAT64 get() const;
 
+  /**
+   * For a lazy variable the value is read from the sim first if this is the first call of get()
+   * or hasChanged() in the current tick (considering the max age) and the value is not dirty, so
+   * polling hasChanged() sees the changes of a lazy or demoted variable.
+   * @return true if the value has changed since the last read from the sim.
+   */
+  [[nodiscard]] bool hasChanged() const override;
+
   /**
    * Reads the value from the sim if the cached value is older than the max age (time and ticks).<p/>
    *
@@ -110,6 +133,17 @@ class CacheableVariable : public ManagedDataObjectBase {
    */
   FLOAT64 updateFromSim(FLOAT64 timeStamp, UINT64 tickCounter);
 
+  /**
+   * Checks if updateFromSim() would read the value from the sim for the given time and tick.
+   * This is the case if no value is cached or the cached value is older than the max age.
+   * @param timeStamp the current sim time (taken from the sim update event)
+   * @param tickCounter the current tick counter (taken from a custom counter at each update event)
+   * @return true if the value would be read from the sim, false if it would be taken from the cache
+   */
+  [[nodiscard]] bool isUpdateFromSimDue(FLOAT64 timeStamp, UINT64 tickCounter) const {
+    return !cachedValue.has_value() || needsUpdateFromSim(timeStamp, tickCounter);
+  }
+
   /**
    * Reads the value from the sim ignoring the cached value. It is recommended to use the
    * updateFromSim() method instead as this guarantees that a variable is only read once per tick
@@ -220,6 +254,20 @@ class CacheableVariable : public ManagedDataObjectBase {
    */
   void setEpsilon(FLOAT64 eps) { epsilon = eps; }
 
+  /**
+   * @return true if the variable is only read from the sim when its value is requested
+   */
+  [[nodiscard]] bool isLazy() const { return lazy; }
+
+  /**
+   * Sets the variable to be read from the sim only the first time get() is called in a tick.
+   * The DataManager then skips the variable in its auto read pass even if it is set to auto read.<p/>
+   * Note: the changed flag and callbacks of a lazy variable are only updated when get() or
+   * hasChanged() is called.
+   * @param isLazy true to read the variable on demand, false to read it in the auto read pass
+   */
+  void setLazy(bool isLazy) { lazy = isLazy; }
+
   /**
    * @return the data id the sim assigned to this variable
    */
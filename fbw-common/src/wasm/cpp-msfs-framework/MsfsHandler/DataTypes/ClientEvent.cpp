@@ -139,14 +139,13 @@ void ClientEvent::trigger_ex1(DWORD data0, DWORD data1, DWORD data2, DWORD data3
 
 CallbackID ClientEvent::addCallback(const EventCallbackFunction& callback) {
   const auto id = callbackIdGen.getNextId();
-  callbacks.insert({id, callback});
+  callbacks.add(id, callback);
   LOG_DEBUG("Added callback to event " + clientEventName + " with callback ID " + std::to_string(id));
   return id;
 }
 
 bool ClientEvent::removeCallback(CallbackID callbackId) {
-  if (auto pair = callbacks.find(callbackId); pair != callbacks.end()) {
-    callbacks.erase(pair);
+  if (callbacks.remove(callbackId)) {
     LOG_DEBUG("Removed callback from event " + clientEventName + " with callback ID " + std::to_string(callbackId));
     return true;
   }
@@ -159,15 +158,11 @@ bool ClientEvent::removeCallback(CallbackID callbackId) {
 // =================================================================================================
 
 void ClientEvent::processEvent(DWORD data) {
-  for (const auto& [id, callback] : callbacks) {
-    callback(1, data, 0, 0, 0, 0);
-  }
+  callbacks(1, data, 0, 0, 0, 0);
 }
 
 void ClientEvent::processEvent(DWORD data0, DWORD data1, DWORD data2, DWORD data3, DWORD data4) {
-  for (const auto& [id, callback] : callbacks) {
-    callback(5, data0, data1, data2, data3, data4);
-  }
+  callbacks(5, data0, data1, data2, data3, data4);
 }
 
 // =================================================================================================
@@ -262,7 +257,7 @@ std::string ClientEvent::str() const {
   ss << "Event: [" << clientEventName;
   ss << ", ClientID:" << clientEventId;
   ss << ", Registered:" << (registeredToSim);
-  ss << ", Callbacks:" << callbacks.size();
+  ss << ", Callbacks:" << callbacks.getSize();
   ss << "]";
   return ss.str();
 }
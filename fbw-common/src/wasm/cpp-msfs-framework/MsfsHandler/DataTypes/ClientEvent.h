@@ -4,15 +4,14 @@
 #ifndef FLYBYWIRE_AIRCRAFT_CLIENTEVENT_H
 #define FLYBYWIRE_AIRCRAFT_CLIENTEVENT_H
 
-#include <functional>
 #include <iostream>
-#include <map>
 #include <string>
 #include <vector>
 
 #include <MSFS/Legacy/gauges.h>
 #include <SimConnect.h>
 
+#include "CallbackList.hpp"
 #include "IDGenerator.h"
 
 class DataManager;
@@ -20,12 +19,15 @@ class DataManager;
 // Used for callback registration to allow removal of callbacks
 using CallbackID = uint64_t;
 
+// Callback list type for events
+using EventCallbackList = CallbackList<void(int number, DWORD param0, DWORD param1, DWORD param2, DWORD param3, DWORD param4)>;
+
 /**
- * Defines a callback function for an event
+ * Defines a callback function for an event - stored without heap allocation, see InplaceFunction
  * @param number of parameters to use - TODO: maybe remove this
  * @param parameters 0-4 to pass to the callback function
  */
-using EventCallbackFunction = std::function<void(int number, DWORD param0, DWORD param1, DWORD param2, DWORD param3, DWORD param4)>;
+using EventCallbackFunction = EventCallbackList::Function;
 
 /**
  * @brief The ClientEvent class represents a client event which can be used to create a custom event,
@@ -62,7 +64,7 @@ class ClientEvent {
   IDGenerator callbackIdGen{};
 
   // the callbacks for the event when the sim sends the event
-  std::map<CallbackID, EventCallbackFunction> callbacks;
+  EventCallbackList callbacks{};
 
   // flag to indicate if the event is registered to the sim
   bool registeredToSim = false;
@@ -397,7 +399,7 @@ class ClientEvent {
   /**
    * @return True if the client event has callbacks registered to it.
    */
-  [[nodiscard]] bool hasCallbacks() const { return !callbacks.empty(); }
+  [[nodiscard]] bool hasCallbacks() const { return !callbacks.isEmpty(); }
 };
 
 #endif  // FLYBYWIRE_AIRCRAFT_CLIENTEVENT_H
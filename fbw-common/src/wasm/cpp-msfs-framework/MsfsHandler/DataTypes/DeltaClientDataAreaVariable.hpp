@@ -0,0 +1,228 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_DELTACLIENTDATAAREAVARIABLE_HPP
+#define FLYBYWIRE_AIRCRAFT_DELTACLIENTDATAAREAVARIABLE_HPP
+
+#include <array>
+
+#include "ClientDataAreaVariable.hpp"
+#include "DeltaCodec.hpp"
+#include "UpdateMode.h"
+
+class DataManager;
+
+/**
+ * @brief The DeltaClientDataAreaVariable class is a special variant of the ClientDataAreaVariable
+ * class which only sends the changes of the data struct instead of the complete data struct.<p/>
+ *
+ * The writer compares the data struct with the last sent data struct and sends a patch with the
+ * changed byte ranges (see DeltaEncoder) - or nothing if the data struct has not changed. The
+ * reader applies the patch in place to its data struct (see DeltaDecoder). Both sides must use a
+ * DeltaClientDataAreaVariable for the same data struct as the client data area contains the patch
+ * and not the data struct.<p/>
+ *
+ * SimConnect requires the size of the data set to match the size of the client data definition.
+ * The variable therefore registers additional definitions for patch sizes of
+ * PATCH_SIZE_BUCKETS bytes and sends a patch with the smallest definition which fits.<p/>
+ *
+ * A keyframe with the complete data struct is sent with the first write and periodically, also
+ * while the data struct does not change, so a reader which started late or missed a patch can
+ * synchronize again. A reader which missed a
+ * patch keeps its data until the next keyframe.<p/>
+ *
+ * Applying a patch detects changes of the data struct at no extra cost so setSkipChangeCheck()
+ * has no effect.
+ *
+ * @tparam T The data struct that will be used to store the data - must be trivially copyable
+ */
+template <typename T>
+class DeltaClientDataAreaVariable : public ClientDataAreaVariable<T> {
+  static_assert(std::is_trivially_copyable_v<T>, "DeltaClientDataAreaVariable requires a trivially copyable data struct");
+
+ public:
+  // the size of the client data area - a patch is at most the data struct plus the patch and range headers
+  static constexpr std::size_t AREA_SIZE = DeltaEncoder::getMaxPatchSize(sizeof(T));
+  static_assert(AREA_SIZE <= SIMCONNECT_CLIENTDATA_MAX_SIZE, "Data struct is too large for a DeltaClientDataAreaVariable");
+
+  // the sizes of the additional client data definitions used for small patches
+  static constexpr std::array<std::size_t, 3> PATCH_SIZE_BUCKETS{64, 256, 1024};
+
+  // the client data definition IDs for the patch size buckets
+  using BucketDefinitionIds = std::array<SIMCONNECT_CLIENT_DATA_DEFINITION_ID, PATCH_SIZE_BUCKETS.size()>;
+
+ private:
+  // The data manager is a friend, so it can access the private constructor.
+  friend DataManager;
+
+  BucketDefinitionIds bucketDefinitionIds;
+
+  DeltaEncoder encoder;
+  DeltaDecoder decoder;
+
+  // the number of bytes actually sent to the sim - including the padding of the patches to the bucket size
+  UINT64 sentBytes = 0;
+
+  /**
+   * Creates an instance of a delta client data area variable.<p/>
+   *
+   * Use the DataManager's make_deltaclientdataarea_var() to create instances of DeltaClientDataAreaVariable
+   * as it ensures unique clientDataId, clientDataDefinitionId and requestId within the SimConnect session.
+   *
+   * @param hSimConnect the SimConnect handle
+   * @param clientDataName the name of the client data area
+   * @param clientDataId the ID of the client data area
+   * @param clientDataDefinitionId the definition ID of the client data area for patches of AREA_SIZE
+   * @param bucketDefinitionIds the definition IDs for patches of the sizes in PATCH_SIZE_BUCKETS
+   * @param requestId the request ID of the client data area
+   * @param updateMode optional DataManager update mode of the variable (default=UpdateMode::NO_AUTO_UPDATE)
+   * @param maxAgeTime The maximum age of the value in sim time before it is updated from the sim by
+   *                    the requestUpdateFromSim() method.
+   * @param maxAgeTicks The maximum age of the value in ticks before it is updated from the sim by
+   *                    the requestUpdateFromSim() method.
+   */
+  DeltaClientDataAreaVariable(HANDLE hSimConnect,
+                              const std::string& clientDataName,
+                              SIMCONNECT_CLIENT_DATA_ID clientDataId,
+                              SIMCONNECT_CLIENT_DATA_DEFINITION_ID clientDataDefinitionId,
+                              const BucketDefinitionIds& bucketDefinitionIds,
+                              SIMCONNECT_DATA_REQUEST_ID requestId,
+                              UpdateMode updateMode = UpdateMode::NO_AUTO_UPDATE,
+                              FLOAT64 maxAgeTime = 0.0,
+                              UINT64 maxAgeTicks = 0)
+      : ClientDataAreaVariable<T>(hSimConnect,
+                                  clientDataName,
+                                  clientDataId,
+                                  clientDataDefinitionId,
+                                  requestId,
+                                  AREA_SIZE,
+                                  updateMode,
+                                  maxAgeTime,
+                                  maxAgeTicks),
+        bucketDefinitionIds(bucketDefinitionIds),
+        encoder(sizeof(T)),
+        decoder(sizeof(T)) {
+    for (std::size_t i = 0; i < PATCH_SIZE_BUCKETS.size() && PATCH_SIZE_BUCKETS[i] < AREA_SIZE; i++) {
+      if (!SUCCEEDED(SimConnect_AddToClientDataDefinition(hSimConnect, bucketDefinitionIds[i], 0, PATCH_SIZE_BUCKETS[i]))) {
+        LOG_ERROR("DeltaClientDataAreaVariable: Adding to client data definition failed: " + this->name);
+      }
+    }
+  }
+
+ public:
+  DeltaClientDataAreaVariable() = delete;                                               // no default constructor
+  DeltaClientDataAreaVariable(const DeltaClientDataAreaVariable&) = delete;             // no copy constructor
+  DeltaClientDataAreaVariable& operator=(const DeltaClientDataAreaVariable&) = delete;  // no copy assignment
+  DeltaClientDataAreaVariable(DeltaClientDataAreaVariable&&) = delete;                  // no move constructor
+  DeltaClientDataAreaVariable& operator=(DeltaClientDataAreaVariable&&) = delete;       // no move assignment
+
+  ~DeltaClientDataAreaVariable() override {
+    for (std::size_t i = 0; i < PATCH_SIZE_BUCKETS.size() && PATCH_SIZE_BUCKETS[i] < AREA_SIZE; i++) {
+      SimConnect_ClearClientDataDefinition(this->hSimConnect, bucketDefinitionIds[i]);
+    }
+  }
+
+  bool allocateClientDataArea(bool readOnlyForOthers = false) override {
+    const DWORD readOnlyFlag =
+        readOnlyForOthers ? SIMCONNECT_CREATE_CLIENT_DATA_FLAG_READ_ONLY : SIMCONNECT_CREATE_CLIENT_DATA_FLAG_DEFAULT;
+    if (!SUCCEEDED(SimConnect_CreateClientData(this->hSimConnect, this->clientDataId, AREA_SIZE, readOnlyFlag))) {
+      LOG_ERROR("DeltaClientDataAreaVariable: Creating client data area failed: " + this->getName());
+      return false;
+    }
+    return true;
+  }
+
+  void processSimData(const SIMCONNECT_RECV* pData, FLOAT64 simTime, UINT64 tickCounter) override {
+    const auto pClientData = reinterpret_cast<const SIMCONNECT_RECV_CLIENT_DATA*>(pData);
+    // the patch is applied in place and only reports a change if a byte of the data struct changed
+    if (decoder.apply(&pClientData->dwData, &this->dataStruct)) {
+      this->updateStamps(simTime, tickCounter);
+      this->setChanged(true);
+      return;
+    }
+    this->setChanged(false);
+  }
+
+  /**
+   * Sends the changes of the data struct since the last write as a patch. Nothing is sent if the
+   * data struct has not changed.
+   * @return true if successful, false otherwise
+   */
+  bool writeDataToSim() override {
+    const std::size_t patchSize = encoder.encode(&this->dataStruct);
+    if (patchSize == 0) {
+      return true;
+    }
+
+    // use the smallest definition which fits the patch - the patch buffer has AREA_SIZE bytes
+    SIMCONNECT_CLIENT_DATA_DEFINITION_ID definitionId = this->dataDefId;
+    std::size_t setSize = AREA_SIZE;
+    for (std::size_t i = 0; i < PATCH_SIZE_BUCKETS.size(); i++) {
+      if (patchSize <= PATCH_SIZE_BUCKETS[i] && PATCH_SIZE_BUCKETS[i] < AREA_SIZE) {
+        definitionId = bucketDefinitionIds[i];
+        setSize = PATCH_SIZE_BUCKETS[i];
+        break;
+      }
+    }
+
+    if (!SUCCEEDED(SimConnect_SetClientData(this->hSimConnect, this->clientDataId, definitionId, SIMCONNECT_CLIENT_DATA_SET_FLAG_DEFAULT,
+                                            0, static_cast<DWORD>(setSize), const_cast<std::byte*>(encoder.getPatch())))) {
+      LOG_ERROR("DeltaClientDataAreaVariable: Setting data to sim for " + this->name + " with dataDefId=" + std::to_string(definitionId) +
+                " failed!");
+      // the reader is out of sync now
+      encoder.requestKeyframe();
+      return false;
+    }
+    sentBytes += setSize;
+    return true;
+  }
+
+  /**
+   * Sends the complete data struct with the next write, e.g. when a new reader has been started.
+   */
+  void requestKeyframe() { encoder.requestKeyframe(); }
+
+  /**
+   * @return the number of bytes sent to the sim
+   */
+  [[nodiscard]] UINT64 getSentBytes() const { return sentBytes; }
+
+  /**
+   * @return the encoder with the statistics of the writes of this variable
+   */
+  [[nodiscard]] const DeltaEncoder& getEncoder() const { return encoder; }
+
+  /**
+   * @return the decoder with the statistics of the reads of this variable
+   */
+  [[nodiscard]] const DeltaDecoder& getDecoder() const { return decoder; }
+
+  [[nodiscard]] std::string str() const override {
+    std::stringstream ss;
+    ss << "DeltaClientDataAreaVariable[ name=" << this->getName();
+    ss << ", clientDataId=" << this->clientDataId;
+    ss << ", dataDefId=" << this->dataDefId;
+    ss << ", requestId=" << this->requestId;
+    ss << ", structSize=" << sizeof(T);
+    ss << ", areaSize=" << AREA_SIZE;
+    ss << ", writes=" << encoder.getEncodeCount();
+    ss << ", unchangedWrites=" << encoder.getUnchangedCount();
+    ss << ", keyframesSent=" << encoder.getKeyframeCount();
+    ss << ", fullSizeBytes=" << encoder.getImageBytes();
+    ss << ", sentBytes=" << sentBytes;
+    ss << ", patchesApplied=" << decoder.getAppliedCount();
+    ss << ", patchesDropped=" << decoder.getDroppedCount();
+    ss << ", receivedBytes=" << decoder.getPatchBytes();
+    ss << ", synchronized=" << decoder.isSynchronized();
+    ss << ", timeStamp: " << this->timeStampSimTime;
+    ss << ", tickStamp: " << this->tickStamp;
+    ss << ", dataChanged: " << this->hasChanged();
+    ss << ", autoRead: " << this->isAutoRead();
+    ss << ", autoWrite: " << this->isAutoWrite();
+    ss << ", dataType=" << typeid(this->dataStruct).name() << "::" << quote(dataStruct);
+    ss << "]";
+    return ss.str();
+  }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_DELTACLIENTDATAAREAVARIABLE_HPP
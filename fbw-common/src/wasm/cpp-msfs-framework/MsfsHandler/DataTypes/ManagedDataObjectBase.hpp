@@ -4,12 +4,14 @@
 #ifndef FLYBYWIRE_A32NX_MANAGEDDATAOBJECTBASE_H
 #define FLYBYWIRE_A32NX_MANAGEDDATAOBJECTBASE_H
 
+#include <algorithm>
 #include <cstdint>
-#include <map>
 #include <string>
+#include <vector>
 
 #include <MSFS/Legacy/gauges.h>
 
+#include "CallbackList.hpp"
 #include "DataObjectBase.hpp"
 #include "IDGenerator.h"
 #include "UpdateMode.h"
@@ -18,8 +20,23 @@
 // Used for callback registration to allow removal of callbacks
 using CallbackID = uint64_t;
 
-// Callback function type
-using CallbackFunction = std::function<void()>;
+// Callback list type
+using ChangeCallbackList = CallbackList<void()>;
+
+// Callback function type - stored without heap allocation, see InplaceFunction
+using CallbackFunction = ChangeCallbackList::Function;
+
+class ManagedDataObjectBase;
+
+/**
+ * The coalesced change notifications of the data objects of one DataManager: the data objects
+ * queued for change notification and the buffer of the notifications currently being delivered.
+ * Both keep their capacity so queueing does not allocate once warmed up.
+ */
+struct ChangeNotificationQueue {
+  std::vector<ManagedDataObjectBase*> pending{};
+  std::vector<ManagedDataObjectBase*> delivering{};
+};
 
 /**
  * @brief The ManagedDataObjectBase class is the base class for all data objects and provides auto
@@ -28,7 +45,13 @@ using CallbackFunction = std::function<void()>;
  * Adds the ability to autoRead, autoWrite variables considering max age based on
  * time- and tick-stamps.
  * Also adds a hasChanged flag and the ability to register callbacks for when
- * the variable changes.
+ * the variable changes.<p/>
+ *
+ * By default the callbacks are called as soon as the data object changes. With
+ * setCoalescedNotification(true) a data object which changes is queued once instead and its
+ * callbacks are called once when the DataManager delivers the queued notifications in its
+ * preUpdate() after all reads of the tick, no matter how often the data object changed.
+ * The queue belongs to the DataManager the data object is registered with.
  */
 class ManagedDataObjectBase : public DataObjectBase {
  private:
@@ -38,15 +61,52 @@ class ManagedDataObjectBase : public DataObjectBase {
   IDGenerator callbackIdGen{};
 
   /**
-   * Map of callbacks to be called when the event is triggered in the sim.
+   * Callbacks to be called when the data object has changed.
    */
-  std::map<CallbackID, CallbackFunction> callbacks{};
+  ChangeCallbackList callbacks{};
+
+  /**
+   * Flag to indicate that the data object is queued for change notification.
+   */
+  bool isNotificationPending = false;
+
+  /**
+   * Flag to indicate that the change notifications are queued for the next delivery instead of
+   * calling the callbacks as soon as the data object changes.
+   */
+  bool coalescedNotificationFlag = false;
+
+  /**
+   * The queue of the DataManager the data object is registered with. Without a queue the
+   * callbacks are called as soon as the data object changes even with coalesced notification.
+   */
+  ChangeNotificationQueue* notificationQueue = nullptr;
 
   // Flag to indicate if the variable has changed compared to the last read/write from the sim.
   // Private because it should only be set by the setChanged() method so callbacks from
   // listeners can be triggered.
   bool changedFlag = false;
 
+  /**
+   * Incremented whenever the update mode of any data object changes. The DataManager compares it
+   * with the generation its auto read and auto write lists were built for and rebuilds them if
+   * it differs.
+   */
+  static UINT64 updateModeGeneration;
+
+  /**
+   * The sim time and tick counter of the current tick as set by the DataManager at the start of
+   * each tick. Used for lazy reads and consumption tracking which happen outside the DataManager.
+   */
+  static FLOAT64 currentTimeStamp;
+  static UINT64 currentTickCounter;
+
+  /**
+   * The tick counter of the last tick the value of the data object has been consumed (get() or
+   * hasChanged()). Mutable as consuming a value does not change the data object.
+   */
+  mutable UINT64 consumedTickStamp = 0;
+
  protected:
   /**
    * Flag to indicate if the check for data changes should be skipped to save performance when the
@@ -98,19 +158,32 @@ class ManagedDataObjectBase : public DataObjectBase {
    * @param maxAgeTicks the maximum age of the value in ticks before it is updated from the sim
    */
   ManagedDataObjectBase(const std::string& varName, UpdateMode updateMode, FLOAT64 maxAgeTime, UINT64 maxAgeTicks)
-      : DataObjectBase(varName), updateMode(updateMode), maxAgeTime(maxAgeTime), maxAgeTicks(maxAgeTicks) {}
+      : DataObjectBase(varName),
+        consumedTickStamp(currentTickCounter),
+        updateMode(updateMode),
+        maxAgeTime(maxAgeTime),
+        maxAgeTicks(maxAgeTicks) {}
+
+  /**
+   * Records that the value of the data object has been consumed in the current tick.
+   */
+  void markConsumed() const { consumedTickStamp = currentTickCounter; }
 
   /**
-   * Sets the changedFlag flag to the given value and triggers the registered callbacks
-   * if the value has changedFlag.
+   * Sets the changedFlag flag to the given value and calls the callbacks if the value has changed.
+   * With coalesced notification the data object is queued for change notification instead if
+   * callbacks are registered.
    * @param changed the new value for the changedFlag flag
    */
   void setChanged(bool changed) {
     changedFlag = changed;
-    if (changedFlag) {
-      for (const auto& [_, callback] : callbacks) {
-        callback();
-      }
+    if (changedFlag && (!coalescedNotificationFlag || notificationQueue == nullptr)) {
+      callbacks();
+      return;
+    }
+    if (changedFlag && !isNotificationPending && !callbacks.isEmpty()) {
+      isNotificationPending = true;
+      notificationQueue->pending.push_back(this);
     }
   }
 
@@ -120,7 +193,9 @@ class ManagedDataObjectBase : public DataObjectBase {
   ManagedDataObjectBase& operator=(const ManagedDataObjectBase&) = delete;  // no copy assignment
   ManagedDataObjectBase(ManagedDataObjectBase&&) = delete;                  // no move constructor
   ManagedDataObjectBase& operator=(ManagedDataObjectBase&&) = delete;       // no move assignment
-  virtual ~ManagedDataObjectBase() = default;                               // so derived classes can be destroyed with base class pointer
+
+  // virtual so derived classes can be destroyed with base class pointer
+  virtual ~ManagedDataObjectBase() { setChangeNotificationQueue(nullptr); }
 
   /**
    * Adds a callback function to be called when the data object's data changed.<p/>
@@ -129,7 +204,7 @@ class ManagedDataObjectBase : public DataObjectBase {
    */
   CallbackID addCallback(const CallbackFunction& callback) {
     const auto id = callbackIdGen.getNextId();
-    callbacks.insert({id, callback});
+    callbacks.add(id, callback);
     LOG_DEBUG("Added callback to data object " + name + " with callback ID " + std::to_string(id));
     return id;
   }
@@ -139,8 +214,7 @@ class ManagedDataObjectBase : public DataObjectBase {
    * @param callbackId The ID receive when adding the callback.
    */
   bool removeCallback(CallbackID callbackId) {
-    if (auto pair = callbacks.find(callbackId); pair != callbacks.end()) {
-      callbacks.erase(pair);
+    if (callbacks.remove(callbackId)) {
       LOG_DEBUG("Removed callback from data object " + name + " with callback ID " + std::to_string(callbackId));
       return true;
     }
@@ -176,7 +250,111 @@ class ManagedDataObjectBase : public DataObjectBase {
   /**
    * @return true if the value has changed since the last read from the sim.
    */
-  [[nodiscard]] bool hasChanged() const { return changedFlag; }
+  [[nodiscard]] virtual bool hasChanged() const {
+    markConsumed();
+    return changedFlag;
+  }
+
+  /**
+   * @return true if callbacks are registered for changes of the data object
+   */
+  [[nodiscard]] bool hasCallbacks() const { return !callbacks.isEmpty(); }
+
+  /**
+   * Sets whether the callbacks are called once per tick by the DataManager instead of as soon as
+   * the data object changes. Coalescing saves the repeated calls of a data object which changes
+   * several times per tick, but its callbacks then run in the next preUpdate() of the DataManager,
+   * i.e. for changes made with a setter in the next tick.
+   * @param coalescedNotification true to queue the notifications, false to call the callbacks
+   *                              as soon as the data object changes (default)
+   */
+  void setCoalescedNotification(bool coalescedNotification) { coalescedNotificationFlag = coalescedNotification; }
+
+  /**
+   * @return true if the change notifications are queued and delivered once per tick
+   */
+  [[nodiscard]] bool isCoalescedNotification() const { return coalescedNotificationFlag; }
+
+  /**
+   * @return true if the data object is queued for change notification
+   */
+  [[nodiscard]] bool isChangeNotificationPending() const { return isNotificationPending; }
+
+  /**
+   * Sets the queue coalesced change notifications are delivered from. Called by the DataManager
+   * when the data object is registered and with nullptr when the DataManager shuts down. A
+   * notification pending in the previous queue is discarded.
+   * @param queue the queue of the DataManager or nullptr
+   */
+  void setChangeNotificationQueue(ChangeNotificationQueue* queue) {
+    if (notificationQueue != nullptr && notificationQueue != queue) {
+      // entries are set to nullptr so a delivery in progress skips them
+      std::replace(notificationQueue->pending.begin(), notificationQueue->pending.end(), this,
+                   static_cast<ManagedDataObjectBase*>(nullptr));
+      std::replace(notificationQueue->delivering.begin(), notificationQueue->delivering.end(), this,
+                   static_cast<ManagedDataObjectBase*>(nullptr));
+      isNotificationPending = false;
+    }
+    notificationQueue = queue;
+  }
+
+  /**
+   * Calls the callbacks of all data objects which have changed since the last delivery. Each data
+   * object is notified once. Data objects which change again in a callback are queued for the
+   * next delivery. Called by the DataManager once per tick.
+   * @param queue the queue of the DataManager
+   */
+  static void deliverChangeNotifications(ChangeNotificationQueue& queue) {
+    queue.delivering.swap(queue.pending);
+    for (std::size_t i = 0; i < queue.delivering.size(); i++) {
+      // entries are set to nullptr if the data object has been destroyed in the meantime
+      ManagedDataObjectBase* dataObject = queue.delivering[i];
+      if (dataObject != nullptr) {
+        dataObject->isNotificationPending = false;
+        dataObject->callbacks();
+      }
+    }
+    queue.delivering.clear();
+  }
+
+  /**
+   * Discards all queued change notifications without calling the callbacks.
+   * @param queue the queue of the DataManager
+   */
+  static void discardChangeNotifications(ChangeNotificationQueue& queue) {
+    for (ManagedDataObjectBase* dataObject : queue.pending) {
+      if (dataObject != nullptr) {
+        dataObject->isNotificationPending = false;
+      }
+    }
+    queue.pending.clear();
+  }
+
+  /**
+   * @return the tick counter of the last tick the value has been consumed with get() or hasChanged()
+   */
+  [[nodiscard]] UINT64 getConsumedTickStamp() const { return consumedTickStamp; }
+
+  /**
+   * Sets the sim time and tick counter of the current tick. Called by the DataManager at the
+   * start of each tick.
+   * @param timeStamp - current sim time
+   * @param tickCounter - current tick counter
+   */
+  static void setCurrentTick(FLOAT64 timeStamp, UINT64 tickCounter) {
+    currentTimeStamp = timeStamp;
+    currentTickCounter = tickCounter;
+  }
+
+  /**
+   * @return the sim time of the current tick
+   */
+  [[nodiscard]] static FLOAT64 getCurrentTimeStamp() { return currentTimeStamp; }
+
+  /**
+   * @return the tick counter of the current tick
+   */
+  [[nodiscard]] static UINT64 getCurrentTickCounter() { return currentTickCounter; }
 
   /**
    * When this is true every read from the sim will set the changed flag to true
@@ -201,6 +379,7 @@ class ManagedDataObjectBase : public DataObjectBase {
    */
   virtual void setAutoRead(bool autoRead) {
     updateMode = static_cast<UpdateMode>(autoRead ? updateMode | UpdateMode::AUTO_READ : updateMode & ~UpdateMode::AUTO_READ);
+    updateModeGeneration++;
   }
 
   /**
@@ -215,6 +394,7 @@ class ManagedDataObjectBase : public DataObjectBase {
    */
   virtual void setAutoWrite(bool autoWrite) {
     updateMode = static_cast<UpdateMode>(autoWrite ? updateMode | UpdateMode::AUTO_WRITE : updateMode & ~UpdateMode::AUTO_WRITE);
+    updateModeGeneration++;
   }
 
   /**
@@ -226,7 +406,16 @@ class ManagedDataObjectBase : public DataObjectBase {
    * @brief Sets the update mode.
    * @param updateMode the new update mode
    */
-  void setUpdateMode(UpdateMode updateMode) { this->updateMode = updateMode; }
+  void setUpdateMode(UpdateMode updateMode) {
+    this->updateMode = updateMode;
+    updateModeGeneration++;
+  }
+
+  /**
+   * @return the current update mode generation which changes whenever the update mode of any
+   *         data object changes
+   */
+  [[nodiscard]] static UINT64 getUpdateModeGeneration() { return updateModeGeneration; }
 
   /**
    * @return the time stamp of the last read from the sim
@@ -261,4 +450,8 @@ class ManagedDataObjectBase : public DataObjectBase {
   void setMaxAgeTicks(UINT64 maxAgeTicksInTicks) { maxAgeTicks = maxAgeTicksInTicks; }
 };
 
+inline UINT64 ManagedDataObjectBase::updateModeGeneration = 0;
+inline FLOAT64 ManagedDataObjectBase::currentTimeStamp = 0.0;
+inline UINT64 ManagedDataObjectBase::currentTickCounter = 0;
+
 #endif  // FLYBYWIRE_A32NX_MANAGEDDATAOBJECTBASE_H
@@ -5,6 +5,7 @@
 #define FLYBYWIRE_AIRCRAFT_STREAMINGCLIENTDATAAREAVARIABLE_HPP
 
 #include "ClientDataAreaVariable.hpp"
+#include "StreamingBuffer.hpp"
 #include "UpdateMode.h"
 
 class DataManager;
@@ -18,6 +19,10 @@ class DataManager;
  *
  * Before receiving data the reserve() method must be called to reset the data and set the number of bytes to be
  * received.<br/>
+ * Chunks are copied directly to their position in the data and the tail chunk is sent from the data
+ * without a bounce buffer (see StreamingBuffer). Once the data has reached its largest size streaming
+ * does not allocate. With setDoubleBuffered(true) getData() returns the last complete transfer while
+ * the next transfer is received.<br/>
  *
  * @tparam T the type of the data to be sent/received - e.g. char for string data
  * @tparam ChunkSize the size of the chunks to be sent/received - must be <= 8192. Default is 8192.
@@ -28,17 +33,8 @@ class StreamingClientDataAreaVariable : public ClientDataAreaVariable<T> {
   // The data manager is a friend, so it can access the private constructor.
   friend DataManager;
 
-  // the content of the client data area as a vector of T
-  std::vector<T> content;
-
-  // the number of bytes expected to be received - set in reserve()
-  std::size_t expectedByteCount{};
-
-  // the number of bytes received so far - re-set in reserve()
-  std::size_t receivedBytes{};
-
-  // the number of chunks received so far - re-set in reserve()
-  std::size_t receivedChunks{};
+  // the content of the client data area and the state of the current transfer
+  StreamingBuffer<T, ChunkSize> buffer;
 
   // hide incompatible methods - alternative would be to make this class independent of ClientDataAreaVariable
   using ClientDataAreaVariable<T>::data;
@@ -77,7 +73,7 @@ class StreamingClientDataAreaVariable : public ClientDataAreaVariable<T> {
                                   updateMode,
                                   maxAgeTime,
                                   maxAgeTicks),
-        content() {}
+        buffer() {}
 
  public:
   StreamingClientDataAreaVariable<T, ChunkSize>() = delete;                                        // no default constructor
@@ -101,37 +97,31 @@ class StreamingClientDataAreaVariable : public ClientDataAreaVariable<T> {
    * This tells this instance the expected number of bytes to be received and prepares the internal
    * data structure.<br/>
    * It needs to be called before the first data chunk is received so that the internal data structure
-   * is reset and prepared to receive new data.
+   * is reset and prepared to receive new data.<br/>
+   * The data is resized to the expected size - without double buffering getData() contains the
+   * data of the previous transfer until it is overwritten by the received chunks.
    * @param expectedByteCnt Number of expected bytes in streaming cases
    */
   void reserve(std::size_t expectedByteCnt) {
     this->setChanged(false);
-    this->content.clear();
-    this->receivedBytes = 0;
-    this->receivedChunks = 0;
-    this->expectedByteCount = expectedByteCnt;
-    this->content.reserve(expectedByteCnt);
+    buffer.reserve(expectedByteCnt);
   }
 
+  /**
+   * Enables or disables double buffering. With double buffering the chunks are received into a
+   * second buffer and getData() returns the last complete transfer until the next transfer is
+   * complete. Should be set before the first transfer.
+   * @param doubleBuffered true to enable double buffering, false otherwise
+   */
+  void setDoubleBuffered(bool doubleBuffered) { buffer.setDoubleBuffered(doubleBuffered); }
+
   void processSimData(const SIMCONNECT_RECV* pData, FLOAT64 simTime, UINT64 tickCounter) override {
     const auto pClientData = reinterpret_cast<const SIMCONNECT_RECV_CLIENT_DATA*>(pData);
 
-    std::size_t remainingBytes = this->expectedByteCount - this->receivedBytes;
-    if (remainingBytes > ChunkSize) {
-      remainingBytes = ChunkSize;
-    }
-
-    // insert the data into the vector - very fast as well but results in a valid vector instance (memcpy doesn't)
-    this->content.insert(this->content.end(), (T*)&pClientData->dwData, (T*)&pClientData->dwData + remainingBytes);
-
-    this->receivedChunks++;
-    this->receivedBytes += remainingBytes;
-
-    // received all data?
-    if (this->receivedBytes >= this->expectedByteCount) {
+    // copy the chunk directly to its position in the data
+    if (buffer.receiveChunk(&pClientData->dwData)) {
       this->updateStamps(simTime, tickCounter);
       this->setChanged(true);
-      return;
     }
   }
 
@@ -141,38 +131,19 @@ class StreamingClientDataAreaVariable : public ClientDataAreaVariable<T> {
    * @return true if successful, false otherwise
    */
   bool writeDataToSim() override {
-    [[maybe_unused]] int chunkCount = 0;  // for debugging output only
-    std::size_t sentBytes = 0;
-    std::size_t remainingBytes = this->content.size();
-
-    while (sentBytes < this->content.size()) {
-      if (remainingBytes >= ChunkSize) {
-        chunkCount++;
-        if (!SUCCEEDED(SimConnect_SetClientData(this->hSimConnect, this->clientDataId, this->dataDefId,
-                                                SIMCONNECT_CLIENT_DATA_SET_FLAG_DEFAULT, 0, ChunkSize, &this->content.data()[sentBytes]))) {
-          LOG_ERROR("Setting data to sim for " + this->getName() + " with dataDefId=" + std::to_string(this->dataDefId) + " failed!");
-          return false;
-        }
-        sentBytes += ChunkSize;
-      } else {  // last chunk
-        // use a tmp array buffer to send the remaining bytes
-        std::array<T, ChunkSize> buffer{};
-        std::memcpy(buffer.data(), &this->content.data()[sentBytes], remainingBytes);
-        chunkCount++;
-        if (!SUCCEEDED(SimConnect_SetClientData(this->hSimConnect, this->clientDataId, this->dataDefId,
-                                                SIMCONNECT_CLIENT_DATA_SET_FLAG_DEFAULT, 0, ChunkSize, buffer.data()))) {
-          LOG_ERROR("Setting data to sim for " + this->getName() + " with dataDefId=" + std::to_string(this->dataDefId) + " failed!");
-          return false;
-        }
-        sentBytes += remainingBytes;
-      }
-      remainingBytes = this->content.size() - sentBytes;
-      LOG_VERBOSE("Sending chunk: " + std::to_string(chunkCount) + " Sent bytes: " + std::to_string(sentBytes) +
-                  " Remaining bytes: " + std::to_string(remainingBytes));
+    const std::size_t expectedChunkCount = buffer.getChunkCount();
+    const std::size_t chunkCount = buffer.sendChunks([this](const T* chunk) {
+      return SUCCEEDED(SimConnect_SetClientData(this->hSimConnect, this->clientDataId, this->dataDefId,
+                                                SIMCONNECT_CLIENT_DATA_SET_FLAG_DEFAULT, 0, ChunkSize, const_cast<T*>(chunk)));
+    });
+    if (chunkCount < expectedChunkCount) {
+      LOG_ERROR("Setting data to sim for " + this->getName() + " with dataDefId=" + std::to_string(this->dataDefId) + " failed at chunk " +
+                std::to_string(chunkCount + 1) + " of " + std::to_string(expectedChunkCount) + "!");
+      return false;
     }
 
-    LOG_DEBUG("Finished sending data in " + std::to_string(chunkCount) + " chunks" + " Sent bytes: " + std::to_string(sentBytes) +
-              " Remaining bytes: " + std::to_string(remainingBytes) + " DataSize: " + std::to_string(this->content.size()));
+    LOG_DEBUG("Finished sending data in " + std::to_string(chunkCount) + " chunks" + " DataSize: " +
+              std::to_string(buffer.getData().size()));
     return true;
   }
 
@@ -180,25 +151,25 @@ class StreamingClientDataAreaVariable : public ClientDataAreaVariable<T> {
    * Returns a modifiable reference to the data container
    * @return T& Reference to the data container
    */
-  [[nodiscard]] std::vector<T>& getData() { return content; }
+  [[nodiscard]] std::vector<T>& getData() { return buffer.getData(); }
 
   /**
    * Returns a constant reference to the data container
    * @return std::vector<T>& Reference to the data container
    */
-  [[nodiscard]] const std::vector<T>& getData() const { return content; }
+  [[nodiscard]] const std::vector<T>& getData() const { return buffer.getData(); }
 
   /**
    * Returns the number of bytes received so far
    * @return std::size_t Number of bytes received so far
    */
-  [[nodiscard]] std::size_t getReceivedBytes() const { return receivedBytes; }
+  [[nodiscard]] std::size_t getReceivedBytes() const { return buffer.getReceivedBytes(); }
 
   /**
    * Returns the number of chunks received so far
    * @return std::size_t Number of chunks received so far
    */
-  [[nodiscard]] std::size_t getReceivedChunks() const { return receivedChunks; }
+  [[nodiscard]] std::size_t getReceivedChunks() const { return buffer.getReceivedChunks(); }
 
   [[nodiscard]] std::string str() const override {
     std::stringstream ss;
@@ -206,10 +177,11 @@ class StreamingClientDataAreaVariable : public ClientDataAreaVariable<T> {
     ss << ", clientDataId=" << this->clientDataId;
     ss << ", dataDefId=" << this->dataDefId;
     ss << ", requestId=" << this->requestId;
-    ss << ", expectedByteCount=" << this->expectedByteCount;
-    ss << ", receivedBytes=" << this->receivedBytes;
-    ss << ", receivedChunks=" << this->receivedChunks;
-    ss << ", structSize=" << content.size() * sizeof(T);
+    ss << ", expectedByteCount=" << buffer.getExpectedBytes();
+    ss << ", receivedBytes=" << buffer.getReceivedBytes();
+    ss << ", receivedChunks=" << buffer.getReceivedChunks();
+    ss << ", doubleBuffered=" << buffer.isDoubleBuffered();
+    ss << ", structSize=" << buffer.getData().size() * sizeof(T);
     ss << ", timeStamp: " << this->timeStampSimTime;
     ss << ", nextUpdateTimeStamp: " << this->nextUpdateTimeStamp;
     ss << ", tickStamp: " << this->tickStamp;
@@ -220,7 +192,7 @@ class StreamingClientDataAreaVariable : public ClientDataAreaVariable<T> {
     ss << ", autoWrite: " << this->isAutoWrite();
     ss << ", maxAgeTime: " << this->maxAgeTime;
     ss << ", maxAgeTicks: " << this->maxAgeTicks;
-    ss << ", dataType=" << typeid(T).name() << "::" << quote(content);
+    ss << ", dataType=" << typeid(T).name() << "::" << quote(buffer.getData());
     ss << "]";
     return ss.str();
   }
@@ -6,6 +6,7 @@
 
 #include <MSFS/Legacy/gauges.h>
 
+#include "ModuleScheduler.h"
 #include "MsfsHandler.h"
 
 /**
@@ -19,9 +20,41 @@
  * user/developer if somethings went wrong and where and what happened.<p/>
  *
  * Non-excessive positive logging about what is happening is also a good idea and helps
- * tremendously with finding any issues as it will be easier to locate the cause of the issue.
+ * tremendously with finding any issues as it will be easier to locate the cause of the issue.<p/>
+ *
+ * By default a module is updated every frame. Modules which mostly idle should declare a lower
+ * update rate with setUpdateRate() so the ModuleScheduler can skip them and spread their work
+ * across frames.
  */
 class Module {
+  // The scheduler is a friend so it can consume update requests and record statistics.
+  friend ModuleScheduler;
+
+  /**
+   * How often the module is updated.
+   */
+  ModuleUpdateRate updateRate = ModuleUpdateRate::EVERY_FRAME;
+
+  /**
+   * The update rate in Hz for ModuleUpdateRate::FIXED_RATE.
+   */
+  FLOAT64 updateRateHz = 0.0;
+
+  /**
+   * The time the module may take per frame in microseconds. 0 means no budget.
+   */
+  FLOAT64 frameBudgetMicroseconds = 0.0;
+
+  /**
+   * Flag to indicate that the module should be updated in the next frame.
+   */
+  bool isUpdateRequested = false;
+
+  /**
+   * The update statistics recorded by the scheduler.
+   */
+  ModuleStatistics statistics{};
+
  protected:
   /**
    * The MsfsHandler instance that is used to communicate with the simulator.
@@ -89,6 +122,51 @@ class Module {
    * @return true if the module has been initialized, false otherwise.
    */
   [[nodiscard]] bool isInitialized() const { return _isInitialized; }
+
+  /**
+   * Requests an update of a ModuleUpdateRate::ON_EVENT or ModuleUpdateRate::FIXED_RATE module in
+   * the next frame. If called during the module's own update the module is updated again in the
+   * next frame.
+   */
+  void requestUpdate() { isUpdateRequested = true; }
+
+  /**
+   * @return how often the module is updated
+   */
+  [[nodiscard]] ModuleUpdateRate getUpdateRate() const { return updateRate; }
+
+  /**
+   * @return the update rate in Hz for ModuleUpdateRate::FIXED_RATE
+   */
+  [[nodiscard]] FLOAT64 getUpdateRateHz() const { return updateRateHz; }
+
+  /**
+   * @return the time the module may take per frame in microseconds, 0 if there is no budget
+   */
+  [[nodiscard]] FLOAT64 getFrameBudgetMicroseconds() const { return frameBudgetMicroseconds; }
+
+  /**
+   * @return the update statistics of the module
+   */
+  [[nodiscard]] const ModuleStatistics& getStatistics() const { return statistics; }
+
+ protected:
+  /**
+   * Sets how often the module is updated. Usually called in the constructor or initialize().
+   * @param rate the update rate
+   * @param rateHz the update rate in Hz for ModuleUpdateRate::FIXED_RATE
+   */
+  void setUpdateRate(ModuleUpdateRate rate, FLOAT64 rateHz = 0.0) {
+    updateRate = rate;
+    updateRateHz = rateHz;
+  }
+
+  /**
+   * Sets the time the module may take per frame. Updates taking longer are counted as missed
+   * deadlines in the module's statistics.
+   * @param budgetMicroseconds the budget in microseconds, 0 for no budget
+   */
+  void setFrameBudgetMicroseconds(FLOAT64 budgetMicroseconds) { frameBudgetMicroseconds = budgetMicroseconds; }
 };
 
 #endif  // FLYBYWIRE_MODULE_H
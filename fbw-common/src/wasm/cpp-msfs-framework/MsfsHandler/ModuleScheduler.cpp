@@ -0,0 +1,196 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string>
+
+#include "AllocationCounter.h"
+#include "Module.h"
+#include "ModuleScheduler.h"
+#include "logging.h"
+
+void ModuleScheduler::addModule(Module* pModule) {
+  ScheduledModule scheduledModule{pModule};
+  scheduledModule.profileScopeId = profiler.addScope("Module " + std::to_string(scheduledModules.size()));
+  scheduledModule.phaseProfileScopeIds[PRE_UPDATE] = profiler.addScope("preUpdate()", scheduledModule.profileScopeId);
+  scheduledModule.phaseProfileScopeIds[UPDATE] = profiler.addScope("update()", scheduledModule.profileScopeId);
+  scheduledModule.phaseProfileScopeIds[POST_UPDATE] = profiler.addScope("postUpdate()", scheduledModule.profileScopeId);
+
+  lowPriorityOrder.push_back(scheduledModules.size());
+  reorderBuffer.reserve(lowPriorityOrder.size());
+  scheduledModules.push_back(scheduledModule);
+}
+
+void ModuleScheduler::clear() {
+  scheduledModules.clear();
+  lowPriorityOrder.clear();
+  reorderBuffer.clear();
+  fixedRateModuleCount = 0;
+}
+
+void ModuleScheduler::beginFrame(FLOAT64 timeStamp, const sGaugeDrawData* pData) {
+  for (ScheduledModule& scheduledModule : scheduledModules) {
+    scheduledModule.timeSinceUpdate += pData->dt;
+    scheduledModule.isDue = scheduledModule.module->getUpdateRate() == ModuleUpdateRate::EVERY_FRAME;
+    scheduledModule.frameTimeNanoseconds = 0;
+    scheduledModule.frameAllocationCount = 0;
+  }
+
+  // select the due low priority modules until the estimated time exceeds the budget
+  FLOAT64 estimatedTimeMicroseconds = 0.0;
+  bool isAnyLowPriorityModuleDue = false;
+  for (const std::size_t index : lowPriorityOrder) {
+    ScheduledModule& scheduledModule = scheduledModules[index];
+    if (scheduledModule.module->getUpdateRate() == ModuleUpdateRate::EVERY_FRAME) {
+      continue;
+    }
+    if (!isLowPriorityModuleDue(scheduledModule, timeStamp)) {
+      scheduledModule.module->statistics.skippedCount++;
+      continue;
+    }
+    const FLOAT64 estimateMicroseconds = scheduledModule.module->statistics.lastTimeMicroseconds;
+    if (lowPriorityFrameBudgetMicroseconds > 0.0 && isAnyLowPriorityModuleDue &&
+        estimatedTimeMicroseconds + estimateMicroseconds > lowPriorityFrameBudgetMicroseconds) {
+      scheduledModule.module->statistics.deferredCount++;
+      continue;
+    }
+    scheduledModule.isDue = true;
+    estimatedTimeMicroseconds += estimateMicroseconds;
+    isAnyLowPriorityModuleDue = true;
+
+    // consume the request and advance the fixed rate period
+    scheduledModule.module->isUpdateRequested = false;
+    if (scheduledModule.module->getUpdateRate() == ModuleUpdateRate::FIXED_RATE && scheduledModule.module->getUpdateRateHz() > 0.0) {
+      const FLOAT64 period = 1.0 / scheduledModule.module->getUpdateRateHz();
+      scheduledModule.nextDueTime += period;
+      if (scheduledModule.nextDueTime <= timeStamp) {
+        scheduledModule.nextDueTime = timeStamp + period;
+      }
+    }
+  }
+
+  // modules which have not been updated in this frame are considered first in the next frame -
+  // a stable partition into a reused buffer as std::stable_partition may allocate
+  reorderBuffer.clear();
+  for (const std::size_t index : lowPriorityOrder) {
+    if (!scheduledModules[index].isDue) {
+      reorderBuffer.push_back(index);
+    }
+  }
+  for (const std::size_t index : lowPriorityOrder) {
+    if (scheduledModules[index].isDue) {
+      reorderBuffer.push_back(index);
+    }
+  }
+  lowPriorityOrder.swap(reorderBuffer);
+
+  // pass the time since the last update to the due modules
+  for (ScheduledModule& scheduledModule : scheduledModules) {
+    if (scheduledModule.isDue) {
+      scheduledModule.drawData = *pData;
+      scheduledModule.drawData.dt = scheduledModule.timeSinceUpdate;
+      scheduledModule.timeSinceUpdate = 0.0;
+    }
+  }
+}
+
+bool ModuleScheduler::preUpdate() {
+  return runPhase(&Module::preUpdate, PRE_UPDATE);
+}
+
+bool ModuleScheduler::update() {
+  return runPhase(&Module::update, UPDATE);
+}
+
+bool ModuleScheduler::postUpdate() {
+  return runPhase(&Module::postUpdate, POST_UPDATE);
+}
+
+void ModuleScheduler::endFrame() {
+  for (const ScheduledModule& scheduledModule : scheduledModules) {
+    if (!scheduledModule.isDue) {
+      continue;
+    }
+    profiler.record(scheduledModule.profileScopeId, scheduledModule.frameTimeNanoseconds);
+    const FLOAT64 frameTimeMicroseconds = static_cast<FLOAT64>(scheduledModule.frameTimeNanoseconds) / 1000.0;
+    ModuleStatistics& statistics = scheduledModule.module->statistics;
+    statistics.updateCount++;
+    statistics.lastTimeMicroseconds = frameTimeMicroseconds;
+    statistics.maxTimeMicroseconds = (std::max)(statistics.maxTimeMicroseconds, frameTimeMicroseconds);
+    statistics.lastAllocationCount = scheduledModule.frameAllocationCount;
+    if (scheduledModule.frameAllocationCount > 0) {
+      statistics.allocatingUpdateCount++;
+    }
+    const FLOAT64 budgetMicroseconds = scheduledModule.module->getFrameBudgetMicroseconds();
+    if (budgetMicroseconds > 0.0 && frameTimeMicroseconds > budgetMicroseconds) {
+      statistics.budgetOverrunCount++;
+    }
+  }
+}
+
+void ModuleScheduler::printStatistics() const {
+  for (std::size_t i = 0; i < scheduledModules.size(); i++) {
+    const ModuleStatistics& statistics = scheduledModules[i].module->getStatistics();
+    LOG_INFO("Module " + std::to_string(i) + ": updates " + std::to_string(statistics.updateCount) + ", skipped " +
+             std::to_string(statistics.skippedCount) + ", deferred " + std::to_string(statistics.deferredCount) + ", budget overruns " +
+             std::to_string(statistics.budgetOverrunCount) + ", last " + std::to_string(statistics.lastTimeMicroseconds) + "us, max " +
+             std::to_string(statistics.maxTimeMicroseconds) + "us" +
+             (AllocationCounter::isEnabled() ? ", allocating updates " + std::to_string(statistics.allocatingUpdateCount) +
+                                                   ", last allocations " + std::to_string(statistics.lastAllocationCount)
+                                             : ""));
+  }
+}
+
+// =================================================================================================
+// PRIVATE METHODS
+// =================================================================================================
+
+bool ModuleScheduler::isLowPriorityModuleDue(ScheduledModule& scheduledModule, FLOAT64 timeStamp) {
+  const Module* pModule = scheduledModule.module;
+  if (pModule->isUpdateRequested || pModule->getUpdateRate() == ModuleUpdateRate::ON_EVENT) {
+    return pModule->isUpdateRequested;
+  }
+
+  // a fixed rate without a valid rate is updated every frame
+  if (pModule->getUpdateRateHz() <= 0.0) {
+    return true;
+  }
+  const FLOAT64 period = 1.0 / pModule->getUpdateRateHz();
+
+  // stagger the first update by a fraction of the period (golden ratio sequence) so modules
+  // with the same rate are spread across frames without knowing the number of modules
+  if (scheduledModule.nextDueTime < 0.0) {
+    constexpr FLOAT64 GOLDEN_RATIO_FRACTION = 0.6180339887498949;
+    const FLOAT64 fraction = std::fmod(static_cast<FLOAT64>(fixedRateModuleCount++) * GOLDEN_RATIO_FRACTION, 1.0);
+    scheduledModule.nextDueTime = timeStamp + period * fraction;
+  }
+
+  // the sim time went backwards (e.g. flight restarted) - reschedule
+  if (scheduledModule.nextDueTime - timeStamp > period) {
+    scheduledModule.nextDueTime = timeStamp;
+  }
+
+  return timeStamp >= scheduledModule.nextDueTime;
+}
+
+bool ModuleScheduler::runPhase(bool (Module::*phase)(sGaugeDrawData*), Phase phaseIndex) {
+  for (ScheduledModule& scheduledModule : scheduledModules) {
+    if (!scheduledModule.isDue) {
+      continue;
+    }
+    const UINT64 allocationStart = AllocationCounter::getAllocationCount();
+    const auto start = TraceRecorder::Clock::now();
+    const bool result = (scheduledModule.module->*phase)(&scheduledModule.drawData);
+    const auto end = TraceRecorder::Clock::now();
+    profiler.record(scheduledModule.phaseProfileScopeIds[phaseIndex], start, end);
+    scheduledModule.frameTimeNanoseconds +=
+        static_cast<UINT64>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    scheduledModule.frameAllocationCount += AllocationCounter::getAllocationCount() - allocationStart;
+    if (!result) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,244 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_MODULESCHEDULER_H
+#define FLYBYWIRE_MODULESCHEDULER_H
+
+#include <array>
+#include <vector>
+
+#include <MSFS/Legacy/gauges.h>
+#include <MSFS/MSFS.h>
+
+#include "FrameProfiler.hpp"
+
+class Module;
+
+/**
+ * @brief The ModuleUpdateRate enum defines how often a module is updated by the MsfsHandler.<p/>
+ * EVERY_FRAME: The module is updated every frame (default)<br/>
+ * FIXED_RATE: The module is updated with the rate in Hz set with Module::setUpdateRate()<br/>
+ * ON_EVENT: The module is only updated in the frame after Module::requestUpdate() has been called<br/>
+ *
+ * A FIXED_RATE module is also updated in the frame after it called Module::requestUpdate(). This
+ * allows a module to poll with a low rate and to run every frame while it is busy.<p/>
+ *
+ * FIXED_RATE and ON_EVENT modules are low priority and are spread across frames if the
+ * low priority frame budget of the scheduler is used up.
+ */
+enum class ModuleUpdateRate {
+  EVERY_FRAME,
+  FIXED_RATE,
+  ON_EVENT
+};
+
+/**
+ * @brief Update statistics of a module as recorded by the ModuleScheduler.
+ */
+struct ModuleStatistics {
+  // Number of frames the module has been updated in
+  UINT64 updateCount = 0;
+  // Number of frames the module has been skipped in because it was not due
+  UINT64 skippedCount = 0;
+  // Number of frames a due module has been postponed because the low priority frame budget was used up
+  UINT64 deferredCount = 0;
+  // Number of updates which took longer than the frame budget of the module
+  UINT64 budgetOverrunCount = 0;
+  // Time of preUpdate(), update() and postUpdate() of the last update in microseconds
+  FLOAT64 lastTimeMicroseconds = 0.0;
+  // Maximum time of preUpdate(), update() and postUpdate() of a single update in microseconds
+  FLOAT64 maxTimeMicroseconds = 0.0;
+  // Number of heap allocations in preUpdate(), update() and postUpdate() of the last update
+  // (only counted with ALLOCATION_TRACKING - see AllocationCounter)
+  UINT64 lastAllocationCount = 0;
+  // Number of updates which allocated on the heap (only counted with ALLOCATION_TRACKING)
+  UINT64 allocatingUpdateCount = 0;
+
+  /**
+   * @return the number of deadlines missed by the module - either because it has been postponed
+   * or because it exceeded its frame budget
+   */
+  [[nodiscard]] UINT64 getMissedDeadlineCount() const { return deferredCount + budgetOverrunCount; }
+};
+
+/**
+ * @brief The ModuleScheduler decides which modules are updated in a frame and calls their
+ * preUpdate(), update() and postUpdate() methods.
+ *
+ * Modules with ModuleUpdateRate::EVERY_FRAME are always updated. Modules with a fixed rate are
+ * updated when their period has passed and their first updates are staggered so modules with the
+ * same rate are not all due in the same frame. Modules with ModuleUpdateRate::ON_EVENT are only
+ * updated after they requested an update.<p/>
+ *
+ * Fixed rate and on event modules are low priority. Their estimated time (the time of their last
+ * update) is summed up and once the low priority frame budget would be exceeded the remaining due
+ * modules are postponed to the next frame. At least one low priority module is updated per frame
+ * and postponed modules are considered first in the next frame so no module is starved.<p/>
+ *
+ * A module is passed the time since its last update as sGaugeDrawData::dt so modules which are
+ * not updated every frame can still integrate over time correctly.<p/>
+ *
+ * The heap allocations of each module are recorded in its statistics when the framework is
+ * compiled with ALLOCATION_TRACKING (see AllocationCounter).<p/>
+ *
+ * The time of each module and of each of its phases is recorded in the FrameProfiler passed to the
+ * constructor as a "Module <index>" scope with the child scopes "preUpdate()", "update()" and
+ * "postUpdate()".
+ */
+class ModuleScheduler {
+  /**
+   * The phases of a module update - used as index of the profiler scopes of the phases.
+   */
+  enum Phase : std::size_t {
+    PRE_UPDATE,
+    UPDATE,
+    POST_UPDATE,
+    PHASE_COUNT
+  };
+
+  /**
+   * The scheduling state of a registered module.
+   */
+  struct ScheduledModule {
+    Module* module;
+    // the module is updated in the current frame
+    bool isDue = false;
+    // the sim time the next update of a fixed rate module is due, negative if not yet scheduled
+    FLOAT64 nextDueTime = -1.0;
+    // the time since the last update of the module in seconds
+    FLOAT64 timeSinceUpdate = 0.0;
+    // the draw data passed to the module in the current frame
+    sGaugeDrawData drawData{};
+    // the time of the module in the current frame in nanoseconds
+    UINT64 frameTimeNanoseconds = 0;
+    // the heap allocations of the module in the current frame
+    UINT64 frameAllocationCount = 0;
+    // the profiler scopes of the module and of its phases
+    ProfileScopeId profileScopeId = FrameProfiler::ROOT_SCOPE;
+    std::array<ProfileScopeId, PHASE_COUNT> phaseProfileScopeIds{};
+  };
+
+  /**
+   * The profiler the time of the modules and their phases is recorded in.
+   */
+  FrameProfiler& profiler;
+
+  /**
+   * The modules in the order of registration. This order is kept for the update calls.
+   */
+  std::vector<ScheduledModule> scheduledModules{};
+
+  /**
+   * The indices of the low priority modules in the order they are considered for the next frame.
+   */
+  std::vector<std::size_t> lowPriorityOrder{};
+
+  /**
+   * Buffer to reorder lowPriorityOrder without allocating in each frame.
+   */
+  std::vector<std::size_t> reorderBuffer{};
+
+  /**
+   * The time all low priority modules may take per frame in microseconds. 0 means no limit.
+   */
+  FLOAT64 lowPriorityFrameBudgetMicroseconds = 1000.0;
+
+  /**
+   * The number of fixed rate modules which have been scheduled for the first time. Used to stagger
+   * the first updates of fixed rate modules.
+   */
+  std::size_t fixedRateModuleCount = 0;
+
+ public:
+  /**
+   * Creates a module scheduler.
+   * @param profiler the profiler to record the time of the modules and their phases in
+   */
+  explicit ModuleScheduler(FrameProfiler& profiler) : profiler(profiler) {}
+
+  ModuleScheduler(const ModuleScheduler&) = delete;             // no copy constructor
+  ModuleScheduler& operator=(const ModuleScheduler&) = delete;  // no copy assignment
+  ModuleScheduler(ModuleScheduler&&) = delete;                  // no move constructor
+  ModuleScheduler& operator=(ModuleScheduler&&) = delete;       // no move assignment
+  ~ModuleScheduler() = default;
+
+  /**
+   * Adds a module to the scheduler. The modules are updated in the order they are added.
+   * Also adds the profiler scopes of the module.
+   * @param pModule pointer to the module
+   */
+  void addModule(Module* pModule);
+
+  /**
+   * Removes all modules from the scheduler.
+   */
+  void clear();
+
+  /**
+   * Decides which modules are updated in this frame. Must be called once per frame before the
+   * update phases.
+   * @param timeStamp the current sim time
+   * @param pData sGaugeDrawData structure containing the data for the current frame
+   */
+  void beginFrame(FLOAT64 timeStamp, const sGaugeDrawData* pData);
+
+  /**
+   * Calls preUpdate() on all modules which are due in this frame.
+   * @return false if a module returned false, true otherwise
+   */
+  bool preUpdate();
+
+  /**
+   * Calls update() on all modules which are due in this frame.
+   * @return false if a module returned false, true otherwise
+   */
+  bool update();
+
+  /**
+   * Calls postUpdate() on all modules which are due in this frame.
+   * @return false if a module returned false, true otherwise
+   */
+  bool postUpdate();
+
+  /**
+   * Records the statistics of the modules updated in this frame. Must be called once per frame
+   * after the update phases.
+   */
+  void endFrame();
+
+  /**
+   * Logs the statistics of all modules.
+   */
+  void printStatistics() const;
+
+  /**
+   * @return the time all low priority modules may take per frame in microseconds
+   */
+  [[nodiscard]] FLOAT64 getLowPriorityFrameBudgetMicroseconds() const { return lowPriorityFrameBudgetMicroseconds; }
+
+  /**
+   * Sets the time all low priority modules may take per frame. 0 means no limit.
+   * @param budgetMicroseconds the budget in microseconds
+   */
+  void setLowPriorityFrameBudgetMicroseconds(FLOAT64 budgetMicroseconds) { lowPriorityFrameBudgetMicroseconds = budgetMicroseconds; }
+
+ private:
+  /**
+   * Checks if a low priority module is due in this frame.
+   * @param scheduledModule the module to check
+   * @param timeStamp the current sim time
+   * @return true if the module is due, false otherwise
+   */
+  bool isLowPriorityModuleDue(ScheduledModule& scheduledModule, FLOAT64 timeStamp);
+
+  /**
+   * Calls the given phase on all modules which are due in this frame and measures their time
+   * and allocations.
+   * @param phase the member function of the module to call
+   * @param phaseIndex the index of the phase's profiler scope
+   * @return false if a module returned false, true otherwise
+   */
+  bool runPhase(bool (Module::*phase)(sGaugeDrawData*), Phase phaseIndex);
+};
+
+#endif  // FLYBYWIRE_MODULESCHEDULER_H
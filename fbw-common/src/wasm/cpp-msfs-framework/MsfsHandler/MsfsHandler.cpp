@@ -2,8 +2,10 @@
 // SPDX-License-Identifier: GPL-3.0
 
 #include <algorithm>
+#include <cctype>
 #include <functional>
 
+#include "AllocationCounter.h"
 #include "Callback.h"
 #include "ClientEvent.h"
 #include "Module.h"
@@ -17,6 +19,7 @@
 
 void MsfsHandler::registerModule(Module* pModule) {
   modules.push_back(pModule);
+  moduleScheduler.addModule(pModule);
 }
 
 bool MsfsHandler::initialize() {
@@ -67,7 +70,8 @@ bool MsfsHandler::initialize() {
   // PAUSE_STATE_FLAG_PAUSE_WITH_SOUND 2  // FSX Legacy Pause (not used anymore)
   // PAUSE_STATE_FLAG_ACTIVE_PAUSE 4      // Pause was activated using the "Active Pause" Button
   // PAUSE_STATE_FLAG_SIM_PAUSE 8         // Pause the player sim but traffic, multi, etc... will still run
-  a32nxPauseDetected = dataManager.make_named_var("PAUSE_DETECTED", UNITS.Number, UpdateMode::AUTO_READ_WRITE);
+  // read and written directly in update() and the event callback so no auto update is needed
+  a32nxPauseDetected = dataManager.make_named_var("PAUSE_DETECTED", UNITS.Number, UpdateMode::NO_AUTO_UPDATE);
   pauseDetectedEvent = dataManager.make_client_event("A32NX.PAUSE_DETECTED_EVENT", false);
   pauseDetectedEvent->addCallback([&](const int, const DWORD param0, const DWORD, const DWORD, const DWORD, const DWORD) {
     LOG_INFO(simConnectName + ": Pause detected: " + std::to_string(param0));
@@ -79,6 +83,26 @@ bool MsfsHandler::initialize() {
   }
   LOG_INFO(simConnectName + ": Subscribed to PAUSE_EX1 event");
 
+  // frame profile export - the LVAR names are derived from the SimConnect name so several
+  // instances in the same aircraft do not overwrite each other
+  std::string profileName = simConnectName;
+  std::transform(profileName.begin(), profileName.end(), profileName.begin(),
+                 [](unsigned char c) { return std::isalnum(c) ? static_cast<char>(std::toupper(c)) : '_'; });
+  frameProfileExport = dataManager.make_clientdataarea_var<FrameProfileExport>(simConnectName + "_FRAME_PROFILE");
+  // the export is a diagnostic only - the module keeps running without it
+  if (!frameProfileExport->allocateClientDataArea(true)) {
+    LOG_WARN(simConnectName + ": Failed to allocate frame profile client data area - frame profile export disabled");
+    frameProfileExport = nullptr;
+  }
+  frameTimeP50 = dataManager.make_named_var("FRAME_TIME_" + profileName + "_P50", UNITS.Number, UpdateMode::NO_AUTO_UPDATE);
+  frameTimeP99 = dataManager.make_named_var("FRAME_TIME_" + profileName + "_P99", UNITS.Number, UpdateMode::NO_AUTO_UPDATE);
+  frameTimeP999 = dataManager.make_named_var("FRAME_TIME_" + profileName + "_P999", UNITS.Number, UpdateMode::NO_AUTO_UPDATE);
+  frameTimeMax = dataManager.make_named_var("FRAME_TIME_" + profileName + "_MAX", UNITS.Number, UpdateMode::NO_AUTO_UPDATE);
+
+  // read directly in update() so no auto update is needed - shared by all WASM modules with a trace recorder
+  traceDumpTrigger = dataManager.make_named_var("TRACE_DUMP", UNITS.Number, UpdateMode::NO_AUTO_UPDATE);
+  traceRecorder.setTriggerValue(traceDumpTrigger->readFromSim());
+
   // Initialize modules
   result = std::all_of(modules.begin(), modules.end(), [](Module* pModule) { return pModule->initialize(); });
   if (!result) {
@@ -98,15 +122,20 @@ bool MsfsHandler::update(sGaugeDrawData* pData) {
     return false;
   }
 
-#ifdef PROFILING
-  profiler.start();
-#endif
+  const auto frameStart = TraceRecorder::Clock::now();
+  const UINT64 frameAllocationStart = AllocationCounter::getAllocationCount();
 
   // initial request of data from sim to retrieve all requests which have
   // periodic updates enabled. This includes the base sim data for pause detection.
   // Other data without periodic updates are requested either in the data manager or
   // in the modules.
-  dataManager.getRequestedData();
+  {
+    ProfileSample sample{frameProfiler, getRequestedDataScopeId};
+    dataManager.getRequestedData();
+  }
+
+  // also checked in pause so a stutter can be captured by pausing the sim right after it
+  traceRecorder.dumpOnTrigger(traceDumpTrigger->readFromSim());
 
   // Pause detection
   // In all pause states except active pause return immediately.
@@ -127,33 +156,52 @@ bool MsfsHandler::update(sGaugeDrawData* pData) {
   timeStamp = baseSimData->data().simulationTime;
   tickCounter++;
 
-  // Call preUpdate(), update() and postUpdate() for all modules
+  // Call preUpdate(), update() and postUpdate() for all modules due in this frame
   // Datamanager is always called first to ensure that all variables are updated before the modules
   // are called.
+  moduleScheduler.beginFrame(timeStamp, pData);
 
   // PRE UPDATE
   bool result = true;
-  result &= dataManager.preUpdate(pData);
-  result &= std::all_of(modules.begin(), modules.end(), [&pData](Module* pModule) { return pModule->preUpdate(pData); });
+  UINT64 dataManagerAllocationStart = AllocationCounter::getAllocationCount();
+  {
+    ProfileSample sample{frameProfiler, dataManagerPreUpdateScopeId};
+    result &= dataManager.preUpdate(pData);
+  }
+  lastDataManagerAllocationCount = AllocationCounter::getAllocationCount() - dataManagerAllocationStart;
+  result &= moduleScheduler.preUpdate();
 
   // UPDATE
-  result &= dataManager.update(pData);
-  result &= std::all_of(modules.begin(), modules.end(), [&pData](Module* pModule) { return pModule->update(pData); });
+  {
+    ProfileSample sample{frameProfiler, dataManagerUpdateScopeId};
+    result &= dataManager.update(pData);
+  }
+  result &= moduleScheduler.update();
 
   // POST UPDATE
-  result &= dataManager.postUpdate(pData);
-  result &= std::all_of(modules.begin(), modules.end(), [&pData](Module* pModule) { return pModule->postUpdate(pData); });
+  dataManagerAllocationStart = AllocationCounter::getAllocationCount();
+  {
+    ProfileSample sample{frameProfiler, dataManagerPostUpdateScopeId};
+    result &= dataManager.postUpdate(pData);
+  }
+  lastDataManagerAllocationCount += AllocationCounter::getAllocationCount() - dataManagerAllocationStart;
+  result &= moduleScheduler.postUpdate();
+
+  moduleScheduler.endFrame();
+  recordFrameAllocations(frameAllocationStart);
 
   if (!result) {
     LOG_ERROR(simConnectName + ": MsfsHandler::update() - failed");
   }
 
+  frameProfiler.record(FrameProfiler::ROOT_SCOPE, frameStart, TraceRecorder::Clock::now());
+  if (tickCounter % FRAME_PROFILE_WINDOW_TICKS == 0) {
 #ifdef PROFILING
-  profiler.stop();
-  if (tickCounter % 120 == 0) {
-    profiler.print();
-  }
+    LOG_INFO(simConnectName + ": " + frameProfiler.str());
+    moduleScheduler.printStatistics();
 #endif
+    exportFrameProfile();
+  }
 
   return result;
 }
@@ -161,6 +209,8 @@ bool MsfsHandler::update(sGaugeDrawData* pData) {
 bool MsfsHandler::shutdown() {
   bool result = std::all_of(modules.begin(), modules.end(), [](Module* pModule) { return pModule->shutdown(); });
   result &= dataManager.shutdown();
+  moduleScheduler.printStatistics();
+  moduleScheduler.clear();
   modules.clear();
   unregister_key_event_handler_EX1(reinterpret_cast<GAUGE_KEY_EVENT_HANDLER_EX1>(keyEventHandlerEx1), nullptr);
   unregister_all_named_vars();
@@ -174,3 +224,37 @@ bool MsfsHandler::getAircraftIsReadyVar() const {
 FLOAT64 MsfsHandler::getAircraftDevelopmentStateVar() const {
   return baseSimData->data().aircraftDevelopmentState;
 }
+
+// =================================================================================================
+// PRIVATE METHODS
+// =================================================================================================
+
+void MsfsHandler::recordFrameAllocations(UINT64 frameAllocationStart) {
+  lastFrameAllocationCount = AllocationCounter::getAllocationCount() - frameAllocationStart;
+  if (lastFrameAllocationCount == 0 || tickCounter <= ALLOCATION_WARMUP_TICKS) {
+    return;
+  }
+  allocatingFrameCount++;
+  // report the first allocating frame and then every 600th - logging allocates itself
+  if (allocatingFrameCount % 600 == 1) {
+    LOG_WARN(simConnectName + ": Frame " + std::to_string(tickCounter) + " allocated " + std::to_string(lastFrameAllocationCount) +
+             " times (DataManager: " + std::to_string(lastDataManagerAllocationCount) + ") - " + std::to_string(allocatingFrameCount) +
+             " allocating frames after warm-up");
+    moduleScheduler.printStatistics();
+  }
+}
+
+void MsfsHandler::exportFrameProfile() {
+  if (frameProfileExport) {
+    frameProfiler.exportTo(frameProfileExport->data(), tickCounter);
+    frameProfileExport->writeDataToSim();
+  }
+
+  const LatencyHistogram& frameHistogram = frameProfiler.getHistogram(FrameProfiler::ROOT_SCOPE);
+  frameTimeP50->setAndWriteToSim(static_cast<FLOAT64>(frameHistogram.getPercentile(50.0)) / 1000.0);
+  frameTimeP99->setAndWriteToSim(static_cast<FLOAT64>(frameHistogram.getPercentile(99.0)) / 1000.0);
+  frameTimeP999->setAndWriteToSim(static_cast<FLOAT64>(frameHistogram.getPercentile(99.9)) / 1000.0);
+  frameTimeMax->setAndWriteToSim(static_cast<FLOAT64>(frameHistogram.getMaximum()) / 1000.0);
+
+  frameProfiler.reset();
+}
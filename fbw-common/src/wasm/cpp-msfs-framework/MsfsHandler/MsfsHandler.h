@@ -12,7 +12,9 @@
 #include <vector>
 
 #include "DataManager.h"
-#include "SimpleProfiler.hpp"
+#include "FrameProfiler.hpp"
+#include "ModuleScheduler.h"
+#include "TraceRecorder.hpp"
 
 class Module;
 
@@ -37,6 +39,31 @@ class MsfsHandler {
    */
   std::vector<Module*> modules{};
 
+  /**
+   * Always-on trace of the frame loop - the frame profiler records its samples as trace events.
+   * Changing the LVAR TRACE_DUMP (e.g. incrementing it) writes the trace of the last seconds to
+   * the work folder.
+   */
+  TraceRecorder traceRecorder;
+  NamedVariablePtr traceDumpTrigger;
+
+  /**
+   * Always-on profiler of the frame loop with the scopes of the data manager and of all modules and
+   * their phases (see ModuleScheduler). Declared before the scheduler as the scheduler adds its
+   * scopes to it.
+   */
+  FrameProfiler frameProfiler{"MsfsHandler::update()"};
+  ProfileScopeId getRequestedDataScopeId;
+  ProfileScopeId dataManagerPreUpdateScopeId;
+  ProfileScopeId dataManagerUpdateScopeId;
+  ProfileScopeId dataManagerPostUpdateScopeId;
+
+  /**
+   * The scheduler decides which modules are due in a frame based on their update rate and the
+   * low priority frame budget and calls their update methods.
+   */
+  ModuleScheduler moduleScheduler;
+
   /**
    * The data manager is responsible for managing all variables and events.
    * It is used to register variables and events and to update them.
@@ -97,11 +124,25 @@ class MsfsHandler {
   // Callback function for register_key_event_handler_EX1
   GAUGE_KEY_EVENT_HANDLER_EX1 keyEventHandlerEx1 = nullptr;
 
-  // Allows immediate view on runtime performance issue. Add additional instances into
-  // Modules while developing and profiling a module's performance.
-#ifdef PROFILING
-  SimpleProfiler profiler{"MsfsHandler::update()", 120};
-#endif
+  // The frame profiler statistics are exported and reset every FRAME_PROFILE_WINDOW_TICKS ticks:
+  // the statistics of all scopes to the client data area <simConnectName>_FRAME_PROFILE and the
+  // statistics of the complete frame to the LVARs FRAME_TIME_<SIMCONNECT NAME>_P50/P99/P999/MAX
+  // in microseconds. With PROFILING the statistics are logged as well. frameProfileExport is null
+  // if its client data area could not be allocated.
+  static constexpr UINT64 FRAME_PROFILE_WINDOW_TICKS = 600;
+  ClientDataAreaVariablePtr<FrameProfileExport> frameProfileExport;
+  NamedVariablePtr frameTimeP50;
+  NamedVariablePtr frameTimeP99;
+  NamedVariablePtr frameTimeP999;
+  NamedVariablePtr frameTimeMax;
+
+  // Heap allocations of the frame loop - only counted with ALLOCATION_TRACKING (see AllocationCounter).
+  // Frames within the warm-up are not counted as allocating frames as variables and buffers are
+  // often created lazily in the first updates.
+  static constexpr UINT64 ALLOCATION_WARMUP_TICKS = 600;
+  UINT64 lastFrameAllocationCount = 0;
+  UINT64 lastDataManagerAllocationCount = 0;
+  UINT64 allocatingFrameCount = 0;
 
  public:
   /**
@@ -110,8 +151,17 @@ class MsfsHandler {
    * @param aircraftPrefix string containing the prefix for all named variables (LVARs).
    *                       E.g. "A32NX_" for the A32NX aircraft or "A380X_" for the A380X aircraft.
    */
-  explicit MsfsHandler(std::string&& name, const std::string& aircraftPrefix) : dataManager(this), simConnectName(std::move(name)) {
+  explicit MsfsHandler(std::string&& name, const std::string& aircraftPrefix)
+      : traceRecorder(name),
+        getRequestedDataScopeId(frameProfiler.addScope("DataManager::getRequestedData()")),
+        dataManagerPreUpdateScopeId(frameProfiler.addScope("DataManager::preUpdate()")),
+        dataManagerUpdateScopeId(frameProfiler.addScope("DataManager::update()")),
+        dataManagerPostUpdateScopeId(frameProfiler.addScope("DataManager::postUpdate()")),
+        moduleScheduler(frameProfiler),
+        dataManager(this),
+        simConnectName(std::move(name)) {
     LOG_INFO("Creating MsfsHandler instance with Simconnect name " + simConnectName + " and aircraft prefix " + aircraftPrefix);
+    frameProfiler.setTraceRecorder(&traceRecorder);
     NamedVariable::setAircraftPrefix(aircraftPrefix);
   }
 
@@ -124,7 +174,8 @@ class MsfsHandler {
   bool initialize();
 
   /**
-   * Calls the preUpdate, update, postUpdate method of the DataManager and all modules.
+   * Calls the preUpdate, update, postUpdate method of the DataManager and all modules which are
+   * due in this frame (see ModuleScheduler).
    * Is called by the gauge handler when the PANEL_SERVICE_PRE_DRAW event is received.
    * @param pData pointer to the sGaugeDrawData struct.
    * @return true if the update was successful, false otherwise.
@@ -152,6 +203,21 @@ class MsfsHandler {
    */
   DataManager& getDataManager() { return dataManager; }
 
+  /**
+   * @return a modifiable reference to the module scheduler.
+   */
+  ModuleScheduler& getModuleScheduler() { return moduleScheduler; }
+
+  /**
+   * @return a modifiable reference to the frame profiler, e.g. to add scopes for parts of a module.
+   */
+  FrameProfiler& getFrameProfiler() { return frameProfiler; }
+
+  /**
+   * @return a modifiable reference to the trace recorder, e.g. to add trace scopes for parts of a module.
+   */
+  TraceRecorder& getTraceRecorder() { return traceRecorder; }
+
   /**
    * @return value of LVAR A32NX_IS_READY
    */
@@ -172,6 +238,31 @@ class MsfsHandler {
    * @return the current tick counter
    */
   [[nodiscard]] UINT64 getTickCounter() const { return tickCounter; }
+
+  /**
+   * @return the number of heap allocations in the last frame (only counted with ALLOCATION_TRACKING)
+   */
+  [[nodiscard]] UINT64 getLastFrameAllocationCount() const { return lastFrameAllocationCount; }
+
+  /**
+   * @return the number of frames after the warm-up which allocated on the heap (only counted with
+   *         ALLOCATION_TRACKING)
+   */
+  [[nodiscard]] UINT64 getAllocatingFrameCount() const { return allocatingFrameCount; }
+
+ private:
+  /**
+   * Records the heap allocations of the frame and logs a warning when a frame after the warm-up
+   * allocated, including the module statistics which show the allocating modules.
+   * @param frameAllocationStart the allocation count at the start of the frame
+   */
+  void recordFrameAllocations(UINT64 frameAllocationStart);
+
+  /**
+   * Exports the frame profiler statistics to the client data area and the LVARs and resets them
+   * for the next window.
+   */
+  void exportFrameProfile();
 };
 
 #endif  // FLYBYWIRE_MSFSHANDLER_H
@@ -0,0 +1,83 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#include "AllocationCounter.h"
+
+#ifdef ALLOCATION_TRACKING
+
+#include <cstdlib>
+#include <new>
+
+// Replacements of the global operator new and delete which count all heap allocations of the
+// module. The size of each allocation is stored in a header in front of the returned memory so the
+// number of live bytes can be tracked with the unsized operator delete as well. Over-aligned
+// allocations use the default operators and are not counted.
+
+namespace {
+constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* countedAllocate(std::size_t size) noexcept {
+  auto* block = static_cast<std::byte*>(std::malloc(size + HEADER_SIZE));
+  if (block == nullptr) {
+    return nullptr;
+  }
+  *reinterpret_cast<std::size_t*>(block) = size;
+  AllocationCounter::recordAllocation(size);
+  return block + HEADER_SIZE;
+}
+
+void countedDeallocate(void* pointer) noexcept {
+  if (pointer == nullptr) {
+    return;
+  }
+  std::byte* block = static_cast<std::byte*>(pointer) - HEADER_SIZE;
+  AllocationCounter::recordDeallocation(*reinterpret_cast<std::size_t*>(block));
+  std::free(block);
+}
+}  // namespace
+
+void* operator new(std::size_t size) {
+  void* pointer = countedAllocate(size);
+  if (pointer == nullptr) {
+    std::abort();  // the modules are compiled without exceptions
+  }
+  return pointer;
+}
+
+void* operator new[](std::size_t size) {
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return countedAllocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return countedAllocate(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  countedDeallocate(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  countedDeallocate(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+  countedDeallocate(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+  countedDeallocate(pointer);
+}
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept {
+  countedDeallocate(pointer);
+}
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept {
+  countedDeallocate(pointer);
+}
+
+#endif  // ALLOCATION_TRACKING
@@ -0,0 +1,81 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_ALLOCATIONCOUNTER_H
+#define FLYBYWIRE_AIRCRAFT_ALLOCATIONCOUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Counts the heap allocations of the whole WASM module.
+ *
+ * With the compile definition ALLOCATION_TRACKING the global operator new and delete are replaced
+ * (see AllocationCounter.cpp) and every heap allocation is counted. This is used by the MsfsHandler
+ * and the ModuleScheduler to report the allocations per frame and per module so allocations in the
+ * steady-state frame loop are found.<p/>
+ *
+ * Without ALLOCATION_TRACKING all counters stay 0 and there is no overhead.<p/>
+ *
+ * The counters are not thread-safe - the MSFS WASM modules are single-threaded.
+ */
+class AllocationCounter {
+ private:
+  static inline uint64_t allocationCount = 0;
+  static inline uint64_t deallocationCount = 0;
+  static inline uint64_t allocatedBytes = 0;
+  static inline uint64_t liveBytes = 0;
+
+ public:
+  /**
+   * @return true if allocations are counted (compiled with ALLOCATION_TRACKING), false otherwise
+   */
+  [[nodiscard]] static constexpr bool isEnabled() {
+#ifdef ALLOCATION_TRACKING
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @return the number of heap allocations since the start of the module
+   */
+  [[nodiscard]] static uint64_t getAllocationCount() { return allocationCount; }
+
+  /**
+   * @return the number of heap deallocations since the start of the module
+   */
+  [[nodiscard]] static uint64_t getDeallocationCount() { return deallocationCount; }
+
+  /**
+   * @return the number of bytes allocated since the start of the module
+   */
+  [[nodiscard]] static uint64_t getAllocatedBytes() { return allocatedBytes; }
+
+  /**
+   * @return the number of bytes currently allocated
+   */
+  [[nodiscard]] static uint64_t getLiveBytes() { return liveBytes; }
+
+  /**
+   * Records an allocation. Called by the replaced operator new.
+   * @param size the size of the allocation in bytes
+   */
+  static void recordAllocation(std::size_t size) {
+    allocationCount++;
+    allocatedBytes += size;
+    liveBytes += size;
+  }
+
+  /**
+   * Records a deallocation. Called by the replaced operator delete.
+   * @param size the size of the allocation in bytes
+   */
+  static void recordDeallocation(std::size_t size) {
+    deallocationCount++;
+    liveBytes -= size;
+  }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_ALLOCATIONCOUNTER_H
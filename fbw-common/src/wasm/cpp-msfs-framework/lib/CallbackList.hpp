@@ -0,0 +1,145 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_CALLBACKLIST_HPP
+#define FLYBYWIRE_AIRCRAFT_CALLBACKLIST_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "InplaceFunction.hpp"
+
+/**
+ * @brief List of callbacks with the same signature which are identified by an ID.
+ * @tparam Signature The callbacks' signature - the return type must be void
+ */
+template <typename Signature>
+class CallbackList;
+
+/**
+ * @brief List of callbacks with the same signature which are identified by an ID.
+ *
+ * The callbacks are stored as InplaceFunction in a contiguous vector in the order they were added.
+ * Calling the list does not allocate and only iterates over the vector.<p/>
+ *
+ * Callbacks may add or remove callbacks of the same list while the list is called. Added callbacks
+ * are not called in the current call and removed callbacks are only marked as removed and
+ * destroyed after the call, so a callback can safely remove itself.
+ *
+ * @tparam Params The callbacks' parameters as a variadic list
+ */
+template <typename... Params>
+class CallbackList<void(Params...)> {
+ public:
+  using Function = InplaceFunction<void(Params...)>;
+
+ private:
+  struct Entry {
+    uint64_t id;
+    Function function;
+    bool isRemoved;
+  };
+
+  std::vector<Entry> entries{};
+
+  // the number of entries which have not been removed
+  std::size_t size = 0;
+
+  // the number of nested calls of the list - entries are only erased when this is 0
+  std::size_t callDepth = 0;
+
+  // flag to indicate that entries have been marked as removed during a call
+  bool hasRemovedEntries = false;
+
+  // callbacks added during a call - appended to the entries after the call
+  std::vector<Entry> addedEntries{};
+
+ public:
+  /**
+   * Adds a callback to the list.
+   * @param id the ID of the callback - must be unique within the list
+   * @param function the callback
+   */
+  void add(uint64_t id, const Function& function) {
+    if (callDepth > 0) {
+      addedEntries.push_back({id, function, false});
+    } else {
+      entries.push_back({id, function, false});
+    }
+    size++;
+  }
+
+  /**
+   * Removes the callback with the given ID from the list.
+   * @param id the ID of the callback
+   * @return true if the callback was found and removed, false otherwise
+   */
+  bool remove(uint64_t id) {
+    const auto matches = [id](const Entry& entry) { return entry.id == id && !entry.isRemoved; };
+    if (auto it = std::find_if(entries.begin(), entries.end(), matches); it != entries.end()) {
+      if (callDepth > 0) {
+        it->isRemoved = true;
+        hasRemovedEntries = true;
+      } else {
+        entries.erase(it);
+      }
+      size--;
+      return true;
+    }
+    if (auto it = std::find_if(addedEntries.begin(), addedEntries.end(), matches); it != addedEntries.end()) {
+      addedEntries.erase(it);
+      size--;
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * Calls all callbacks in the order they were added.
+   * @param params the parameters to pass to the callbacks
+   */
+  void operator()(Params... params) {
+    callDepth++;
+    // the entries vector does not change during the call as additions are deferred
+    for (const Entry& entry : entries) {
+      if (!entry.isRemoved) {
+        entry.function(params...);
+      }
+    }
+    callDepth--;
+    if (callDepth == 0) {
+      if (hasRemovedEntries) {
+        std::erase_if(entries, [](const Entry& entry) { return entry.isRemoved; });
+        hasRemovedEntries = false;
+      }
+      if (!addedEntries.empty()) {
+        std::move(addedEntries.begin(), addedEntries.end(), std::back_inserter(entries));
+        addedEntries.clear();
+      }
+    }
+  }
+
+  /**
+   * Removes all callbacks. Must not be called while the list is called.
+   */
+  void clear() {
+    entries.clear();
+    addedEntries.clear();
+    size = 0;
+    hasRemovedEntries = false;
+  }
+
+  /**
+   * @return the number of callbacks in the list
+   */
+  [[nodiscard]] std::size_t getSize() const { return size; }
+
+  /**
+   * @return true if there are no callbacks in the list, false otherwise
+   */
+  [[nodiscard]] bool isEmpty() const { return size == 0; }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_CALLBACKLIST_HPP
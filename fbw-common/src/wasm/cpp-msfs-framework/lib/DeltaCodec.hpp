@@ -0,0 +1,344 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_DELTACODEC_HPP
+#define FLYBYWIRE_AIRCRAFT_DELTACODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/**
+ * @brief Header of a delta patch as written by the DeltaEncoder.<p/>
+ *
+ * A patch consists of this header followed by rangeCount ranges. Each range is a DeltaRangeHeader
+ * followed by the length bytes to copy to the offset in the image.
+ */
+struct DeltaPatchHeader {
+  // incremented for each patch - used by the decoder to detect lost patches
+  std::uint32_t sequence;
+  // the number of ranges following the header
+  std::uint16_t rangeCount;
+  // DeltaPatchHeader::KEYFRAME if the patch contains the complete image
+  std::uint16_t flags;
+
+  static constexpr std::uint16_t KEYFRAME = 1;
+};
+
+/**
+ * @brief Header of a range of changed bytes within a delta patch.
+ */
+struct DeltaRangeHeader {
+  std::uint16_t offset;
+  std::uint16_t length;
+};
+
+/**
+ * @brief Encodes the changes of a fixed size image (e.g. a data struct) since the last encoded image
+ * as a patch of changed byte ranges.<p/>
+ *
+ * Changed bytes which are at most mergeGap bytes apart are sent as one range, as a range header
+ * costs as much as a few unchanged bytes. If the patch would be larger than the complete image a
+ * keyframe with the complete image is encoded instead. Keyframes are also encoded for the first
+ * image, when requested and periodically so receivers which joined late or lost a patch can
+ * synchronize again. Periodic keyframes are counted in calls of encode() and are also encoded if
+ * the image has not changed, otherwise a receiver would never synchronize while the image is
+ * constant.<p/>
+ *
+ * Encoding does not allocate - the buffers are allocated in the constructor.
+ */
+class DeltaEncoder {
+ private:
+  std::size_t imageSize;
+  std::size_t mergeGap;
+
+  // the last encoded image and the current patch
+  std::vector<std::byte> lastImage;
+  std::vector<std::byte> patch;
+  std::size_t patchSize = 0;
+
+  std::uint32_t sequence = 0;
+  bool isKeyframeRequested = true;
+
+  // the number of calls of encode() after which a keyframe is encoded - 0 for no periodic keyframes
+  std::uint64_t keyframeInterval;
+  std::uint64_t encodesSinceKeyframe = 0;
+
+  // statistics
+  std::uint64_t encodeCount = 0;
+  std::uint64_t unchangedCount = 0;
+  std::uint64_t keyframeCount = 0;
+  std::uint64_t patchBytes = 0;
+
+ public:
+  /**
+   * @param imageSize the size of the image in bytes - must be < 65536
+   * @return the size of the largest patch (a keyframe) for an image of the given size
+   */
+  static constexpr std::size_t getMaxPatchSize(std::size_t imageSize) {
+    return sizeof(DeltaPatchHeader) + sizeof(DeltaRangeHeader) + imageSize;
+  }
+
+  /**
+   * Creates an encoder for images of the given size.
+   * @param imageSize the size of the image in bytes - must be < 65536
+   * @param keyframeInterval the number of calls of encode() after which a keyframe is encoded - 0 for no periodic keyframes
+   * @param mergeGap the maximum number of unchanged bytes between two changed bytes of the same range
+   */
+  explicit DeltaEncoder(std::size_t imageSize, std::uint64_t keyframeInterval = 60, std::size_t mergeGap = sizeof(DeltaRangeHeader))
+      : imageSize(imageSize),
+        mergeGap(mergeGap),
+        lastImage(imageSize),
+        patch(getMaxPatchSize(imageSize)),
+        keyframeInterval(keyframeInterval) {}
+
+  /**
+   * Encodes the changes of the image since the last call as a patch.
+   * @param image pointer to the image - must be imageSize bytes
+   * @return the size of the patch in bytes, 0 if the image has not changed and nothing needs to be sent
+   */
+  std::size_t encode(const void* image) {
+    const auto* bytes = static_cast<const std::byte*>(image);
+    encodeCount++;
+    encodesSinceKeyframe++;
+
+    const bool isKeyframeDue = isKeyframeRequested || (keyframeInterval > 0 && encodesSinceKeyframe >= keyframeInterval);
+    if (isKeyframeDue || !encodeRanges(bytes)) {
+      encodeKeyframe(bytes);
+    } else if (patchSize == 0) {
+      unchangedCount++;
+      return 0;
+    }
+
+    std::memcpy(lastImage.data(), bytes, imageSize);
+    patchBytes += patchSize;
+    return patchSize;
+  }
+
+  /**
+   * Requests a keyframe for the next call of encode().
+   */
+  void requestKeyframe() { isKeyframeRequested = true; }
+
+  /**
+   * @return pointer to the patch encoded by the last call of encode() - the buffer is
+   * getMaxPatchSize(imageSize) bytes large
+   */
+  [[nodiscard]] const std::byte* getPatch() const { return patch.data(); }
+
+  /**
+   * @return the size of the image in bytes
+   */
+  [[nodiscard]] std::size_t getImageSize() const { return imageSize; }
+
+  /**
+   * @return the number of calls of encode()
+   */
+  [[nodiscard]] std::uint64_t getEncodeCount() const { return encodeCount; }
+
+  /**
+   * @return the number of calls of encode() with an unchanged image
+   */
+  [[nodiscard]] std::uint64_t getUnchangedCount() const { return unchangedCount; }
+
+  /**
+   * @return the number of keyframes encoded
+   */
+  [[nodiscard]] std::uint64_t getKeyframeCount() const { return keyframeCount; }
+
+  /**
+   * @return the number of bytes of all encoded patches
+   */
+  [[nodiscard]] std::uint64_t getPatchBytes() const { return patchBytes; }
+
+  /**
+   * @return the number of bytes which would have been sent without delta encoding
+   */
+  [[nodiscard]] std::uint64_t getImageBytes() const { return encodeCount * imageSize; }
+
+ private:
+  /**
+   * Encodes the changed ranges of the image into the patch.
+   * @return false if the patch would be larger than a keyframe, true otherwise
+   */
+  bool encodeRanges(const std::byte* image) {
+    patchSize = sizeof(DeltaPatchHeader);
+    std::uint16_t rangeCount = 0;
+    std::size_t index = 0;
+    while (index < imageSize) {
+      if (image[index] == lastImage[index]) {
+        index++;
+        continue;
+      }
+      // extend the range until more than mergeGap bytes are unchanged
+      const std::size_t start = index;
+      std::size_t end = index + 1;
+      for (index = end; index < imageSize && index - end <= mergeGap; index++) {
+        if (image[index] != lastImage[index]) {
+          end = index + 1;
+        }
+      }
+      const std::size_t length = end - start;
+      // a patch as large as a keyframe has no benefit
+      if (patchSize + sizeof(DeltaRangeHeader) + length >= patch.size()) {
+        return false;
+      }
+      writeRange(start, length, image);
+      rangeCount++;
+      index = end;
+    }
+    if (rangeCount == 0) {
+      patchSize = 0;
+      return true;
+    }
+    writeHeader(rangeCount, 0);
+    return true;
+  }
+
+  void encodeKeyframe(const std::byte* image) {
+    patchSize = sizeof(DeltaPatchHeader);
+    writeRange(0, imageSize, image);
+    writeHeader(1, DeltaPatchHeader::KEYFRAME);
+    isKeyframeRequested = false;
+    encodesSinceKeyframe = 0;
+    keyframeCount++;
+  }
+
+  void writeRange(std::size_t offset, std::size_t length, const std::byte* image) {
+    const DeltaRangeHeader rangeHeader{static_cast<std::uint16_t>(offset), static_cast<std::uint16_t>(length)};
+    std::memcpy(patch.data() + patchSize, &rangeHeader, sizeof(rangeHeader));
+    std::memcpy(patch.data() + patchSize + sizeof(rangeHeader), image + offset, length);
+    patchSize += sizeof(rangeHeader) + length;
+  }
+
+  void writeHeader(std::uint16_t rangeCount, std::uint16_t flags) {
+    const DeltaPatchHeader header{++sequence, rangeCount, flags};
+    std::memcpy(patch.data(), &header, sizeof(header));
+  }
+};
+
+/**
+ * @brief Applies patches encoded by a DeltaEncoder to an image in place.<p/>
+ *
+ * The decoder tracks the sequence of the patches. If a patch is lost the image is out of date and
+ * further patches are dropped until the next keyframe. A patch which is received again (e.g. when
+ * the data is requested once more) is ignored.
+ */
+class DeltaDecoder {
+ private:
+  std::size_t imageSize;
+
+  std::uint32_t lastSequence = 0;
+  bool synchronized = false;
+
+  // statistics
+  std::uint64_t appliedCount = 0;
+  std::uint64_t droppedCount = 0;
+  std::uint64_t keyframeCount = 0;
+  std::uint64_t patchBytes = 0;
+
+ public:
+  /**
+   * Creates a decoder for images of the given size.
+   * @param imageSize the size of the image in bytes - must be < 65536
+   */
+  explicit DeltaDecoder(std::size_t imageSize) : imageSize(imageSize) {}
+
+  /**
+   * Applies a patch to the image.
+   * @param patch pointer to the patch - must be at least DeltaEncoder::getMaxPatchSize(imageSize) bytes
+   * @param image pointer to the image - must be imageSize bytes
+   * @return true if the image has changed, false otherwise
+   */
+  bool apply(const void* patch, void* image) {
+    const auto* bytes = static_cast<const std::byte*>(patch);
+    DeltaPatchHeader header{};
+    std::memcpy(&header, bytes, sizeof(header));
+
+    const bool isKeyframe = (header.flags & DeltaPatchHeader::KEYFRAME) != 0;
+    if (synchronized && header.sequence == lastSequence) {
+      return false;
+    }
+    if (!isKeyframe && (!synchronized || header.sequence != lastSequence + 1)) {
+      synchronized = false;
+      droppedCount++;
+      return false;
+    }
+    if (!isValid(bytes, header.rangeCount)) {
+      synchronized = false;
+      droppedCount++;
+      return false;
+    }
+
+    bool hasChanged = false;
+    std::size_t position = sizeof(DeltaPatchHeader);
+    for (std::uint16_t i = 0; i < header.rangeCount; i++) {
+      DeltaRangeHeader rangeHeader{};
+      std::memcpy(&rangeHeader, bytes + position, sizeof(rangeHeader));
+      position += sizeof(rangeHeader);
+      std::byte* target = static_cast<std::byte*>(image) + rangeHeader.offset;
+      if (std::memcmp(target, bytes + position, rangeHeader.length) != 0) {
+        std::memcpy(target, bytes + position, rangeHeader.length);
+        hasChanged = true;
+      }
+      position += rangeHeader.length;
+    }
+
+    lastSequence = header.sequence;
+    synchronized = true;
+    appliedCount++;
+    keyframeCount += isKeyframe ? 1 : 0;
+    patchBytes += position;
+    return hasChanged;
+  }
+
+  /**
+   * @return true if the image is up to date with the last received patch, false if a patch has been
+   * lost and the decoder waits for the next keyframe
+   */
+  [[nodiscard]] bool isSynchronized() const { return synchronized; }
+
+  /**
+   * @return the number of patches applied
+   */
+  [[nodiscard]] std::uint64_t getAppliedCount() const { return appliedCount; }
+
+  /**
+   * @return the number of patches dropped because a previous patch has been lost or the patch is invalid
+   */
+  [[nodiscard]] std::uint64_t getDroppedCount() const { return droppedCount; }
+
+  /**
+   * @return the number of keyframes applied
+   */
+  [[nodiscard]] std::uint64_t getKeyframeCount() const { return keyframeCount; }
+
+  /**
+   * @return the number of bytes of all applied patches
+   */
+  [[nodiscard]] std::uint64_t getPatchBytes() const { return patchBytes; }
+
+ private:
+  /**
+   * Checks that all ranges of the patch are within the patch buffer and the image.
+   */
+  [[nodiscard]] bool isValid(const std::byte* bytes, std::uint16_t rangeCount) const {
+    const std::size_t maxPatchSize = DeltaEncoder::getMaxPatchSize(imageSize);
+    std::size_t position = sizeof(DeltaPatchHeader);
+    for (std::uint16_t i = 0; i < rangeCount; i++) {
+      if (position + sizeof(DeltaRangeHeader) > maxPatchSize) {
+        return false;
+      }
+      DeltaRangeHeader rangeHeader{};
+      std::memcpy(&rangeHeader, bytes + position, sizeof(rangeHeader));
+      position += sizeof(rangeHeader) + rangeHeader.length;
+      if (std::size_t{rangeHeader.offset} + rangeHeader.length > imageSize || position > maxPatchSize) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_DELTACODEC_HPP
@@ -0,0 +1,260 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_FRAMEPROFILER_HPP
+#define FLYBYWIRE_AIRCRAFT_FRAMEPROFILER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "LatencyHistogram.hpp"
+#include "TraceRecorder.hpp"
+
+// Identifies a scope of the FrameProfiler
+using ProfileScopeId = std::size_t;
+
+/**
+ * @brief Export of the FrameProfiler statistics as a plain struct, e.g. for a client data area.
+ * All times are in microseconds.
+ */
+struct FrameProfileExport {
+  static constexpr std::size_t MAX_SCOPES = 32;
+  static constexpr std::size_t NAME_LENGTH = 32;
+
+  struct Scope {
+    char name[NAME_LENGTH];
+    // the index of the parent scope - the root scope is its own parent
+    std::uint32_t parent;
+    std::uint32_t count;
+    float p50;
+    float p99;
+    float p999;
+    float max;
+  };
+
+  // the tick counter at the end of the window the statistics were collected in
+  std::uint64_t tickCounter;
+  std::uint32_t scopeCount;
+  std::uint32_t reserved;
+  Scope scopes[MAX_SCOPES];
+};
+
+/**
+ * @brief Always-on profiler which records the time of hierarchical scopes (e.g. a frame, its
+ * stages and the modules within the stages) in LatencyHistograms.<p/>
+ *
+ * Scopes are added once during initialization. Recording a sample is a histogram update and does
+ * not allocate, so the profiler can run in production builds. The statistics (p50, p99, p99.9 and
+ * max) are reported per window: the owner calls str() or exportTo() at the end of a window and
+ * then reset().<p/>
+ *
+ * If a TraceRecorder is attached with setTraceRecorder() each sample recorded with a start and end
+ * time is also recorded as trace event. The trace name of a scope is qualified with the name of its
+ * parent scope (e.g. "Module 0::update()") unless the parent is the root scope.
+ *
+ * @usage
+ *   FrameProfiler profiler{"MyModule::update()"};<br/>
+ *   const ProfileScopeId stageId = profiler.addScope("stage");<br/>
+ *   { ProfileSample sample{profiler, stageId}; doStage(); }<br/>
+ */
+class FrameProfiler {
+ public:
+  static constexpr ProfileScopeId ROOT_SCOPE = 0;
+
+ private:
+  struct Scope {
+    std::string name;
+    ProfileScopeId parent;
+    std::size_t depth;
+    LatencyHistogram histogram;
+    TraceNameId traceNameId;
+  };
+
+  std::vector<Scope> scopes{};
+
+  // optional recorder the samples are also recorded in as trace events
+  TraceRecorder* traceRecorder = nullptr;
+
+ public:
+  /**
+   * Creates a profiler with a root scope.
+   * @param rootName the name of the root scope
+   */
+  explicit FrameProfiler(const std::string& rootName) { scopes.push_back({rootName, ROOT_SCOPE, 0, {}, 0}); }
+
+  FrameProfiler(const FrameProfiler&) = delete;             // no copy constructor
+  FrameProfiler& operator=(const FrameProfiler&) = delete;  // no copy assignment
+  FrameProfiler(FrameProfiler&&) = delete;                  // no move constructor
+  FrameProfiler& operator=(FrameProfiler&&) = delete;       // no move assignment
+  ~FrameProfiler() = default;
+
+  /**
+   * Adds a scope. Should only be called during initialization as it allocates.
+   * @param name the name of the scope
+   * @param parent the parent scope (default: the root scope)
+   * @return the ID of the scope to record samples with
+   */
+  ProfileScopeId addScope(const std::string& name, ProfileScopeId parent = ROOT_SCOPE) {
+    scopes.push_back({name, parent, scopes[parent].depth + 1, {}, 0});
+    const ProfileScopeId scopeId = scopes.size() - 1;
+    addTraceName(scopeId);
+    return scopeId;
+  }
+
+  /**
+   * Attaches a trace recorder which records the samples with a start and end time as trace events.
+   * Registers the trace names of all scopes, so it should only be called during initialization.
+   * @param recorder the recorder or nullptr to detach the recorder
+   */
+  void setTraceRecorder(TraceRecorder* recorder) {
+    traceRecorder = recorder;
+    for (ProfileScopeId scopeId = 0; scopeId < scopes.size(); scopeId++) {
+      addTraceName(scopeId);
+    }
+  }
+
+  /**
+   * Records a sample of a scope.
+   * @param scopeId the ID of the scope
+   * @param nanoseconds the time of the sample in nanoseconds
+   */
+  void record(ProfileScopeId scopeId, std::uint64_t nanoseconds) { scopes[scopeId].histogram.record(nanoseconds); }
+
+  /**
+   * Records a sample of a scope and the trace event of the sample if a trace recorder is attached.
+   * @param scopeId the ID of the scope
+   * @param start the time the sample started
+   * @param end the time the sample ended
+   */
+  void record(ProfileScopeId scopeId, TraceRecorder::Clock::time_point start, TraceRecorder::Clock::time_point end) {
+    record(scopeId, static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+    if (traceRecorder != nullptr) {
+      traceRecorder->record(scopes[scopeId].traceNameId, start, end);
+    }
+  }
+
+  /**
+   * Removes the samples of all scopes, e.g. at the start of a new window.
+   */
+  void reset() {
+    for (Scope& scope : scopes) {
+      scope.histogram.reset();
+    }
+  }
+
+  /**
+   * @param scopeId the ID of the scope
+   * @return the histogram of the scope
+   */
+  [[nodiscard]] const LatencyHistogram& getHistogram(ProfileScopeId scopeId) const { return scopes[scopeId].histogram; }
+
+  /**
+   * @param scopeId the ID of the scope
+   * @return the name of the scope
+   */
+  [[nodiscard]] const std::string& getName(ProfileScopeId scopeId) const { return scopes[scopeId].name; }
+
+  /**
+   * @return the number of scopes including the root scope
+   */
+  [[nodiscard]] std::size_t getScopeCount() const { return scopes.size(); }
+
+  /**
+   * Writes the statistics of the first FrameProfileExport::MAX_SCOPES scopes to the export struct.
+   * Does not allocate.
+   * @param exportData the struct to write to
+   * @param tickCounter the tick counter at the end of the window
+   */
+  void exportTo(FrameProfileExport& exportData, std::uint64_t tickCounter) const {
+    constexpr float NANOSECONDS_PER_MICROSECOND = 1000.0f;
+    exportData.tickCounter = tickCounter;
+    exportData.scopeCount = static_cast<std::uint32_t>((std::min)(scopes.size(), FrameProfileExport::MAX_SCOPES));
+    for (std::size_t i = 0; i < exportData.scopeCount; i++) {
+      const Scope& scope = scopes[i];
+      FrameProfileExport::Scope& exportScope = exportData.scopes[i];
+      std::memset(exportScope.name, 0, FrameProfileExport::NAME_LENGTH);
+      std::memcpy(exportScope.name, scope.name.c_str(), (std::min)(scope.name.size(), FrameProfileExport::NAME_LENGTH - 1));
+      exportScope.parent = static_cast<std::uint32_t>(scope.parent);
+      exportScope.count = static_cast<std::uint32_t>(scope.histogram.getCount());
+      exportScope.p50 = static_cast<float>(scope.histogram.getPercentile(50.0)) / NANOSECONDS_PER_MICROSECOND;
+      exportScope.p99 = static_cast<float>(scope.histogram.getPercentile(99.0)) / NANOSECONDS_PER_MICROSECOND;
+      exportScope.p999 = static_cast<float>(scope.histogram.getPercentile(99.9)) / NANOSECONDS_PER_MICROSECOND;
+      exportScope.max = static_cast<float>(scope.histogram.getMaximum()) / NANOSECONDS_PER_MICROSECOND;
+    }
+  }
+
+  /**
+   * @return a table of the statistics of all scopes in tree order with times in microseconds
+   */
+  [[nodiscard]] std::string str() const {
+    std::stringstream ss;
+    ss << "FrameProfiler (us):" << std::fixed << std::setprecision(1);
+    appendScope(ss, ROOT_SCOPE);
+    return ss.str();
+  }
+
+ private:
+  void addTraceName(ProfileScopeId scopeId) {
+    if (traceRecorder == nullptr) {
+      return;
+    }
+    Scope& scope = scopes[scopeId];
+    const bool isQualified = scopeId != ROOT_SCOPE && scope.parent != ROOT_SCOPE;
+    scope.traceNameId = traceRecorder->addName(isQualified ? scopes[scope.parent].name + "::" + scope.name : scope.name);
+  }
+
+  void appendScope(std::stringstream& ss, ProfileScopeId scopeId) const {
+    const Scope& scope = scopes[scopeId];
+    const LatencyHistogram& histogram = scope.histogram;
+    ss << "\n" << std::string(scope.depth * 2, ' ') << std::left << std::setw(static_cast<int>(40 - scope.depth * 2)) << scope.name
+       << std::right << " n=" << std::setw(7) << histogram.getCount()      //
+       << " p50=" << std::setw(9) << histogram.getPercentile(50.0) / 1000.0  //
+       << " p99=" << std::setw(9) << histogram.getPercentile(99.0) / 1000.0  //
+       << " p99.9=" << std::setw(9) << histogram.getPercentile(99.9) / 1000.0
+       << " max=" << std::setw(9) << histogram.getMaximum() / 1000.0;
+    for (ProfileScopeId childId = scopeId + 1; childId < scopes.size(); childId++) {
+      if (scopes[childId].parent == scopeId) {
+        appendScope(ss, childId);
+      }
+    }
+  }
+};
+
+/**
+ * @brief Records the time from its creation to its destruction as a sample of a FrameProfiler scope.
+ */
+class ProfileSample {
+  using Clock = TraceRecorder::Clock;
+
+ private:
+  FrameProfiler& profiler;
+  const ProfileScopeId scopeId;
+  const Clock::time_point start;
+
+ public:
+  /**
+   * Starts the sample.
+   * @param profiler the profiler to record the sample in
+   * @param scopeId the ID of the scope
+   */
+  ProfileSample(FrameProfiler& profiler, ProfileScopeId scopeId) : profiler(profiler), scopeId(scopeId), start(Clock::now()) {}
+
+  ProfileSample(const ProfileSample&) = delete;             // no copy constructor
+  ProfileSample& operator=(const ProfileSample&) = delete;  // no copy assignment
+  ProfileSample(ProfileSample&&) = delete;                  // no move constructor
+  ProfileSample& operator=(ProfileSample&&) = delete;       // no move assignment
+
+  /**
+   * Records the sample.
+   */
+  ~ProfileSample() { profiler.record(scopeId, start, Clock::now()); }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_FRAMEPROFILER_HPP
@@ -0,0 +1,146 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_INPLACEFUNCTION_HPP
+#define FLYBYWIRE_AIRCRAFT_INPLACEFUNCTION_HPP
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Default size of the buffer of an InplaceFunction - enough for a lambda capturing a handful of
+// pointers or shared pointers or for a std::function.
+constexpr std::size_t INPLACE_FUNCTION_DEFAULT_CAPACITY = 64;
+
+/**
+ * @brief Callable container which stores the callable in a fixed size buffer instead of the heap.
+ * @tparam Signature The callable's signature
+ * @tparam Capacity The size of the buffer in bytes
+ */
+template <typename Signature, std::size_t Capacity = INPLACE_FUNCTION_DEFAULT_CAPACITY>
+class InplaceFunction;
+
+/**
+ * @brief Callable container which stores the callable in a fixed size buffer instead of the heap.
+ *
+ * Behaves like std::function but never allocates. Callables which do not fit into the buffer are
+ * rejected at compile time so the cost of creating, copying and calling an InplaceFunction is
+ * always known. Copying an InplaceFunction copies the stored callable.
+ *
+ * @tparam Ret The callable's return type
+ * @tparam Params The callable's parameters as a variadic list
+ * @tparam Capacity The size of the buffer in bytes
+ */
+template <typename Ret, typename... Params, std::size_t Capacity>
+class InplaceFunction<Ret(Params...), Capacity> {
+ private:
+  /**
+   * The type specific operations on the stored callable.
+   */
+  struct Operations {
+    Ret (*invoke)(void* storage, Params... params);
+    void (*copy)(void* destination, const void* source);
+    void (*move)(void* destination, void* source);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename Callable>
+  static constexpr Operations OPERATIONS{
+      [](void* storage, Params... params) -> Ret { return (*static_cast<Callable*>(storage))(std::forward<Params>(params)...); },
+      [](void* destination, const void* source) { ::new (destination) Callable(*static_cast<const Callable*>(source)); },
+      [](void* destination, void* source) {
+        ::new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+        static_cast<Callable*>(source)->~Callable();
+      },
+      [](void* storage) { static_cast<Callable*>(storage)->~Callable(); }};
+
+  // mutable as calling the function must be possible on a const InplaceFunction like with std::function
+  alignas(std::max_align_t) mutable std::byte storage[Capacity];
+  const Operations* operations = nullptr;
+
+ public:
+  InplaceFunction() noexcept = default;
+  InplaceFunction(std::nullptr_t) noexcept {}  // NOLINT(google-explicit-constructor)
+
+  /**
+   * Creates an InplaceFunction storing a copy of the given callable.
+   * @param callable the callable to store - must fit into the buffer
+   */
+  template <typename Callable,
+            typename = std::enable_if_t<!std::is_same_v<std::decay_t<Callable>, InplaceFunction> &&
+                                        std::is_invocable_r_v<Ret, std::decay_t<Callable>&, Params...>>>
+  InplaceFunction(Callable&& callable) {  // NOLINT(google-explicit-constructor)
+    using StoredCallable = std::decay_t<Callable>;
+    static_assert(sizeof(StoredCallable) <= Capacity, "Callable does not fit into the InplaceFunction - capture less or increase the capacity");
+    static_assert(alignof(StoredCallable) <= alignof(std::max_align_t), "Callable is over-aligned for the InplaceFunction");
+    static_assert(std::is_copy_constructible_v<StoredCallable>, "Callable of an InplaceFunction must be copy constructible");
+    ::new (static_cast<void*>(storage)) StoredCallable(std::forward<Callable>(callable));
+    operations = &OPERATIONS<StoredCallable>;
+  }
+
+  InplaceFunction(const InplaceFunction& other) : operations(other.operations) {
+    if (operations != nullptr) {
+      operations->copy(storage, other.storage);
+    }
+  }
+
+  InplaceFunction(InplaceFunction&& other) noexcept : operations(other.operations) {
+    if (operations != nullptr) {
+      operations->move(storage, other.storage);
+      other.operations = nullptr;
+    }
+  }
+
+  InplaceFunction& operator=(const InplaceFunction& other) {
+    if (this != &other) {
+      reset();
+      if (other.operations != nullptr) {
+        other.operations->copy(storage, other.storage);
+        operations = other.operations;
+      }
+    }
+    return *this;
+  }
+
+  InplaceFunction& operator=(InplaceFunction&& other) noexcept {
+    if (this != &other) {
+      reset();
+      if (other.operations != nullptr) {
+        other.operations->move(storage, other.storage);
+        operations = other.operations;
+        other.operations = nullptr;
+      }
+    }
+    return *this;
+  }
+
+  InplaceFunction& operator=(std::nullptr_t) noexcept {
+    reset();
+    return *this;
+  }
+
+  ~InplaceFunction() { reset(); }
+
+  /**
+   * Calls the stored callable. Must not be called on an empty InplaceFunction.
+   * @param params the parameters to pass to the callable
+   * @return the result of the callable
+   */
+  Ret operator()(Params... params) const { return operations->invoke(storage, std::forward<Params>(params)...); }
+
+  /**
+   * @return true if a callable is stored, false otherwise
+   */
+  explicit operator bool() const noexcept { return operations != nullptr; }
+
+ private:
+  void reset() noexcept {
+    if (operations != nullptr) {
+      operations->destroy(storage);
+      operations = nullptr;
+    }
+  }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_INPLACEFUNCTION_HPP
@@ -0,0 +1,128 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_LATENCYHISTOGRAM_HPP
+#define FLYBYWIRE_AIRCRAFT_LATENCYHISTOGRAM_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+/**
+ * @brief Fixed size log-linear histogram of durations in nanoseconds (HDR histogram style).<p/>
+ *
+ * Each power of two range is divided into 2^SUB_BUCKET_BITS linear sub-buckets, so every recorded
+ * value is stored with a relative error of at most 1 / 2^SUB_BUCKET_BITS (~3%) independent of its
+ * magnitude. Values up to MAX_VALUE (~4.3 seconds) are recorded, larger values are clamped.<p/>
+ *
+ * Recording is a few integer operations and never allocates. Percentiles are calculated by one
+ * pass over the buckets without copying or sorting samples.
+ */
+class LatencyHistogram {
+ public:
+  static constexpr std::uint32_t SUB_BUCKET_BITS = 5;
+  static constexpr std::uint32_t VALUE_BITS = 32;
+  static constexpr std::uint64_t MAX_VALUE = (std::uint64_t{1} << VALUE_BITS) - 1;
+
+ private:
+  static constexpr std::uint64_t SUB_BUCKET_COUNT = std::uint64_t{1} << SUB_BUCKET_BITS;
+  static constexpr std::size_t BUCKET_COUNT = (VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+  std::array<std::uint32_t, BUCKET_COUNT> buckets{};
+  std::uint64_t count = 0;
+  std::uint64_t sum = 0;
+  std::uint64_t minimum = std::numeric_limits<std::uint64_t>::max();
+  std::uint64_t maximum = 0;
+
+ public:
+  /**
+   * Records a value.
+   * @param nanoseconds the value in nanoseconds - values larger than MAX_VALUE are clamped
+   */
+  void record(std::uint64_t nanoseconds) {
+    const std::uint64_t value = (std::min)(nanoseconds, MAX_VALUE);
+    buckets[getBucketIndex(value)]++;
+    count++;
+    sum += value;
+    minimum = (std::min)(minimum, value);
+    maximum = (std::max)(maximum, value);
+  }
+
+  /**
+   * Removes all recorded values.
+   */
+  void reset() {
+    buckets.fill(0);
+    count = 0;
+    sum = 0;
+    minimum = std::numeric_limits<std::uint64_t>::max();
+    maximum = 0;
+  }
+
+  /**
+   * Returns the value below which the given percentage of the recorded values fall. The result is
+   * the upper bound of the bucket containing the percentile, capped at the maximum recorded value.
+   * @param percentile the percentile in percent (0-100), e.g. 99.9
+   * @return the percentile in nanoseconds, 0 if no values have been recorded
+   */
+  [[nodiscard]] std::uint64_t getPercentile(double percentile) const {
+    if (count == 0) {
+      return 0;
+    }
+    const double clamped = (std::clamp)(percentile, 0.0, 100.0);
+    // the rank of the value - at least the first value
+    const auto rank = (std::max)(std::uint64_t{1}, static_cast<std::uint64_t>(clamped / 100.0 * static_cast<double>(count) + 0.5));
+    std::uint64_t cumulative = 0;
+    for (std::size_t index = 0; index < BUCKET_COUNT; index++) {
+      cumulative += buckets[index];
+      if (cumulative >= rank) {
+        return (std::min)(getBucketUpperBound(index), maximum);
+      }
+    }
+    return maximum;
+  }
+
+  /**
+   * @return the number of recorded values
+   */
+  [[nodiscard]] std::uint64_t getCount() const { return count; }
+
+  /**
+   * @return the smallest recorded value in nanoseconds, 0 if no values have been recorded
+   */
+  [[nodiscard]] std::uint64_t getMinimum() const { return count > 0 ? minimum : 0; }
+
+  /**
+   * @return the largest recorded value in nanoseconds
+   */
+  [[nodiscard]] std::uint64_t getMaximum() const { return maximum; }
+
+  /**
+   * @return the mean of the recorded values in nanoseconds, 0 if no values have been recorded
+   */
+  [[nodiscard]] std::uint64_t getMean() const { return count > 0 ? sum / count : 0; }
+
+ private:
+  static std::size_t getBucketIndex(std::uint64_t value) {
+    // values below two sub-bucket ranges map linearly
+    if (value < 2 * SUB_BUCKET_COUNT) {
+      return static_cast<std::size_t>(value);
+    }
+    const auto shift = static_cast<std::uint32_t>(std::bit_width(value)) - 1 - SUB_BUCKET_BITS;
+    return static_cast<std::size_t>((shift + 1) * SUB_BUCKET_COUNT + (value >> shift) - SUB_BUCKET_COUNT);
+  }
+
+  static std::uint64_t getBucketUpperBound(std::size_t index) {
+    if (index < 2 * SUB_BUCKET_COUNT) {
+      return index;
+    }
+    const std::uint64_t shift = index / SUB_BUCKET_COUNT - 1;
+    const std::uint64_t subBucket = index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT;
+    return ((subBucket + 1) << shift) - 1;
+  }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_LATENCYHISTOGRAM_HPP
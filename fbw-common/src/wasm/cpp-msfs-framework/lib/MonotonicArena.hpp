@@ -0,0 +1,206 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_MONOTONICARENA_HPP
+#define FLYBYWIRE_AIRCRAFT_MONOTONICARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Arena which hands out memory from large blocks and only releases it when all allocations
+ * have been deallocated or the arena is destroyed.
+ *
+ * Intended for long-lived objects which are created during initialization and live until the end
+ * of the program (e.g. the variables and events registered with the DataManager). Grouping them in
+ * a few large blocks avoids many small heap allocations and the fragmentation they cause in a
+ * long-running WASM module.<p/>
+ *
+ * Memory of a single destroyed object is not reused. The blocks are released as soon as the last
+ * allocation is deallocated, so a registry which is torn down and built again (e.g. on a shutdown
+ * and re-initialization of the DataManager) starts with fresh blocks instead of adding to the old
+ * ones. Do not use the arena for objects which are created and destroyed repeatedly while others
+ * are still alive.
+ */
+class MonotonicArena {
+ private:
+  std::size_t blockSize;
+  std::vector<std::unique_ptr<std::byte[]>> blocks{};
+  std::byte* current = nullptr;
+  std::size_t remaining = 0;
+  std::size_t liveAllocationCount = 0;
+
+  // statistics
+  std::size_t allocationCount = 0;
+  std::size_t allocatedBytes = 0;
+  std::size_t reservedBytes = 0;
+
+ public:
+  /**
+   * Creates an arena. No memory is reserved until the first allocation.
+   * @param blockSize the size of the blocks requested from the heap in bytes (default: 64 KiB)
+   */
+  explicit MonotonicArena(std::size_t blockSize = 64 * 1024) : blockSize(blockSize) {}
+
+  MonotonicArena(const MonotonicArena&) = delete;             // no copy constructor
+  MonotonicArena& operator=(const MonotonicArena&) = delete;  // no copy assignment
+  MonotonicArena(MonotonicArena&&) = delete;                  // no move constructor
+  MonotonicArena& operator=(MonotonicArena&&) = delete;       // no move assignment
+  ~MonotonicArena() = default;
+
+  /**
+   * Allocates memory from the current block or from a new block if the current block is used up.
+   * Allocations larger than a quarter of the block size get a block of their own so the current
+   * block is not abandoned with a lot of unused memory.
+   * @param size the size in bytes
+   * @param alignment the alignment in bytes - must be a power of two
+   * @return pointer to the memory
+   */
+  void* allocate(std::size_t size, std::size_t alignment = alignof(std::max_align_t)) {
+    liveAllocationCount++;
+    allocationCount++;
+    allocatedBytes += size;
+
+    if (size > blockSize / 4) {
+      return alignUp(addBlock(size + alignment), alignment);
+    }
+
+    std::size_t padding = paddingFor(current, alignment);
+    if (current == nullptr || padding + size > remaining) {
+      current = addBlock(blockSize);
+      remaining = blockSize;
+      padding = paddingFor(current, alignment);
+    }
+    std::byte* result = current + padding;
+    current += padding + size;
+    remaining -= padding + size;
+    return result;
+  }
+
+  /**
+   * Releases all blocks when this was the last allocation which had not been deallocated yet.
+   * Otherwise the memory is not reused.
+   * @param pointer the memory returned by allocate()
+   */
+  void deallocate(void* pointer, [[maybe_unused]] std::size_t size) noexcept {
+    if (pointer == nullptr || liveAllocationCount == 0) {
+      return;
+    }
+    if (--liveAllocationCount == 0) {
+      blocks.clear();
+      current = nullptr;
+      remaining = 0;
+      allocatedBytes = 0;
+      reservedBytes = 0;
+    }
+  }
+
+  /**
+   * @return the number of allocations served by the arena
+   */
+  [[nodiscard]] std::size_t getAllocationCount() const { return allocationCount; }
+
+  /**
+   * @return the number of bytes handed out from the current blocks
+   */
+  [[nodiscard]] std::size_t getAllocatedBytes() const { return allocatedBytes; }
+
+  /**
+   * @return the number of allocations which have not been deallocated yet
+   */
+  [[nodiscard]] std::size_t getLiveAllocationCount() const { return liveAllocationCount; }
+
+  /**
+   * @return the number of bytes currently requested from the heap by the arena
+   */
+  [[nodiscard]] std::size_t getReservedBytes() const { return reservedBytes; }
+
+  /**
+   * @return the number of blocks requested from the heap by the arena
+   */
+  [[nodiscard]] std::size_t getBlockCount() const { return blocks.size(); }
+
+ private:
+  std::byte* addBlock(std::size_t size) {
+    blocks.emplace_back(new std::byte[size]);
+    reservedBytes += size;
+    return blocks.back().get();
+  }
+
+  static std::size_t paddingFor(const std::byte* pointer, std::size_t alignment) {
+    const auto address = reinterpret_cast<std::uintptr_t>(pointer);
+    return (alignment - (address % alignment)) % alignment;
+  }
+
+  static std::byte* alignUp(std::byte* pointer, std::size_t alignment) { return pointer + paddingFor(pointer, alignment); }
+};
+
+/**
+ * @brief Standard allocator which allocates from a MonotonicArena.
+ *
+ * Can be used with std::allocate_shared or as the allocator of a container. The arena must
+ * outlive all objects allocated with it.
+ *
+ * @tparam T the type of the objects to allocate
+ */
+template <typename T>
+class ArenaAllocator {
+  template <typename U>
+  friend class ArenaAllocator;
+
+ private:
+  MonotonicArena* arena;
+
+ public:
+  using value_type = T;
+
+  explicit ArenaAllocator(MonotonicArena& arena) noexcept : arena(&arena) {}
+
+  template <typename U>
+  ArenaAllocator(const ArenaAllocator<U>& other) noexcept : arena(other.arena) {}  // NOLINT(google-explicit-constructor)
+
+  T* allocate(std::size_t n) { return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T))); }
+
+  void deallocate(T* pointer, std::size_t n) noexcept { arena->deallocate(pointer, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const ArenaAllocator<U>& other) const noexcept {
+    return arena == other.arena;
+  }
+
+  template <typename U>
+  bool operator!=(const ArenaAllocator<U>& other) const noexcept {
+    return arena != other.arena;
+  }
+};
+
+/**
+ * @brief Creates an object in the arena and returns a shared pointer to it. The shared pointer's
+ * control block is allocated in the arena as well. When the last shared pointer is released the
+ * object is destroyed and its memory is deallocated in the arena.
+ *
+ * In contrast to std::allocate_shared the object is constructed by the caller of this function,
+ * so objects with a private constructor can be created by their friends.
+ *
+ * @tparam T the type of the object
+ * @param arena the arena to allocate from - must outlive the object
+ * @param construct callable which receives the memory for the object and returns the constructed
+ *                  object, e.g. [&](void* memory) { return new (memory) T(...); }
+ * @return shared pointer to the object
+ */
+template <typename T, typename Construct>
+std::shared_ptr<T> makeSharedInArena(MonotonicArena& arena, Construct&& construct) {
+  void* memory = arena.allocate(sizeof(T), alignof(T));
+  T* object = std::forward<Construct>(construct)(memory);
+  auto destroy = [arenaPtr = &arena](T* pointer) {
+    pointer->~T();
+    arenaPtr->deallocate(pointer, sizeof(T));
+  };
+  return std::shared_ptr<T>(object, destroy, ArenaAllocator<T>(arena));
+}
+
+#endif  // FLYBYWIRE_AIRCRAFT_MONOTONICARENA_HPP
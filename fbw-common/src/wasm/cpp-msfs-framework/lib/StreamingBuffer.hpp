@@ -0,0 +1,164 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_STREAMINGBUFFER_HPP
+#define FLYBYWIRE_AIRCRAFT_STREAMINGBUFFER_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Transport buffer for data which is streamed in fixed size chunks, e.g. through a
+ * SimConnect client data area which is limited to 8192 bytes.<p/>
+ *
+ * Receiving: reserve() announces the size of the next transfer and sizes the receive buffer.
+ * Each chunk is then copied directly to its position in the buffer with receiveChunk() - there is
+ * no intermediate buffer and no allocation once the buffer has reached the largest transfer size.<p/>
+ *
+ * Sending: sendChunks() passes pointers into the buffer to the send function. The tail chunk is
+ * padded with zeros inside the buffer's capacity instead of being copied into a separate chunk
+ * buffer.<p/>
+ *
+ * Double buffering: with setDoubleBuffered(true) chunks are received into a second buffer and the
+ * buffers are swapped when a transfer is complete. getData() therefore always returns the last
+ * complete transfer and the consumer can read frame N while frame N+1 is streamed in.
+ *
+ * @tparam T the element type of the data - must be trivially copyable
+ * @tparam ChunkSize the size of a chunk in bytes - must be a multiple of sizeof(T)
+ */
+template <typename T, std::size_t ChunkSize>
+class StreamingBuffer {
+  static_assert(std::is_trivially_copyable_v<T>, "StreamingBuffer requires a trivially copyable element type");
+  static_assert(ChunkSize % sizeof(T) == 0, "ChunkSize must be a multiple of the element size");
+
+ public:
+  // the number of elements in a chunk
+  static constexpr std::size_t CHUNK_ELEMENT_COUNT = ChunkSize / sizeof(T);
+
+ private:
+  std::vector<T> buffers[2];
+
+  // the buffer returned by getData() and the buffer chunks are received into - identical if not double buffered
+  std::size_t readIndex = 0;
+  std::size_t writeIndex = 0;
+
+  // the number of elements of the current transfer - set in reserve()
+  std::size_t expectedCount = 0;
+
+  // the number of elements and chunks received so far in the current transfer
+  std::size_t receivedCount = 0;
+  std::size_t receivedChunks = 0;
+
+ public:
+  /**
+   * Enables or disables double buffering. Should be set before the first transfer.
+   * @param doubleBuffered true to receive into a second buffer, false to receive into the buffer returned by getData()
+   */
+  void setDoubleBuffered(bool doubleBuffered) { writeIndex = doubleBuffered ? 1 - readIndex : readIndex; }
+
+  /**
+   * @return true if chunks are received into a second buffer, false otherwise
+   */
+  [[nodiscard]] bool isDoubleBuffered() const { return writeIndex != readIndex; }
+
+  /**
+   * Prepares the receive buffer for a transfer of the given size. Must be called before the first
+   * chunk of a transfer is received. Only allocates if the transfer is larger than all previous ones.
+   * @param expectedByteCount the size of the transfer in bytes
+   */
+  void reserve(std::size_t expectedByteCount) {
+    expectedCount = (expectedByteCount + sizeof(T) - 1) / sizeof(T);
+    receivedCount = 0;
+    receivedChunks = 0;
+    std::vector<T>& buffer = buffers[writeIndex];
+    buffer.reserve(paddedCount(expectedCount));
+    buffer.resize(expectedCount);
+  }
+
+  /**
+   * Copies a received chunk to its position in the receive buffer. Chunks received after the
+   * transfer is complete are ignored.
+   * @param chunk pointer to the chunk data - must be at least ChunkSize bytes or the remaining size of the transfer
+   * @return true if the chunk completed the transfer, false otherwise
+   */
+  bool receiveChunk(const void* chunk) {
+    if (receivedCount >= expectedCount) {
+      return false;
+    }
+    const std::size_t count = (std::min)(expectedCount - receivedCount, CHUNK_ELEMENT_COUNT);
+    std::memcpy(buffers[writeIndex].data() + receivedCount, chunk, count * sizeof(T));
+    receivedCount += count;
+    receivedChunks++;
+    if (receivedCount < expectedCount) {
+      return false;
+    }
+    if (isDoubleBuffered()) {
+      std::swap(readIndex, writeIndex);
+    }
+    return true;
+  }
+
+  /**
+   * Sends the data returned by getData() in chunks of ChunkSize bytes. The tail chunk is padded
+   * with zeros inside the buffer's capacity so each chunk is sent directly from the buffer.
+   * @param sendChunk callable with the signature bool(const T* chunk) which sends one chunk of
+   *                  ChunkSize bytes and returns false if sending failed
+   * @return the number of chunks sent - less than the number of chunks of the data if sending failed
+   */
+  template <typename SendChunk>
+  std::size_t sendChunks(SendChunk&& sendChunk) {
+    std::vector<T>& buffer = buffers[readIndex];
+    const std::size_t count = buffer.size();
+    buffer.resize(paddedCount(count));
+    std::size_t chunkCount = 0;
+    for (std::size_t offset = 0; offset < count; offset += CHUNK_ELEMENT_COUNT) {
+      if (!sendChunk(static_cast<const T*>(buffer.data() + offset))) {
+        break;
+      }
+      chunkCount++;
+    }
+    buffer.resize(count);
+    return chunkCount;
+  }
+
+  /**
+   * @return the number of chunks required for the data returned by getData()
+   */
+  [[nodiscard]] std::size_t getChunkCount() const { return paddedCount(buffers[readIndex].size()) / CHUNK_ELEMENT_COUNT; }
+
+  /**
+   * @return a modifiable reference to the data - the last complete transfer if double buffered
+   */
+  [[nodiscard]] std::vector<T>& getData() { return buffers[readIndex]; }
+
+  /**
+   * @return a constant reference to the data - the last complete transfer if double buffered
+   */
+  [[nodiscard]] const std::vector<T>& getData() const { return buffers[readIndex]; }
+
+  /**
+   * @return the number of bytes of the current transfer as set with reserve()
+   */
+  [[nodiscard]] std::size_t getExpectedBytes() const { return expectedCount * sizeof(T); }
+
+  /**
+   * @return the number of bytes received so far in the current transfer
+   */
+  [[nodiscard]] std::size_t getReceivedBytes() const { return receivedCount * sizeof(T); }
+
+  /**
+   * @return the number of chunks received so far in the current transfer
+   */
+  [[nodiscard]] std::size_t getReceivedChunks() const { return receivedChunks; }
+
+ private:
+  static std::size_t paddedCount(std::size_t count) {
+    return (count + CHUNK_ELEMENT_COUNT - 1) / CHUNK_ELEMENT_COUNT * CHUNK_ELEMENT_COUNT;
+  }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_STREAMINGBUFFER_HPP
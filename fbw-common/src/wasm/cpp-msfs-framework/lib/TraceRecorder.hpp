@@ -0,0 +1,283 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_AIRCRAFT_TRACERECORDER_HPP
+#define FLYBYWIRE_AIRCRAFT_TRACERECORDER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Identifies a name of the TraceRecorder
+using TraceNameId = std::uint32_t;
+
+/**
+ * @brief Records the begin and end of named scopes into a fixed size ring buffer and writes the
+ * most recent events as a Chrome trace JSON file (chrome://tracing, https://ui.perfetto.dev) on
+ * demand.<p/>
+ *
+ * The recorder is meant to always run so the frames before a stutter are available when a dump
+ * is requested. Recording an event is two clock reads and a write into the ring buffer - names
+ * are registered once during initialization and events only store the ID of their name. When the
+ * ring buffer is full the oldest events are overwritten.<p/>
+ *
+ * A dump is requested by changing the value of a trigger (e.g. incrementing an LVAR) which is
+ * passed to dumpOnTrigger() every frame. Several WASM modules can watch the same trigger as the
+ * trigger is never reset. The value of the trigger at setup must be passed to setTriggerValue() so
+ * that a value kept from an earlier session does not start a dump on the first frame. Writing the
+ * file allocates and takes a few milliseconds, this only happens on demand.
+ *
+ * @usage
+ *   TraceRecorder recorder{"MyGauge"};<br/>
+ *   const TraceNameId updateId = recorder.addName("update()");<br/>
+ *   recorder.setTriggerValue(triggerLvar->get());<br/>
+ *   { TraceScope scope{recorder, updateId}; update(); }<br/>
+ *   recorder.dumpOnTrigger(triggerLvar->get());<br/>
+ */
+class TraceRecorder {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // the default number of events in the ring buffer - e.g. ~20 seconds with 25 scopes per frame at 30 fps
+  static constexpr std::size_t DEFAULT_CAPACITY = 16384;
+
+  // the default age of the oldest event written by a dump in seconds
+  static constexpr double DEFAULT_DUMP_SECONDS = 10.0;
+
+ private:
+  /**
+   * A completed scope - the times are relative to the creation of the recorder.
+   */
+  struct Event {
+    std::uint64_t startNanoseconds;
+    std::uint32_t durationNanoseconds;
+    TraceNameId nameId;
+  };
+
+  std::string processName;
+  std::vector<std::string> names{};
+
+  std::vector<Event> events;
+  std::size_t nextIndex = 0;
+  std::size_t eventCount = 0;
+  std::uint64_t overwrittenCount = 0;
+
+  const Clock::time_point epoch;
+  bool enabled = true;
+
+  double lastTriggerValue = 0.0;
+  std::uint64_t dumpCount = 0;
+
+ public:
+  /**
+   * Creates a recorder and allocates its ring buffer.
+   * @param processName the name of the WASM module - used as process name in the trace and in the file name
+   * @param capacity the number of events in the ring buffer
+   */
+  explicit TraceRecorder(std::string processName, std::size_t capacity = DEFAULT_CAPACITY)
+      : processName(std::move(processName)), events(capacity), epoch(Clock::now()) {}
+
+  TraceRecorder(const TraceRecorder&) = delete;             // no copy constructor
+  TraceRecorder& operator=(const TraceRecorder&) = delete;  // no copy assignment
+  TraceRecorder(TraceRecorder&&) = delete;                  // no move constructor
+  TraceRecorder& operator=(TraceRecorder&&) = delete;       // no move assignment
+  ~TraceRecorder() = default;
+
+  /**
+   * Registers a name for events. Should only be called during initialization as it allocates.
+   * @param name the name of the scope as shown in the trace viewer
+   * @return the ID to record events with
+   */
+  TraceNameId addName(const std::string& name) {
+    names.push_back(name);
+    return static_cast<TraceNameId>(names.size() - 1);
+  }
+
+  /**
+   * Records a completed scope. Does not allocate.
+   * @param nameId the ID of the name of the scope
+   * @param start the time the scope started
+   * @param end the time the scope ended
+   */
+  void record(TraceNameId nameId, Clock::time_point start, Clock::time_point end) {
+    if (!enabled || events.empty()) {
+      return;
+    }
+    Event& event = events[nextIndex];
+    event.startNanoseconds = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch).count());
+    event.durationNanoseconds = static_cast<std::uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    event.nameId = nameId;
+    nextIndex = (nextIndex + 1) % events.size();
+    if (eventCount < events.size()) {
+      eventCount++;
+    } else {
+      overwrittenCount++;
+    }
+  }
+
+  /**
+   * Writes the events of the last maxAgeSeconds as Chrome trace JSON file.
+   * @param filePath the path of the file
+   * @param maxAgeSeconds the age of the oldest event to write relative to the newest event
+   * @return true if successful, false otherwise
+   */
+  bool writeChromeTrace(const std::string& filePath, double maxAgeSeconds = DEFAULT_DUMP_SECONDS) const {
+    std::FILE* file = std::fopen(filePath.c_str(), "w");
+    if (file == nullptr) {
+      return false;
+    }
+
+    std::fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    std::fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"%s\"}}",
+                 escape(processName).c_str());
+
+    // the end of the newest event is the reference for the age of the events
+    std::uint64_t newestEndNanoseconds = 0;
+    for (std::size_t i = 0; i < eventCount; i++) {
+      const Event& event = getEvent(i);
+      newestEndNanoseconds = (std::max)(newestEndNanoseconds, event.startNanoseconds + event.durationNanoseconds);
+    }
+    const auto maxAgeNanoseconds = static_cast<std::uint64_t>(maxAgeSeconds * 1e9);
+    const std::uint64_t oldestStartNanoseconds = newestEndNanoseconds > maxAgeNanoseconds ? newestEndNanoseconds - maxAgeNanoseconds : 0;
+
+    for (std::size_t i = 0; i < eventCount; i++) {
+      const Event& event = getEvent(i);
+      if (event.startNanoseconds < oldestStartNanoseconds || event.nameId >= names.size()) {
+        continue;
+      }
+      std::fprintf(file, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}",
+                   escape(names[event.nameId]).c_str(), static_cast<double>(event.startNanoseconds) / 1000.0,
+                   static_cast<double>(event.durationNanoseconds) / 1000.0);
+    }
+
+    std::fprintf(file, "\n]}\n");
+    return std::fclose(file) == 0;
+  }
+
+  /**
+   * Sets the current value of the trigger without writing a trace file. Must be called during setup
+   * with the value the trigger has when the module starts.
+   * @param triggerValue the current value of the trigger
+   */
+  void setTriggerValue(double triggerValue) { lastTriggerValue = triggerValue; }
+
+  /**
+   * Writes a trace file to the work folder if the value of the trigger has changed since the last
+   * call, e.g. because an LVAR has been incremented.
+   * @param triggerValue the current value of the trigger
+   * @return true if a trace file has been written, false otherwise
+   */
+  bool dumpOnTrigger(double triggerValue) {
+    if (triggerValue == lastTriggerValue) {
+      return false;
+    }
+    lastTriggerValue = triggerValue;
+    const std::string filePath = makeFilePath();
+    if (!writeChromeTrace(filePath)) {
+      std::cout << "TraceRecorder: Writing trace file " << filePath << " failed" << std::endl;
+      return false;
+    }
+    std::cout << "TraceRecorder: Wrote " << eventCount << " events to " << filePath << std::endl;
+    return true;
+  }
+
+  /**
+   * Enables or disables the recording of events.
+   * @param isEnabled true to record events, false otherwise
+   */
+  void setEnabled(bool isEnabled) { enabled = isEnabled; }
+
+  /**
+   * @return true if events are recorded, false otherwise
+   */
+  [[nodiscard]] bool isEnabled() const { return enabled; }
+
+  /**
+   * @return the number of events in the ring buffer
+   */
+  [[nodiscard]] std::size_t getEventCount() const { return eventCount; }
+
+  /**
+   * @return the number of events the ring buffer can hold
+   */
+  [[nodiscard]] std::size_t getCapacity() const { return events.size(); }
+
+  /**
+   * @return the number of events which have been overwritten because the ring buffer was full
+   */
+  [[nodiscard]] std::uint64_t getOverwrittenCount() const { return overwrittenCount; }
+
+ private:
+  /**
+   * @param index the index of the event from the oldest event in the ring buffer
+   * @return the event
+   */
+  [[nodiscard]] const Event& getEvent(std::size_t index) const {
+    const std::size_t oldestIndex = eventCount < events.size() ? 0 : nextIndex;
+    return events[(oldestIndex + index) % events.size()];
+  }
+
+  /**
+   * @return the path of a new trace file in the work folder, e.g. \work\FadecGauge-2023-05-01-12-00-00-123-1.trace.json
+   * with the milliseconds and the number of the dump so dumps within the same second do not overwrite each other
+   */
+  [[nodiscard]] std::string makeFilePath() {
+    const auto now = std::chrono::system_clock::now();
+    const std::time_t nowSeconds = std::chrono::system_clock::to_time_t(now);
+    const auto milliseconds = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+    std::stringstream ss;
+    ss << "\\work\\" << processName << std::put_time(std::gmtime(&nowSeconds), "-%Y-%m-%d-%H-%M-%S") << "-" << std::setw(3)
+       << std::setfill('0') << milliseconds << "-" << ++dumpCount << ".trace.json";
+    return ss.str();
+  }
+
+  static std::string escape(const std::string& value) {
+    std::string escaped;
+    for (const char c : value) {
+      if (c == '"' || c == '\\') {
+        escaped += '\\';
+      }
+      escaped += c;
+    }
+    return escaped;
+  }
+};
+
+/**
+ * @brief Records the time from its creation to its destruction as an event of a TraceRecorder.
+ */
+class TraceScope {
+ private:
+  TraceRecorder& recorder;
+  const TraceNameId nameId;
+  const TraceRecorder::Clock::time_point start;
+
+ public:
+  /**
+   * Starts the scope.
+   * @param recorder the recorder to record the event in
+   * @param nameId the ID of the name of the scope
+   */
+  TraceScope(TraceRecorder& recorder, TraceNameId nameId) : recorder(recorder), nameId(nameId), start(TraceRecorder::Clock::now()) {}
+
+  TraceScope(const TraceScope&) = delete;             // no copy constructor
+  TraceScope& operator=(const TraceScope&) = delete;  // no copy assignment
+  TraceScope(TraceScope&&) = delete;                  // no move constructor
+  TraceScope& operator=(TraceScope&&) = delete;       // no move assignment
+
+  /**
+   * Records the event.
+   */
+  ~TraceScope() { recorder.record(nameId, start, TraceRecorder::Clock::now()); }
+};
+
+#endif  // FLYBYWIRE_AIRCRAFT_TRACERECORDER_HPP
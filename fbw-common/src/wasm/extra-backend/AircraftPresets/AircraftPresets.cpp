@@ -63,6 +63,9 @@ bool AircraftPresets::update(sGaugeDrawData* pData) {
 
   // has request to load a preset been received?
   if (loadAircraftPresetRequest->getAsInt64() > 0) {
+    // procedure steps are timed in milliseconds so run every frame while a preset is requested
+    requestUpdate();
+
     // we do not allow loading of presets in the air to prevent users from
     // accidentally changing the aircraft configuration
     if (!simOnGround->getAsBool()) {
@@ -57,7 +57,10 @@ class AircraftPresets : public Module {
    * @param aircraftProceduresDefinitions The AircraftProceduresDefinition instance that is used to define the procedures.
    */
   explicit AircraftPresets(MsfsHandler& msfsHandler, const PresetProceduresDefinition& aircraftProceduresDefinitions)
-      : Module(msfsHandler), presetProcedures(PresetProcedures(aircraftProceduresDefinitions)) {}
+      : Module(msfsHandler), presetProcedures(PresetProcedures(aircraftProceduresDefinitions)) {
+    // polls for load requests and requests every frame updates while a preset is loading
+    setUpdateRate(ModuleUpdateRate::FIXED_RATE, 10.0);
+  }
 
   bool initialize() override;
   bool preUpdate(sGaugeDrawData*) override { return true; }; // not required for this module
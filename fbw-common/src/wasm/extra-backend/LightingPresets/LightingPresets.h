@@ -40,7 +40,10 @@ class LightingPresets : public Module {
   // for testing manually configured presets.
   bool readIniFile = true;
 
-  LightingPresets(MsfsHandler& handler) : Module(handler), iniFile(CONFIGURATION_FILEPATH) {}
+  LightingPresets(MsfsHandler& handler) : Module(handler), iniFile(CONFIGURATION_FILEPATH) {
+    // load and save requests are only polled
+    setUpdateRate(ModuleUpdateRate::FIXED_RATE, 10.0);
+  }
 
   virtual bool initialize() override = 0; // this needs to be implemented by the derived class
   bool preUpdate([[maybe_unused]] sGaugeDrawData* pData) override { return true; }; // not required for this module
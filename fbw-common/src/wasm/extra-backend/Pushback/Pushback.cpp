@@ -92,6 +92,9 @@ bool Pushback::update(sGaugeDrawData* pData) {
     return true;
   }
 
+  // the tug is controlled every frame while it is attached
+  requestUpdate();
+
   const FLOAT64 timeStamp = msfsHandler.getTimeStamp();
   const UINT64 tickCounter = msfsHandler.getTickCounter();
 
@@ -76,7 +76,10 @@ class Pushback : public Module {
    * Creates a new Pushback instance and takes a reference to the MsfsHandler instance.
    * @param msfsHandler The MsfsHandler instance that is used to communicate with the simulator.
    */
-  explicit Pushback(MsfsHandler& msfsHandler) : Module(msfsHandler) {}
+  explicit Pushback(MsfsHandler& msfsHandler) : Module(msfsHandler) {
+    // polls the pushback conditions and requests every frame updates while a tug is attached
+    setUpdateRate(ModuleUpdateRate::FIXED_RATE, 10.0);
+  }
 
   bool initialize() override;
   bool preUpdate(sGaugeDrawData* pData) override;
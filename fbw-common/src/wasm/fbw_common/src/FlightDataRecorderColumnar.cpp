@@ -0,0 +1,196 @@
+#include <cstring>
+
+#include "FlightDataRecorderColumnar.h"
+
+FlightDataRecorderColumnarEncoder::~FlightDataRecorderColumnarEncoder() {
+  if (isStreamInitialized) {
+    deflateEnd(&stream);
+  }
+}
+
+void FlightDataRecorderColumnarEncoder::initialize(const FdrStruct* structs,
+                                                   size_t structCount,
+                                                   uint32_t maximumFramesPerChunk,
+                                                   int compressionLevel) {
+  // build column layout from the schema
+  columns.clear();
+  frameSize = 0;
+  for (size_t s = 0; s < structCount; s++) {
+    for (uint32_t f = 0; f < structs[s].fieldCount; f++) {
+      const auto& field = structs[s].fields[f];
+      columns.push_back({static_cast<uint32_t>(frameSize + field.offset), static_cast<uint32_t>(fdrFieldTypeSize(field.type))});
+    }
+    frameSize += structs[s].size;
+  }
+
+  // initialize compression stream once, it is reset for every column
+  if (isStreamInitialized) {
+    deflateEnd(&stream);
+  }
+  stream = {};
+  isStreamInitialized = deflateInit(&stream, compressionLevel) == Z_OK;
+
+  // allocate all buffers upfront so that encoding a chunk does not allocate
+  framesPerChunk = maximumFramesPerChunk;
+  frameCount = 0;
+  frames.assign(framesPerChunk * frameSize, 0);
+  scratch.assign(framesPerChunk * sizeof(uint64_t), 0);
+  compressedColumns.resize(columns.size());
+  compressedSizes.assign(columns.size(), 0);
+  for (size_t i = 0; i < columns.size(); i++) {
+    compressedColumns[i].resize(deflateBound(&stream, framesPerChunk * columns[i].width));
+  }
+}
+
+bool FlightDataRecorderColumnarEncoder::encodeColumn(size_t column) {
+  const auto& layout = columns[column];
+
+  // XOR every value with the previous one and group the bytes by significance
+  for (uint32_t f = 0; f < frameCount; f++) {
+    const char* value = frames.data() + f * frameSize + layout.offset;
+    for (uint32_t b = 0; b < layout.width; b++) {
+      uint8_t previous = f > 0 ? static_cast<uint8_t>(*(value - frameSize + b)) : 0;
+      scratch[b * frameCount + f] = static_cast<uint8_t>(value[b]) ^ previous;
+    }
+  }
+
+  // compress the encoded column
+  uint32_t encodedSize = frameCount * layout.width;
+  if (isStreamInitialized) {
+    deflateReset(&stream);
+    stream.next_in = scratch.data();
+    stream.avail_in = encodedSize;
+    stream.next_out = compressedColumns[column].data();
+    stream.avail_out = static_cast<uInt>(compressedColumns[column].size());
+    if (deflate(&stream, Z_FINISH) == Z_STREAM_END) {
+      compressedSizes[column] = static_cast<uint32_t>(stream.total_out);
+      return true;
+    }
+  }
+
+  // store the encoded column uncompressed so that the chunk stays readable, the buffer is at least as large
+  std::memcpy(compressedColumns[column].data(), scratch.data(), encodedSize);
+  compressedSizes[column] = encodedSize | FDR_COLUMN_STORED;
+  return false;
+}
+
+void FlightDataRecorderColumnarEncoder::writeChunk(std::ostream& out) {
+  uint32_t columnCount = static_cast<uint32_t>(columns.size());
+  out.write(reinterpret_cast<const char*>(&FDR_CHUNK_MAGIC), sizeof(FDR_CHUNK_MAGIC));
+  out.write(reinterpret_cast<const char*>(&frameCount), sizeof(frameCount));
+  out.write(reinterpret_cast<const char*>(&columnCount), sizeof(columnCount));
+  out.write(reinterpret_cast<const char*>(compressedSizes.data()), static_cast<std::streamsize>(columnCount * sizeof(uint32_t)));
+  for (size_t i = 0; i < columns.size(); i++) {
+    out.write(reinterpret_cast<const char*>(compressedColumns[i].data()), compressedSizes[i] & ~FDR_COLUMN_STORED);
+  }
+
+  // start a new chunk
+  frameCount = 0;
+}
+
+FlightDataRecorderColumnarDecoder::~FlightDataRecorderColumnarDecoder() {
+  if (isStreamInitialized) {
+    inflateEnd(&stream);
+  }
+}
+
+void FlightDataRecorderColumnarDecoder::initialize(std::vector<FdrColumnLayout> columnLayouts) {
+  columns = std::move(columnLayouts);
+  decoded.assign(columns.size(), false);
+  values.resize(columns.size());
+  compressedSizes.resize(columns.size());
+  frameCount = 0;
+
+  if (isStreamInitialized) {
+    inflateEnd(&stream);
+  }
+  stream = {};
+  isStreamInitialized = inflateInit(&stream) == Z_OK;
+}
+
+bool FlightDataRecorderColumnarDecoder::readChunk(std::istream& in, const std::vector<bool>& selected) {
+  frameCount = 0;
+  if (!isStreamInitialized) {
+    return false;
+  }
+
+  // read chunk header
+  uint32_t magic = 0;
+  uint32_t chunkFrameCount = 0;
+  uint32_t columnCount = 0;
+  in.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+  in.read(reinterpret_cast<char*>(&chunkFrameCount), sizeof(chunkFrameCount));
+  in.read(reinterpret_cast<char*>(&columnCount), sizeof(columnCount));
+  if (!in.good() || magic != FDR_CHUNK_MAGIC || columnCount != columns.size()) {
+    return false;
+  }
+  in.read(reinterpret_cast<char*>(compressedSizes.data()), static_cast<std::streamsize>(columnCount * sizeof(uint32_t)));
+  if (!in.good()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < columns.size(); i++) {
+    decoded[i] = i < selected.size() && selected[i];
+    bool isStored = (compressedSizes[i] & FDR_COLUMN_STORED) != 0;
+    uint32_t storedSize = compressedSizes[i] & ~FDR_COLUMN_STORED;
+
+    // skip columns that are not needed without inflating them
+    if (!decoded[i]) {
+      in.ignore(storedSize);
+      continue;
+    }
+
+    const auto& layout = columns[i];
+    size_t columnSize = static_cast<size_t>(chunkFrameCount) * layout.width;
+
+    // columns which could not be compressed are stored as they are
+    if (isStored) {
+      if (storedSize != columnSize) {
+        return false;
+      }
+      scratch.resize(columnSize);
+      in.read(reinterpret_cast<char*>(scratch.data()), storedSize);
+      if (!in.good()) {
+        return false;
+      }
+    } else {
+      compressed.resize(storedSize);
+      in.read(reinterpret_cast<char*>(compressed.data()), storedSize);
+      if (!in.good()) {
+        return false;
+      }
+
+      // inflate the column
+      scratch.resize(columnSize);
+      inflateReset(&stream);
+      stream.next_in = compressed.data();
+      stream.avail_in = storedSize;
+      stream.next_out = scratch.data();
+      stream.avail_out = static_cast<uInt>(columnSize);
+      if (inflate(&stream, Z_FINISH) != Z_STREAM_END || stream.total_out != columnSize) {
+        return false;
+      }
+    }
+
+    // restore the byte order and undo the XOR with the previous value
+    auto& columnValues = values[i];
+    columnValues.resize(columnSize);
+    for (uint32_t f = 0; f < chunkFrameCount; f++) {
+      for (uint32_t b = 0; b < layout.width; b++) {
+        uint8_t previous = f > 0 ? columnValues[(f - 1) * layout.width + b] : 0;
+        columnValues[f * layout.width + b] = scratch[b * chunkFrameCount + f] ^ previous;
+      }
+    }
+  }
+
+  frameCount = chunkFrameCount;
+  return true;
+}
+
+void FlightDataRecorderColumnarDecoder::getFrame(uint32_t index, char* frame) const {
+  for (size_t i = 0; i < columns.size(); i++) {
+    if (decoded[i]) {
+      std::memcpy(frame + columns[i].offset, values[i].data() + index * columns[i].width, columns[i].width);
+    }
+  }
+}
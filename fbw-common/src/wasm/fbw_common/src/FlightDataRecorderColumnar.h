@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "FlightDataRecorderSchema.h"
+#include "zlib.h"
+
+// Columnar layout of the flight data recorder. Frames are buffered and stored in chunks, every chunk contains
+// one compressed block per field of the schema. Within a block every value is XOR-ed with the value of the
+// previous frame and the bytes of all values are grouped by their significance before compressing them. As most
+// fields barely change from frame to frame this results in long runs of zeros.
+//
+// Layout of a chunk (all values little endian):
+//   uint32  magic (FDR_CHUNK_MAGIC)
+//   uint32  number of frames
+//   uint32  number of columns
+//   uint32  compressed size per column, FDR_COLUMN_STORED is set if the column is stored uncompressed
+//   per column:
+//     zlib stream of the encoded values or the encoded values themselves
+//
+// The column directory allows a reader to skip columns it does not need without inflating them.
+
+constexpr uint32_t FDR_CHUNK_MAGIC = 0x43524446;  // "FDRC"
+constexpr uint32_t FDR_COLUMN_STORED = 0x80000000;
+
+// position and size of a single column within a frame
+struct FdrColumnLayout {
+  uint32_t offset;
+  uint32_t width;
+};
+
+class FlightDataRecorderColumnarEncoder {
+ public:
+  FlightDataRecorderColumnarEncoder() = default;
+  FlightDataRecorderColumnarEncoder(const FlightDataRecorderColumnarEncoder&) = delete;
+  FlightDataRecorderColumnarEncoder& operator=(const FlightDataRecorderColumnarEncoder&) = delete;
+  ~FlightDataRecorderColumnarEncoder();
+
+  void initialize(const FdrStruct* structs, size_t structCount, uint32_t framesPerChunk, int compressionLevel);
+
+  // returns the buffer the next frame has to be copied into
+  char* getNextFrame() { return frames.data() + frameCount * frameSize; }
+  // marks the frame returned by getNextFrame() as complete
+  void commitFrame() { frameCount++; }
+
+  // returns a buffered frame of the current chunk
+  [[nodiscard]] const char* getFrame(uint32_t index) const { return frames.data() + index * frameSize; }
+  [[nodiscard]] uint32_t getFrameCount() const { return frameCount; }
+
+  [[nodiscard]] bool isEmpty() const { return frameCount == 0; }
+  [[nodiscard]] bool isFull() const { return frameCount >= framesPerChunk; }
+  [[nodiscard]] size_t getColumnCount() const { return columns.size(); }
+
+  // encodes and compresses a single column of the buffered frames, returns false if the column could not be
+  // compressed and is stored uncompressed instead
+  bool encodeColumn(size_t column);
+  // writes the chunk of already encoded columns to the stream and starts a new chunk
+  void writeChunk(std::ostream& out);
+
+ private:
+  std::vector<FdrColumnLayout> columns;
+  size_t frameSize = 0;
+  uint32_t framesPerChunk = 0;
+  bool isStreamInitialized = false;
+  z_stream stream = {};
+
+  uint32_t frameCount = 0;
+  std::vector<char> frames;
+  std::vector<uint8_t> scratch;
+  std::vector<std::vector<uint8_t>> compressedColumns;
+  std::vector<uint32_t> compressedSizes;
+};
+
+class FlightDataRecorderColumnarDecoder {
+ public:
+  FlightDataRecorderColumnarDecoder() = default;
+  FlightDataRecorderColumnarDecoder(const FlightDataRecorderColumnarDecoder&) = delete;
+  FlightDataRecorderColumnarDecoder& operator=(const FlightDataRecorderColumnarDecoder&) = delete;
+  ~FlightDataRecorderColumnarDecoder();
+
+  void initialize(std::vector<FdrColumnLayout> columnLayouts);
+
+  // reads the next chunk from the stream, only columns marked as selected are inflated
+  bool readChunk(std::istream& in, const std::vector<bool>& selected);
+
+  [[nodiscard]] uint32_t getFrameCount() const { return frameCount; }
+
+  // copies the selected columns of a frame of the current chunk into a frame buffer
+  void getFrame(uint32_t index, char* frame) const;
+
+ private:
+  std::vector<FdrColumnLayout> columns;
+  std::vector<bool> decoded;
+  bool isStreamInitialized = false;
+  z_stream stream = {};
+
+  uint32_t frameCount = 0;
+  std::vector<uint32_t> compressedSizes;
+  std::vector<uint8_t> compressed;
+  std::vector<uint8_t> scratch;
+  std::vector<std::vector<uint8_t>> values;
+};
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// Seek index appended to a flight data recorder file when it is closed. Every entry points to a position in the
+// file where decoding can start without reading the data before it: a full flush point of the deflate stream in
+// the row layout or the start of a chunk in the columnar layout.
+//
+// Layout of the index (all values little endian):
+//   uint32  magic (FDR_INDEX_MAGIC)
+//   uint32  number of entries
+//   per entry:
+//     uint64  number of the first frame after the position
+//     double  smallest simulation time of the frames up to the next entry
+//     double  largest simulation time of the frames up to the next entry
+//     uint64  offset in the file
+//   uint64  offset of the index in the file
+//   uint32  magic (FDR_INDEX_MAGIC)
+//
+// The index is found by reading the last 12 bytes of the file. In the row layout it follows the gzip stream,
+// which is ignored by gzip readers as trailing garbage. Files that were not closed properly have no index.
+// Simulation time is not required to increase as it jumps back on a reset of the simulation, the range of every
+// entry tells a reader which parts of the file can contain a time window.
+
+constexpr uint32_t FDR_INDEX_MAGIC = 0x49524446;  // "FDRI"
+constexpr size_t FDR_INDEX_FOOTER_SIZE = sizeof(uint64_t) + sizeof(uint32_t);
+
+struct FdrIndexEntry {
+  uint64_t frame;
+  double minimumSimulationTime;
+  double maximumSimulationTime;
+  uint64_t offset;
+};
+
+class FlightDataRecorderIndexWriter {
+ public:
+  FlightDataRecorderIndexWriter() = delete;
+
+  static void write(std::ostream& out, uint64_t indexOffset, const std::vector<FdrIndexEntry>& entries) {
+    uint32_t entryCount = static_cast<uint32_t>(entries.size());
+    out.write(reinterpret_cast<const char*>(&FDR_INDEX_MAGIC), sizeof(FDR_INDEX_MAGIC));
+    out.write(reinterpret_cast<const char*>(&entryCount), sizeof(entryCount));
+    for (const auto& entry : entries) {
+      out.write(reinterpret_cast<const char*>(&entry.frame), sizeof(entry.frame));
+      out.write(reinterpret_cast<const char*>(&entry.minimumSimulationTime), sizeof(entry.minimumSimulationTime));
+      out.write(reinterpret_cast<const char*>(&entry.maximumSimulationTime), sizeof(entry.maximumSimulationTime));
+      out.write(reinterpret_cast<const char*>(&entry.offset), sizeof(entry.offset));
+    }
+    out.write(reinterpret_cast<const char*>(&indexOffset), sizeof(indexOffset));
+    out.write(reinterpret_cast<const char*>(&FDR_INDEX_MAGIC), sizeof(FDR_INDEX_MAGIC));
+  }
+};
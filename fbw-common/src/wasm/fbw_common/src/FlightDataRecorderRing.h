@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Fixed size ring of frames used to decouple recording a frame from compressing and writing it. All memory
+// is allocated once in initialize(), so adding a frame only copies the data.
+class FlightDataRecorderRing {
+ public:
+  void initialize(size_t frameSizeInBytes, size_t capacityInFrames) {
+    frameSize = frameSizeInBytes;
+    capacity = capacityInFrames;
+    buffer.assign(frameSize * capacity, 0);
+    head = 0;
+    count = 0;
+  }
+
+  // returns the buffer for the next frame or nullptr if the ring is full
+  char* beginWrite() {
+    if (count >= capacity) {
+      return nullptr;
+    }
+    return buffer.data() + ((head + count) % capacity) * frameSize;
+  }
+  // marks the frame returned by beginWrite() as complete
+  void commitWrite() { count++; }
+
+  // returns the oldest frame, only valid if the ring is not empty
+  [[nodiscard]] const char* front() const { return buffer.data() + head * frameSize; }
+  // removes the oldest frame
+  void pop() {
+    head = (head + 1) % capacity;
+    count--;
+  }
+
+  [[nodiscard]] bool isEmpty() const { return count == 0; }
+  [[nodiscard]] size_t getSize() const { return count; }
+  [[nodiscard]] size_t getCapacity() const { return capacity; }
+
+ private:
+  std::vector<char> buffer;
+  size_t frameSize = 0;
+  size_t capacity = 0;
+  size_t head = 0;
+  size_t count = 0;
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+// Describes the layout of the structs recorded by the flight data recorder. The recorder writes this
+// description once at the beginning of every file, so that a converter can decode any file version
+// without being compiled against the matching struct definitions.
+//
+// Layout of the schema block (all values little endian):
+//   uint32  magic (FDR_SCHEMA_MAGIC)
+//   uint32  schema format version (FDR_SCHEMA_FORMAT_VERSION)
+//   string  aircraft identifier
+//   uint8   layout of the frames following the schema block (FdrLayout, since format version 2)
+//   uint16  number of structs
+//   per struct:
+//     string  name (used as column prefix)
+//     uint32  size of the struct in bytes
+//     uint32  number of fields
+//     per field:
+//       string  name
+//       uint32  offset within the struct
+//       uint8   type (FdrFieldType)
+// A string is stored as uint16 length followed by the characters without termination.
+//
+// In the row layout every frame following the schema block is the concatenation of all structs in the given
+// order. The columnar layout is described in FlightDataRecorderColumnar.h.
+
+constexpr uint32_t FDR_SCHEMA_MAGIC = 0x53524446;  // "FDRS"
+constexpr uint32_t FDR_SCHEMA_FORMAT_VERSION = 2;
+
+enum class FdrLayout : uint8_t {
+  Row = 0,
+  Columnar = 1,
+};
+
+enum class FdrFieldType : uint8_t {
+  Boolean = 1,
+  Int8 = 2,
+  UInt8 = 3,
+  Int16 = 4,
+  UInt16 = 5,
+  Int32 = 6,
+  UInt32 = 7,
+  Int64 = 8,
+  UInt64 = 9,
+  Float = 10,
+  Double = 11,
+};
+
+constexpr size_t fdrFieldTypeSize(FdrFieldType type) {
+  switch (type) {
+    case FdrFieldType::Boolean:
+    case FdrFieldType::Int8:
+    case FdrFieldType::UInt8:
+      return 1;
+    case FdrFieldType::Int16:
+    case FdrFieldType::UInt16:
+      return 2;
+    case FdrFieldType::Int32:
+    case FdrFieldType::UInt32:
+    case FdrFieldType::Float:
+      return 4;
+    case FdrFieldType::Int64:
+    case FdrFieldType::UInt64:
+    case FdrFieldType::Double:
+      return 8;
+  }
+  return 0;
+}
+
+template <typename T>
+constexpr FdrFieldType fdrFieldTypeOf() {
+  if constexpr (std::is_enum_v<T>) {
+    return fdrFieldTypeOf<std::underlying_type_t<T>>();
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return FdrFieldType::Boolean;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return FdrFieldType::Float;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return FdrFieldType::Double;
+  } else {
+    static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "unsupported field type for flight data recorder");
+    if constexpr (sizeof(T) == 1) {
+      return std::is_signed_v<T> ? FdrFieldType::Int8 : FdrFieldType::UInt8;
+    } else if constexpr (sizeof(T) == 2) {
+      return std::is_signed_v<T> ? FdrFieldType::Int16 : FdrFieldType::UInt16;
+    } else if constexpr (sizeof(T) == 4) {
+      return std::is_signed_v<T> ? FdrFieldType::Int32 : FdrFieldType::UInt32;
+    } else {
+      return std::is_signed_v<T> ? FdrFieldType::Int64 : FdrFieldType::UInt64;
+    }
+  }
+}
+
+struct FdrField {
+  std::string_view name;
+  uint32_t offset;
+  FdrFieldType type;
+};
+
+struct FdrStruct {
+  std::string_view name;
+  uint32_t size;
+  const FdrField* fields;
+  uint32_t fieldCount;
+};
+
+// describes a field whose column name differs from the member path
+#define FDR_FIELD_NAMED(STRUCT, NAME, MEMBER) \
+  FdrField{NAME, static_cast<uint32_t>(offsetof(STRUCT, MEMBER)), fdrFieldTypeOf<std::remove_cvref_t<decltype(STRUCT::MEMBER)>>()}
+
+// describes a field whose column name equals the member path
+#define FDR_FIELD(STRUCT, MEMBER) FDR_FIELD_NAMED(STRUCT, #MEMBER, MEMBER)
+
+template <typename STRUCT, size_t N>
+constexpr FdrStruct makeFdrStruct(std::string_view name, const FdrField (&fields)[N]) {
+  return FdrStruct{name, static_cast<uint32_t>(sizeof(STRUCT)), fields, static_cast<uint32_t>(N)};
+}
+
+constexpr size_t getFdrFrameSize(const FdrStruct* structs, size_t structCount) {
+  size_t result = 0;
+  for (size_t i = 0; i < structCount; i++) {
+    result += structs[i].size;
+  }
+  return result;
+}
+
+template <size_t N>
+constexpr size_t getFdrFrameSize(const FdrStruct (&structs)[N]) {
+  return getFdrFrameSize(structs, N);
+}
+
+class FlightDataRecorderSchemaWriter {
+ public:
+  FlightDataRecorderSchemaWriter() = delete;
+
+  static void write(std::ostream& out, std::string_view aircraft, FdrLayout layout, const FdrStruct* structs, size_t structCount) {
+    writeValue<uint32_t>(out, FDR_SCHEMA_MAGIC);
+    writeValue<uint32_t>(out, FDR_SCHEMA_FORMAT_VERSION);
+    writeString(out, aircraft);
+    writeValue<uint8_t>(out, static_cast<uint8_t>(layout));
+    writeValue<uint16_t>(out, static_cast<uint16_t>(structCount));
+    for (size_t n = 0; n < structCount; n++) {
+      const auto& s = structs[n];
+      writeString(out, s.name);
+      writeValue<uint32_t>(out, s.size);
+      writeValue<uint32_t>(out, s.fieldCount);
+      for (uint32_t i = 0; i < s.fieldCount; i++) {
+        writeString(out, s.fields[i].name);
+        writeValue<uint32_t>(out, s.fields[i].offset);
+        writeValue<uint8_t>(out, static_cast<uint8_t>(s.fields[i].type));
+      }
+    }
+  }
+
+  template <size_t N>
+  static void write(std::ostream& out, std::string_view aircraft, FdrLayout layout, const FdrStruct (&structs)[N]) {
+    write(out, aircraft, layout, structs, N);
+  }
+
+ private:
+  template <typename T>
+  static void writeValue(std::ostream& out, T value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  static void writeString(std::ostream& out, std::string_view value) {
+    writeValue<uint16_t>(out, static_cast<uint16_t>(value.size()));
+    out.write(value.data(), static_cast<std::streamsize>(value.size()));
+  }
+};
@@ -0,0 +1,312 @@
+#include <dirent.h>
+#include <ini.h>
+#include <ini_type_conversion.h>
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "FlightDataRecorderWriter.h"
+
+using namespace mINI;
+
+void FlightDataRecorderWriter::initialize(std::string_view aircraftName,
+                                          uint64_t interfaceVersion,
+                                          const FdrStruct* structs,
+                                          size_t structCount,
+                                          size_t simulationTimeOffsetInBytes) {
+  aircraft = aircraftName;
+  version = interfaceVersion;
+  fdrStructs = structs;
+  fdrStructCount = structCount;
+  frameSize = getFdrFrameSize(structs, structCount);
+  simulationTimeOffset = simulationTimeOffsetInBytes;
+
+  // read configuration
+  INIStructure iniStructure;
+  INIFile iniFile(CONFIGURATION_FILEPATH);
+  if (!iniFile.read(iniStructure)) {
+    // file does not exist yet -> store the default configuration in a file
+    iniStructure["FLIGHT_DATA_RECORDER"]["ENABLED"] = "true";
+    iniStructure["FLIGHT_DATA_RECORDER"]["MAXIMUM_NUMBER_OF_FILES"] = "15";
+    iniStructure["FLIGHT_DATA_RECORDER"]["MAXIMUM_NUMBER_OF_ENTRIES_PER_FILE"] = "864000";
+    iniStructure["FLIGHT_DATA_RECORDER"]["COLUMNAR_LAYOUT"] = "false";
+    iniStructure["FLIGHT_DATA_RECORDER"]["COLUMNAR_FRAMES_PER_CHUNK"] = "1000";
+    iniStructure["FLIGHT_DATA_RECORDER"]["FRAME_BUDGET_US"] = "500";
+    iniStructure["FLIGHT_DATA_RECORDER"]["RING_CAPACITY_FRAMES"] = "600";
+    iniStructure["FLIGHT_DATA_RECORDER"]["INDEX_INTERVAL_FRAMES"] = "1000";
+    iniFile.write(iniStructure, true);
+  }
+
+  // read basic configuration
+  enabled = INITypeConversion::getBoolean(iniStructure, "FLIGHT_DATA_RECORDER", "ENABLED", true);
+  maximumFileCount = INITypeConversion::getInteger(iniStructure, "FLIGHT_DATA_RECORDER", "MAXIMUM_NUMBER_OF_FILES", 15);
+  maximumSampleCounter = INITypeConversion::getInteger(iniStructure, "FLIGHT_DATA_RECORDER", "MAXIMUM_NUMBER_OF_ENTRIES_PER_FILE", 864000);
+  isColumnarLayout = INITypeConversion::getBoolean(iniStructure, "FLIGHT_DATA_RECORDER", "COLUMNAR_LAYOUT", false);
+  framesPerChunk = std::max(1, INITypeConversion::getInteger(iniStructure, "FLIGHT_DATA_RECORDER", "COLUMNAR_FRAMES_PER_CHUNK", 1000));
+  frameBudgetMicroseconds = std::max(0, INITypeConversion::getInteger(iniStructure, "FLIGHT_DATA_RECORDER", "FRAME_BUDGET_US", 500));
+  ringCapacity = std::max(1, INITypeConversion::getInteger(iniStructure, "FLIGHT_DATA_RECORDER", "RING_CAPACITY_FRAMES", 600));
+  indexInterval = std::max(1, INITypeConversion::getInteger(iniStructure, "FLIGHT_DATA_RECORDER", "INDEX_INTERVAL_FRAMES", 1000));
+
+  // allocate the ring once, recording a frame only copies into it
+  if (enabled) {
+    ring.initialize(frameSize, ringCapacity);
+  }
+
+  // the columnar layout buffers a chunk of frames before compressing every column on its own
+  if (isColumnarLayout) {
+    columnarEncoder.initialize(structs, structCount, framesPerChunk, Z_DEFAULT_COMPRESSION);
+  }
+
+  // print configuration
+  std::cout << "WASM: Flight Data Recorder Configuration : Enabled                        = " << enabled << std::endl;
+  std::cout << "WASM: Flight Data Recorder Configuration : MaximumNumberOfFiles           = " << maximumFileCount << std::endl;
+  std::cout << "WASM: Flight Data Recorder Configuration : MaximumNumberOfEntriesPerFile  = " << maximumSampleCounter << std::endl;
+  std::cout << "WASM: Flight Data Recorder Configuration : ColumnarLayout                 = " << isColumnarLayout << std::endl;
+  std::cout << "WASM: Flight Data Recorder Configuration : ColumnarFramesPerChunk         = " << framesPerChunk << std::endl;
+  std::cout << "WASM: Flight Data Recorder Configuration : FrameBudgetMicroseconds        = " << frameBudgetMicroseconds << std::endl;
+  std::cout << "WASM: Flight Data Recorder Configuration : RingCapacityFrames             = " << ringCapacity << std::endl;
+  std::cout << "WASM: Flight Data Recorder Configuration : IndexIntervalFrames            = " << indexInterval << std::endl;
+  std::cout << "WASM: Flight Data Recorder Configuration : Interface Version              = " << version << std::endl;
+}
+
+void FlightDataRecorderWriter::recordFrame(std::initializer_list<FdrFramePart> parts) {
+  // check if enabled
+  if (!enabled) {
+    return;
+  }
+
+  // the parts have to match the structs of the field tables, otherwise the file could not be decoded
+  bool isMatchingLayout = parts.size() == fdrStructCount;
+  for (size_t i = 0; isMatchingLayout && i < fdrStructCount; i++) {
+    isMatchingLayout = parts.begin()[i].size == fdrStructs[i].size;
+  }
+  if (!isMatchingLayout) {
+    std::cout << "WASM: Flight Data Recorder frame does not match the field tables, recording disabled" << std::endl;
+    enabled = false;
+    return;
+  }
+
+  // copy the frame into the ring
+  char* frame = beginFrame();
+  if (frame != nullptr) {
+    for (const FdrFramePart& part : parts) {
+      std::memcpy(frame, part.data, part.size);
+      frame += part.size;
+    }
+    ring.commitWrite();
+  }
+
+  // compress and write pending frames within the budget
+  processPendingFrames(frameBudgetMicroseconds);
+}
+
+char* FlightDataRecorderWriter::beginFrame() {
+  // if compression cannot keep up the frame is dropped
+  char* frame = ring.beginWrite();
+  if (frame == nullptr) {
+    ringOverflowCount++;
+  }
+  return frame;
+}
+
+void FlightDataRecorderWriter::terminate() {
+  // write all pending frames without budget
+  processPendingFrames(0);
+  closeFlightDataRecorderFile();
+}
+
+void FlightDataRecorderWriter::processPendingFrames(int budgetMicroseconds) {
+  auto start = std::chrono::steady_clock::now();
+  double elapsedMicroseconds = 0;
+
+  // at least one step is done per frame, a budget of zero means no limit
+  while (processNextStep()) {
+    elapsedMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    if (budgetMicroseconds > 0 && elapsedMicroseconds >= budgetMicroseconds) {
+      break;
+    }
+  }
+
+  lastProcessingTimeMicroseconds = elapsedMicroseconds;
+}
+
+bool FlightDataRecorderWriter::processNextStep() {
+  // a full chunk is encoded one column per step
+  if (isEncodingChunk) {
+    columnarEncoder.encodeColumn(nextColumnToEncode++);
+    if (nextColumnToEncode >= columnarEncoder.getColumnCount()) {
+      writeColumnarChunk();
+      // close the file if it is considered full
+      if (sampleCounter >= maximumSampleCounter) {
+        closeFlightDataRecorderFile();
+      }
+    }
+    return true;
+  }
+
+  if (ring.isEmpty()) {
+    return false;
+  }
+
+  // do file management
+  manageFlightDataRecorderFiles();
+
+  // hand the oldest frame over to the file
+  if (isColumnarLayout) {
+    std::memcpy(columnarEncoder.getNextFrame(), ring.front(), frameSize);
+    columnarEncoder.commitFrame();
+  } else {
+    // add a full flush point to the index, decoding can start there without the data before it
+    double simulationTime = getSimulationTime(ring.front());
+    if (sampleCounter % indexInterval == 0 && gzflush(rowFile, Z_FULL_FLUSH) == Z_OK) {
+      indexEntries.push_back(
+          {static_cast<uint64_t>(sampleCounter), simulationTime, simulationTime, static_cast<uint64_t>(gzoffset(rowFile))});
+    } else if (!indexEntries.empty()) {
+      indexEntries.back().minimumSimulationTime = std::min(indexEntries.back().minimumSimulationTime, simulationTime);
+      indexEntries.back().maximumSimulationTime = std::max(indexEntries.back().maximumSimulationTime, simulationTime);
+    }
+    gzwrite(rowFile, ring.front(), frameSize);
+  }
+  ring.pop();
+  sampleCounter++;
+
+  // start encoding when the chunk is full or the file is considered full
+  if (isColumnarLayout && (columnarEncoder.isFull() || sampleCounter >= maximumSampleCounter)) {
+    isEncodingChunk = true;
+    nextColumnToEncode = 0;
+  } else if (sampleCounter >= maximumSampleCounter) {
+    closeFlightDataRecorderFile();
+  }
+
+  return true;
+}
+
+void FlightDataRecorderWriter::writeColumnarChunk() {
+  // every chunk can be decoded on its own and is added to the index
+  uint64_t firstFrame = sampleCounter - columnarEncoder.getFrameCount();
+  double firstSimulationTime = getSimulationTime(columnarEncoder.getFrame(0));
+  FdrIndexEntry entry = {firstFrame, firstSimulationTime, firstSimulationTime, static_cast<uint64_t>(fileStream->tellp())};
+  for (uint32_t i = 1; i < columnarEncoder.getFrameCount(); i++) {
+    double simulationTime = getSimulationTime(columnarEncoder.getFrame(i));
+    entry.minimumSimulationTime = std::min(entry.minimumSimulationTime, simulationTime);
+    entry.maximumSimulationTime = std::max(entry.maximumSimulationTime, simulationTime);
+  }
+  indexEntries.push_back(entry);
+  columnarEncoder.writeChunk(*fileStream);
+  isEncodingChunk = false;
+}
+
+double FlightDataRecorderWriter::getSimulationTime(const char* frame) const {
+  double simulationTime = 0;
+  std::memcpy(&simulationTime, frame + simulationTimeOffset, sizeof(simulationTime));
+  return simulationTime;
+}
+
+void FlightDataRecorderWriter::manageFlightDataRecorderFiles() {
+  if (rowFile != nullptr || fileStream) {
+    return;
+  }
+
+  // reset counter and index
+  sampleCounter = 0;
+  indexEntries.clear();
+  indexEntries.reserve(maximumSampleCounter / indexInterval + 2);
+
+  // header with version and schema describing the layout of every frame
+  std::ostringstream header;
+  header.write((char*)&version, sizeof(version));
+  FlightDataRecorderSchemaWriter::write(header, aircraft, isColumnarLayout ? FdrLayout::Columnar : FdrLayout::Row, fdrStructs,
+                                        fdrStructCount);
+
+  // create new file and write header
+  fileName = getFlightDataRecorderFilename();
+  if (isColumnarLayout) {
+    fileStream = std::make_shared<std::ofstream>(fileName, std::ios::out | std::ios::binary);
+    fileStream->write(header.str().data(), header.str().size());
+  } else {
+    rowFile = gzopen(fileName.c_str(), "wb");
+    gzwrite(rowFile, header.str().data(), header.str().size());
+  }
+
+  // clean up directory
+  cleanUpFlightDataRecorderFiles();
+}
+
+void FlightDataRecorderWriter::closeFlightDataRecorderFile() {
+  if (isColumnarLayout && fileStream) {
+    // write the remaining frames of the current chunk
+    if (!columnarEncoder.isEmpty()) {
+      if (!isEncodingChunk) {
+        nextColumnToEncode = 0;
+      }
+      while (nextColumnToEncode < columnarEncoder.getColumnCount()) {
+        columnarEncoder.encodeColumn(nextColumnToEncode++);
+      }
+      writeColumnarChunk();
+    }
+    // append index, the file is closed when the stream is destroyed
+    FlightDataRecorderIndexWriter::write(*fileStream, static_cast<uint64_t>(fileStream->tellp()), indexEntries);
+    fileStream.reset();
+  } else if (rowFile != nullptr) {
+    // finish the gzip stream and append the index behind it
+    gzclose(rowFile);
+    rowFile = nullptr;
+    std::fstream file(fileName, std::ios::in | std::ios::out | std::ios::binary | std::ios::ate);
+    FlightDataRecorderIndexWriter::write(file, static_cast<uint64_t>(file.tellp()), indexEntries);
+  }
+}
+
+std::string FlightDataRecorderWriter::getFlightDataRecorderFilename() {
+  // get time
+  auto in_time_t = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+
+  // get filepath based on time
+  std::stringstream result;
+  result << std::put_time(std::gmtime(&in_time_t), "\\work\\%Y-%m-%d-%H-%M-%S.fdr");
+
+  // return result
+  return result.str();
+}
+
+void FlightDataRecorderWriter::cleanUpFlightDataRecorderFiles() {
+  // std::vector for directory entries
+  std::vector<std::string> files;
+
+  // extension
+  std::string extension = "fdr";
+
+  // structure representing an directory entry
+  struct dirent* directoryEntry;
+
+  // open directory
+  DIR* directory = opendir("\\work");
+
+  // read directory until end
+  while ((directoryEntry = readdir(directory)) != NULL) {
+    // get filename as std::string
+    std::string filename = directoryEntry->d_name;
+
+    // check if file has right extension
+    if (filename.find(extension, (filename.length() - extension.length())) != std::string::npos) {
+      files.push_back(std::move(filename));
+    }
+  }
+
+  // close directory
+  closedir(directory);
+
+  // sort std::vector
+  std::sort(files.begin(), files.end(), std::greater<>());
+
+  // remove older files
+  while (files.size() > maximumFileCount) {
+    bool result = remove(("\\work\\" + files.back()).c_str());
+    files.pop_back();
+  }
+}
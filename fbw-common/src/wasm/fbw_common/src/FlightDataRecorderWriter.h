@@ -0,0 +1,102 @@
+#pragma once
+
+#include <fstream>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FlightDataRecorderColumnar.h"
+#include "FlightDataRecorderIndex.h"
+#include "FlightDataRecorderRing.h"
+#include "FlightDataRecorderSchema.h"
+#include "zlib.h"
+
+// a struct of the aircraft to be copied into a frame
+struct FdrFramePart {
+  const void* data;
+  size_t size;
+};
+
+// Aircraft independent part of the flight data recorder. The aircraft hands its structs to recordFrame(), everything
+// else (configuration, ring, compression, seek index and file management) is done here. The frame layout is given
+// by the field tables of the aircraft, they are written into every file so the converter does not need the structs.
+class FlightDataRecorderWriter {
+ public:
+  // the simulation time is read from every indexed frame and has to be a double at the given offset
+  void initialize(std::string_view aircraftName,
+                  uint64_t interfaceVersion,
+                  const FdrStruct* structs,
+                  size_t structCount,
+                  size_t simulationTimeOffset);
+
+  [[nodiscard]] bool isEnabled() const { return enabled; }
+
+  // copies the parts into the next frame of the ring in the order of the structs given to initialize(), then
+  // compresses and writes pending frames within the frame budget - does nothing if the recorder is disabled
+  void recordFrame(std::initializer_list<FdrFramePart> parts);
+
+  // compresses and writes pending frames within the frame budget, a budget of zero means no limit
+  void processPendingFrames(int budgetMicroseconds);
+
+  void terminate();
+
+  [[nodiscard]] size_t getFrameSize() const { return frameSize; }
+  [[nodiscard]] int getFrameBudgetMicroseconds() const { return frameBudgetMicroseconds; }
+  [[nodiscard]] double getLastProcessingTimeMicroseconds() const { return lastProcessingTimeMicroseconds; }
+  [[nodiscard]] size_t getPendingFrameCount() const { return ring.getSize(); }
+  [[nodiscard]] uint64_t getRingOverflowCount() const { return ringOverflowCount; }
+
+ private:
+  const std::string CONFIGURATION_FILEPATH = "\\work\\FlightDataRecorder.ini";
+
+  std::string aircraft;
+  uint64_t version = 0;
+  const FdrStruct* fdrStructs = nullptr;
+  size_t fdrStructCount = 0;
+  size_t frameSize = 0;
+  size_t simulationTimeOffset = 0;
+
+  bool enabled = false;
+  int sampleCounter = 0;
+  int maximumSampleCounter = 0;
+  int maximumFileCount = 0;
+  bool isColumnarLayout = false;
+  int framesPerChunk = 0;
+  int frameBudgetMicroseconds = 0;
+  int ringCapacity = 0;
+  int indexInterval = 0;
+
+  // the row layout is written as a single gzip stream, the columnar layout compresses every column on its own
+  std::string fileName;
+  gzFile rowFile = nullptr;
+  std::shared_ptr<std::ofstream> fileStream;
+  std::vector<FdrIndexEntry> indexEntries;
+
+  // frames are only copied into the ring on update, compression and file output happen within the frame budget
+  FlightDataRecorderRing ring;
+  uint64_t ringOverflowCount = 0;
+  double lastProcessingTimeMicroseconds = 0;
+
+  FlightDataRecorderColumnarEncoder columnarEncoder;
+  bool isEncodingChunk = false;
+  size_t nextColumnToEncode = 0;
+
+  // returns the buffer for the next frame or nullptr if the ring is full and the frame has to be dropped
+  char* beginFrame();
+
+  bool processNextStep();
+
+  void writeColumnarChunk();
+
+  double getSimulationTime(const char* frame) const;
+
+  void manageFlightDataRecorderFiles();
+
+  void closeFlightDataRecorderFile();
+
+  std::string getFlightDataRecorderFilename();
+
+  void cleanUpFlightDataRecorderFiles();
+};
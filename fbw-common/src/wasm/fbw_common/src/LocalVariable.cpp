@@ -1,28 +1,48 @@
+#include <chrono>
+
 #include "LocalVariable.h"
 
-using std::cout;
-using std::endl;
-using std::set;
 using std::string;
+using std::vector;
+
+LOCAL_VARIABLE_STORAGE vector<LocalVariable*> LocalVariable::LOCAL_VARIABLES;
+LOCAL_VARIABLE_STORAGE vector<ID> LocalVariable::IDS;
+LOCAL_VARIABLE_STORAGE vector<double> LocalVariable::VALUES;
+LOCAL_VARIABLE_STORAGE vector<uint8_t> LocalVariable::IS_WRITE_PENDING;
 
-set<LocalVariable*> LocalVariable::LOCAL_VARIABLES;
+LOCAL_VARIABLE_STORAGE bool LocalVariable::isDeferringWrites = false;
+LOCAL_VARIABLE_STORAGE LocalVariableBatchStatistics LocalVariable::readAllStatistics;
+LOCAL_VARIABLE_STORAGE LocalVariableBatchStatistics LocalVariable::writeAllStatistics;
 
 LocalVariable::LocalVariable(const string& variable, bool shouldUseDirtyState) {
   // initialize variables
   useDirtyState = shouldUseDirtyState;
   isDirty = false;
-  value = 0.0;
   name = variable;
-  // register variable
-  id = register_named_variable(name.c_str());
+  // register variable and remember it in the global list (for readAll and writeAll)
+  index = LOCAL_VARIABLES.size();
+  LOCAL_VARIABLES.push_back(this);
+  IDS.push_back(register_named_variable(name.c_str()));
+  VALUES.push_back(0.0);
+  IS_WRITE_PENDING.push_back(false);
   // read current value
   read();
-  // remember in global list (for readAll)
-  LOCAL_VARIABLES.insert(this);
 }
 
 LocalVariable::~LocalVariable() {
-  LOCAL_VARIABLES.erase(this);
+  // move the last variable into the free slot to keep the arrays dense
+  size_t last = LOCAL_VARIABLES.size() - 1;
+  if (index != last) {
+    LOCAL_VARIABLES[index] = LOCAL_VARIABLES[last];
+    IDS[index] = IDS[last];
+    VALUES[index] = VALUES[last];
+    IS_WRITE_PENDING[index] = IS_WRITE_PENDING[last];
+    LOCAL_VARIABLES[index]->index = index;
+  }
+  LOCAL_VARIABLES.pop_back();
+  IDS.pop_back();
+  VALUES.pop_back();
+  IS_WRITE_PENDING.pop_back();
 }
 
 string LocalVariable::getName() {
@@ -33,37 +53,76 @@ double LocalVariable::get(bool shouldRead) {
   if (shouldRead) {
     read();
   }
-  return value;
+  return VALUES[index];
 }
 
 void LocalVariable::set(double newValue, bool shouldWrite) {
-  value = newValue;
+  VALUES[index] = newValue;
   isDirty = true;
   if (shouldWrite) {
-    write();
+    if (isDeferringWrites) {
+      IS_WRITE_PENDING[index] = true;
+    } else {
+      write();
+    }
   }
 }
 
+void LocalVariable::setImmediate(double newValue) {
+  VALUES[index] = newValue;
+  isDirty = true;
+  write();
+}
+
 void LocalVariable::read() {
-  value = get_named_variable_value(id);
+  // the sim still has the old value until the pending write is done
+  if (IS_WRITE_PENDING[index]) {
+    return;
+  }
+  VALUES[index] = get_named_variable_value(IDS[index]);
 }
 
 void LocalVariable::write() {
+  IS_WRITE_PENDING[index] = false;
   if (useDirtyState && !isDirty) {
     return;
   }
-  set_named_variable_value(id, value);
+  set_named_variable_value(IDS[index], VALUES[index]);
   isDirty = false;
 }
 
 void LocalVariable::readAll() {
-  for (auto variable : LOCAL_VARIABLES) {
-    variable->read();
+  auto start = std::chrono::steady_clock::now();
+
+  const size_t size = IDS.size();
+  uint64_t count = 0;
+  for (size_t i = 0; i < size; i++) {
+    if (!IS_WRITE_PENDING[i]) {
+      VALUES[i] = get_named_variable_value(IDS[i]);
+      count++;
+    }
   }
+
+  readAllStatistics.count = count;
+  readAllStatistics.timeMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
 }
 
 void LocalVariable::writeAll() {
-  for (auto variable : LOCAL_VARIABLES) {
-    variable->write();
+  auto start = std::chrono::steady_clock::now();
+
+  const size_t size = IDS.size();
+  uint64_t count = 0;
+  for (size_t i = 0; i < size; i++) {
+    LocalVariable* variable = LOCAL_VARIABLES[i];
+    IS_WRITE_PENDING[i] = false;
+    if (variable->useDirtyState && !variable->isDirty) {
+      continue;
+    }
+    set_named_variable_value(IDS[i], VALUES[i]);
+    variable->isDirty = false;
+    count++;
   }
+
+  writeAllStatistics.count = count;
+  writeAllStatistics.timeMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
 }
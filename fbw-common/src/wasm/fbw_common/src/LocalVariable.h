@@ -1,34 +1,69 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
-#include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <MSFS/Legacy/gauges.h>
 
+// the native model build runs independent simulations on several threads, each of them has its own
+// local variables as the named variables of the native gauges stub are kept per thread as well
+#ifdef FBW_NATIVE
+#define LOCAL_VARIABLE_STORAGE thread_local
+#else
+#define LOCAL_VARIABLE_STORAGE
+#endif
+
+// Counts and time of the last batched read or write pass over all local variables
+struct LocalVariableBatchStatistics {
+  uint64_t count = 0;
+  double timeMicroseconds = 0;
+};
+
 class LocalVariable {
  public:
   explicit LocalVariable(const std::string& name, bool shouldUseDirtyState = true);
+  LocalVariable(const LocalVariable&) = delete;
+  LocalVariable& operator=(const LocalVariable&) = delete;
   ~LocalVariable();
 
   std::string getName();
 
   double get(bool shouldRead = false);
   void set(double newValue, bool shouldWrite = true);
+  // writes the value right away also when writes are deferred, e.g. for data read by an event fired next
+  void setImmediate(double newValue);
 
+  // keeps the value while a deferred write is pending
   void read();
   void write();
 
+  // reads all local variables in one pass, variables with a deferred write pending keep their value
   static void readAll();
+  // writes all dirty local variables in one pass
   static void writeAll();
 
+  // when enabled set() only marks the variable and the value is written by the next writeAll()
+  static void setDeferredWrites(bool isEnabled) { isDeferringWrites = isEnabled; }
+
+  static const LocalVariableBatchStatistics& getReadAllStatistics() { return readAllStatistics; }
+  static const LocalVariableBatchStatistics& getWriteAllStatistics() { return writeAllStatistics; }
+
  private:
-  static std::set<LocalVariable*> LOCAL_VARIABLES;
+  // ids and values of all local variables are kept in dense arrays so a batch pass is a single loop over them
+  static LOCAL_VARIABLE_STORAGE std::vector<LocalVariable*> LOCAL_VARIABLES;
+  static LOCAL_VARIABLE_STORAGE std::vector<ID> IDS;
+  static LOCAL_VARIABLE_STORAGE std::vector<double> VALUES;
+  static LOCAL_VARIABLE_STORAGE std::vector<uint8_t> IS_WRITE_PENDING;
+
+  static LOCAL_VARIABLE_STORAGE bool isDeferringWrites;
+  static LOCAL_VARIABLE_STORAGE LocalVariableBatchStatistics readAllStatistics;
+  static LOCAL_VARIABLE_STORAGE LocalVariableBatchStatistics writeAllStatistics;
 
-  ID id;
+  size_t index;
   std::string name;
   bool useDirtyState;
   bool isDirty;
-  double value;
 };
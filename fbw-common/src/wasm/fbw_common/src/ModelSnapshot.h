@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Flat copy of the complete state of a trivially copyable type, used to rewind the computers or to fork
+// many simulations from one state.
+//
+// The generated models are the exception: they keep all of their state in plain structs inside the instance
+// (_U, _Y, _B and _DWork) and their parameters are static, so the bytes of an instance are its state, but the
+// code generator deletes their copy and move and gives them an empty user-provided destructor, which makes
+// them not trivially copyable. Such a type, or a computer wrapping one, is snapshotted only after it has been
+// checked to have no virtual functions and to neither own memory nor point into itself, and then opts in by
+// specializing isModelSnapshotOptIn next to its declaration.
+//
+// A snapshot must be restored into the instance it was saved from or into one constructed with the same
+// arguments, as constant members (e.g. the unit number of a computer) are part of the copied bytes.
+template <typename T>
+inline constexpr bool isModelSnapshotOptIn = false;
+
+template <typename T>
+class ModelSnapshot {
+  using Element = std::remove_all_extents_t<T>;
+
+  static_assert(std::is_trivially_copyable_v<T> || isModelSnapshotOptIn<Element>,
+                "only the bytes of a trivially copyable type, or of a generated model opted in, are its state");
+  static_assert(!std::is_polymorphic_v<Element>, "restoring the bytes of a polymorphic type overwrites its virtual table pointer");
+
+ public:
+  // all memory is allocated here, so saving and restoring only copy the state
+  ModelSnapshot() : state(sizeof(T)) {}
+
+  void save(const T& instance) {
+    std::memcpy(state.data(), static_cast<const void*>(&instance), sizeof(T));
+    saved = true;
+  }
+
+  // returns false and leaves the instance untouched if nothing has been saved yet
+  bool restore(T& instance) const {
+    if (!saved) {
+      return false;
+    }
+    std::memcpy(static_cast<void*>(&instance), state.data(), sizeof(T));
+    return true;
+  }
+
+  [[nodiscard]] bool isSaved() const { return saved; }
+
+ private:
+  std::vector<std::byte> state;
+  bool saved = false;
+};
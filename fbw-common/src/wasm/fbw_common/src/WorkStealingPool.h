@@ -0,0 +1,70 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Runs a fixed set of tasks on a number of threads. Every thread owns a queue and takes tasks from its front,
+// a thread that runs out of tasks steals from the back of the other queues. Tasks should be sorted by cost with
+// the most expensive first so that the long running ones start early.
+// Only used by the host tools (fdr2csv and the native builds), the WASM modules are single threaded.
+class WorkStealingPool {
+ public:
+  explicit WorkStealingPool(unsigned int numberOfThreads) : threadCount(std::max(1u, numberOfThreads)) {}
+
+  // distributes the tasks over the queues and returns when all of them are done
+  void run(const std::vector<std::function<void()>>& tasks) {
+    std::vector<Queue> queues(threadCount);
+    for (size_t i = 0; i < tasks.size(); i++) {
+      queues[i % threadCount].tasks.push_back(i);
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (unsigned int t = 0; t < threadCount; t++) {
+      threads.emplace_back([&tasks, &queues, t, this]() {
+        size_t task = 0;
+        while (takeTask(queues, t, task)) {
+          tasks[task]();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<size_t> tasks;
+  };
+
+  unsigned int threadCount;
+
+  bool takeTask(std::vector<Queue>& queues, unsigned int owner, size_t& task) const {
+    // own queue first
+    {
+      std::lock_guard<std::mutex> lock(queues[owner].mutex);
+      if (!queues[owner].tasks.empty()) {
+        task = queues[owner].tasks.front();
+        queues[owner].tasks.pop_front();
+        return true;
+      }
+    }
+    // steal from the other queues, no tasks are added while running so all queues being empty means done
+    for (unsigned int i = 1; i < threadCount; i++) {
+      auto& victim = queues[(owner + i) % threadCount];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (!victim.tasks.empty()) {
+        task = victim.tasks.back();
+        victim.tasks.pop_back();
+        return true;
+      }
+    }
+    return false;
+  }
+};
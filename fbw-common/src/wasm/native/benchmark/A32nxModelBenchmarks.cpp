@@ -0,0 +1,125 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Benchmarks of the step() of the A32NX flight control and autopilot models.
+//
+// The computers are benchmarked as a single computer. The buses of the other computers are not
+// transmitting, except for the words the ELAC needs for normal law: the SECs report their spoilers
+// as available and the opposite ELAC reports the capabilities of the benchmarked one. Surface
+// positions follow the orders of the previous step.
+
+#include <cstdint>
+#include <iostream>
+
+#include "ElacComputer.h"
+#include "SecComputer.h"
+
+#include "AutopilotBenchmarks.h"
+#include "FacComputerBenchmarks.h"
+#include "FlightScenarios.h"
+#include "ModelBenchmark.h"
+
+constexpr double TOTAL_WEIGHT_KG = 64000;
+constexpr double HYDRAULIC_PRESSURE_PSI = 3000;
+
+static void fillElacInputs(ElacComputer::ExternalInputs_ElacComputer_T& inputs, const FlightState& state, const elac_outputs& previous) {
+  const bool slatsOut = state.condition.flapsConf != FlapsConf::CONF_0;
+  elac_inputs& in = inputs.in;
+
+  fillTime(in.time, state);
+  fillSimData(in.sim_data);
+
+  // ELAC 1 with the pitch axis of ELAC 2 failed, so it computes both the pitch and roll laws
+  in.discrete_inputs.is_unit_1 = true;
+  in.discrete_inputs.opp_axis_pitch_failure = true;
+  in.discrete_inputs.ap_1_disengaged = true;
+  in.discrete_inputs.ap_2_disengaged = true;
+  in.discrete_inputs.sfcc_1_slats_out = slatsOut;
+  in.discrete_inputs.sfcc_2_slats_out = slatsOut;
+  in.discrete_inputs.elac_engaged_from_switch = true;
+
+  in.analog_inputs.capt_pitch_stick_pos = state.pitchStick;
+  in.analog_inputs.capt_roll_stick_pos = state.rollStick;
+  in.analog_inputs.left_elevator_pos_deg = previous.analog_outputs.left_elev_pos_order_deg;
+  in.analog_inputs.right_elevator_pos_deg = previous.analog_outputs.right_elev_pos_order_deg;
+  in.analog_inputs.ths_pos_deg = previous.analog_outputs.ths_pos_order;
+  in.analog_inputs.left_aileron_pos_deg = previous.analog_outputs.left_aileron_pos_order;
+  in.analog_inputs.right_aileron_pos_deg = previous.analog_outputs.right_aileron_pos_order;
+  in.analog_inputs.load_factor_acc_1_g = state.nzG;
+  in.analog_inputs.load_factor_acc_2_g = state.nzG;
+  in.analog_inputs.blue_hyd_pressure_psi = HYDRAULIC_PRESSURE_PSI;
+  in.analog_inputs.green_hyd_pressure_psi = HYDRAULIC_PRESSURE_PSI;
+  in.analog_inputs.yellow_hyd_pressure_psi = HYDRAULIC_PRESSURE_PSI;
+
+  fillAdrBus(in.bus_inputs.adr_1_bus, state, 0);
+  fillAdrBus(in.bus_inputs.adr_2_bus, state, 1);
+  fillAdrBus(in.bus_inputs.adr_3_bus, state, 2);
+  fillIrBus(in.bus_inputs.ir_1_bus, state, 0);
+  fillIrBus(in.bus_inputs.ir_2_bus, state, 1);
+  fillIrBus(in.bus_inputs.ir_3_bus, state, 2);
+  fillRaBus(in.bus_inputs.ra_1_bus, state, 0);
+  fillRaBus(in.bus_inputs.ra_2_bus, state, 1);
+  fillSfccBus(in.bus_inputs.sfcc_1_bus, state);
+  fillSfccBus(in.bus_inputs.sfcc_2_bus, state);
+  // the SECs report their roll spoilers as available, which the ELAC needs for normal law
+  setDiscreteWord(in.bus_inputs.sec_1_bus.discrete_status_word_1, {15, 16});
+  setDiscreteWord(in.bus_inputs.sec_2_bus.discrete_status_word_1, {15});
+  // a healthy opposite ELAC reports the same capabilities as this one
+  in.bus_inputs.elac_opp_bus = previous.bus_outputs;
+}
+
+static void fillSecInputs(SecComputer::ExternalInputs_SecComputer_T& inputs, const FlightState& state, const sec_outputs& previous) {
+  const bool slatsOut = state.condition.flapsConf != FlapsConf::CONF_0;
+  sec_inputs& in = inputs.in;
+
+  fillTime(in.time, state);
+  fillSimData(in.sim_data);
+
+  in.discrete_inputs.sec_engaged_from_switch = true;
+  in.discrete_inputs.is_unit_1 = true;
+  in.discrete_inputs.sfcc_1_slats_out = slatsOut;
+  in.discrete_inputs.sfcc_2_slats_out = slatsOut;
+
+  in.analog_inputs.capt_pitch_stick_pos = state.pitchStick;
+  in.analog_inputs.capt_roll_stick_pos = state.rollStick;
+  in.analog_inputs.thr_lever_1_pos = 25;
+  in.analog_inputs.thr_lever_2_pos = 25;
+  in.analog_inputs.left_elevator_pos_deg = previous.analog_outputs.left_elev_pos_order_deg;
+  in.analog_inputs.right_elevator_pos_deg = previous.analog_outputs.right_elev_pos_order_deg;
+  in.analog_inputs.ths_pos_deg = previous.analog_outputs.ths_pos_order_deg;
+  in.analog_inputs.left_spoiler_1_pos_deg = previous.analog_outputs.left_spoiler_1_pos_order_deg;
+  in.analog_inputs.right_spoiler_1_pos_deg = previous.analog_outputs.right_spoiler_1_pos_order_deg;
+  in.analog_inputs.left_spoiler_2_pos_deg = previous.analog_outputs.left_spoiler_2_pos_order_deg;
+  in.analog_inputs.right_spoiler_2_pos_deg = previous.analog_outputs.right_spoiler_2_pos_order_deg;
+  in.analog_inputs.load_factor_acc_1_g = state.nzG;
+  in.analog_inputs.load_factor_acc_2_g = state.nzG;
+
+  fillAdrBus(in.bus_inputs.adr_1_bus, state, 0);
+  fillAdrBus(in.bus_inputs.adr_2_bus, state, 1);
+  fillIrBus(in.bus_inputs.ir_1_bus, state, 0);
+  fillIrBus(in.bus_inputs.ir_2_bus, state, 1);
+  fillSfccBus(in.bus_inputs.sfcc_1_bus, state);
+  fillSfccBus(in.bus_inputs.sfcc_2_bus, state);
+  fillLgciuBus(in.bus_inputs.lgciu_1_bus, state);
+  fillLgciuBus(in.bus_inputs.lgciu_2_bus, state);
+}
+
+int main(int argc, char** argv) {
+  ModelBenchmarkRunner runner{"A32NX", ModelBenchmarkRunner::parseArguments(argc, argv)};
+
+  for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+    runModelBenchmark<ElacComputer, ElacComputer::ExternalInputs_ElacComputer_T>(
+        runner, "ElacComputer", condition,
+        [](auto& inputs, const FlightState& state, std::uint64_t, const auto& previous) { fillElacInputs(inputs, state, previous); });
+  }
+  for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+    runModelBenchmark<SecComputer, SecComputer::ExternalInputs_SecComputer_T>(
+        runner, "SecComputer", condition,
+        [](auto& inputs, const FlightState& state, std::uint64_t, const auto& previous) { fillSecInputs(inputs, state, previous); });
+  }
+  runFacComputerBenchmarks(runner);
+  runAutopilotBenchmarks<AutothrustModelClass>(runner, TOTAL_WEIGHT_KG);
+
+  runner.report(std::cout);
+  return 0;
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Benchmarks of the step() of the A380X flight control and autopilot models.
+//
+// The computers are benchmarked as a single computer. The buses of the other computers are not
+// transmitting, except for the surface status words the PRIM needs for normal law. Without the
+// PRIM buses the SEC controls the surfaces in direct law. Surface positions follow the orders of
+// the previous step.
+//
+// The PRIM does not degrade its law on ADR failures, it stays in normal law in the alternate-law
+// scenario.
+
+#include <cstdint>
+#include <iostream>
+
+#include "A380PrimComputer.h"
+#include "A380SecComputer.h"
+
+#include "AutopilotBenchmarks.h"
+#include "FacComputerBenchmarks.h"
+#include "FlightScenarios.h"
+#include "ModelBenchmark.h"
+
+constexpr double TOTAL_WEIGHT_KG = 380000;
+constexpr double HYDRAULIC_PRESSURE_PSI = 5000;
+
+/**
+ * Sets the status words of another PRIM or SEC to report all its ailerons and elevators as
+ * engaged. The PRIM counts the engaged surfaces reported by the other computers to select the
+ * pitch law.
+ */
+template <typename ComputerBus>
+void fillSurfacesEngaged(ComputerBus& bus) {
+  setDiscreteWord(bus.aileron_status_word, {12, 15, 18, 21});
+  setDiscreteWord(bus.elevator_status_word, {12, 15, 18, 21});
+}
+
+static void fillPrimInputs(A380PrimComputer::ExternalInputs_A380PrimComputer_T& inputs,
+                           const FlightState& state,
+                           const prim_outputs& previous) {
+  prim_inputs& in = inputs.in;
+
+  fillTime(in.time, state);
+  fillSimData(in.sim_data);
+
+  in.discrete_inputs.prim_overhead_button_pressed = true;
+  in.discrete_inputs.is_unit_1 = true;
+  in.discrete_inputs.fcu_healthy = true;
+
+  in.analog_inputs.capt_pitch_stick_pos = state.pitchStick;
+  in.analog_inputs.capt_roll_stick_pos = state.rollStick;
+  in.analog_inputs.thr_lever_1_pos = 25;
+  in.analog_inputs.thr_lever_2_pos = 25;
+  in.analog_inputs.thr_lever_3_pos = 25;
+  in.analog_inputs.thr_lever_4_pos = 25;
+  in.analog_inputs.elevator_1_pos_deg = previous.analog_outputs.elevator_1_pos_order_deg;
+  in.analog_inputs.elevator_2_pos_deg = previous.analog_outputs.elevator_2_pos_order_deg;
+  in.analog_inputs.elevator_3_pos_deg = previous.analog_outputs.elevator_3_pos_order_deg;
+  in.analog_inputs.ths_pos_deg = previous.analog_outputs.ths_pos_order_deg;
+  in.analog_inputs.left_aileron_1_pos_deg = previous.analog_outputs.left_aileron_1_pos_order_deg;
+  in.analog_inputs.left_aileron_2_pos_deg = previous.analog_outputs.left_aileron_2_pos_order_deg;
+  in.analog_inputs.right_aileron_1_pos_deg = previous.analog_outputs.right_aileron_1_pos_order_deg;
+  in.analog_inputs.right_aileron_2_pos_deg = previous.analog_outputs.right_aileron_2_pos_order_deg;
+  in.analog_inputs.left_spoiler_pos_deg = previous.analog_outputs.left_spoiler_pos_order_deg;
+  in.analog_inputs.right_spoiler_pos_deg = previous.analog_outputs.right_spoiler_pos_order_deg;
+  in.analog_inputs.rudder_1_pos_deg = previous.analog_outputs.rudder_1_pos_order_deg;
+  in.analog_inputs.rudder_2_pos_deg = previous.analog_outputs.rudder_2_pos_order_deg;
+  in.analog_inputs.yellow_hyd_pressure_psi = HYDRAULIC_PRESSURE_PSI;
+  in.analog_inputs.green_hyd_pressure_psi = HYDRAULIC_PRESSURE_PSI;
+  in.analog_inputs.vert_acc_1_g = state.nzG;
+  in.analog_inputs.vert_acc_2_g = state.nzG;
+  in.analog_inputs.vert_acc_3_g = state.nzG;
+
+  fillAdrBus(in.bus_inputs.adr_1_bus, state, 0);
+  fillAdrBus(in.bus_inputs.adr_2_bus, state, 1);
+  fillAdrBus(in.bus_inputs.adr_3_bus, state, 2);
+  fillIrBus(in.bus_inputs.ir_1_bus, state, 0);
+  fillIrBus(in.bus_inputs.ir_2_bus, state, 1);
+  fillIrBus(in.bus_inputs.ir_3_bus, state, 2);
+  fillRaBus(in.bus_inputs.ra_1_bus, state, 0);
+  fillRaBus(in.bus_inputs.ra_2_bus, state, 1);
+  fillSfccBus(in.bus_inputs.sfcc_1_bus, state);
+  fillSfccBus(in.bus_inputs.sfcc_2_bus, state);
+  fillSurfacesEngaged(in.bus_inputs.prim_x_bus);
+  fillSurfacesEngaged(in.bus_inputs.prim_y_bus);
+  fillSurfacesEngaged(in.bus_inputs.sec_1_bus);
+  fillSurfacesEngaged(in.bus_inputs.sec_2_bus);
+  fillSurfacesEngaged(in.bus_inputs.sec_3_bus);
+}
+
+static void fillSecInputs(A380SecComputer::ExternalInputs_A380SecComputer_T& inputs,
+                          const FlightState& state,
+                          const sec_outputs& previous) {
+  sec_inputs& in = inputs.in;
+
+  fillTime(in.time, state);
+  fillSimData(in.sim_data);
+
+  in.discrete_inputs.sec_overhead_button_pressed = true;
+  in.discrete_inputs.is_unit_1 = true;
+
+  in.analog_inputs.capt_pitch_stick_pos = state.pitchStick;
+  in.analog_inputs.capt_roll_stick_pos = state.rollStick;
+  in.analog_inputs.elevator_1_pos_deg = previous.analog_outputs.elevator_1_pos_order_deg;
+  in.analog_inputs.elevator_2_pos_deg = previous.analog_outputs.elevator_2_pos_order_deg;
+  in.analog_inputs.elevator_3_pos_deg = previous.analog_outputs.elevator_3_pos_order_deg;
+  in.analog_inputs.ths_pos_deg = previous.analog_outputs.ths_pos_order_deg;
+  in.analog_inputs.left_aileron_1_pos_deg = previous.analog_outputs.left_aileron_1_pos_order_deg;
+  in.analog_inputs.left_aileron_2_pos_deg = previous.analog_outputs.left_aileron_2_pos_order_deg;
+  in.analog_inputs.right_aileron_1_pos_deg = previous.analog_outputs.right_aileron_1_pos_order_deg;
+  in.analog_inputs.right_aileron_2_pos_deg = previous.analog_outputs.right_aileron_2_pos_order_deg;
+  in.analog_inputs.left_spoiler_1_pos_deg = previous.analog_outputs.left_spoiler_1_pos_order_deg;
+  in.analog_inputs.right_spoiler_1_pos_deg = previous.analog_outputs.right_spoiler_1_pos_order_deg;
+  in.analog_inputs.left_spoiler_2_pos_deg = previous.analog_outputs.left_spoiler_2_pos_order_deg;
+  in.analog_inputs.right_spoiler_2_pos_deg = previous.analog_outputs.right_spoiler_2_pos_order_deg;
+  in.analog_inputs.rudder_1_pos_deg = previous.analog_outputs.rudder_1_pos_order_deg;
+  in.analog_inputs.rudder_2_pos_deg = previous.analog_outputs.rudder_2_pos_order_deg;
+  in.analog_inputs.rudder_trim_pos_deg = previous.analog_outputs.rudder_trim_pos_order_deg;
+
+  fillAdrBus(in.bus_inputs.adr_1_bus, state, 0);
+  fillAdrBus(in.bus_inputs.adr_2_bus, state, 1);
+  fillIrBus(in.bus_inputs.ir_1_bus, state, 0);
+  fillIrBus(in.bus_inputs.ir_2_bus, state, 1);
+  fillSfccBus(in.bus_inputs.sfcc_1_bus, state);
+  fillSfccBus(in.bus_inputs.sfcc_2_bus, state);
+}
+
+int main(int argc, char** argv) {
+  ModelBenchmarkRunner runner{"A380X", ModelBenchmarkRunner::parseArguments(argc, argv)};
+
+  for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+    runModelBenchmark<A380PrimComputer, A380PrimComputer::ExternalInputs_A380PrimComputer_T>(
+        runner, "A380PrimComputer", condition,
+        [](auto& inputs, const FlightState& state, std::uint64_t, const auto& previous) { fillPrimInputs(inputs, state, previous); });
+  }
+  for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+    runModelBenchmark<A380SecComputer, A380SecComputer::ExternalInputs_A380SecComputer_T>(
+        runner, "A380SecComputer", condition,
+        [](auto& inputs, const FlightState& state, std::uint64_t, const auto& previous) { fillSecInputs(inputs, state, previous); });
+  }
+  runFacComputerBenchmarks(runner);
+  runAutopilotBenchmarks<Autothrust>(runner, TOTAL_WEIGHT_KG);
+
+  runner.report(std::cout);
+  return 0;
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Benchmarks of the autopilot and autothrust models. Both aircraft use models with the same
+// names and interfaces, this header is compiled against the models of the aircraft whose model
+// directory is on the include path.
+
+#ifndef FLYBYWIRE_NATIVE_AUTOPILOTBENCHMARKS_H
+#define FLYBYWIRE_NATIVE_AUTOPILOTBENCHMARKS_H
+
+#include <cstdint>
+#include <memory>
+
+#include "AutopilotLaws.h"
+#include "AutopilotStateMachine.h"
+#include "Autothrust.h"
+
+#include "FlightScenarios.h"
+#include "ModelBenchmark.h"
+
+// frames of a scenario at which the FCU buttons are pushed during the warm-up
+constexpr std::uint64_t ATHR_PUSH_FRAME = 30;
+constexpr std::uint64_t AP_PUSH_FRAME = 200;
+constexpr std::uint64_t APPR_PUSH_FRAME = 230;
+// frames the state machine runs to engage the modes of a scenario for the laws and autothrust
+constexpr std::uint64_t AUTOPILOT_SETTLE_FRAMES = 450;
+
+inline void fillAutopilotStateMachineInputs(AutopilotStateMachineModelClass::ExternalInputs_AutopilotStateMachine_T& inputs,
+                                            const FlightState& state,
+                                            std::uint64_t frame,
+                                            double totalWeightKg) {
+  const FlightCondition& c = state.condition;
+
+  inputs.in.time.dt = SAMPLE_TIME_SECONDS;
+  inputs.in.time.simulation_time = state.timeSeconds;
+  fillAutopilotData(inputs.in.data, state);
+  inputs.in.data.total_weight_kg = totalWeightKg;
+
+  ap_raw_sm_input& input = inputs.in.input;
+  input.FD_active = true;
+  input.AP_1_push = frame == AP_PUSH_FRAME;
+  input.APPR_push = c.approach && frame == APPR_PUSH_FRAME;
+  input.V_fcu_kn = c.iasKn;
+  input.Psi_fcu_deg = c.headingDeg;
+  input.H_fcu_ft = c.approach ? 3000 : c.altitudeFt;
+  input.H_constraint_ft = 0;
+  input.H_dot_fcu_fpm = 0;
+  input.FPA_fcu_deg = 0;
+  input.MACH_mode = !c.approach;
+  input.ATHR_engaged = true;
+  input.is_SPEED_managed = true;
+  input.FM_requested_vertical_mode = fm_requested_vertical_mode_NONE;
+  input.TCAS_mode_available = true;
+  input.condition_Flare = c.approach && state.radioHeightFt < 40;
+}
+
+template <typename AutothrustInputs>
+void fillAutothrustInputs(AutothrustInputs& inputs, const FlightState& state, std::uint64_t frame, const ap_raw_laws_input& autopilot) {
+  const FlightCondition& c = state.condition;
+
+  inputs.in.time.dt = SAMPLE_TIME_SECONDS;
+  inputs.in.time.simulation_time = state.timeSeconds;
+  fillAutothrustData(inputs.in.data, state);
+
+  auto& input = inputs.in.input;
+  input.ATHR_push = frame == ATHR_PUSH_FRAME;
+  // thrust levers in the climb detent, four engines on the A380
+  input.TLA_1_deg = 25;
+  input.TLA_2_deg = 25;
+  if constexpr (requires { input.TLA_4_deg; }) {
+    input.TLA_3_deg = 25;
+    input.TLA_4_deg = 25;
+  }
+  input.V_c_kn = c.iasKn;
+  input.V_LS_kn = c.flapsConf == FlapsConf::CONF_0 ? 210 : 132;
+  input.V_MAX_kn = c.flapsConf == FlapsConf::CONF_0 ? 340 : 177;
+  input.thrust_limit_REV_percent = 79;
+  input.thrust_limit_IDLE_percent = c.approach ? 25 : 60;
+  input.thrust_limit_CLB_percent = 89;
+  input.thrust_limit_MCT_percent = 93;
+  input.thrust_limit_FLEX_percent = 0;
+  input.thrust_limit_TOGA_percent = 97;
+  input.mode_requested = autopilot.autothrust_mode;
+  input.is_mach_mode_active = !c.approach;
+  input.is_approach_mode_active = autopilot.vertical_mode >= 30 && autopilot.vertical_mode <= 34;
+  input.is_LAND_mode_active = autopilot.vertical_mode == 32;
+  input.thrust_reduction_altitude = 1500;
+  input.thrust_reduction_altitude_go_around = 1500;
+  input.flight_phase = c.approach ? 5 : 3;
+  input.is_alt_soft_mode_active = autopilot.ALT_soft_mode_active;
+  input.FD_active = true;
+  input.target_TCAS_RA_rate_fpm = autopilot.H_dot_c_fpm;
+}
+
+/**
+ * Runs the state machine through the start of a scenario so the autopilot is engaged in the
+ * modes of the scenario.
+ * @return the output of the state machine which is the input of the laws
+ */
+inline ap_raw_laws_input settleAutopilot(const FlightCondition& condition, double totalWeightKg) {
+  auto stateMachine = std::make_unique<AutopilotStateMachineModelClass>();
+  auto inputs = std::make_unique<AutopilotStateMachineModelClass::ExternalInputs_AutopilotStateMachine_T>();
+  stateMachine->initialize();
+  for (std::uint64_t frame = 0; frame < AUTOPILOT_SETTLE_FRAMES; frame++) {
+    fillAutopilotStateMachineInputs(*inputs, FlightState::at(condition, frame), frame, totalWeightKg);
+    stateMachine->setExternalInputs(inputs.get());
+    stateMachine->step();
+  }
+  return stateMachine->getExternalOutputs().out.output;
+}
+
+/**
+ * Runs the benchmarks of the autopilot state machine, the autopilot laws and the autothrust in
+ * all scenarios. The autopilot is engaged during the warm-up, the laws and the autothrust run
+ * with the modes the state machine engaged in the scenario.
+ * @tparam AutothrustModel the autothrust model class, its name differs between the aircraft
+ * @param runner the runner of the benchmarks
+ * @param totalWeightKg the weight of the aircraft
+ */
+template <typename AutothrustModel>
+void runAutopilotBenchmarks(ModelBenchmarkRunner& runner, double totalWeightKg) {
+  for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+    runModelBenchmark<AutopilotStateMachineModelClass, AutopilotStateMachineModelClass::ExternalInputs_AutopilotStateMachine_T>(
+        runner, "AutopilotStateMachine", condition, [&](auto& inputs, const FlightState& state, std::uint64_t frame, const auto&) {
+          fillAutopilotStateMachineInputs(inputs, state, frame, totalWeightKg);
+        });
+  }
+
+  for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+    const ap_raw_laws_input autopilot = settleAutopilot(condition, totalWeightKg);
+    runModelBenchmark<AutopilotLawsModelClass, AutopilotLawsModelClass::ExternalInputs_AutopilotLaws_T>(
+        runner, "AutopilotLaws", condition, [&](auto& inputs, const FlightState& state, std::uint64_t, const auto&) {
+          inputs.in.time.dt = SAMPLE_TIME_SECONDS;
+          inputs.in.time.simulation_time = state.timeSeconds;
+          fillAutopilotData(inputs.in.data, state);
+          inputs.in.data.total_weight_kg = totalWeightKg;
+          inputs.in.input = autopilot;
+        });
+  }
+
+  for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+    const ap_raw_laws_input autopilot = settleAutopilot(condition, totalWeightKg);
+    runModelBenchmark<AutothrustModel, typename AutothrustModel::ExternalInputs_Autothrust_T>(
+        runner, "Autothrust", condition, [&](auto& inputs, const FlightState& state, std::uint64_t frame, const auto&) {
+          fillAutothrustInputs(inputs, state, frame, autopilot);
+        });
+  }
+}
+
+#endif  // FLYBYWIRE_NATIVE_AUTOPILOTBENCHMARKS_H
@@ -0,0 +1,59 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Benchmarks of the FAC. Both aircraft use a FAC model with the same interface, this header is
+// compiled against the model of the aircraft whose model directory is on the include path.
+
+#ifndef FLYBYWIRE_NATIVE_FACCOMPUTERBENCHMARKS_H
+#define FLYBYWIRE_NATIVE_FACCOMPUTERBENCHMARKS_H
+
+#include <cstdint>
+
+#include "FacComputer.h"
+
+#include "FlightScenarios.h"
+#include "ModelBenchmark.h"
+
+inline void fillFacInputs(FacComputer::ExternalInputs_FacComputer_T& inputs, const FlightState& state, const fac_outputs& previous) {
+  fac_inputs& in = inputs.in;
+
+  fillTime(in.time, state);
+  fillSimData(in.sim_data);
+
+  in.discrete_inputs.elac_1_healthy = true;
+  in.discrete_inputs.elac_2_healthy = true;
+  in.discrete_inputs.fac_engaged_from_switch = true;
+  in.discrete_inputs.fac_opp_healthy = true;
+  in.discrete_inputs.rudder_trim_actuator_healthy = true;
+  in.discrete_inputs.rudder_travel_lim_actuator_healthy = true;
+  in.discrete_inputs.slats_extended = state.condition.flapsConf != FlapsConf::CONF_0;
+  in.discrete_inputs.yaw_damper_has_hyd_press = true;
+
+  in.analog_inputs.yaw_damper_position_deg = previous.analog_outputs.yaw_damper_order_deg;
+  in.analog_inputs.rudder_trim_position_deg = previous.analog_outputs.rudder_trim_order_deg;
+  in.analog_inputs.rudder_travel_lim_position_deg = previous.analog_outputs.rudder_travel_limit_order_deg;
+
+  fillAdrBus(in.bus_inputs.adr_own_bus, state, 0);
+  fillAdrBus(in.bus_inputs.adr_opp_bus, state, 1);
+  fillAdrBus(in.bus_inputs.adr_3_bus, state, 2);
+  fillIrBus(in.bus_inputs.ir_own_bus, state, 0);
+  fillIrBus(in.bus_inputs.ir_opp_bus, state, 1);
+  fillIrBus(in.bus_inputs.ir_3_bus, state, 2);
+  fillSfccBus(in.bus_inputs.sfcc_own_bus, state);
+  fillLgciuBus(in.bus_inputs.lgciu_own_bus, state);
+}
+
+/**
+ * Runs the benchmarks of FAC 1 in all scenarios. The yaw damper, rudder trim and rudder travel
+ * limiter positions follow the orders of the previous step.
+ * @param runner the runner of the benchmarks
+ */
+inline void runFacComputerBenchmarks(ModelBenchmarkRunner& runner) {
+  for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+    runModelBenchmark<FacComputer, FacComputer::ExternalInputs_FacComputer_T>(
+        runner, "FacComputer", condition,
+        [](auto& inputs, const FlightState& state, std::uint64_t, const auto& previous) { fillFacInputs(inputs, state, previous); });
+  }
+}
+
+#endif  // FLYBYWIRE_NATIVE_FACCOMPUTERBENCHMARKS_H
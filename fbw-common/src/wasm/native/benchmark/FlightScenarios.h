@@ -0,0 +1,434 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_NATIVE_FLIGHTSCENARIOS_H
+#define FLYBYWIRE_NATIVE_FLIGHTSCENARIOS_H
+
+#include <cmath>
+#include <cstdint>
+#include <initializer_list>
+
+#include "Arinc429.h"
+
+// the models run with the frame rate of the sim, this is a typical frame time
+constexpr double SAMPLE_TIME_SECONDS = 1.0 / 30.0;
+
+enum class FlapsConf { CONF_0, CONF_1, CONF_2, CONF_3, CONF_FULL };
+
+/**
+ * @brief A steady flight condition the model inputs of a benchmark scenario are derived from.<p/>
+ *
+ * The condition describes the trimmed state of the aircraft. FlightState adds small periodic
+ * sidestick inputs and the matching attitude and load factor variations so the models do not
+ * run on constant inputs.
+ */
+struct FlightCondition {
+  const char* name;
+  double altitudeFt;
+  // radio altimeters report no computed data above 2500 ft
+  double radioHeightFt;
+  double iasKn;
+  double tasKn;
+  double mach;
+  double verticalSpeedFtMin;
+  double alphaDeg;
+  double thetaDeg;
+  double headingDeg;
+  FlapsConf flapsConf;
+  bool gearDown;
+  // amplitude of the sidestick inputs (-1..1)
+  double stickAmplitude;
+  // amplitude of a periodic variation of the radio height, e.g. to stay around the flare height
+  double radioHeightVariationFt;
+  // engine N1 to hold the speed
+  double engineN1Percent;
+  // localizer and glideslope received
+  bool approach;
+  // ADR 1 up to ADR n report a failure
+  int failedAdrCount;
+  // IR 2 and RA 1 report a failure and ADR 3 disagrees with the other ADRs
+  bool sensorFailures;
+};
+
+// clang-format off
+constexpr FlightCondition FLIGHT_CONDITIONS[] = {
+    // name             alt      RA    IAS  TAS    mach  V/S   alpha theta hdg  flaps                 gear   stick RA var N1    appr   ADR   sensors
+    {"cruise",          37000.0, 0.0,  255, 450.0, 0.78, 0.0,  2.5,  2.5,  90,  FlapsConf::CONF_0,    false, 0.05, 0.0,  82.0, false, 0,    false},
+    {"approach",        2000.0,  2000, 140, 145.0, 0.22, -750, 6.0,  3.0,  90,  FlapsConf::CONF_FULL, true,  0.10, 0.0,  55.0, true,  0,    false},
+    {"flare",           30.0,    30.0, 135, 137.0, 0.21, -300, 7.0,  5.0,  90,  FlapsConf::CONF_FULL, true,  0.30, 20.0, 45.0, true,  0,    false},
+    {"alternate-law",   37000.0, 0.0,  255, 450.0, 0.78, 0.0,  2.5,  2.5,  90,  FlapsConf::CONF_0,    false, 0.05, 0.0,  82.0, false, 2,    false},
+    {"sensor-failure",  2000.0,  2000, 140, 145.0, 0.22, -750, 6.0,  3.0,  90,  FlapsConf::CONF_FULL, true,  0.10, 0.0,  55.0, true,  0,    true},
+};
+// clang-format on
+
+/**
+ * @brief The state of the aircraft in a frame of a scenario.
+ */
+struct FlightState {
+  const FlightCondition& condition;
+  double timeSeconds;
+  double pitchStick;
+  double rollStick;
+  double thetaDeg;
+  double phiDeg;
+  double qDegS;
+  double pDegS;
+  double nzG;
+  double radioHeightFt;
+  double alphaDeg;
+  double flightPathAngleDeg;
+  double verticalSpeedFtMin;
+  // direction the wind is coming from
+  double windDirectionDeg;
+  double windSpeedKn;
+
+  /**
+   * @param condition the condition of the scenario
+   * @param frame the frame of the scenario
+   * @return the state of the aircraft in the frame
+   */
+  static FlightState at(const FlightCondition& condition, std::uint64_t frame) {
+    constexpr double TWO_PI = 6.283185307179586;
+    const double t = static_cast<double>(frame) * SAMPLE_TIME_SECONDS;
+    const double pitchPhase = TWO_PI * 0.25 * t;
+    const double rollPhase = TWO_PI * 0.15 * t;
+    const double amplitude = condition.stickAmplitude;
+
+    FlightState state{condition, t, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, condition.verticalSpeedFtMin, 0, 0};
+    state.pitchStick = amplitude * std::sin(pitchPhase);
+    state.rollStick = amplitude * std::sin(rollPhase);
+    state.thetaDeg = condition.thetaDeg + 4.0 * amplitude * std::sin(pitchPhase);
+    state.phiDeg = 30.0 * amplitude * std::sin(rollPhase);
+    state.qDegS = 4.0 * amplitude * TWO_PI * 0.25 * std::cos(pitchPhase);
+    state.pDegS = 30.0 * amplitude * TWO_PI * 0.15 * std::cos(rollPhase);
+    state.nzG = 1.0 / std::cos(state.phiDeg / 57.29577951308232) + 0.5 * state.pitchStick;
+    state.radioHeightFt = condition.radioHeightFt + condition.radioHeightVariationFt * std::sin(TWO_PI * 0.05 * t);
+    state.alphaDeg = condition.alphaDeg + (state.thetaDeg - condition.thetaDeg);
+    state.flightPathAngleDeg = state.thetaDeg - condition.alphaDeg;
+    return state;
+  }
+
+  [[nodiscard]] bool isAdrFailed(int adrIndex) const { return adrIndex < condition.failedAdrCount; }
+  [[nodiscard]] bool isIrFailed(int irIndex) const { return condition.sensorFailures && irIndex == 1; }
+  [[nodiscard]] bool isRaFailed(int raIndex) const { return condition.sensorFailures && raIndex == 0; }
+  [[nodiscard]] bool isAdrDisagreeing(int adrIndex) const { return condition.sensorFailures && adrIndex == 2; }
+
+  [[nodiscard]] double flapsHandleIndex() const {
+    switch (condition.flapsConf) {
+      case FlapsConf::CONF_0:
+        return 0;
+      case FlapsConf::CONF_1:
+        return 1;
+      case FlapsConf::CONF_2:
+        return 3;
+      case FlapsConf::CONF_3:
+        return 4;
+      case FlapsConf::CONF_FULL:
+        return 5;
+    }
+    return 0;
+  }
+};
+
+// ============================================================================
+// Bus inputs shared by the computers of both aircraft
+// ============================================================================
+
+template <typename Time>
+void fillTime(Time& time, const FlightState& state) {
+  time.dt = SAMPLE_TIME_SECONDS;
+  time.simulation_time = state.timeSeconds;
+  time.monotonic_time = state.timeSeconds;
+}
+
+template <typename SimData>
+void fillSimData(SimData& simData) {
+  simData.slew_on = false;
+  simData.pause_on = false;
+  simData.tracking_mode_on_override = false;
+  simData.tailstrike_protection_on = true;
+  simData.computer_running = true;
+}
+
+template <typename Word>
+void setWord(Word& word, double value, Arinc429SignStatus ssm = Arinc429SignStatus::NormalOperation) {
+  word.SSM = ssm;
+  word.Data = static_cast<float>(value);
+}
+
+/**
+ * Sets a discrete word with the given bits (1 based as in the ARINC 429 label definitions).
+ */
+template <typename Word>
+void setDiscreteWord(Word& word, std::initializer_list<int> bits) {
+  std::uint32_t value = 0;
+  for (const int bit : bits) {
+    value |= 1u << (bit - 1);
+  }
+  setWord(word, static_cast<double>(value));
+}
+
+template <typename AdrBus>
+void fillAdrBus(AdrBus& bus, const FlightState& state, int adrIndex) {
+  const FlightCondition& c = state.condition;
+  const Arinc429SignStatus ssm = state.isAdrFailed(adrIndex) ? Arinc429SignStatus::FailureWarning : Arinc429SignStatus::NormalOperation;
+  const double speedBias = state.isAdrDisagreeing(adrIndex) ? -25.0 : 0.0;
+  const double alphaBias = state.isAdrDisagreeing(adrIndex) ? 4.0 : 0.0;
+  const double staticPressureHpa = 1013.25 * std::pow(1.0 - 6.8756e-6 * c.altitudeFt, 5.2559);
+
+  setWord(bus.altitude_standard_ft, c.altitudeFt, ssm);
+  setWord(bus.altitude_corrected_ft, c.altitudeFt, ssm);
+  setWord(bus.mach, c.mach, ssm);
+  setWord(bus.airspeed_computed_kn, c.iasKn + speedBias, ssm);
+  setWord(bus.airspeed_true_kn, c.tasKn + speedBias, ssm);
+  setWord(bus.vertical_speed_ft_min, state.verticalSpeedFtMin, ssm);
+  setWord(bus.aoa_corrected_deg, state.alphaDeg + alphaBias, ssm);
+  setWord(bus.corrected_average_static_pressure, staticPressureHpa, ssm);
+}
+
+template <typename IrBus>
+void fillIrBus(IrBus& bus, const FlightState& state, int irIndex) {
+  const FlightCondition& c = state.condition;
+  const Arinc429SignStatus ssm = state.isIrFailed(irIndex) ? Arinc429SignStatus::FailureWarning : Arinc429SignStatus::NormalOperation;
+  constexpr double DEG_TO_RAD = 0.017453292519943295;
+  constexpr double RAD_TO_DEG = 57.29577951308232;
+
+  // the ground speed is the sum of the true airspeed along the heading and the wind, which blows towards the
+  // opposite of its direction
+  const double northKn = c.tasKn * std::cos(c.headingDeg * DEG_TO_RAD) - state.windSpeedKn * std::cos(state.windDirectionDeg * DEG_TO_RAD);
+  const double eastKn = c.tasKn * std::sin(c.headingDeg * DEG_TO_RAD) - state.windSpeedKn * std::sin(state.windDirectionDeg * DEG_TO_RAD);
+  const double groundSpeedKn = std::hypot(northKn, eastKn);
+  const double trackDeg = std::fmod(std::atan2(eastKn, northKn) * RAD_TO_DEG + 360.0, 360.0);
+  const double driftDeg = std::remainder(trackDeg - c.headingDeg, 360.0);
+
+  setWord(bus.discrete_word_1, 0, ssm);
+  setWord(bus.latitude_deg, 47.45, ssm);
+  setWord(bus.longitude_deg, 8.56, ssm);
+  setWord(bus.ground_speed_kn, groundSpeedKn, ssm);
+  setWord(bus.track_angle_true_deg, trackDeg, ssm);
+  setWord(bus.heading_true_deg, c.headingDeg, ssm);
+  setWord(bus.wind_speed_kn, state.windSpeedKn, ssm);
+  setWord(bus.wind_direction_true_deg, state.windDirectionDeg, ssm);
+  setWord(bus.track_angle_magnetic_deg, trackDeg, ssm);
+  setWord(bus.heading_magnetic_deg, c.headingDeg, ssm);
+  setWord(bus.drift_angle_deg, driftDeg, ssm);
+  setWord(bus.flight_path_angle_deg, state.flightPathAngleDeg, ssm);
+  setWord(bus.flight_path_accel_g, 0, ssm);
+  setWord(bus.pitch_angle_deg, state.thetaDeg, ssm);
+  setWord(bus.roll_angle_deg, state.phiDeg, ssm);
+  setWord(bus.body_pitch_rate_deg_s, state.qDegS, ssm);
+  setWord(bus.body_roll_rate_deg_s, state.pDegS, ssm);
+  setWord(bus.body_yaw_rate_deg_s, 0, ssm);
+  setWord(bus.body_long_accel_g, 0, ssm);
+  setWord(bus.body_lat_accel_g, 0, ssm);
+  setWord(bus.body_normal_accel_g, state.nzG, ssm);
+  setWord(bus.track_angle_rate_deg_s, 0, ssm);
+  setWord(bus.pitch_att_rate_deg_s, state.qDegS, ssm);
+  setWord(bus.roll_att_rate_deg_s, state.pDegS, ssm);
+  setWord(bus.inertial_alt_ft, c.altitudeFt, ssm);
+  setWord(bus.along_track_horiz_acc_g, 0, ssm);
+  setWord(bus.cross_track_horiz_acc_g, 0, ssm);
+  setWord(bus.vertical_accel_g, state.nzG - 1.0, ssm);
+  setWord(bus.inertial_vertical_speed_ft_s, state.verticalSpeedFtMin / 60.0, ssm);
+  setWord(bus.north_south_velocity_kn, northKn, ssm);
+  setWord(bus.east_west_velocity_kn, eastKn, ssm);
+}
+
+template <typename RaBus>
+void fillRaBus(RaBus& bus, const FlightState& state, int raIndex) {
+  if (state.isRaFailed(raIndex)) {
+    setWord(bus.radio_height_ft, 0, Arinc429SignStatus::FailureWarning);
+  } else if (state.condition.radioHeightFt <= 0 || state.radioHeightFt > 2500) {
+    setWord(bus.radio_height_ft, 10000, Arinc429SignStatus::NoComputedData);
+  } else {
+    setWord(bus.radio_height_ft, state.radioHeightFt);
+  }
+}
+
+/**
+ * Sets the words of the slat flap control computer as the SFCCs of the systems simulation do.
+ */
+template <typename SfccBus>
+void fillSfccBus(SfccBus& bus, const FlightState& state) {
+  switch (state.condition.flapsConf) {
+    case FlapsConf::CONF_0:
+      setDiscreteWord(bus.slat_flap_system_status_word, {17, 28, 29});
+      setDiscreteWord(bus.slat_flap_actual_position_word, {11, 12, 18, 19});
+      setWord(bus.slat_actual_position_deg, 0);
+      setWord(bus.flap_actual_position_deg, 0);
+      break;
+    case FlapsConf::CONF_1:
+      setDiscreteWord(bus.slat_flap_system_status_word, {18, 26, 28, 29});
+      setDiscreteWord(bus.slat_flap_actual_position_word, {11, 13, 18, 19});
+      setWord(bus.slat_actual_position_deg, 18);
+      setWord(bus.flap_actual_position_deg, 0);
+      break;
+    case FlapsConf::CONF_2:
+      setDiscreteWord(bus.slat_flap_system_status_word, {19, 28, 29});
+      setDiscreteWord(bus.slat_flap_actual_position_word, {11, 13, 14, 18, 20});
+      setWord(bus.slat_actual_position_deg, 22);
+      setWord(bus.flap_actual_position_deg, 15);
+      break;
+    case FlapsConf::CONF_3:
+      setDiscreteWord(bus.slat_flap_system_status_word, {20, 28, 29});
+      setDiscreteWord(bus.slat_flap_actual_position_word, {11, 13, 14, 18, 20, 21});
+      setWord(bus.slat_actual_position_deg, 22);
+      setWord(bus.flap_actual_position_deg, 20);
+      break;
+    case FlapsConf::CONF_FULL:
+      setDiscreteWord(bus.slat_flap_system_status_word, {21, 28, 29});
+      setDiscreteWord(bus.slat_flap_actual_position_word, {11, 13, 14, 15, 18, 20, 21, 22, 23});
+      setWord(bus.slat_actual_position_deg, 27);
+      setWord(bus.flap_actual_position_deg, 40);
+      break;
+  }
+  setWord(bus.slat_flap_component_status_word, 0);
+}
+
+/**
+ * Sets the words of the landing gear control interface unit as the LGCIUs of the systems
+ * simulation do for an aircraft in flight.
+ */
+template <typename LgciuBus>
+void fillLgciuBus(LgciuBus& bus, const FlightState& state) {
+  if (state.condition.gearDown) {
+    // down and locked, gear handle down, not compressed
+    setDiscreteWord(bus.discrete_word_1, {23, 24, 25, 29});
+    setDiscreteWord(bus.discrete_word_3, {11, 12, 13});
+  } else {
+    // up and locked, gear handle up
+    setDiscreteWord(bus.discrete_word_1, {});
+    setDiscreteWord(bus.discrete_word_3, {14});
+  }
+  setDiscreteWord(bus.discrete_word_2, {});
+  setDiscreteWord(bus.discrete_word_4, {});
+}
+
+// ============================================================================
+// Autopilot and autothrust inputs shared by both aircraft
+// ============================================================================
+
+template <typename AutopilotData>
+void fillAutopilotData(AutopilotData& data, const FlightState& state) {
+  constexpr double DEG_TO_RAD = 0.017453292519943295;
+  const FlightCondition& c = state.condition;
+
+  data.aircraft_position.lat = 47.45;
+  data.aircraft_position.lon = 8.56;
+  data.aircraft_position.alt = c.altitudeFt * 0.3048;
+  data.Theta_deg = state.thetaDeg;
+  data.Phi_deg = state.phiDeg;
+  data.q_rad_s = state.qDegS * DEG_TO_RAD;
+  data.r_rad_s = 0;
+  data.p_rad_s = state.pDegS * DEG_TO_RAD;
+  data.V_ias_kn = c.iasKn;
+  data.V_tas_kn = c.tasKn;
+  data.V_mach = c.mach;
+  data.V_gnd_kn = c.tasKn;
+  data.alpha_deg = state.alphaDeg;
+  data.beta_deg = 0;
+  data.H_ft = c.altitudeFt;
+  data.H_ind_ft = c.altitudeFt;
+  data.H_radio_ft = c.radioHeightFt > 0 ? state.radioHeightFt : 10000;
+  data.H_dot_ft_min = state.verticalSpeedFtMin;
+  data.Psi_magnetic_deg = c.headingDeg;
+  data.Psi_magnetic_track_deg = c.headingDeg;
+  data.Psi_true_deg = c.headingDeg;
+  data.bx_m_s2 = 0;
+  data.by_m_s2 = 0;
+  data.bz_m_s2 = 9.81 * (state.nzG - 1.0);
+
+  data.nav_valid = c.approach;
+  data.nav_loc_deg = c.headingDeg;
+  data.nav_gs_deg = 3.0;
+  data.nav_dme_valid = c.approach ? 1 : 0;
+  data.nav_dme_nmi = c.approach ? c.radioHeightFt / 318.0 : 0;
+  data.nav_loc_valid = c.approach;
+  data.nav_loc_magvar_deg = 0;
+  data.nav_loc_error_deg = c.approach ? 0.1 * std::sin(state.timeSeconds) : 0;
+  data.nav_loc_position = {47.45, 8.56, 400};
+  data.nav_gs_valid = c.approach;
+  data.nav_gs_error_deg = c.approach ? 0.05 * std::sin(0.7 * state.timeSeconds) : 0;
+  data.nav_gs_position = {47.45, 8.56, 400};
+
+  data.flight_guidance_xtk_nmi = 0;
+  data.flight_guidance_tae_deg = 0;
+  data.flight_guidance_phi_deg = 0;
+  data.flight_guidance_phi_limit_deg = 25;
+  data.flight_phase = c.approach ? 5 : 3;
+  data.V2_kn = 145;
+  data.VAPP_kn = 137;
+  data.VLS_kn = c.flapsConf == FlapsConf::CONF_0 ? 210 : 132;
+  data.VMAX_kn = c.flapsConf == FlapsConf::CONF_0 ? 340 : 177;
+  data.is_flight_plan_available = true;
+  data.altitude_constraint_ft = 0;
+  data.thrust_reduction_altitude = 1500;
+  data.thrust_reduction_altitude_go_around = 1500;
+  data.acceleration_altitude = 1500;
+  data.acceleration_altitude_engine_out = 1500;
+  data.acceleration_altitude_go_around = 1500;
+  data.acceleration_altitude_go_around_engine_out = 1500;
+  data.cruise_altitude = 37000;
+  data.gear_strut_compression_1 = 0;
+  data.gear_strut_compression_2 = 0;
+  data.zeta_pos = 0;
+  data.throttle_lever_1_pos = 25;
+  data.throttle_lever_2_pos = 25;
+  data.flaps_handle_index = state.flapsHandleIndex();
+  data.is_engine_operative_1 = true;
+  data.is_engine_operative_2 = true;
+  data.altimeter_setting_left_mbar = 1013.25;
+  data.altimeter_setting_right_mbar = 1013.25;
+}
+
+template <typename AutothrustData>
+void fillAutothrustData(AutothrustData& data, const FlightState& state) {
+  const FlightCondition& c = state.condition;
+  const double isaDegC = 15.0 - 0.0019812 * std::fmin(c.altitudeFt, 36089.0);
+
+  data.nz_g = state.nzG;
+  data.Theta_deg = state.thetaDeg;
+  data.Phi_deg = state.phiDeg;
+  data.V_ias_kn = c.iasKn;
+  data.V_tas_kn = c.tasKn;
+  data.V_mach = c.mach;
+  data.V_gnd_kn = c.tasKn;
+  data.alpha_deg = state.alphaDeg;
+  data.H_ft = c.altitudeFt;
+  data.H_ind_ft = c.altitudeFt;
+  data.H_radio_ft = c.radioHeightFt > 0 ? state.radioHeightFt : 10000;
+  data.H_dot_fpm = state.verticalSpeedFtMin;
+  data.bx_m_s2 = 0;
+  data.by_m_s2 = 0;
+  data.bz_m_s2 = 9.81 * (state.nzG - 1.0);
+  data.Psi_magnetic_deg = c.headingDeg;
+  data.Psi_magnetic_track_deg = c.headingDeg;
+  data.gear_strut_compression_1 = 0;
+  data.gear_strut_compression_2 = 0;
+  data.flap_handle_index = state.flapsHandleIndex();
+  data.is_engine_operative_1 = true;
+  data.is_engine_operative_2 = true;
+  data.commanded_engine_N1_1_percent = c.engineN1Percent;
+  data.commanded_engine_N1_2_percent = c.engineN1Percent;
+  data.engine_N1_1_percent = c.engineN1Percent;
+  data.engine_N1_2_percent = c.engineN1Percent;
+  data.corrected_engine_N1_1_percent = c.engineN1Percent;
+  data.corrected_engine_N1_2_percent = c.engineN1Percent;
+  // four engines on the A380
+  if constexpr (requires { data.engine_N1_4_percent; }) {
+    data.is_engine_operative_3 = true;
+    data.is_engine_operative_4 = true;
+    data.commanded_engine_N1_3_percent = c.engineN1Percent;
+    data.commanded_engine_N1_4_percent = c.engineN1Percent;
+    data.engine_N1_3_percent = c.engineN1Percent;
+    data.engine_N1_4_percent = c.engineN1Percent;
+    data.corrected_engine_N1_3_percent = c.engineN1Percent;
+    data.corrected_engine_N1_4_percent = c.engineN1Percent;
+  }
+  const double tasMS = c.tasKn * 0.514444;
+  data.TAT_degC = isaDegC + tasMS * tasMS / 2010.0;
+  data.OAT_degC = isaDegC;
+  data.ambient_density_kg_per_m3 = 1.225 * std::pow(1.0 - 6.8756e-6 * std::fmin(c.altitudeFt, 36089.0), 4.2559);
+}
+
+#endif  // FLYBYWIRE_NATIVE_FLIGHTSCENARIOS_H
@@ -0,0 +1,363 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_NATIVE_MODELBENCHMARK_H
+#define FLYBYWIRE_NATIVE_MODELBENCHMARK_H
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "FlightScenarios.h"
+
+/**
+ * @brief Counts the retired instructions and cache misses of the calling thread with the Linux
+ * perf_event_open interface.<p/>
+ *
+ * Hardware counters are not available on all machines (e.g. most virtual machines or with
+ * kernel.perf_event_paranoid > 2). In this case the counters are reported as unavailable and the
+ * benchmarks only report the time per step.
+ */
+class PerfCounters {
+ public:
+  struct Values {
+    std::optional<double> instructions;
+    std::optional<double> cacheMisses;
+  };
+
+ private:
+  int instructionsFd = -1;
+  int cacheMissesFd = -1;
+
+  static int open(std::uint64_t config, int groupFd) {
+    perf_event_attr attr{};
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = groupFd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+  }
+
+  /**
+   * @return the value of the counter scaled for the time it was not running due to multiplexing
+   */
+  static std::optional<double> read(int fd) {
+    if (fd < 0) {
+      return std::nullopt;
+    }
+    std::uint64_t values[3]{};  // value, time enabled, time running
+    if (::read(fd, values, sizeof(values)) != sizeof(values) || values[2] == 0) {
+      return std::nullopt;
+    }
+    return static_cast<double>(values[0]) * static_cast<double>(values[1]) / static_cast<double>(values[2]);
+  }
+
+ public:
+  PerfCounters() {
+    instructionsFd = open(PERF_COUNT_HW_INSTRUCTIONS, -1);
+    if (instructionsFd >= 0) {
+      cacheMissesFd = open(PERF_COUNT_HW_CACHE_MISSES, instructionsFd);
+    }
+  }
+
+  PerfCounters(const PerfCounters&) = delete;             // no copy constructor
+  PerfCounters& operator=(const PerfCounters&) = delete;  // no copy assignment
+
+  ~PerfCounters() {
+    if (cacheMissesFd >= 0) {
+      close(cacheMissesFd);
+    }
+    if (instructionsFd >= 0) {
+      close(instructionsFd);
+    }
+  }
+
+  /**
+   * @return true if at least the instructions counter is available
+   */
+  [[nodiscard]] bool isAvailable() const { return instructionsFd >= 0; }
+
+  /**
+   * Resets and starts the counters.
+   */
+  void start() {
+    if (instructionsFd >= 0) {
+      ioctl(instructionsFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(instructionsFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+  }
+
+  /**
+   * Stops the counters.
+   * @return the values since the last call to start()
+   */
+  Values stop() {
+    if (instructionsFd >= 0) {
+      ioctl(instructionsFd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+    return {read(instructionsFd), read(cacheMissesFd)};
+  }
+};
+
+/**
+ * @brief Options of the benchmark executables, parsed from the command line.
+ */
+struct BenchmarkOptions {
+  // steps before measuring, so filters, rate limiters and mode logic reach the state of the scenario
+  std::uint64_t warmupSteps = 500;
+  std::uint64_t stepsPerRepetition = 1000;
+  std::uint64_t repetitions = 20;
+  // only benchmarks whose "model/scenario" name contains this string are run
+  std::string filter;
+  bool json = false;
+};
+
+/**
+ * @brief Result of one model in one scenario. Times and counters are per step.
+ */
+struct BenchmarkResult {
+  std::string model;
+  std::string scenario;
+  double nsPerStepMedian;
+  double nsPerStepMin;
+  double nsPerStepMax;
+  std::optional<double> instructionsPerStep;
+  std::optional<double> cacheMissesPerStep;
+};
+
+/**
+ * @brief Runs the model benchmarks and reports the results as a table or as JSON.<p/>
+ *
+ * A benchmark is a callable which sets the inputs of a model for a given frame of a scenario and
+ * steps the model. Each benchmark is first warmed up and then run for a number of repetitions of
+ * a fixed number of steps. The time per step is reported as the median, minimum and maximum of the
+ * repetitions, the counters as the average over all repetitions. The scenario continues through
+ * the warm-up and all repetitions, i.e. each step sees the inputs of the next frame.
+ *
+ * @usage
+ *   ModelBenchmarkRunner runner{"A32NX", ModelBenchmarkRunner::parseArguments(argc, argv)};<br/>
+ *   runner.run("ElacComputer", "cruise", [&](std::uint64_t frame) { ... model.step(); });<br/>
+ *   runner.report(std::cout);
+ */
+class ModelBenchmarkRunner {
+ private:
+  std::string aircraft;
+  BenchmarkOptions options;
+  PerfCounters counters{};
+  std::vector<BenchmarkResult> results{};
+
+  static void printUsage(const char* executable) {
+    std::cerr << "Usage: " << executable << " [options]\n"
+              << "  --json                output the results as JSON\n"
+              << "  --filter <text>       only run benchmarks whose model/scenario name contains the text\n"
+              << "  --warmup <steps>      steps before measuring (default 500)\n"
+              << "  --steps <steps>       steps per repetition (default 1000)\n"
+              << "  --repetitions <n>     number of measured repetitions (default 20)\n";
+  }
+
+  static void writeJsonNumber(std::ostream& out, const std::optional<double>& value) {
+    if (value.has_value()) {
+      out << value.value();
+    } else {
+      out << "null";
+    }
+  }
+
+  void reportTable(std::ostream& out) const {
+    out << aircraft << " model benchmarks - " << options.repetitions << " x " << options.stepsPerRepetition << " steps";
+    if (!counters.isAvailable()) {
+      out << " (hardware counters not available)";
+    }
+    out << "\n\n";
+    out << std::left << std::setw(24) << "Model" << std::setw(20) << "Scenario" << std::right << std::setw(12) << "ns/step"
+        << std::setw(12) << "min" << std::setw(12) << "max" << std::setw(14) << "instr/step" << std::setw(14) << "misses/step"
+        << "\n";
+    out << std::fixed << std::setprecision(0);
+    for (const BenchmarkResult& result : results) {
+      out << std::left << std::setw(24) << result.model << std::setw(20) << result.scenario << std::right << std::setw(12)
+          << result.nsPerStepMedian << std::setw(12) << result.nsPerStepMin << std::setw(12) << result.nsPerStepMax;
+      out << std::setw(14) << (result.instructionsPerStep ? std::to_string(std::llround(*result.instructionsPerStep)) : "-");
+      out << std::setw(14) << (result.cacheMissesPerStep ? std::to_string(std::llround(*result.cacheMissesPerStep)) : "-");
+      out << "\n";
+    }
+    out << std::defaultfloat;
+  }
+
+  void reportJson(std::ostream& out) const {
+    out << std::fixed << std::setprecision(1);
+    out << "{\n";
+    out << "  \"aircraft\": \"" << aircraft << "\",\n";
+    out << "  \"warmupSteps\": " << options.warmupSteps << ",\n";
+    out << "  \"stepsPerRepetition\": " << options.stepsPerRepetition << ",\n";
+    out << "  \"repetitions\": " << options.repetitions << ",\n";
+    out << "  \"hardwareCounters\": " << (counters.isAvailable() ? "true" : "false") << ",\n";
+    out << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); i++) {
+      const BenchmarkResult& result = results[i];
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\"model\": \"" << result.model << "\", \"scenario\": \"" << result.scenario << "\", ";
+      out << "\"nsPerStep\": {\"median\": " << result.nsPerStepMedian << ", \"min\": " << result.nsPerStepMin
+          << ", \"max\": " << result.nsPerStepMax << "}, ";
+      out << "\"instructionsPerStep\": ";
+      writeJsonNumber(out, result.instructionsPerStep);
+      out << ", \"cacheMissesPerStep\": ";
+      writeJsonNumber(out, result.cacheMissesPerStep);
+      out << "}";
+    }
+    out << "\n  ]\n}\n";
+    out << std::defaultfloat;
+  }
+
+ public:
+  /**
+   * @param aircraft the name of the aircraft whose models are benchmarked
+   * @param options the options of the run
+   */
+  ModelBenchmarkRunner(std::string aircraft, BenchmarkOptions options) : aircraft(std::move(aircraft)), options(std::move(options)) {}
+
+  ModelBenchmarkRunner(const ModelBenchmarkRunner&) = delete;             // no copy constructor
+  ModelBenchmarkRunner& operator=(const ModelBenchmarkRunner&) = delete;  // no copy assignment
+
+  /**
+   * Parses the command line. Prints the usage and exits on invalid arguments or --help.
+   * @return the options of the run
+   */
+  static BenchmarkOptions parseArguments(int argc, char** argv) {
+    BenchmarkOptions options{};
+    for (int i = 1; i < argc; i++) {
+      const std::string argument = argv[i];
+      const bool hasValue = i + 1 < argc;
+      if (argument == "--json") {
+        options.json = true;
+      } else if (argument == "--filter" && hasValue) {
+        options.filter = argv[++i];
+      } else if (argument == "--warmup" && hasValue) {
+        options.warmupSteps = std::strtoull(argv[++i], nullptr, 10);
+      } else if (argument == "--steps" && hasValue) {
+        options.stepsPerRepetition = std::max<std::uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+      } else if (argument == "--repetitions" && hasValue) {
+        options.repetitions = std::max<std::uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+      } else {
+        printUsage(argv[0]);
+        std::exit(argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE);
+      }
+    }
+    return options;
+  }
+
+  /**
+   * Runs a benchmark unless it is excluded by the filter.
+   * @param model the name of the model
+   * @param scenario the name of the scenario
+   * @param step callable taking the frame number which sets the inputs of the frame and steps the model
+   */
+  template <typename StepFunction>
+  void run(const std::string& model, const std::string& scenario, StepFunction&& step) {
+    if (!options.filter.empty() && (model + "/" + scenario).find(options.filter) == std::string::npos) {
+      return;
+    }
+
+    std::uint64_t frame = 0;
+    for (; frame < options.warmupSteps; frame++) {
+      step(frame);
+    }
+
+    std::vector<double> nsPerStep{};
+    nsPerStep.reserve(options.repetitions);
+    double instructions = 0;
+    double cacheMisses = 0;
+    bool hasInstructions = true;
+    bool hasCacheMisses = true;
+
+    for (std::uint64_t repetition = 0; repetition < options.repetitions; repetition++) {
+      counters.start();
+      const auto start = std::chrono::steady_clock::now();
+      for (std::uint64_t i = 0; i < options.stepsPerRepetition; i++, frame++) {
+        step(frame);
+      }
+      const auto end = std::chrono::steady_clock::now();
+      const PerfCounters::Values values = counters.stop();
+
+      nsPerStep.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()) /
+                          static_cast<double>(options.stepsPerRepetition));
+      hasInstructions = hasInstructions && values.instructions.has_value();
+      hasCacheMisses = hasCacheMisses && values.cacheMisses.has_value();
+      instructions += values.instructions.value_or(0);
+      cacheMisses += values.cacheMisses.value_or(0);
+    }
+
+    std::sort(nsPerStep.begin(), nsPerStep.end());
+    const double measuredSteps = static_cast<double>(options.repetitions * options.stepsPerRepetition);
+    BenchmarkResult result{model, scenario, nsPerStep[nsPerStep.size() / 2], nsPerStep.front(), nsPerStep.back(), std::nullopt,
+                           std::nullopt};
+    if (hasInstructions) {
+      result.instructionsPerStep = instructions / measuredSteps;
+    }
+    if (hasCacheMisses) {
+      result.cacheMissesPerStep = cacheMisses / measuredSteps;
+    }
+    results.push_back(result);
+  }
+
+  /**
+   * Writes the results as a table or as JSON depending on the options.
+   * @param out the stream to write to
+   */
+  void report(std::ostream& out) const {
+    if (options.json) {
+      reportJson(out);
+    } else {
+      reportTable(out);
+    }
+  }
+
+  /**
+   * @return the results of all benchmarks run so far
+   */
+  [[nodiscard]] const std::vector<BenchmarkResult>& getResults() const { return results; }
+};
+
+/**
+ * Runs the benchmark of a generated model in a scenario. A new instance of the model is created
+ * and initialized for each benchmark, the inputs start zero initialized.
+ * @tparam Model the generated model class
+ * @tparam Inputs the external inputs of the model
+ * @param runner the runner of the benchmarks
+ * @param modelName the name of the model
+ * @param condition the flight condition of the scenario
+ * @param fillInputs callable (Inputs&, const FlightState&, frame, previous outputs) which sets the
+ * inputs of a frame. The outputs of the previous step allow feeding back e.g. surface positions.
+ */
+template <typename Model, typename Inputs, typename FillFunction>
+void runModelBenchmark(ModelBenchmarkRunner& runner,
+                       const std::string& modelName,
+                       const FlightCondition& condition,
+                       FillFunction&& fillInputs) {
+  auto model = std::make_unique<Model>();
+  auto inputs = std::make_unique<Inputs>();
+  model->initialize();
+  runner.run(modelName, condition.name, [&](std::uint64_t frame) {
+    fillInputs(*inputs, FlightState::at(condition, frame), frame, model->getExternalOutputs().out);
+    model->setExternalInputs(inputs.get());
+    model->step();
+  });
+}
+
+#endif  // FLYBYWIRE_NATIVE_MODELBENCHMARK_H
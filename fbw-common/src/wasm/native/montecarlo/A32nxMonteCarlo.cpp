@@ -0,0 +1,538 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Monte-Carlo runs of the A32NX flight control computers.
+//
+// ELAC 1 and 2, SEC 1 to 3, FAC 1 and 2 and FCDC 1 and 2 are cross-wired as in FlyByWireInterface
+// and closed with the simplified aircraft dynamics. All computers are powered and their pushbuttons
+// are pressed, computer failures are injected through the FailuresConsumer like the failures of
+// the EFB. The autopilot is not engaged, the sidestick inputs are random.
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+
+#include "Arinc429Utils.h"
+#include "Elac.h"
+#include "Fac.h"
+#include "FailuresConsumer.h"
+#include "Fcdc.h"
+#include "LocalVariable.h"
+#include "ModelSnapshot.h"
+#include "Sec.h"
+
+#include "AircraftDynamics.h"
+#include "MonteCarlo.h"
+
+constexpr double HYDRAULIC_PRESSURE_PSI = 3000;
+// the FCDCs report no law for a few frames while an other computer takes over an axis
+constexpr double PITCH_LAW_CONFIRMATION_SECONDS = 0.5;
+
+const MonteCarloAircraft A32NX_AIRCRAFT{"A32NX",
+                                        45000,
+                                        78000,
+                                        64000,
+                                        {static_cast<int>(Failures::Elac1), static_cast<int>(Failures::Elac2),
+                                         static_cast<int>(Failures::Sec1), static_cast<int>(Failures::Sec2),
+                                         static_cast<int>(Failures::Sec3), static_cast<int>(Failures::Fac1),
+                                         static_cast<int>(Failures::Fac2), static_cast<int>(Failures::Fcdc1),
+                                         static_cast<int>(Failures::Fcdc2)}};
+
+/**
+ * @brief The state of the computers and of the surfaces at the end of a warm-up, the scenarios of a
+ * flight condition are forked from it with --fork-warmup.
+ */
+struct WarmedUpState {
+  ModelSnapshot<Elac[2]> elacs;
+  ModelSnapshot<Sec[3]> secs;
+  ModelSnapshot<Fac[2]> facs;
+  ModelSnapshot<Fcdc[2]> fcdcs;
+
+  ModelSnapshot<base_elac_discrete_outputs[2]> elacsDiscreteOutputs;
+  ModelSnapshot<base_elac_analog_outputs[2]> elacsAnalogOutputs;
+  ModelSnapshot<base_elac_out_bus[2]> elacsBusOutputs;
+
+  ModelSnapshot<base_sec_discrete_outputs[3]> secsDiscreteOutputs;
+  ModelSnapshot<base_sec_analog_outputs[3]> secsAnalogOutputs;
+  ModelSnapshot<base_sec_out_bus[3]> secsBusOutputs;
+
+  ModelSnapshot<base_fac_discrete_outputs[2]> facsDiscreteOutputs;
+  ModelSnapshot<base_fac_analog_outputs[2]> facsAnalogOutputs;
+  ModelSnapshot<base_fac_bus[2]> facsBusOutputs;
+
+  ModelSnapshot<FcdcDiscreteOutputs[2]> fcdcsDiscreteOutputs;
+  ModelSnapshot<base_fcdc_bus[2]> fcdcsBusOutputs;
+
+  SurfaceOrders surfaces{};
+};
+
+/**
+ * @brief The flight control computers of a scenario with the aircraft they fly.<p/>
+ *
+ * An instance is created per scenario on the worker thread that runs it. The models keep their state
+ * per instance and the local variables of the failures consumer are kept per thread, so scenarios on
+ * different threads do not share any state.
+ */
+class A32nxFlightControls {
+ private:
+  const ScenarioParameters& parameters;
+  AircraftDynamics aircraft;
+  ScenarioInputs inputs;
+
+  FailuresConsumer failuresConsumer;
+  std::unique_ptr<LocalVariable> failureActivate;
+  std::size_t nextFailure = 0;
+
+  Elac elacs[2] = {Elac(true), Elac(false)};
+  Sec secs[3] = {Sec(true, false), Sec(false, false), Sec(false, true)};
+  Fac facs[2] = {Fac(true), Fac(false)};
+  Fcdc fcdcs[2] = {Fcdc(true), Fcdc(false)};
+
+  base_elac_discrete_outputs elacsDiscreteOutputs[2] = {};
+  base_elac_analog_outputs elacsAnalogOutputs[2] = {};
+  base_elac_out_bus elacsBusOutputs[2] = {};
+
+  base_sec_discrete_outputs secsDiscreteOutputs[3] = {};
+  base_sec_analog_outputs secsAnalogOutputs[3] = {};
+  base_sec_out_bus secsBusOutputs[3] = {};
+
+  base_fac_discrete_outputs facsDiscreteOutputs[2] = {};
+  base_fac_analog_outputs facsAnalogOutputs[2] = {};
+  base_fac_bus facsBusOutputs[2] = {};
+
+  FcdcDiscreteOutputs fcdcsDiscreteOutputs[2] = {};
+  base_fcdc_bus fcdcsBusOutputs[2] = {};
+
+  ReportedPitchLaw lastPitchLaw = ReportedPitchLaw::NORMAL;
+  ReportedPitchLaw confirmedPitchLaw = ReportedPitchLaw::NORMAL;
+  double pitchLawSeconds = 0;
+
+  void injectFailures(double timeSeconds) {
+    // one failure per frame, as the EFB does
+    if (nextFailure < parameters.computerFailures.size() && parameters.computerFailures[nextFailure].timeSeconds <= timeSeconds) {
+      failureActivate->set(parameters.computerFailures[nextFailure].identifier);
+      nextFailure++;
+    }
+    // the failures consumer works on the values read once per frame, as in the interface
+    LocalVariable::readAll();
+    failuresConsumer.update();
+  }
+
+  void updateElac(const FlightState& state, int elacIndex) {
+    const int oppElacIndex = elacIndex == 0 ? 1 : 0;
+    const bool slatsOut = state.condition.flapsConf != FlapsConf::CONF_0;
+    const SurfaceOrders& surfaces = aircraft.surfacePositions();
+    elac_inputs& in = elacs[elacIndex].modelInputs.in;
+
+    fillTime(in.time, state);
+    fillSimData(in.sim_data);
+
+    in.discrete_inputs.ground_spoilers_active_1 = secsDiscreteOutputs[0].ground_spoiler_out;
+    in.discrete_inputs.ground_spoilers_active_2 =
+        elacIndex == 0 ? secsDiscreteOutputs[1].ground_spoiler_out : secsDiscreteOutputs[2].ground_spoiler_out;
+    in.discrete_inputs.is_unit_1 = elacIndex == 0;
+    in.discrete_inputs.is_unit_2 = elacIndex == 1;
+    in.discrete_inputs.opp_axis_pitch_failure = !elacsDiscreteOutputs[oppElacIndex].pitch_axis_ok;
+    in.discrete_inputs.ap_1_disengaged = true;
+    in.discrete_inputs.ap_2_disengaged = true;
+    in.discrete_inputs.opp_left_aileron_lost = !elacsDiscreteOutputs[oppElacIndex].left_aileron_ok;
+    in.discrete_inputs.opp_right_aileron_lost = !elacsDiscreteOutputs[oppElacIndex].right_aileron_ok;
+    in.discrete_inputs.fac_1_yaw_control_lost = !facsDiscreteOutputs[0].yaw_damper_avail_for_norm_law;
+    in.discrete_inputs.fac_2_yaw_control_lost = !facsDiscreteOutputs[1].yaw_damper_avail_for_norm_law;
+    in.discrete_inputs.sfcc_1_slats_out = slatsOut;
+    in.discrete_inputs.sfcc_2_slats_out = slatsOut;
+    in.discrete_inputs.elac_engaged_from_switch = true;
+
+    in.analog_inputs.capt_pitch_stick_pos = state.pitchStick;
+    in.analog_inputs.capt_roll_stick_pos = state.rollStick;
+    in.analog_inputs.left_elevator_pos_deg = surfaces.leftElevatorDeg;
+    in.analog_inputs.right_elevator_pos_deg = surfaces.rightElevatorDeg;
+    in.analog_inputs.ths_pos_deg = surfaces.thsDeg;
+    in.analog_inputs.left_aileron_pos_deg = surfaces.leftAileronDeg;
+    in.analog_inputs.right_aileron_pos_deg = surfaces.rightAileronDeg;
+    in.analog_inputs.load_factor_acc_1_g = state.nzG;
+    in.analog_inputs.load_factor_acc_2_g = state.nzG;
+    in.analog_inputs.blue_hyd_pressure_psi = HYDRAULIC_PRESSURE_PSI;
+    in.analog_inputs.green_hyd_pressure_psi = HYDRAULIC_PRESSURE_PSI;
+    in.analog_inputs.yellow_hyd_pressure_psi = HYDRAULIC_PRESSURE_PSI;
+
+    fillAdrBus(in.bus_inputs.adr_1_bus, state, 0);
+    fillAdrBus(in.bus_inputs.adr_2_bus, state, 1);
+    fillAdrBus(in.bus_inputs.adr_3_bus, state, 2);
+    fillIrBus(in.bus_inputs.ir_1_bus, state, 0);
+    fillIrBus(in.bus_inputs.ir_2_bus, state, 1);
+    fillIrBus(in.bus_inputs.ir_3_bus, state, 2);
+    fillRaBus(in.bus_inputs.ra_1_bus, state, 0);
+    fillRaBus(in.bus_inputs.ra_2_bus, state, 1);
+    fillSfccBus(in.bus_inputs.sfcc_1_bus, state);
+    fillSfccBus(in.bus_inputs.sfcc_2_bus, state);
+    in.bus_inputs.fcdc_1_bus = fcdcsBusOutputs[0];
+    in.bus_inputs.fcdc_2_bus = fcdcsBusOutputs[1];
+    in.bus_inputs.sec_1_bus = secsBusOutputs[0];
+    in.bus_inputs.sec_2_bus = secsBusOutputs[1];
+    in.bus_inputs.elac_opp_bus = elacsBusOutputs[oppElacIndex];
+
+    elacs[elacIndex].update(SAMPLE_TIME_SECONDS, state.timeSeconds,
+                            failuresConsumer.isActive(elacIndex == 0 ? Failures::Elac1 : Failures::Elac2), true);
+
+    elacsDiscreteOutputs[elacIndex] = elacs[elacIndex].getDiscreteOutputs();
+    elacsAnalogOutputs[elacIndex] = elacs[elacIndex].getAnalogOutputs();
+    elacsBusOutputs[elacIndex] = elacs[elacIndex].getBusOutputs();
+  }
+
+  void updateSec(const FlightState& state, int secIndex) {
+    const int oppSecIndex = secIndex == 0 ? 1 : 0;
+    const bool slatsOut = state.condition.flapsConf != FlapsConf::CONF_0;
+    const SurfaceOrders& surfaces = aircraft.surfacePositions();
+    sec_inputs& in = secs[secIndex].modelInputs.in;
+
+    fillTime(in.time, state);
+    fillSimData(in.sim_data);
+
+    in.discrete_inputs.sec_engaged_from_switch = true;
+    in.discrete_inputs.is_unit_1 = secIndex == 0;
+    in.discrete_inputs.is_unit_2 = secIndex == 1;
+    in.discrete_inputs.is_unit_3 = secIndex == 2;
+    // SEC 3 has no pitch function
+    if (secIndex < 2) {
+      in.discrete_inputs.pitch_not_avail_elac_1 = !elacsDiscreteOutputs[0].pitch_axis_ok;
+      in.discrete_inputs.pitch_not_avail_elac_2 = !elacsDiscreteOutputs[1].pitch_axis_ok;
+      in.discrete_inputs.left_elev_not_avail_sec_opp = !secsDiscreteOutputs[oppSecIndex].left_elevator_ok;
+      in.discrete_inputs.right_elev_not_avail_sec_opp = !secsDiscreteOutputs[oppSecIndex].right_elevator_ok;
+      in.analog_inputs.capt_pitch_stick_pos = state.pitchStick;
+      in.analog_inputs.left_elevator_pos_deg = surfaces.leftElevatorDeg;
+      in.analog_inputs.right_elevator_pos_deg = surfaces.rightElevatorDeg;
+      in.analog_inputs.ths_pos_deg = surfaces.thsDeg;
+      in.analog_inputs.load_factor_acc_1_g = state.nzG;
+      in.analog_inputs.load_factor_acc_2_g = state.nzG;
+    }
+    in.discrete_inputs.digital_output_failed_elac_1 = !elacsDiscreteOutputs[0].digital_output_validated;
+    in.discrete_inputs.digital_output_failed_elac_2 = !elacsDiscreteOutputs[1].digital_output_validated;
+    in.discrete_inputs.sfcc_1_slats_out = slatsOut;
+    in.discrete_inputs.sfcc_2_slats_out = slatsOut;
+
+    in.analog_inputs.capt_roll_stick_pos = state.rollStick;
+    in.analog_inputs.thr_lever_1_pos = 25;
+    in.analog_inputs.thr_lever_2_pos = 25;
+    // the dynamics only keep the sum of the spoilers of a wing, the spoilers follow the orders of the previous frame
+    in.analog_inputs.left_spoiler_1_pos_deg = secsAnalogOutputs[secIndex].left_spoiler_1_pos_order_deg;
+    in.analog_inputs.right_spoiler_1_pos_deg = secsAnalogOutputs[secIndex].right_spoiler_1_pos_order_deg;
+    in.analog_inputs.left_spoiler_2_pos_deg = secsAnalogOutputs[secIndex].left_spoiler_2_pos_order_deg;
+    in.analog_inputs.right_spoiler_2_pos_deg = secsAnalogOutputs[secIndex].right_spoiler_2_pos_order_deg;
+
+    // ADRs and IRs per SEC as in the aircraft
+    const int adrIrIndices[3][2] = {{0, 2}, {0, 1}, {1, 2}};
+    fillAdrBus(in.bus_inputs.adr_1_bus, state, adrIrIndices[secIndex][0]);
+    fillAdrBus(in.bus_inputs.adr_2_bus, state, adrIrIndices[secIndex][1]);
+    fillIrBus(in.bus_inputs.ir_1_bus, state, adrIrIndices[secIndex][0]);
+    fillIrBus(in.bus_inputs.ir_2_bus, state, adrIrIndices[secIndex][1]);
+    in.bus_inputs.fcdc_1_bus = fcdcsBusOutputs[0];
+    in.bus_inputs.fcdc_2_bus = fcdcsBusOutputs[1];
+    in.bus_inputs.elac_1_bus = elacsBusOutputs[0];
+    in.bus_inputs.elac_2_bus = elacsBusOutputs[1];
+    fillSfccBus(in.bus_inputs.sfcc_1_bus, state);
+    fillSfccBus(in.bus_inputs.sfcc_2_bus, state);
+    fillLgciuBus(in.bus_inputs.lgciu_1_bus, state);
+    fillLgciuBus(in.bus_inputs.lgciu_2_bus, state);
+
+    const Failures failure = secIndex == 0 ? Failures::Sec1 : (secIndex == 1 ? Failures::Sec2 : Failures::Sec3);
+    secs[secIndex].update(SAMPLE_TIME_SECONDS, state.timeSeconds, failuresConsumer.isActive(failure), true);
+
+    secsDiscreteOutputs[secIndex] = secs[secIndex].getDiscreteOutputs();
+    secsAnalogOutputs[secIndex] = secs[secIndex].getAnalogOutputs();
+    secsBusOutputs[secIndex] = secs[secIndex].getBusOutputs();
+  }
+
+  void updateFac(const FlightState& state, int facIndex) {
+    const int oppFacIndex = facIndex == 0 ? 1 : 0;
+    fac_inputs& in = facs[facIndex].modelInputs.in;
+
+    fillTime(in.time, state);
+    fillSimData(in.sim_data);
+
+    in.discrete_inputs.yaw_damper_opp_engaged = facsDiscreteOutputs[oppFacIndex].yaw_damper_engaged;
+    in.discrete_inputs.rudder_trim_opp_engaged = facsDiscreteOutputs[oppFacIndex].rudder_trim_engaged;
+    in.discrete_inputs.rudder_travel_lim_opp_engaged = facsDiscreteOutputs[oppFacIndex].rudder_travel_lim_engaged;
+    in.discrete_inputs.elac_1_healthy = elacsDiscreteOutputs[0].digital_output_validated;
+    in.discrete_inputs.elac_2_healthy = elacsDiscreteOutputs[1].digital_output_validated;
+    in.discrete_inputs.fac_engaged_from_switch = true;
+    in.discrete_inputs.fac_opp_healthy = facsDiscreteOutputs[oppFacIndex].fac_healthy;
+    in.discrete_inputs.is_unit_1 = facIndex == 0;
+    in.discrete_inputs.rudder_trim_actuator_healthy = true;
+    in.discrete_inputs.rudder_travel_lim_actuator_healthy = true;
+    in.discrete_inputs.slats_extended = state.condition.flapsConf != FlapsConf::CONF_0;
+    in.discrete_inputs.yaw_damper_has_hyd_press = true;
+
+    in.analog_inputs.yaw_damper_position_deg = facsAnalogOutputs[facIndex].yaw_damper_order_deg;
+    in.analog_inputs.rudder_trim_position_deg = facsAnalogOutputs[facIndex].rudder_trim_order_deg;
+    in.analog_inputs.rudder_travel_lim_position_deg = facsAnalogOutputs[facIndex].rudder_travel_limit_order_deg;
+
+    in.bus_inputs.fac_opp_bus = facsBusOutputs[oppFacIndex];
+    fillAdrBus(in.bus_inputs.adr_own_bus, state, facIndex);
+    fillAdrBus(in.bus_inputs.adr_opp_bus, state, oppFacIndex);
+    fillAdrBus(in.bus_inputs.adr_3_bus, state, 2);
+    fillIrBus(in.bus_inputs.ir_own_bus, state, facIndex);
+    fillIrBus(in.bus_inputs.ir_opp_bus, state, oppFacIndex);
+    fillIrBus(in.bus_inputs.ir_3_bus, state, 2);
+    fillSfccBus(in.bus_inputs.sfcc_own_bus, state);
+    fillLgciuBus(in.bus_inputs.lgciu_own_bus, state);
+    in.bus_inputs.elac_1_bus = elacsBusOutputs[0];
+    in.bus_inputs.elac_2_bus = elacsBusOutputs[1];
+
+    facs[facIndex].update(SAMPLE_TIME_SECONDS, state.timeSeconds,
+                          failuresConsumer.isActive(facIndex == 0 ? Failures::Fac1 : Failures::Fac2), true);
+
+    facsDiscreteOutputs[facIndex] = facs[facIndex].getDiscreteOutputs();
+    facsAnalogOutputs[facIndex] = facs[facIndex].getAnalogOutputs();
+    facsBusOutputs[facIndex] = facs[facIndex].getBusOutputs();
+  }
+
+  void updateFcdc(int fcdcIndex) {
+    const int oppFcdcIndex = fcdcIndex == 0 ? 1 : 0;
+    Fcdc& fcdc = fcdcs[fcdcIndex];
+
+    fcdc.discreteInputs.elac1Valid = elacsDiscreteOutputs[0].digital_output_validated;
+    fcdc.discreteInputs.elac2Valid = elacsDiscreteOutputs[1].digital_output_validated;
+    fcdc.discreteInputs.sec1Valid = !secsDiscreteOutputs[0].sec_failed;
+    fcdc.discreteInputs.sec2Valid = !secsDiscreteOutputs[1].sec_failed;
+    fcdc.discreteInputs.sec3Valid = !secsDiscreteOutputs[2].sec_failed;
+    fcdc.discreteInputs.oppFcdcFailed = !fcdcsDiscreteOutputs[oppFcdcIndex].fcdcValid;
+    fcdc.busInputs.elac1 = elacsBusOutputs[0];
+    fcdc.busInputs.elac2 = elacsBusOutputs[1];
+    fcdc.busInputs.sec1 = secsBusOutputs[0];
+    fcdc.busInputs.sec2 = secsBusOutputs[1];
+    fcdc.busInputs.sec3 = secsBusOutputs[2];
+    fcdc.busInputs.fcdcOpp = fcdcsBusOutputs[oppFcdcIndex];
+
+    fcdc.update(SAMPLE_TIME_SECONDS, failuresConsumer.isActive(fcdcIndex == 0 ? Failures::Fcdc1 : Failures::Fcdc2), true);
+
+    fcdcsDiscreteOutputs[fcdcIndex] = fcdc.getDiscreteOutputs();
+    // the bus of the wrapper has the layout of the bus of the models
+    const FcdcBus bus = fcdc.getBusOutputs();
+    static_assert(sizeof(FcdcBus) == sizeof(base_fcdc_bus));
+    std::memcpy(&fcdcsBusOutputs[fcdcIndex], &bus, sizeof(bus));
+  }
+
+  /**
+   * @return the surface orders of the computers whose servos are in active mode, as the hydraulic
+   * actuators of the systems simulation do
+   */
+  [[nodiscard]] SurfaceOrders surfaceOrders() const {
+    SurfaceOrders orders{};
+    for (int i = 0; i < 2; i++) {
+      if (elacsDiscreteOutputs[i].left_aileron_active_mode) {
+        orders.leftAileronDeg = elacsAnalogOutputs[i].left_aileron_pos_order;
+      }
+      if (elacsDiscreteOutputs[i].right_aileron_active_mode) {
+        orders.rightAileronDeg = elacsAnalogOutputs[i].right_aileron_pos_order;
+      }
+    }
+    // the elevator servos have a reverted logic: the damping mode of the computers of the other side energizes the
+    // solenoid, which puts the servo in damping mode
+    for (int i = 0; i < 2; i++) {
+      const int other = i == 0 ? 1 : 0;
+      if (!elacsDiscreteOutputs[other].left_elevator_damping_mode && !secsDiscreteOutputs[other].left_elevator_damping_mode) {
+        orders.leftElevatorDeg = elacsAnalogOutputs[i].left_elev_pos_order_deg + secsAnalogOutputs[i].left_elev_pos_order_deg;
+      }
+      if (!elacsDiscreteOutputs[other].right_elevator_damping_mode && !secsDiscreteOutputs[other].right_elevator_damping_mode) {
+        orders.rightElevatorDeg = elacsAnalogOutputs[i].right_elev_pos_order_deg + secsAnalogOutputs[i].right_elev_pos_order_deg;
+      }
+    }
+    if (elacsDiscreteOutputs[1].ths_active) {
+      orders.thsDeg = elacsAnalogOutputs[1].ths_pos_order;
+    } else if (elacsDiscreteOutputs[0].ths_active || secsDiscreteOutputs[0].ths_active) {
+      orders.thsDeg = elacsAnalogOutputs[0].ths_pos_order + secsAnalogOutputs[0].ths_pos_order_deg;
+    } else if (secsDiscreteOutputs[1].ths_active) {
+      orders.thsDeg = secsAnalogOutputs[1].ths_pos_order_deg;
+    } else {
+      orders.thsDeg = aircraft.surfacePositions().thsDeg;
+    }
+    for (const base_sec_analog_outputs& sec : secsAnalogOutputs) {
+      orders.leftSpoilersDeg += sec.left_spoiler_1_pos_order_deg + sec.left_spoiler_2_pos_order_deg;
+      orders.rightSpoilersDeg += sec.right_spoiler_1_pos_order_deg + sec.right_spoiler_2_pos_order_deg;
+    }
+    return orders;
+  }
+
+  /**
+   * @return the pitch law of the first valid FCDC, the last reported one if both FCDCs failed
+   */
+  ReportedPitchLaw reportedPitchLaw() {
+    for (const base_fcdc_bus& bus : fcdcsBusOutputs) {
+      if (bus.efcs_status_word_1.SSM != static_cast<std::uint32_t>(Arinc429SignStatus::NormalOperation)) {
+        continue;
+      }
+      if (Arinc429Utils::bitFromValue(bus.efcs_status_word_1, 11)) {
+        lastPitchLaw = ReportedPitchLaw::NORMAL;
+      } else if (Arinc429Utils::bitFromValue(bus.efcs_status_word_1, 12)) {
+        lastPitchLaw = ReportedPitchLaw::ALTERNATE_1;
+      } else if (Arinc429Utils::bitFromValue(bus.efcs_status_word_1, 13)) {
+        lastPitchLaw = ReportedPitchLaw::ALTERNATE_2;
+      } else if (Arinc429Utils::bitFromValue(bus.efcs_status_word_1, 15)) {
+        lastPitchLaw = ReportedPitchLaw::DIRECT;
+      } else {
+        lastPitchLaw = ReportedPitchLaw::MECHANICAL_BACKUP;
+      }
+      break;
+    }
+    return lastPitchLaw;
+  }
+
+  /**
+   * @return the reported pitch law once it has been reported for the confirmation time
+   */
+  ReportedPitchLaw confirmPitchLaw() {
+    const ReportedPitchLaw previousPitchLaw = lastPitchLaw;
+    if (reportedPitchLaw() != previousPitchLaw) {
+      pitchLawSeconds = 0;
+    }
+    pitchLawSeconds += SAMPLE_TIME_SECONDS;
+    if (pitchLawSeconds >= PITCH_LAW_CONFIRMATION_SECONDS) {
+      confirmedPitchLaw = lastPitchLaw;
+    }
+    return confirmedPitchLaw;
+  }
+
+ public:
+  /**
+   * @param parameters the parameters of the scenario, they must outlive the instance
+   */
+  explicit A32nxFlightControls(const ScenarioParameters& parameters)
+      : parameters(parameters),
+        aircraft(parameters.condition, parameters.weightKg, A32NX_AIRCRAFT.nominalWeightKg, parameters.baseCondition->tasKn),
+        inputs(parameters, parameters.condition.tasKn * 0.514444) {
+    // a previous scenario on this thread may have ended with a failure not consumed yet
+    failureActivate = std::make_unique<LocalVariable>("A32NX_FAILURE_ACTIVATE");
+    failureActivate->set(0);
+    failuresConsumer.initialize();
+  }
+
+  A32nxFlightControls(const A32nxFlightControls&) = delete;             // no copy constructor
+  A32nxFlightControls& operator=(const A32nxFlightControls&) = delete;  // no copy assignment
+
+  /**
+   * Saves the state of the computers and surfaces, the failures consumer is not saved as no failure is
+   * injected during the warm-up.
+   * @param state the state to save to
+   */
+  void save(WarmedUpState& state) const {
+    state.elacs.save(elacs);
+    state.secs.save(secs);
+    state.facs.save(facs);
+    state.fcdcs.save(fcdcs);
+    state.elacsDiscreteOutputs.save(elacsDiscreteOutputs);
+    state.elacsAnalogOutputs.save(elacsAnalogOutputs);
+    state.elacsBusOutputs.save(elacsBusOutputs);
+    state.secsDiscreteOutputs.save(secsDiscreteOutputs);
+    state.secsAnalogOutputs.save(secsAnalogOutputs);
+    state.secsBusOutputs.save(secsBusOutputs);
+    state.facsDiscreteOutputs.save(facsDiscreteOutputs);
+    state.facsAnalogOutputs.save(facsAnalogOutputs);
+    state.facsBusOutputs.save(facsBusOutputs);
+    state.fcdcsDiscreteOutputs.save(fcdcsDiscreteOutputs);
+    state.fcdcsBusOutputs.save(fcdcsBusOutputs);
+    state.surfaces = aircraft.surfacePositions();
+  }
+
+  /**
+   * Restores the state of the computers and surfaces of a warm-up.
+   * @param state the state saved by an instance flying the same condition
+   */
+  void restore(const WarmedUpState& state) {
+    state.elacs.restore(elacs);
+    state.secs.restore(secs);
+    state.facs.restore(facs);
+    state.fcdcs.restore(fcdcs);
+    state.elacsDiscreteOutputs.restore(elacsDiscreteOutputs);
+    state.elacsAnalogOutputs.restore(elacsAnalogOutputs);
+    state.elacsBusOutputs.restore(elacsBusOutputs);
+    state.secsDiscreteOutputs.restore(secsDiscreteOutputs);
+    state.secsAnalogOutputs.restore(secsAnalogOutputs);
+    state.secsBusOutputs.restore(secsBusOutputs);
+    state.facsDiscreteOutputs.restore(facsDiscreteOutputs);
+    state.facsAnalogOutputs.restore(facsAnalogOutputs);
+    state.facsBusOutputs.restore(facsBusOutputs);
+    state.fcdcsDiscreteOutputs.restore(fcdcsDiscreteOutputs);
+    state.fcdcsBusOutputs.restore(fcdcsBusOutputs);
+    aircraft.setSurfacePositions(state.surfaces);
+  }
+
+  /**
+   * Runs the scenario.
+   * @param firstFrame the frame to start from, the end of the warm-up when a warmed-up state has been restored
+   * @return the envelope reached after the warm-up
+   */
+  ScenarioResult run(std::uint64_t firstFrame = 0) {
+    ScenarioResult result{};
+
+    for (std::uint64_t frame = firstFrame; frame < parameters.frames; frame++) {
+      const bool warmup = frame < parameters.warmupFrames;
+      const double timeSeconds = static_cast<double>(frame) * SAMPLE_TIME_SECONDS;
+      if (!warmup) {
+        // the stall warning is inhibited in normal law
+        const FlightState previousState = aircraft.state(timeSeconds, inputs.getPitchStick(), inputs.getRollStick());
+        const bool stallWarning = confirmedPitchLaw != ReportedPitchLaw::NORMAL && previousState.alphaDeg > aircraft.stallAlphaDeg();
+        inputs.update(previousState, stallWarning);
+      }
+
+      FlightState state = aircraft.state(timeSeconds, inputs.getPitchStick(), inputs.getRollStick());
+      state.windDirectionDeg = parameters.windDirectionDeg;
+      state.windSpeedKn = parameters.windSpeedKn;
+
+      injectFailures(timeSeconds);
+      updateElac(state, 0);
+      updateElac(state, 1);
+      updateSec(state, 0);
+      updateSec(state, 1);
+      updateSec(state, 2);
+      updateFac(state, 0);
+      updateFac(state, 1);
+      updateFcdc(0);
+      updateFcdc(1);
+
+      aircraft.updateSurfaces(surfaceOrders(), SAMPLE_TIME_SECONDS);
+      // the aircraft is held in the condition while the computers complete their self tests
+      if (warmup) {
+        continue;
+      }
+      aircraft.integrate(inputs.getVerticalGustMS(), SAMPLE_TIME_SECONDS);
+
+      const bool highAlphaProtection = Arinc429Utils::bitFromValueOr(elacsBusOutputs[0].discrete_status_word_2, 23, false) ||
+                                       Arinc429Utils::bitFromValueOr(elacsBusOutputs[1].discrete_status_word_2, 23, false);
+      const bool alphaFloor = Arinc429Utils::bitFromValueOr(facsBusOutputs[0].discrete_word_5, 29, false) ||
+                              Arinc429Utils::bitFromValueOr(facsBusOutputs[1].discrete_word_5, 29, false);
+      result.record(state, SAMPLE_TIME_SECONDS, highAlphaProtection, alphaFloor, confirmPitchLaw());
+    }
+    return result;
+  }
+};
+
+int main(int argc, char** argv) {
+  MonteCarloRunner runner{A32NX_AIRCRAFT, MonteCarloRunner::parseArguments(argc, argv)};
+  runner.run(
+      [](const ScenarioParameters& parameters) {
+        // the computers are too large for the stack of a worker thread
+        auto controls = std::make_unique<A32nxFlightControls>(parameters);
+        if (!parameters.forkWarmup) {
+          return controls->run();
+        }
+
+        // the warm-up only depends on the base condition, so each thread flies it once per condition
+        thread_local std::map<const FlightCondition*, std::unique_ptr<WarmedUpState>> warmedUpStates;
+        std::unique_ptr<WarmedUpState>& warmedUpState = warmedUpStates[parameters.baseCondition];
+        if (!warmedUpState) {
+          const ScenarioParameters warmupParameters{0, parameters.warmupFrames, parameters.warmupFrames, 0,
+                                                    *parameters.baseCondition, A32NX_AIRCRAFT.nominalWeightKg, 0, 0, 0, {},
+                                                    parameters.baseCondition, false};
+          auto warmup = std::make_unique<A32nxFlightControls>(warmupParameters);
+          warmup->run();
+          warmedUpState = std::make_unique<WarmedUpState>();
+          warmup->save(*warmedUpState);
+        }
+        controls->restore(*warmedUpState);
+        return controls->run(parameters.warmupFrames);
+      },
+      std::cout);
+  return 0;
+}
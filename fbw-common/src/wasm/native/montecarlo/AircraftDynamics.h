@@ -0,0 +1,188 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_NATIVE_AIRCRAFTDYNAMICS_H
+#define FLYBYWIRE_NATIVE_AIRCRAFTDYNAMICS_H
+
+#include <algorithm>
+#include <cmath>
+
+#include "FlightScenarios.h"
+
+/**
+ * @brief Orders of the flight control computers to the surfaces. Spoilers are summed per wing.
+ */
+struct SurfaceOrders {
+  double leftElevatorDeg;
+  double rightElevatorDeg;
+  double thsDeg;
+  double leftAileronDeg;
+  double rightAileronDeg;
+  double leftSpoilersDeg;
+  double rightSpoilersDeg;
+};
+
+/**
+ * @brief Simplified dynamics of the aircraft around a trimmed flight condition, used to close the loop
+ * around the flight control computers.<p/>
+ *
+ * This is not a flight model. The speed, altitude and radio height are held at the ones of the
+ * condition, so the mode logic of the computers does not change during a scenario (e.g. no flare).
+ * The pitch axis is a short period mode with a linear lift curve up to the stall and a stable pitch break
+ * beyond it, the load factor is scaled with the weight and turns the flight path. The roll axis is a
+ * first order roll mode. The surfaces follow the orders with first order actuators. The gains give
+ * responses of the order of magnitude of an airliner, so the control laws and protections act on a
+ * plausible response.<p/>
+ *
+ * Signs follow the orders of the computers: positive elevator and THS deflections are nose down,
+ * spoiler deflections are negative when extended, so a positive aileron difference (left - right) and
+ * spoilers extended on the right wing roll to the right.
+ */
+class AircraftDynamics {
+ private:
+  static constexpr double DEG_TO_RAD = 0.017453292519943295;
+  static constexpr double RAD_TO_DEG = 57.29577951308232;
+  static constexpr double GRAVITY_MS2 = 9.80665;
+  static constexpr double KNOTS_TO_MS = 0.514444;
+
+  // short period mode
+  static constexpr double SHORT_PERIOD_FREQUENCY_RAD_S = 1.5;
+  static constexpr double SHORT_PERIOD_DAMPING = 0.6;
+  // change of the trimmed angle of attack per degree of elevator, the THS is more effective
+  static constexpr double ALPHA_PER_ELEVATOR_DEG = 0.8;
+  static constexpr double THS_EFFECTIVENESS = 1.5;
+  // angle of attack at zero lift, lower with slats and flaps extended
+  static constexpr double ZERO_LIFT_ALPHA_CLEAN_DEG = -2.0;
+  static constexpr double ZERO_LIFT_ALPHA_FLAPS_DEG = -6.0;
+  // the lift does not increase anymore above the stall angle of attack
+  static constexpr double STALL_ALPHA_CLEAN_DEG = 12.0;
+  static constexpr double STALL_ALPHA_FLAPS_DEG = 16.0;
+  // stable pitch break: the pitching moment per degree of angle of attack above the stall is this much stronger
+  static constexpr double STALL_PITCH_BREAK = 2.0;
+
+  // roll mode: steady roll rate per degree of aileron difference and per degree of spoiler difference
+  static constexpr double ROLL_RATE_PER_AILERON_DEG = 0.5;
+  static constexpr double ROLL_RATE_PER_SPOILER_DEG = 0.15;
+  static constexpr double ROLL_TIME_CONSTANT_S = 0.6;
+
+  // actuators
+  static constexpr double ACTUATOR_TIME_CONSTANT_S = 0.08;
+  static constexpr double SURFACE_RATE_DEG_S = 40.0;
+  static constexpr double THS_RATE_DEG_S = 1.0;
+
+  const FlightCondition& condition;
+  double speedMS;
+  double zeroLiftAlphaDeg;
+  double alphaStallDeg;
+  // angle of attack giving a load factor of 1 at the weight of the aircraft
+  double trimAlphaDeg;
+  // load factor per degree of angle of attack above the zero lift angle
+  double nzPerAlphaDeg;
+
+  double thetaDeg;
+  double gammaDeg;
+  double qDegS = 0;
+  double phiDeg = 0;
+  double pDegS = 0;
+  double gustAlphaDeg = 0;
+  SurfaceOrders surfaces{};
+
+  static double follow(double position, double order, double maxRateDegS, double dt) {
+    const double rateLimit = maxRateDegS * dt;
+    const double change = (order - position) * std::min(1.0, dt / ACTUATOR_TIME_CONSTANT_S);
+    return position + std::clamp(change, -rateLimit, rateLimit);
+  }
+
+ public:
+  /**
+   * @param condition the condition the aircraft is trimmed in with all surfaces at zero, the angle of attack of
+   * the condition is the one at the nominal weight and speed
+   * @param weightKg the weight of the aircraft
+   * @param nominalWeightKg the weight the condition is trimmed for
+   * @param nominalTasKn the true airspeed the condition is trimmed for, the lift needed grows with the weight
+   * and decreases with the square of the speed
+   */
+  AircraftDynamics(const FlightCondition& condition, double weightKg, double nominalWeightKg, double nominalTasKn)
+      : condition(condition),
+        speedMS(condition.tasKn * KNOTS_TO_MS),
+        zeroLiftAlphaDeg(condition.flapsConf == FlapsConf::CONF_0 ? ZERO_LIFT_ALPHA_CLEAN_DEG : ZERO_LIFT_ALPHA_FLAPS_DEG),
+        alphaStallDeg(condition.flapsConf == FlapsConf::CONF_0 ? STALL_ALPHA_CLEAN_DEG : STALL_ALPHA_FLAPS_DEG),
+        trimAlphaDeg(zeroLiftAlphaDeg + (condition.alphaDeg - zeroLiftAlphaDeg) * weightKg / nominalWeightKg *
+                                            (nominalTasKn / condition.tasKn) * (nominalTasKn / condition.tasKn)),
+        nzPerAlphaDeg(1.0 / (trimAlphaDeg - zeroLiftAlphaDeg)),
+        thetaDeg(condition.thetaDeg - condition.alphaDeg + trimAlphaDeg),
+        gammaDeg(condition.thetaDeg - condition.alphaDeg) {}
+
+  AircraftDynamics(const AircraftDynamics&) = delete;             // no copy constructor
+  AircraftDynamics& operator=(const AircraftDynamics&) = delete;  // no copy assignment
+
+  [[nodiscard]] double alphaDeg() const { return thetaDeg - gammaDeg + gustAlphaDeg; }
+  [[nodiscard]] double stallAlphaDeg() const { return alphaStallDeg; }
+  [[nodiscard]] double nzG() const { return nzPerAlphaDeg * (std::min(alphaDeg(), alphaStallDeg) - zeroLiftAlphaDeg); }
+  [[nodiscard]] const SurfaceOrders& surfacePositions() const { return surfaces; }
+
+  /**
+   * Moves the surfaces to the given positions, e.g. the ones of a forked warm-up.
+   * @param positions the positions of the surfaces
+   */
+  void setSurfacePositions(const SurfaceOrders& positions) { surfaces = positions; }
+
+  /**
+   * Moves the surfaces towards the orders.
+   * @param orders the orders of the computers
+   * @param dt the time step
+   */
+  void updateSurfaces(const SurfaceOrders& orders, double dt) {
+    surfaces.leftElevatorDeg = follow(surfaces.leftElevatorDeg, orders.leftElevatorDeg, SURFACE_RATE_DEG_S, dt);
+    surfaces.rightElevatorDeg = follow(surfaces.rightElevatorDeg, orders.rightElevatorDeg, SURFACE_RATE_DEG_S, dt);
+    surfaces.thsDeg = follow(surfaces.thsDeg, orders.thsDeg, THS_RATE_DEG_S, dt);
+    surfaces.leftAileronDeg = follow(surfaces.leftAileronDeg, orders.leftAileronDeg, SURFACE_RATE_DEG_S, dt);
+    surfaces.rightAileronDeg = follow(surfaces.rightAileronDeg, orders.rightAileronDeg, SURFACE_RATE_DEG_S, dt);
+    surfaces.leftSpoilersDeg = follow(surfaces.leftSpoilersDeg, orders.leftSpoilersDeg, SURFACE_RATE_DEG_S, dt);
+    surfaces.rightSpoilersDeg = follow(surfaces.rightSpoilersDeg, orders.rightSpoilersDeg, SURFACE_RATE_DEG_S, dt);
+  }
+
+  /**
+   * Integrates the pitch and roll axes with the current surface positions.
+   * @param verticalGustMS the vertical wind, positive upwards
+   * @param dt the time step
+   */
+  void integrate(double verticalGustMS, double dt) {
+    gustAlphaDeg = std::atan2(verticalGustMS, speedMS) * RAD_TO_DEG;
+
+    const double alphaChangeDeg = alphaDeg() - trimAlphaDeg;
+    const double elevatorDeg = 0.5 * (surfaces.leftElevatorDeg + surfaces.rightElevatorDeg) + THS_EFFECTIVENESS * surfaces.thsDeg;
+    const double omega2 = SHORT_PERIOD_FREQUENCY_RAD_S * SHORT_PERIOD_FREQUENCY_RAD_S;
+    const double stallExcessDeg = std::max(0.0, alphaDeg() - alphaStallDeg);
+    const double qDotDegS2 = -omega2 * (alphaChangeDeg + STALL_PITCH_BREAK * stallExcessDeg + ALPHA_PER_ELEVATOR_DEG * elevatorDeg) -
+                             2.0 * SHORT_PERIOD_DAMPING * SHORT_PERIOD_FREQUENCY_RAD_S * qDegS;
+
+    const double gammaDotDegS =
+        GRAVITY_MS2 / speedMS * (nzG() * std::cos(phiDeg * DEG_TO_RAD) - std::cos(gammaDeg * DEG_TO_RAD)) * RAD_TO_DEG;
+
+    const double steadyRollRateDegS = ROLL_RATE_PER_AILERON_DEG * (surfaces.leftAileronDeg - surfaces.rightAileronDeg) +
+                                      ROLL_RATE_PER_SPOILER_DEG * (surfaces.leftSpoilersDeg - surfaces.rightSpoilersDeg);
+    const double pDotDegS2 = (steadyRollRateDegS - pDegS) / ROLL_TIME_CONSTANT_S;
+
+    // semi-implicit Euler, rates first
+    qDegS += qDotDegS2 * dt;
+    pDegS += pDotDegS2 * dt;
+    thetaDeg += qDegS * dt;
+    phiDeg = std::remainder(phiDeg + pDegS * dt, 360.0);
+    gammaDeg = std::clamp(gammaDeg + gammaDotDegS * dt, -90.0, 90.0);
+  }
+
+  /**
+   * @param timeSeconds the time of the scenario
+   * @param pitchStick the pitch sidestick position of the frame
+   * @param rollStick the roll sidestick position of the frame
+   * @return the state of the aircraft as seen by the sensors
+   */
+  [[nodiscard]] FlightState state(double timeSeconds, double pitchStick, double rollStick) const {
+    const double verticalSpeedFtMin = speedMS * std::sin(gammaDeg * DEG_TO_RAD) * 196.850394;
+    return FlightState{condition, timeSeconds, pitchStick, rollStick, thetaDeg, phiDeg, qDegS, pDegS, nzG(), condition.radioHeightFt,
+                       alphaDeg(), gammaDeg, verticalSpeedFtMin, 0, 0};
+  }
+};
+
+#endif  // FLYBYWIRE_NATIVE_AIRCRAFTDYNAMICS_H
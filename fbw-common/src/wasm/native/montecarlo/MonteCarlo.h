@@ -0,0 +1,576 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+#ifndef FLYBYWIRE_NATIVE_MONTECARLO_H
+#define FLYBYWIRE_NATIVE_MONTECARLO_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "FlightScenarios.h"
+#include "WorkStealingPool.h"
+
+/**
+ * @brief Options of the Monte-Carlo executables, parsed from the command line.
+ */
+struct MonteCarloOptions {
+  std::uint64_t scenarios = 1000;
+  // index of the first scenario, so single scenarios of a run can be reproduced
+  std::uint64_t firstScenario = 0;
+  std::uint64_t seed = 1;
+  // worker threads, 0 for one per hardware thread
+  unsigned int threads = 0;
+  // simulated time of a scenario after the warm-up
+  double durationSeconds = 60;
+  // probabilities of a scenario with failed computers and with failed sensors
+  double computerFailureProbability = 0.3;
+  double sensorFailureProbability = 0.2;
+  // warm the computers up once per flight condition and fork all scenarios of the condition from that state
+  bool forkWarmup = false;
+  bool json = false;
+};
+
+/**
+ * @brief What the Monte-Carlo runner needs to know about an aircraft.
+ */
+struct MonteCarloAircraft {
+  const char* name;
+  double minWeightKg;
+  double maxWeightKg;
+  // the weight the flight conditions are trimmed for
+  double nominalWeightKg;
+  // identifiers of the computer failures (FailureList.h) the failures consumer of the aircraft handles
+  std::vector<int> computerFailures;
+};
+
+/**
+ * @brief A computer failure activated during a scenario.
+ */
+struct ComputerFailure {
+  int identifier;
+  double timeSeconds;
+};
+
+/**
+ * @brief The randomly perturbed parameters of a scenario.<p/>
+ *
+ * The parameters and the random inputs during the scenario only depend on the seed of the run and the
+ * index of the scenario, so a scenario gives the same result independent of the number of threads.
+ */
+struct ScenarioParameters {
+  std::uint64_t index;
+  // frames of the warm-up, during which the aircraft is held in the condition and nothing is recorded
+  std::uint64_t warmupFrames;
+  // frames of the scenario including the warm-up
+  std::uint64_t frames;
+  // seed of the random sidestick inputs and gusts during the scenario
+  std::uint64_t inputSeed;
+  // a copy of the base condition with the failed sensors of the scenario
+  FlightCondition condition;
+  double weightKg;
+  // direction the wind is coming from
+  double windDirectionDeg;
+  double windSpeedKn;
+  // standard deviation of the vertical gusts
+  double turbulenceSigmaMS;
+  std::vector<ComputerFailure> computerFailures;
+  // the healthy condition the scenario starts from, the same instance for all scenarios starting from it
+  const FlightCondition* baseCondition;
+  // the warm-up is flown once per base condition at the nominal weight without wind, and the weight, wind and
+  // failed sensors of the scenario only apply once the aircraft is released
+  bool forkWarmup;
+};
+
+// the pitch law reported by the flight control data concentrators, from normal to the mechanical backup
+enum class ReportedPitchLaw { NORMAL, ALTERNATE_1, ALTERNATE_2, DIRECT, MECHANICAL_BACKUP };
+
+constexpr const char* REPORTED_PITCH_LAW_NAMES[] = {"normal", "alternate-1", "alternate-2", "direct", "mechanical-backup"};
+constexpr int REPORTED_PITCH_LAW_COUNT = 5;
+
+/**
+ * @brief The envelope reached in a scenario after the warm-up.
+ */
+struct ScenarioResult {
+  double maxNzG = -std::numeric_limits<double>::infinity();
+  double minNzG = std::numeric_limits<double>::infinity();
+  double maxAlphaDeg = -std::numeric_limits<double>::infinity();
+  double maxAbsPhiDeg = 0;
+  double maxThetaDeg = -std::numeric_limits<double>::infinity();
+  double minThetaDeg = std::numeric_limits<double>::infinity();
+  double highAlphaProtectionSeconds = 0;
+  bool alphaFloorTriggered = false;
+  ReportedPitchLaw mostDegradedPitchLaw = ReportedPitchLaw::NORMAL;
+
+  /**
+   * Adds a frame of the scenario to the envelope.
+   */
+  void record(const FlightState& state, double dt, bool highAlphaProtection, bool alphaFloor, ReportedPitchLaw pitchLaw) {
+    maxNzG = std::max(maxNzG, state.nzG);
+    minNzG = std::min(minNzG, state.nzG);
+    maxAlphaDeg = std::max(maxAlphaDeg, state.alphaDeg);
+    maxAbsPhiDeg = std::max(maxAbsPhiDeg, std::fabs(state.phiDeg));
+    maxThetaDeg = std::max(maxThetaDeg, state.thetaDeg);
+    minThetaDeg = std::min(minThetaDeg, state.thetaDeg);
+    if (highAlphaProtection) {
+      highAlphaProtectionSeconds += dt;
+    }
+    alphaFloorTriggered = alphaFloorTriggered || alphaFloor;
+    mostDegradedPitchLaw = std::max(mostDegradedPitchLaw, pitchLaw);
+  }
+};
+
+/**
+ * @brief Random inputs during a scenario: sidestick deflections held for a random time, a third of them
+ * neutral, and vertical gusts as a first order Gauss-Markov process.<p/>
+ *
+ * The pilot does not hold the random deflections beyond the envelope of the normal law: beyond its bank
+ * and pitch attitude limits the axis is flown back with an input growing with the excess, and the stall
+ * warning is answered with a push. The normal law keeps the aircraft inside these limits and inhibits the
+ * stall warning, so only the degraded laws are affected, which would otherwise depart from any plausible
+ * flight (bank angles up to 180 deg).
+ */
+class ScenarioInputs {
+ private:
+  static constexpr double GUST_LENGTH_M = 300.0;
+
+  // envelope the pilot keeps the aircraft in, the limits of the bank angle and pitch attitude protections
+  static constexpr double BANK_LIMIT_DEG = 67.0;
+  static constexpr double PITCH_UP_LIMIT_DEG = 30.0;
+  static constexpr double PITCH_DOWN_LIMIT_DEG = -15.0;
+  // recovery input when just beyond a limit and its growth per degree of excess
+  static constexpr double RECOVERY_STICK = 0.2;
+  static constexpr double RECOVERY_STICK_PER_DEG = 0.1;
+  static constexpr double STALL_RECOVERY_STICK = -0.5;
+  // the pilot flies the attitude predicted from the current rates over this time
+  static constexpr double ANTICIPATION_SECONDS = 1.0;
+
+  std::mt19937_64 random;
+  double turbulenceSigmaMS;
+  double gustCorrelation;
+  double holdRemainingSeconds = 0;
+  double heldPitchStick = 0;
+  double heldRollStick = 0;
+  double pitchStick = 0;
+  double rollStick = 0;
+  double verticalGustMS = 0;
+
+ public:
+  /**
+   * @param parameters the parameters of the scenario
+   * @param speedMS the true airspeed the gusts are flown through
+   */
+  ScenarioInputs(const ScenarioParameters& parameters, double speedMS)
+      : random(parameters.inputSeed),
+        turbulenceSigmaMS(parameters.turbulenceSigmaMS),
+        gustCorrelation(std::exp(-SAMPLE_TIME_SECONDS * speedMS / GUST_LENGTH_M)) {}
+
+  /**
+   * @param excessDeg how far the aircraft is beyond a limit, negative or zero within it
+   * @return the stick deflection towards the limit needed to recover, zero within the limit
+   */
+  static double recovery(double excessDeg) {
+    return excessDeg > 0 ? std::min(1.0, RECOVERY_STICK + RECOVERY_STICK_PER_DEG * excessDeg) : 0;
+  }
+
+  /**
+   * Advances the inputs by one frame.
+   * @param state the state of the aircraft in the previous frame
+   * @param stallWarning true if the stall warning sounds
+   */
+  void update(const FlightState& state, bool stallWarning) {
+    holdRemainingSeconds -= SAMPLE_TIME_SECONDS;
+    if (holdRemainingSeconds <= 0) {
+      holdRemainingSeconds = std::uniform_real_distribution<double>(0.5, 6.0)(random);
+      std::uniform_real_distribution<double> deflection(-1.0, 1.0);
+      const bool neutral = std::uniform_int_distribution<int>(0, 2)(random) == 0;
+      heldPitchStick = neutral ? 0 : deflection(random);
+      heldRollStick = neutral ? 0 : deflection(random);
+    }
+    const double thetaDeg = state.thetaDeg + ANTICIPATION_SECONDS * state.qDegS;
+    const double phiDeg = state.phiDeg + ANTICIPATION_SECONDS * state.pDegS;
+    double pitch = thetaDeg > PITCH_UP_LIMIT_DEG ? -recovery(thetaDeg - PITCH_UP_LIMIT_DEG) : recovery(PITCH_DOWN_LIMIT_DEG - thetaDeg);
+    if (stallWarning) {
+      pitch = std::min(pitch, STALL_RECOVERY_STICK);
+    }
+    const double roll = -std::copysign(recovery(std::fabs(phiDeg) - BANK_LIMIT_DEG), phiDeg);
+    pitchStick = pitch != 0 ? pitch : heldPitchStick;
+    rollStick = roll != 0 ? roll : heldRollStick;
+    const double noise = std::normal_distribution<double>(0.0, 1.0)(random);
+    verticalGustMS = gustCorrelation * verticalGustMS + turbulenceSigmaMS * std::sqrt(1.0 - gustCorrelation * gustCorrelation) * noise;
+  }
+
+  [[nodiscard]] double getPitchStick() const { return pitchStick; }
+  [[nodiscard]] double getRollStick() const { return rollStick; }
+  [[nodiscard]] double getVerticalGustMS() const { return verticalGustMS; }
+};
+
+/**
+ * @brief Runs randomly perturbed closed-loop scenarios of the flight control computers on a thread pool
+ * and reports the statistics of the envelope reached.<p/>
+ *
+ * A scenario starts from one of the healthy flight conditions of the benchmarks with a random weight,
+ * wind, turbulence, failed sensors (ADRs, an IR and a RA as in the benchmark scenarios) and computer
+ * failures activated at a random time. Each scenario is simulated by a callable which builds its own
+ * set of computers, so scenarios are independent and the run scales with the number of threads.
+ *
+ * @usage
+ *   MonteCarloRunner runner{A32NX_AIRCRAFT, MonteCarloRunner::parseArguments(argc, argv)};<br/>
+ *   runner.run([](const ScenarioParameters& parameters) { ... return result; }, std::cout);
+ */
+class MonteCarloRunner {
+ private:
+  // the warm-up lets the computers complete their self tests
+  static constexpr double WARMUP_SECONDS = 12.0;
+  // standard deviation of the vertical gusts of moderate turbulence
+  static constexpr double MAX_TURBULENCE_SIGMA_MS = 1.5;
+
+  MonteCarloAircraft aircraft;
+  MonteCarloOptions options;
+
+  struct Distribution {
+    double min;
+    double p50;
+    double p95;
+    double p99;
+    double max;
+    std::uint64_t maxScenario;
+  };
+
+  struct Summary {
+    std::string name;
+    std::uint64_t scenarios = 0;
+    Distribution maxNzG{};
+    Distribution minNzG{};
+    Distribution maxAlphaDeg{};
+    Distribution maxAbsPhiDeg{};
+    std::uint64_t highAlphaProtection = 0;
+    double highAlphaProtectionSeconds = 0;
+    std::uint64_t alphaFloor = 0;
+    std::uint64_t pitchLaws[REPORTED_PITCH_LAW_COUNT] = {};
+  };
+
+  static void printUsage(const char* executable) {
+    std::cerr << "Usage: " << executable << " [options]\n"
+              << "  --scenarios <n>           number of scenarios (default 1000)\n"
+              << "  --first <index>           index of the first scenario (default 0)\n"
+              << "  --seed <value>            seed of the random perturbations (default 1)\n"
+              << "  --threads <n>             worker threads (default one per hardware thread)\n"
+              << "  --duration <seconds>      simulated time per scenario after the warm-up (default 60)\n"
+              << "  --computer-failures <p>   probability of a scenario with failed computers (default 0.3)\n"
+              << "  --sensor-failures <p>     probability of a scenario with failed sensors (default 0.2)\n"
+              << "  --fork-warmup             fork the scenarios from one warm-up per flight condition\n"
+              << "  --json                    output the results as JSON\n";
+  }
+
+  static std::vector<const FlightCondition*> baseConditions() {
+    std::vector<const FlightCondition*> conditions{};
+    for (const FlightCondition& condition : FLIGHT_CONDITIONS) {
+      // failures are added randomly and the flare needs a varying radio height the runs do not model
+      if (condition.failedAdrCount == 0 && !condition.sensorFailures && condition.radioHeightVariationFt == 0) {
+        conditions.push_back(&condition);
+      }
+    }
+    return conditions;
+  }
+
+  /**
+   * @return the parameters of a scenario, only depending on the seed and the index
+   */
+  [[nodiscard]] ScenarioParameters generate(std::uint64_t index, const std::vector<const FlightCondition*>& conditions) const {
+    std::seed_seq sequence{options.seed, index};
+    std::mt19937_64 random(sequence);
+    auto uniform = [&random](double min, double max) { return std::uniform_real_distribution<double>(min, max)(random); };
+    auto chance = [&uniform](double probability) { return uniform(0, 1) < probability; };
+
+    const auto warmupFrames = static_cast<std::uint64_t>(WARMUP_SECONDS / SAMPLE_TIME_SECONDS);
+    const auto frames = warmupFrames + static_cast<std::uint64_t>(options.durationSeconds / SAMPLE_TIME_SECONDS);
+    const std::uint64_t inputSeed = random();
+    const FlightCondition* baseCondition = conditions[random() % conditions.size()];
+    ScenarioParameters parameters{index, warmupFrames, frames, inputSeed, *baseCondition, 0, 0, 0, 0, {}, baseCondition,
+                                  options.forkWarmup};
+    parameters.weightKg = uniform(aircraft.minWeightKg, aircraft.maxWeightKg);
+    // with slats and flaps extended the speeds are flown relative to the stall speed, which grows with the square
+    // root of the weight, so a heavy aircraft does not approach with a reduced margin to the stall
+    if (baseCondition->flapsConf != FlapsConf::CONF_0) {
+      const double speedFactor = std::sqrt(parameters.weightKg / aircraft.nominalWeightKg);
+      parameters.condition.iasKn *= speedFactor;
+      parameters.condition.tasKn *= speedFactor;
+      parameters.condition.mach *= speedFactor;
+    }
+    parameters.windDirectionDeg = uniform(0, 360);
+    parameters.windSpeedKn = uniform(0, 60);
+    // up to moderate turbulence, severe turbulence drives the gust angle of attack beyond what the laws can protect
+    parameters.turbulenceSigmaMS = chance(0.5) ? uniform(0, MAX_TURBULENCE_SIGMA_MS) : 0;
+
+    if (chance(options.sensorFailureProbability)) {
+      parameters.condition.failedAdrCount = static_cast<int>(random() % 4);
+      parameters.condition.sensorFailures = parameters.condition.failedAdrCount == 0 || chance(0.5);
+    }
+
+    if (!aircraft.computerFailures.empty() && chance(options.computerFailureProbability)) {
+      std::vector<int> candidates = aircraft.computerFailures;
+      const std::uint64_t count = 1 + random() % 2;
+      for (std::uint64_t i = 0; i < count && !candidates.empty(); i++) {
+        const std::size_t candidate = random() % candidates.size();
+        parameters.computerFailures.push_back({candidates[candidate], WARMUP_SECONDS + uniform(0, options.durationSeconds)});
+        candidates.erase(candidates.begin() + static_cast<std::ptrdiff_t>(candidate));
+      }
+      std::sort(parameters.computerFailures.begin(), parameters.computerFailures.end(),
+                [](const ComputerFailure& a, const ComputerFailure& b) { return a.timeSeconds < b.timeSeconds; });
+    }
+    return parameters;
+  }
+
+  static Distribution distribution(const std::vector<std::pair<double, std::uint64_t>>& sortedValues) {
+    auto percentile = [&sortedValues](double p) {
+      const auto rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sortedValues.size())));
+      return sortedValues[std::clamp<std::size_t>(rank, 1, sortedValues.size()) - 1].first;
+    };
+    return {sortedValues.front().first, percentile(0.5), percentile(0.95), percentile(0.99), sortedValues.back().first,
+            sortedValues.back().second};
+  }
+
+  template <typename Metric>
+  static Distribution distribution(const std::vector<std::uint64_t>& indices,
+                                   const std::vector<ScenarioResult>& results,
+                                   std::uint64_t firstScenario,
+                                   Metric&& metric) {
+    std::vector<std::pair<double, std::uint64_t>> values{};
+    values.reserve(indices.size());
+    for (const std::uint64_t i : indices) {
+      values.emplace_back(metric(results[i]), firstScenario + i);
+    }
+    std::sort(values.begin(), values.end());
+    return distribution(values);
+  }
+
+  [[nodiscard]] Summary summarize(const std::string& name,
+                                  const std::vector<std::uint64_t>& indices,
+                                  const std::vector<ScenarioResult>& results) const {
+    Summary summary{name, indices.size()};
+    if (indices.empty()) {
+      return summary;
+    }
+    const std::uint64_t first = options.firstScenario;
+    summary.maxNzG = distribution(indices, results, first, [](const ScenarioResult& r) { return r.maxNzG; });
+    // the lowest load factor is the extreme, so it is summarized negated and flipped back
+    Distribution minNz = distribution(indices, results, first, [](const ScenarioResult& r) { return -r.minNzG; });
+    summary.minNzG = {-minNz.max, -minNz.p50, -minNz.p95, -minNz.p99, -minNz.min, minNz.maxScenario};
+    summary.maxAlphaDeg = distribution(indices, results, first, [](const ScenarioResult& r) { return r.maxAlphaDeg; });
+    summary.maxAbsPhiDeg = distribution(indices, results, first, [](const ScenarioResult& r) { return r.maxAbsPhiDeg; });
+    for (const std::uint64_t i : indices) {
+      const ScenarioResult& result = results[i];
+      if (result.highAlphaProtectionSeconds > 0) {
+        summary.highAlphaProtection++;
+        summary.highAlphaProtectionSeconds += result.highAlphaProtectionSeconds;
+      }
+      if (result.alphaFloorTriggered) {
+        summary.alphaFloor++;
+      }
+      summary.pitchLaws[static_cast<int>(result.mostDegradedPitchLaw)]++;
+    }
+    return summary;
+  }
+
+  static void printDistribution(std::ostream& out, const char* name, const Distribution& d, bool lowestIsExtreme = false) {
+    out << "  " << std::left << std::setw(18) << name << std::right << std::fixed << std::setprecision(2);
+    if (lowestIsExtreme) {
+      out << std::setw(10) << d.max << std::setw(10) << d.p50 << std::setw(10) << d.p95 << std::setw(10) << d.p99 << std::setw(10)
+          << d.min;
+    } else {
+      out << std::setw(10) << d.min << std::setw(10) << d.p50 << std::setw(10) << d.p95 << std::setw(10) << d.p99 << std::setw(10)
+          << d.max;
+    }
+    out << std::setw(12) << d.maxScenario << "\n" << std::defaultfloat;
+  }
+
+  void reportTable(std::ostream& out, const std::vector<Summary>& summaries, double wallSeconds, unsigned int threads) const {
+    const double simulatedSeconds = static_cast<double>(options.scenarios) * (WARMUP_SECONDS + options.durationSeconds);
+    out << aircraft.name << " Monte-Carlo - " << options.scenarios << " scenarios of " << options.durationSeconds << " s, seed "
+        << options.seed << ", " << threads << " threads" << (options.forkWarmup ? ", forked warm-up" : "") << "\n";
+    out << std::fixed << std::setprecision(2) << "wall time " << wallSeconds << " s, "
+        << static_cast<double>(options.scenarios) / wallSeconds << " scenarios/s, " << std::setprecision(0)
+        << simulatedSeconds / wallSeconds << "x real time\n"
+        << std::defaultfloat;
+
+    for (const Summary& summary : summaries) {
+      out << "\n" << summary.name << " (" << summary.scenarios << " scenarios)\n";
+      if (summary.scenarios == 0) {
+        continue;
+      }
+      out << "  " << std::left << std::setw(18) << "" << std::right << std::setw(10) << "min" << std::setw(10) << "p50" << std::setw(10)
+          << "p95" << std::setw(10) << "p99" << std::setw(10) << "max" << std::setw(12) << "scenario" << "\n";
+      printDistribution(out, "max nz [g]", summary.maxNzG);
+      // the percentiles of the lowest load factor count from the lowest value
+      printDistribution(out, "min nz [g]", summary.minNzG, true);
+      printDistribution(out, "max alpha [deg]", summary.maxAlphaDeg);
+      printDistribution(out, "max |phi| [deg]", summary.maxAbsPhiDeg);
+      out << "  high alpha protection " << summary.highAlphaProtection << " scenarios, " << std::fixed << std::setprecision(1)
+          << summary.highAlphaProtectionSeconds << " s" << std::defaultfloat << "\n";
+      out << "  alpha floor           " << summary.alphaFloor << " scenarios\n";
+      out << "  most degraded pitch law:";
+      for (int law = 0; law < REPORTED_PITCH_LAW_COUNT; law++) {
+        out << " " << REPORTED_PITCH_LAW_NAMES[law] << " " << summary.pitchLaws[law];
+      }
+      out << "\n";
+    }
+  }
+
+  static void writeJsonDistribution(std::ostream& out, const char* name, const Distribution& d) {
+    out << "\"" << name << "\": {\"min\": " << d.min << ", \"p50\": " << d.p50 << ", \"p95\": " << d.p95 << ", \"p99\": " << d.p99
+        << ", \"max\": " << d.max << ", \"extremeScenario\": " << d.maxScenario << "}";
+  }
+
+  void reportJson(std::ostream& out, const std::vector<Summary>& summaries, double wallSeconds, unsigned int threads) const {
+    out << std::setprecision(6);
+    out << "{\n";
+    out << "  \"aircraft\": \"" << aircraft.name << "\",\n";
+    out << "  \"scenarios\": " << options.scenarios << ",\n";
+    out << "  \"firstScenario\": " << options.firstScenario << ",\n";
+    out << "  \"seed\": " << options.seed << ",\n";
+    out << "  \"durationSeconds\": " << options.durationSeconds << ",\n";
+    out << "  \"forkWarmup\": " << (options.forkWarmup ? "true" : "false") << ",\n";
+    out << "  \"threads\": " << threads << ",\n";
+    out << "  \"wallSeconds\": " << wallSeconds << ",\n";
+    out << "  \"groups\": [";
+    for (std::size_t i = 0; i < summaries.size(); i++) {
+      const Summary& summary = summaries[i];
+      out << (i == 0 ? "\n" : ",\n");
+      out << "    {\"name\": \"" << summary.name << "\", \"scenarios\": " << summary.scenarios;
+      if (summary.scenarios > 0) {
+        out << ", ";
+        writeJsonDistribution(out, "maxNzG", summary.maxNzG);
+        out << ", ";
+        writeJsonDistribution(out, "minNzG", summary.minNzG);
+        out << ", ";
+        writeJsonDistribution(out, "maxAlphaDeg", summary.maxAlphaDeg);
+        out << ", ";
+        writeJsonDistribution(out, "maxAbsPhiDeg", summary.maxAbsPhiDeg);
+        out << ", \"highAlphaProtection\": " << summary.highAlphaProtection
+            << ", \"highAlphaProtectionSeconds\": " << summary.highAlphaProtectionSeconds << ", \"alphaFloor\": " << summary.alphaFloor
+            << ", \"mostDegradedPitchLaw\": {";
+        for (int law = 0; law < REPORTED_PITCH_LAW_COUNT; law++) {
+          out << (law == 0 ? "" : ", ") << "\"" << REPORTED_PITCH_LAW_NAMES[law] << "\": " << summary.pitchLaws[law];
+        }
+        out << "}";
+      }
+      out << "}";
+    }
+    out << "\n  ]\n}\n";
+  }
+
+ public:
+  /**
+   * @param aircraft the aircraft whose computers are simulated
+   * @param options the options of the run
+   */
+  MonteCarloRunner(MonteCarloAircraft aircraft, MonteCarloOptions options) : aircraft(std::move(aircraft)), options(std::move(options)) {}
+
+  MonteCarloRunner(const MonteCarloRunner&) = delete;             // no copy constructor
+  MonteCarloRunner& operator=(const MonteCarloRunner&) = delete;  // no copy assignment
+
+  /**
+   * Parses the command line. Prints the usage and exits on invalid arguments or --help.
+   * @return the options of the run
+   */
+  static MonteCarloOptions parseArguments(int argc, char** argv) {
+    MonteCarloOptions options{};
+    for (int i = 1; i < argc; i++) {
+      const std::string argument = argv[i];
+      const bool hasValue = i + 1 < argc;
+      if (argument == "--json") {
+        options.json = true;
+      } else if (argument == "--fork-warmup") {
+        options.forkWarmup = true;
+      } else if (argument == "--scenarios" && hasValue) {
+        options.scenarios = std::max<std::uint64_t>(1, std::strtoull(argv[++i], nullptr, 10));
+      } else if (argument == "--first" && hasValue) {
+        options.firstScenario = std::strtoull(argv[++i], nullptr, 10);
+      } else if (argument == "--seed" && hasValue) {
+        options.seed = std::strtoull(argv[++i], nullptr, 10);
+      } else if (argument == "--threads" && hasValue) {
+        options.threads = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+      } else if (argument == "--duration" && hasValue) {
+        options.durationSeconds = std::max(1.0, std::strtod(argv[++i], nullptr));
+      } else if (argument == "--computer-failures" && hasValue) {
+        options.computerFailureProbability = std::clamp(std::strtod(argv[++i], nullptr), 0.0, 1.0);
+      } else if (argument == "--sensor-failures" && hasValue) {
+        options.sensorFailureProbability = std::clamp(std::strtod(argv[++i], nullptr), 0.0, 1.0);
+      } else {
+        printUsage(argv[0]);
+        std::exit(argument == "--help" ? EXIT_SUCCESS : EXIT_FAILURE);
+      }
+    }
+    return options;
+  }
+
+  /**
+   * Runs all scenarios on the thread pool and writes the report.
+   * @param simulate callable taking the ScenarioParameters and returning the ScenarioResult of the scenario,
+   *                 it is called concurrently from the worker threads
+   * @param out the stream to write the report to
+   */
+  template <typename SimulateFunction>
+  void run(SimulateFunction&& simulate, std::ostream& out) {
+    const std::vector<const FlightCondition*> conditions = baseConditions();
+    const unsigned int threads = options.threads > 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<ScenarioParameters> parameters{};
+    parameters.reserve(options.scenarios);
+    for (std::uint64_t i = 0; i < options.scenarios; i++) {
+      parameters.push_back(generate(options.firstScenario + i, conditions));
+    }
+
+    // every task writes its own result, so the results need no synchronization
+    std::vector<ScenarioResult> results(options.scenarios);
+    std::vector<std::function<void()>> tasks{};
+    tasks.reserve(options.scenarios);
+    for (std::uint64_t i = 0; i < options.scenarios; i++) {
+      tasks.emplace_back([&simulate, &parameters, &results, i]() { results[i] = simulate(parameters[i]); });
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    WorkStealingPool(threads).run(tasks);
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<Summary> summaries{};
+    std::vector<std::uint64_t> all(options.scenarios);
+    for (std::uint64_t i = 0; i < options.scenarios; i++) {
+      all[i] = i;
+    }
+    summaries.push_back(summarize("all", all, results));
+    for (const FlightCondition* condition : conditions) {
+      std::vector<std::uint64_t> indices{};
+      std::vector<std::uint64_t> failedIndices{};
+      for (std::uint64_t i = 0; i < options.scenarios; i++) {
+        if (std::string(parameters[i].condition.name) == condition->name) {
+          const ScenarioParameters& p = parameters[i];
+          const bool healthy = p.computerFailures.empty() && p.condition.failedAdrCount == 0 && !p.condition.sensorFailures;
+          (healthy ? indices : failedIndices).push_back(i);
+        }
+      }
+      summaries.push_back(summarize(std::string(condition->name) + " healthy", indices, results));
+      summaries.push_back(summarize(std::string(condition->name) + " with failures", failedIndices, results));
+    }
+
+    if (options.json) {
+      reportJson(out, summaries, wallSeconds, threads);
+    } else {
+      reportTable(out, summaries, wallSeconds, threads);
+    }
+  }
+};
+
+#endif  // FLYBYWIRE_NATIVE_MONTECARLO_H
@@ -0,0 +1,13 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Replays the A32NX autopilot and autothrust models from a flight data recorder file.
+
+#include <iostream>
+
+#include "FdrReplay.h"
+
+int main(int argc, char** argv) {
+  FdrReplayRunner runner{"A32NX", FdrReplayRunner::parseArguments(argc, argv)};
+  return runner.run<AutothrustModelClass>(std::cout);
+}
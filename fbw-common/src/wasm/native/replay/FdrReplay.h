@@ -0,0 +1,562 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Offline replay of the autopilot state machine, the autopilot laws and the autothrust from a
+// flight data recorder file. Both aircraft use models with the same names and interfaces, this
+// header is compiled against the models and recorder field tables of the aircraft whose source
+// directory is on the include path.
+
+#ifndef FLYBYWIRE_NATIVE_FDRREPLAY_H
+#define FLYBYWIRE_NATIVE_FDRREPLAY_H
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "AutopilotLaws.h"
+#include "AutopilotStateMachine.h"
+#include "Autothrust.h"
+#include "FlightDataRecorderFields.h"
+#include "FlightDataRecorderReader.h"
+
+// exit codes of the replay executables
+constexpr int REPLAY_EXIT_IDENTICAL = 0;
+constexpr int REPLAY_EXIT_DIVERGENT = 1;
+constexpr int REPLAY_EXIT_ERROR = 2;
+
+// the model inputs are recorded since this interface version, older files cannot be replayed
+constexpr std::uint64_t FIRST_INTERFACE_VERSION_WITH_INPUTS = 27;
+
+// column of the sample time of a frame, the difference of the simulation time to the previous frame
+constexpr std::string_view SAMPLE_TIME_COLUMN = "ap_sm_in.time.dt";
+
+// largest difference between the simulation time step and the recorded sample time that is not a gap
+constexpr double FRAME_GAP_TOLERANCE = 1e-6;
+
+/**
+ * @brief Options of the replay executables, parsed from the command line.
+ */
+struct ReplayOptions {
+  std::string filePath;
+  bool noCompression = false;
+  // largest difference of floating point outputs that is not reported, zero requires bit-exact outputs
+  double tolerance = 0;
+  // number of divergent fields listed for the first divergent frame of a model
+  std::size_t maxReportedFields = 10;
+};
+
+/**
+ * @param type the type of the value
+ * @param value pointer to the value, does not need to be aligned
+ * @return the value converted to a double for reporting and tolerance checks
+ */
+inline double fdrValueAsDouble(FdrFieldType type, const char* value) {
+  auto read = [value]<typename T>(T) {
+    T result;
+    std::memcpy(&result, value, sizeof(T));
+    return static_cast<double>(result);
+  };
+  switch (type) {
+    case FdrFieldType::Boolean:
+      return read(bool{});
+    case FdrFieldType::Int8:
+      return read(std::int8_t{});
+    case FdrFieldType::UInt8:
+      return read(std::uint8_t{});
+    case FdrFieldType::Int16:
+      return read(std::int16_t{});
+    case FdrFieldType::UInt16:
+      return read(std::uint16_t{});
+    case FdrFieldType::Int32:
+      return read(std::int32_t{});
+    case FdrFieldType::UInt32:
+      return read(std::uint32_t{});
+    case FdrFieldType::Int64:
+      return read(std::int64_t{});
+    case FdrFieldType::UInt64:
+      return read(std::uint64_t{});
+    case FdrFieldType::Float:
+      return read(float{});
+    case FdrFieldType::Double:
+      return read(double{});
+  }
+  return 0;
+}
+
+/**
+ * @brief Binds the fields of a compiled-in recorded struct to the columns of a file.<p/>
+ *
+ * Fields are matched by their column name ("struct.field") and type, not by their offset, so a
+ * file can be replayed with a newer version of the models as long as the fields it needs were
+ * recorded. Fields without a matching column are reported as missing.
+ */
+class FdrStructBinding {
+ public:
+  struct Field {
+    const FdrField* field;
+    std::string columnName;
+    std::uint32_t frameOffset;
+    std::size_t columnIndex;
+  };
+
+ private:
+  std::vector<Field> fields{};
+  std::vector<std::string> missingFields{};
+
+ public:
+  /**
+   * @param schema the schema of the file
+   * @param structName the name of the struct in FDR_STRUCTS
+   */
+  FdrStructBinding(const FlightDataRecorderFileSchema& schema, std::string_view structName) {
+    const FdrStruct* fdrStruct = nullptr;
+    for (const FdrStruct& s : FDR_STRUCTS) {
+      if (s.name == structName) {
+        fdrStruct = &s;
+      }
+    }
+    if (fdrStruct == nullptr) {
+      return;
+    }
+
+    std::unordered_map<std::string_view, std::size_t> columnIndices{};
+    const std::vector<FdrColumn>& columns = schema.getColumns();
+    for (std::size_t i = 0; i < columns.size(); i++) {
+      columnIndices.emplace(columns[i].name, i);
+    }
+
+    for (std::uint32_t i = 0; i < fdrStruct->fieldCount; i++) {
+      const FdrField& field = fdrStruct->fields[i];
+      std::string columnName = std::string{structName} + "." + std::string{field.name};
+      auto column = columnIndices.find(columnName);
+      if (column == columnIndices.end() || columns[column->second].type != field.type) {
+        missingFields.push_back(std::move(columnName));
+        continue;
+      }
+      fields.push_back(Field{&field, std::move(columnName), columns[column->second].offset, column->second});
+    }
+  }
+
+  [[nodiscard]] const std::vector<Field>& getFields() const { return fields; }
+  [[nodiscard]] const std::vector<std::string>& getMissingFields() const { return missingFields; }
+
+  /**
+   * Marks the columns of the bound fields for decoding.
+   * @param selectedColumns the selected columns of the reader
+   */
+  void select(std::vector<bool>& selectedColumns) const {
+    for (const Field& field : fields) {
+      selectedColumns[field.columnIndex] = true;
+    }
+  }
+
+  /**
+   * Copies the bound fields of a frame into the struct, missing fields are left unchanged.
+   * @param frame the frame read from the file
+   * @param target the struct
+   */
+  void copy(const char* frame, void* target) const {
+    char* destination = static_cast<char*>(target);
+    for (const Field& field : fields) {
+      std::memcpy(destination + field.field->offset, frame + field.frameOffset, fdrFieldTypeSize(field.field->type));
+    }
+  }
+};
+
+/**
+ * @brief A field whose replayed value differs from the recorded one.
+ */
+struct FdrFieldDivergence {
+  std::string name;
+  double recorded;
+  double replayed;
+};
+
+/**
+ * @brief Result of the replay of one model.
+ */
+struct ModelReplayResult {
+  std::string model;
+  std::uint64_t frames = 0;
+  std::uint64_t divergentFrames = 0;
+  std::optional<std::uint64_t> firstDivergentFrame{};
+  double firstDivergentSimulationTime = 0;
+  std::size_t firstDivergentFieldCount = 0;
+  std::vector<FdrFieldDivergence> firstDivergentFields{};
+  // frames after a gap in the file, they are not replayed
+  std::uint64_t skippedFrames = 0;
+  std::vector<std::string> missingInputs{};
+  std::vector<std::string> missingOutputs{};
+};
+
+/**
+ * @brief Replays a generated model from the inputs recorded in a file and compares its outputs
+ * with the recorded ones.<p/>
+ *
+ * The model starts from its initial state and is stepped once per frame. Its outputs are compared
+ * with the recorded outputs after every step. As the model keeps its state after a divergence the
+ * following frames often diverge as well, so mainly the first divergent frame is of interest.
+ *
+ * @tparam Model the generated model class
+ * @tparam Inputs the external inputs of the model
+ * @tparam OutputFunction callable returning a pointer to the recorded output struct of the model
+ */
+template <typename Model, typename Inputs, typename OutputFunction>
+class ModelReplay {
+ private:
+  const ReplayOptions& options;
+  OutputFunction getOutputs;
+  std::unique_ptr<Model> model = std::make_unique<Model>();
+  std::unique_ptr<Inputs> inputs = std::make_unique<Inputs>();
+  FdrStructBinding inputBinding;
+  FdrStructBinding outputBinding;
+  ModelReplayResult result{};
+
+  [[nodiscard]] bool isDivergent(FdrFieldType type, const char* recorded, const char* replayed) const {
+    const bool isFloatingPoint = type == FdrFieldType::Float || type == FdrFieldType::Double;
+    if (options.tolerance == 0 || !isFloatingPoint) {
+      return std::memcmp(recorded, replayed, fdrFieldTypeSize(type)) != 0;
+    }
+    const double recordedValue = fdrValueAsDouble(type, recorded);
+    const double replayedValue = fdrValueAsDouble(type, replayed);
+    if (std::isnan(recordedValue) || std::isnan(replayedValue)) {
+      return std::isnan(recordedValue) != std::isnan(replayedValue);
+    }
+    return std::fabs(recordedValue - replayedValue) > options.tolerance;
+  }
+
+ public:
+  /**
+   * @param name the name of the model
+   * @param schema the schema of the file
+   * @param inputStruct the name of the recorded input struct in FDR_STRUCTS
+   * @param outputStruct the name of the recorded output struct in FDR_STRUCTS
+   * @param options the options of the replay
+   * @param getOutputs callable (const Model&) returning a pointer to the recorded output struct
+   */
+  ModelReplay(std::string name,
+              const FlightDataRecorderFileSchema& schema,
+              std::string_view inputStruct,
+              std::string_view outputStruct,
+              const ReplayOptions& options,
+              OutputFunction getOutputs)
+      : options(options), getOutputs(std::move(getOutputs)), inputBinding(schema, inputStruct), outputBinding(schema, outputStruct) {
+    result.model = std::move(name);
+    result.missingInputs = inputBinding.getMissingFields();
+    result.missingOutputs = outputBinding.getMissingFields();
+    model->initialize();
+  }
+
+  ModelReplay(const ModelReplay&) = delete;             // no copy constructor
+  ModelReplay& operator=(const ModelReplay&) = delete;  // no copy assignment
+
+  /**
+   * @return true if the file contains inputs of the model, files recorded before the inputs were
+   * added to the recorder do not
+   */
+  [[nodiscard]] bool hasInputs() const { return !inputBinding.getFields().empty(); }
+
+  /**
+   * Marks the columns needed for the replay for decoding.
+   * @param selectedColumns the selected columns of the reader
+   */
+  void select(std::vector<bool>& selectedColumns) const {
+    inputBinding.select(selectedColumns);
+    outputBinding.select(selectedColumns);
+  }
+
+  /**
+   * Steps the model with the inputs of a frame and compares its outputs with the recorded ones.
+   * @param frame the frame read from the file
+   * @param simulationTime the simulation time of the frame
+   */
+  void step(const char* frame, double simulationTime) {
+    inputBinding.copy(frame, &inputs->in);
+    model->setExternalInputs(inputs.get());
+    model->step();
+
+    const char* outputs = reinterpret_cast<const char*>(getOutputs(*model));
+    const bool isFirstDivergence = !result.firstDivergentFrame.has_value();
+    std::size_t divergentFieldCount = 0;
+    for (const FdrStructBinding::Field& field : outputBinding.getFields()) {
+      const char* recorded = frame + field.frameOffset;
+      const char* replayed = outputs + field.field->offset;
+      if (!isDivergent(field.field->type, recorded, replayed)) {
+        continue;
+      }
+      divergentFieldCount++;
+      if (isFirstDivergence && result.firstDivergentFields.size() < options.maxReportedFields) {
+        result.firstDivergentFields.push_back(FdrFieldDivergence{field.columnName, fdrValueAsDouble(field.field->type, recorded),
+                                                                 fdrValueAsDouble(field.field->type, replayed)});
+      }
+    }
+
+    if (divergentFieldCount > 0) {
+      result.divergentFrames++;
+      if (isFirstDivergence) {
+        result.firstDivergentFrame = result.frames;
+        result.firstDivergentSimulationTime = simulationTime;
+        result.firstDivergentFieldCount = divergentFieldCount;
+      }
+    }
+    result.frames++;
+  }
+
+  /**
+   * Counts a frame that follows a gap in the file. The state of the model cannot be restored after
+   * missing frames, so the frame is neither replayed nor compared.
+   */
+  void skip() { result.skippedFrames++; }
+
+  [[nodiscard]] const ModelReplayResult& getResult() const { return result; }
+};
+
+/**
+ * @brief Replays the autopilot state machine, the autopilot laws and the autothrust from a flight
+ * data recorder file and reports the first divergent frame of every model.<p/>
+ *
+ * Every model is replayed from its own recorded inputs, so a divergence of the state machine does
+ * not hide a divergence of the laws or the autothrust. The models start from their initial state,
+ * only files recorded from the start of a session replay exactly.<p/>
+ *
+ * Frames dropped by the recorder when its ring buffer overflowed leave a gap in the file. The
+ * simulation time of a frame then advances by more than its recorded sample time, and as the
+ * models missed the dropped steps all frames after the first gap are skipped instead of being
+ * reported as divergent.
+ *
+ * @usage
+ *   FdrReplayRunner runner{"A32NX", FdrReplayRunner::parseArguments(argc, argv)};<br/>
+ *   return runner.run<AutothrustModelClass>(std::cout);
+ */
+class FdrReplayRunner {
+ private:
+  std::string aircraft;
+  ReplayOptions options;
+
+  static void printUsage(const char* executable) {
+    std::cerr << "Usage: " << executable << " [options] <file.fdr>\n"
+              << "  -n, --no-compression  the file is not compressed\n"
+              << "  --tolerance <value>   largest difference of floating point outputs that is not reported (default 0)\n"
+              << "  --fields <n>          number of divergent fields listed for the first divergent frame (default 10)\n";
+  }
+
+  static bool isGzipFile(const std::string& filePath) {
+    std::ifstream file(filePath, std::ios::in | std::ios::binary);
+    unsigned char magic[2] = {};
+    file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    return file.good() && magic[0] == 0x1f && magic[1] == 0x8b;
+  }
+
+  static void printFieldList(std::ostream& out, const std::string& model, const char* description, const std::vector<std::string>& fields) {
+    if (fields.empty()) {
+      return;
+    }
+    out << "WARNING: " << model << ": " << fields.size() << " " << description << ":";
+    for (const std::string& field : fields) {
+      out << " " << field;
+    }
+    out << "\n";
+  }
+
+  static const FdrColumn* findColumn(const FlightDataRecorderFileSchema& schema, std::string_view name, FdrFieldType type) {
+    for (const FdrColumn& column : schema.getColumns()) {
+      if (column.name == name && column.type == type) {
+        return &column;
+      }
+    }
+    return nullptr;
+  }
+
+  static void printResult(std::ostream& out, const ModelReplayResult& result) {
+    const std::string skipped =
+        result.skippedFrames > 0 ? " (" + std::to_string(result.skippedFrames) + " frames after a gap skipped)" : std::string{};
+    if (!result.firstDivergentFrame.has_value()) {
+      out << result.model << ": identical" << skipped << "\n";
+      return;
+    }
+    out << result.model << ": " << result.divergentFrames << " of " << result.frames << " frames divergent, first at frame "
+        << *result.firstDivergentFrame << " (simulation time " << result.firstDivergentSimulationTime << " s) in "
+        << result.firstDivergentFieldCount << " fields" << skipped << "\n";
+    for (const FdrFieldDivergence& divergence : result.firstDivergentFields) {
+      out << "  " << std::left << std::setw(56) << divergence.name << std::right << std::setprecision(17) << " recorded "
+          << divergence.recorded << " replayed " << divergence.replayed << std::setprecision(6) << "\n";
+    }
+  }
+
+ public:
+  /**
+   * @param aircraft the name of the aircraft whose models are replayed
+   * @param options the options of the replay
+   */
+  FdrReplayRunner(std::string aircraft, ReplayOptions options) : aircraft(std::move(aircraft)), options(std::move(options)) {}
+
+  /**
+   * Parses the command line. Prints the usage and exits on invalid arguments or --help.
+   * @return the options of the replay
+   */
+  static ReplayOptions parseArguments(int argc, char** argv) {
+    ReplayOptions options{};
+    for (int i = 1; i < argc; i++) {
+      const std::string argument = argv[i];
+      const bool hasValue = i + 1 < argc;
+      if (argument == "-n" || argument == "--no-compression") {
+        options.noCompression = true;
+      } else if (argument == "--tolerance" && hasValue) {
+        options.tolerance = std::fabs(std::strtod(argv[++i], nullptr));
+      } else if (argument == "--fields" && hasValue) {
+        options.maxReportedFields = std::strtoull(argv[++i], nullptr, 10);
+      } else if (!argument.starts_with("-") && options.filePath.empty()) {
+        options.filePath = argument;
+      } else {
+        printUsage(argv[0]);
+        std::exit(argument == "--help" ? EXIT_SUCCESS : REPLAY_EXIT_ERROR);
+      }
+    }
+    if (options.filePath.empty()) {
+      printUsage(argv[0]);
+      std::exit(REPLAY_EXIT_ERROR);
+    }
+    return options;
+  }
+
+  /**
+   * Replays the file and writes the report.
+   * @tparam AutothrustModel the autothrust model class, its name differs between the aircraft
+   * @param out the stream to write the report to
+   * @return REPLAY_EXIT_IDENTICAL, REPLAY_EXIT_DIVERGENT or REPLAY_EXIT_ERROR
+   */
+  template <typename AutothrustModel>
+  int run(std::ostream& out) {
+    FlightDataRecorderReader reader;
+    if (!reader.open(options.filePath, !options.noCompression && isGzipFile(options.filePath))) {
+      std::cerr << "ERROR: failed to read '" << options.filePath << "', interface version " << reader.getInterfaceVersion()
+                << " is not supported or the file is damaged\n";
+      return REPLAY_EXIT_ERROR;
+    }
+    const FlightDataRecorderFileSchema& schema = reader.getSchema();
+    if (schema.getAircraft() != aircraft) {
+      std::cerr << "ERROR: '" << options.filePath << "' was recorded by the " << schema.getAircraft() << ", not the " << aircraft
+                << "\n";
+      return REPLAY_EXIT_ERROR;
+    }
+    if (!reader.hasSimulationTime()) {
+      std::cerr << "ERROR: '" << options.filePath << "' does not contain the simulation time\n";
+      return REPLAY_EXIT_ERROR;
+    }
+
+    ModelReplay<AutopilotStateMachineModelClass, AutopilotStateMachineModelClass::ExternalInputs_AutopilotStateMachine_T,
+                const ap_sm_output* (*)(const AutopilotStateMachineModelClass&)>
+        stateMachine{"AutopilotStateMachine", schema, "ap_sm_in", "ap_sm", options,
+                     [](const AutopilotStateMachineModelClass& model) { return &model.getExternalOutputs().out; }};
+    ModelReplay<AutopilotLawsModelClass, AutopilotLawsModelClass::ExternalInputs_AutopilotLaws_T,
+                const ap_raw_output* (*)(const AutopilotLawsModelClass&)>
+        laws{"AutopilotLaws", schema, "ap_law_in", "ap_law", options,
+             [](const AutopilotLawsModelClass& model) { return &model.getExternalOutputs().out.output; }};
+    ModelReplay<AutothrustModel, typename AutothrustModel::ExternalInputs_Autothrust_T, const athr_out* (*)(const AutothrustModel&)>
+        autothrust{"Autothrust", schema, "athr_in", "athr", options,
+                   [](const AutothrustModel& model) { return &model.getExternalOutputs().out; }};
+
+    if (!stateMachine.hasInputs() || !laws.hasInputs() || !autothrust.hasInputs()) {
+      std::cerr << "ERROR: '" << options.filePath << "' does not contain the model inputs, they are recorded since interface version "
+                << FIRST_INTERFACE_VERSION_WITH_INPUTS << " (file has " << reader.getInterfaceVersion() << ")\n";
+      return REPLAY_EXIT_ERROR;
+    }
+    for (const ModelReplayResult* result : {&stateMachine.getResult(), &laws.getResult(), &autothrust.getResult()}) {
+      printFieldList(out, result->model, "inputs not recorded, replayed as zero", result->missingInputs);
+      printFieldList(out, result->model, "outputs not recorded, not compared", result->missingOutputs);
+    }
+
+    // only the columns needed for the replay are decoded
+    std::vector<bool> selectedColumns(schema.getColumns().size(), false);
+    stateMachine.select(selectedColumns);
+    laws.select(selectedColumns);
+    autothrust.select(selectedColumns);
+    // the sample time reveals frames dropped on ring overflows, it is needed even if the state
+    // machine does not bind it
+    const FdrColumn* sampleTimeColumn = findColumn(schema, SAMPLE_TIME_COLUMN, FdrFieldType::Double);
+    if (sampleTimeColumn != nullptr) {
+      selectedColumns[static_cast<std::size_t>(sampleTimeColumn - schema.getColumns().data())] = true;
+    } else {
+      out << "WARNING: " << SAMPLE_TIME_COLUMN << " not recorded, gaps of dropped frames are not detected\n";
+    }
+    reader.setSelectedColumns(selectedColumns);
+
+    std::vector<char> frame(schema.getFrameSize());
+    std::uint64_t frameCount = 0;
+    std::uint64_t gapCount = 0;
+    std::optional<std::uint64_t> firstGapFrame{};
+    double firstGapSimulationTime = 0;
+    double firstGapSeconds = 0;
+    double firstSimulationTime = 0;
+    double lastSimulationTime = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (reader.readFrame(frame.data())) {
+      const double simulationTime = reader.getSimulationTime(frame.data());
+      if (frameCount == 0) {
+        firstSimulationTime = simulationTime;
+      } else if (sampleTimeColumn != nullptr) {
+        // the recorded sample time is the step of the simulation time, at least 2 ms in pause
+        double sampleTime = 0;
+        std::memcpy(&sampleTime, frame.data() + sampleTimeColumn->offset, sizeof(sampleTime));
+        const double step = simulationTime - lastSimulationTime;
+        if (step < 0 || step > sampleTime + FRAME_GAP_TOLERANCE) {
+          gapCount++;
+          if (!firstGapFrame.has_value()) {
+            firstGapFrame = frameCount;
+            firstGapSimulationTime = simulationTime;
+            firstGapSeconds = step - sampleTime;
+          }
+        }
+      }
+      lastSimulationTime = simulationTime;
+      if (firstGapFrame.has_value()) {
+        stateMachine.skip();
+        laws.skip();
+        autothrust.skip();
+      } else {
+        stateMachine.step(frame.data(), simulationTime);
+        laws.step(frame.data(), simulationTime);
+        autothrust.step(frame.data(), simulationTime);
+      }
+      frameCount++;
+    }
+    const double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double recordedSeconds = lastSimulationTime - firstSimulationTime;
+
+    out << std::fixed << std::setprecision(2);
+    out << aircraft << " replay of '" << options.filePath << "': " << frameCount << " frames, " << recordedSeconds << " s recorded in "
+        << wallSeconds << " s";
+    if (recordedSeconds > 0 && wallSeconds > 0) {
+      out << " (" << std::setprecision(0) << recordedSeconds / wallSeconds << "x real time)";
+    }
+    out << "\n";
+    if (firstGapFrame.has_value()) {
+      out << std::setprecision(3) << "WARNING: " << gapCount
+          << " gaps in the simulation time (frames dropped on a ring overflow of the recorder), first before frame " << *firstGapFrame
+          << " (simulation time " << firstGapSimulationTime << " s, step exceeds the sample time by " << firstGapSeconds << " s), the following "
+          << frameCount - *firstGapFrame << " frames are skipped\n";
+    }
+    out << "\n" << std::defaultfloat << std::setprecision(6);
+
+    bool isDivergent = false;
+    for (const ModelReplayResult* result : {&stateMachine.getResult(), &laws.getResult(), &autothrust.getResult()}) {
+      printResult(out, *result);
+      isDivergent = isDivergent || result->firstDivergentFrame.has_value();
+    }
+    return isDivergent ? REPLAY_EXIT_DIVERGENT : REPLAY_EXIT_IDENTICAL;
+  }
+};
+
+#endif  // FLYBYWIRE_NATIVE_FDRREPLAY_H
@@ -0,0 +1,23 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Force-included for the generated AutopilotStateMachine sources in native builds.
+//
+// The generated AutopilotStateMachine_private.h rejects compilers where long is not 32 bits wide
+// (wasm32 is ILP32, x86-64 Linux is LP64). The generated code does not use long - its 64 bit
+// arithmetic uses uint32_T chunks (see multiword_types.h) - so the check does not apply. This
+// header provides the content of the private header without the check by defining its include
+// guard, so the generated code stays untouched.
+
+#ifndef FLYBYWIRE_NATIVE_AUTOPILOTSTATEMACHINEWORDSIZE_H
+#define FLYBYWIRE_NATIVE_AUTOPILOTSTATEMACHINEWORDSIZE_H
+
+#include <climits>
+
+static_assert(CHAR_BIT == 8 && sizeof(short) == 2 && sizeof(int) == 4, "Generated model code requires 8/16/32 bit char/short/int");
+
+#define RTW_HEADER_AutopilotStateMachine_private_h_
+#include "multiword_types.h"
+#include "rtwtypes.h"
+
+#endif  // FLYBYWIRE_NATIVE_AUTOPILOTSTATEMACHINEWORDSIZE_H
@@ -0,0 +1,124 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Minimal stub of the MSFS SDK gauges API for native (non-WASM) builds of the simulation code.
+// Named variables (LVARs) are kept in memory so native tools can feed inputs (e.g. failures) and
+// read outputs through the same LocalVariable code paths as in the sim.
+
+#ifndef FLYBYWIRE_NATIVE_STUBS_GAUGES_H
+#define FLYBYWIRE_NATIVE_STUBS_GAUGES_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <MSFS/MSFS.h>
+
+using ID = std::int32_t;
+using ENUM = std::uint32_t;
+using FLOAT64 = double;
+using PCSTRINGZ = const char*;
+
+/**
+ * @brief In-memory storage of the named variables of the native stub.<p/>
+ *
+ * The storage is thread local so independent simulation instances can run in parallel on
+ * different threads without sharing their LVARs.
+ */
+class NativeNamedVariables {
+ private:
+  struct Variable {
+    std::string name;
+    FLOAT64 value;
+  };
+
+  static std::vector<Variable>& getVariables() {
+    thread_local std::vector<Variable> variables{};
+    return variables;
+  }
+
+ public:
+  /**
+   * @param name the name of the variable
+   * @return the ID of the variable, -1 if the variable has not been registered
+   */
+  static ID find(const char* name) {
+    const std::vector<Variable>& variables = getVariables();
+    for (std::size_t i = 0; i < variables.size(); i++) {
+      if (variables[i].name == name) {
+        return static_cast<ID>(i);
+      }
+    }
+    return -1;
+  }
+
+  /**
+   * @param name the name of the variable
+   * @return the ID of the variable - the variable is registered with the value 0 if it does not exist
+   */
+  static ID registerVariable(const char* name) {
+    const ID id = find(name);
+    if (id >= 0) {
+      return id;
+    }
+    getVariables().push_back({name, 0.0});
+    return static_cast<ID>(getVariables().size() - 1);
+  }
+
+  static FLOAT64 get(ID id) {
+    const std::vector<Variable>& variables = getVariables();
+    return id >= 0 && static_cast<std::size_t>(id) < variables.size() ? variables[id].value : 0.0;
+  }
+
+  static void set(ID id, FLOAT64 value) {
+    std::vector<Variable>& variables = getVariables();
+    if (id >= 0 && static_cast<std::size_t>(id) < variables.size()) {
+      variables[id].value = value;
+    }
+  }
+
+  /**
+   * Sets a variable by name, e.g. to inject an input. Registers the variable if it does not exist.
+   */
+  static void set(const char* name, FLOAT64 value) { set(registerVariable(name), value); }
+
+  /**
+   * @return the value of a variable by name, 0 if the variable does not exist
+   */
+  static FLOAT64 get(const char* name) { return get(find(name)); }
+
+  /**
+   * Removes all variables.
+   */
+  static void clear() { getVariables().clear(); }
+};
+
+inline ID register_named_variable(PCSTRINGZ name) {
+  return NativeNamedVariables::registerVariable(name);
+}
+
+inline ID check_named_variable(PCSTRINGZ name) {
+  return NativeNamedVariables::find(name);
+}
+
+inline FLOAT64 get_named_variable_value(ID id) {
+  return NativeNamedVariables::get(id);
+}
+
+inline FLOAT64 get_named_variable_typed_value(ID id, ENUM) {
+  return NativeNamedVariables::get(id);
+}
+
+inline void set_named_variable_value(ID id, FLOAT64 value) {
+  NativeNamedVariables::set(id, value);
+}
+
+inline void set_named_variable_typed_value(ID id, FLOAT64 value, ENUM) {
+  NativeNamedVariables::set(id, value);
+}
+
+inline void unregister_all_named_vars() {
+  NativeNamedVariables::clear();
+}
+
+#endif  // FLYBYWIRE_NATIVE_STUBS_GAUGES_H
@@ -0,0 +1,15 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Minimal stub of the MSFS SDK base header for native (non-WASM) builds of the simulation code.
+
+#ifndef FLYBYWIRE_NATIVE_STUBS_MSFS_H
+#define FLYBYWIRE_NATIVE_STUBS_MSFS_H
+
+#include <cstdint>
+
+#define MSFS_CALLBACK
+
+using FsContext = std::uint64_t;
+
+#endif  // FLYBYWIRE_NATIVE_STUBS_MSFS_H
@@ -0,0 +1,35 @@
+// Copyright (c) 2023 FlyByWire Simulations
+// SPDX-License-Identifier: GPL-3.0
+
+// Minimal stub of the SimConnect SDK for native (non-WASM) builds of the simulation code.
+// Only the basic types are provided - code talking to SimConnect is not part of native builds.
+
+#ifndef FLYBYWIRE_NATIVE_STUBS_SIMCONNECT_H
+#define FLYBYWIRE_NATIVE_STUBS_SIMCONNECT_H
+
+#include <cstdint>
+
+using HANDLE = void*;
+using HRESULT = std::int32_t;
+using DWORD = std::uint32_t;
+using SIMCONNECT_OBJECT_ID = DWORD;
+using SIMCONNECT_CLIENT_EVENT_ID = DWORD;
+using SIMCONNECT_DATA_DEFINITION_ID = DWORD;
+using SIMCONNECT_DATA_REQUEST_ID = DWORD;
+using SIMCONNECT_CLIENT_DATA_ID = DWORD;
+using SIMCONNECT_CLIENT_DATA_DEFINITION_ID = DWORD;
+
+#ifndef S_OK
+#define S_OK ((HRESULT)0L)
+#endif
+#ifndef E_FAIL
+#define E_FAIL ((HRESULT)0x80004005L)
+#endif
+#ifndef SUCCEEDED
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#endif
+#ifndef FAILED
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+#endif
+
+#endif  // FLYBYWIRE_NATIVE_STUBS_SIMCONNECT_H
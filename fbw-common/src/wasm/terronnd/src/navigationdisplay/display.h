@@ -112,6 +112,8 @@ class Display : public DisplayBase {
     this->_frameData = connection.clientDataArea<std::uint8_t, SIMCONNECT_CLIENTDATA_MAX_SIZE>();
     this->_frameData->defineArea(side == DisplaySide::Left ? FrameDataLeftName : FrameDataRightName);
     this->_frameData->requestArea(SIMCONNECT_CLIENT_DATA_PERIOD_ON_SET);
+    // the callback runs as soon as the last chunk is received and decodes the frame into an image,
+    // the buffer is not read while the next frame is streamed in so it is not double buffered
     this->_frameData->setOnChangeCallback([=]() {
       this->destroyImage();
 
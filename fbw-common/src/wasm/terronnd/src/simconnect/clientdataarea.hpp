@@ -13,6 +13,7 @@
 #include <vector>
 
 #include "../base/changeable.hpp"
+#include "StreamingBuffer.hpp"
 
 namespace simconnect {
 
@@ -177,26 +178,17 @@ class ClientDataAreaBuffered : public ClientDataAreaBase {
   friend Connection;
 
  private:
-  std::vector<T> _content;
-  std::size_t _expectedByteCount;
-  std::size_t _receivedBytes;
+  StreamingBuffer<T, ChunkSize> _buffer;
 
   ClientDataAreaBuffered(HANDLE* connection, std::uint32_t dataId, std::uint32_t definitionId)
-      : ClientDataAreaBase(connection, dataId, definitionId), _content() {}
+      : ClientDataAreaBase(connection, dataId, definitionId), _buffer() {}
   ClientDataAreaBuffered(const ClientDataAreaBuffered<T, ChunkSize>&) = delete;
 
   ClientDataAreaBuffered<T, ChunkSize>& operator=(const ClientDataAreaBuffered<T, ChunkSize>&) = delete;
 
   void receivedData(void* data) override {
-    std::size_t remainingBytes = this->_expectedByteCount - this->_receivedBytes;
-    if (remainingBytes > ChunkSize) {
-      remainingBytes = ChunkSize;
-    }
-
-    std::memcpy(&this->_content.data()[this->_receivedBytes], data, remainingBytes);
-    this->_receivedBytes += remainingBytes;
-
-    if (this->_receivedBytes >= this->_expectedByteCount) {
+    // the chunk is copied directly to its position in the frame data
+    if (this->_buffer.receiveChunk(data)) {
       this->changed();
     }
   }
@@ -230,49 +222,31 @@ class ClientDataAreaBuffered : public ClientDataAreaBase {
       return false;
     }
 
-    HRESULT result = S_OK;
-    std::size_t sentBytes = 0;
-
-    while (sentBytes < this->_content.size()) {
-      std::size_t remainingBytes = this->_content.size() - sentBytes;
-
-      if (remainingBytes >= ChunkSize) {
-        result &= SimConnect_SetClientData(*this->_connection, this->_dataId, this->_definitionId, SIMCONNECT_CLIENT_DATA_SET_FLAG_DEFAULT,
-                                           0, ChunkSize, &this->_content.data()[sentBytes]);
-        sentBytes += ChunkSize;
-      } else {
-        std::array<T, ChunkSize> buffer{};
-        std::memcpy(buffer.data(), &this->_content.data()[sentBytes], remainingBytes);
-        result &= SimConnect_SetClientData(*this->_connection, this->_dataId, this->_definitionId, SIMCONNECT_CLIENT_DATA_SET_FLAG_DEFAULT,
-                                           0, ChunkSize, buffer.data());
-        sentBytes += remainingBytes;
-      }
-    }
+    const std::size_t chunkCount = this->_buffer.sendChunks([this](const T* chunk) {
+      return SUCCEEDED(SimConnect_SetClientData(*this->_connection, this->_dataId, this->_definitionId,
+                                                SIMCONNECT_CLIENT_DATA_SET_FLAG_DEFAULT, 0, ChunkSize, const_cast<T*>(chunk)));
+    });
 
-    return SUCCEEDED(result);
+    return chunkCount == this->_buffer.getChunkCount();
   }
 
   /**
    * @brief Reserves internal data to receive the data
    * @param expectedByteCount Number of expected bytes in streaming cases
    */
-  void reserve(std::size_t expectedByteCount) {
-    this->_expectedByteCount = expectedByteCount;
-    this->_content.reserve(expectedByteCount);
-    this->_receivedBytes = 0;
-  }
+  void reserve(std::size_t expectedByteCount) { this->_buffer.reserve(expectedByteCount); }
 
   /**
    * @brief Returns a modifiable reference to the data container
    * @return std::vector<T>& Reference to the data container
    */
-  std::vector<T>& data() { return this->_content; }
+  std::vector<T>& data() { return this->_buffer.getData(); }
 
   /**
    * @brief Returns a constant reference to the data container
    * @return std::vector<T>& Reference to the data container
    */
-  const std::vector<T>& data() const { return this->_content; }
+  const std::vector<T>& data() const { return this->_buffer.getData(); }
 };
 
 }  // namespace simconnect
@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "FlightDataRecorderBatchConverter.h"
+#include "WildcardMatch.h"
+#include "WorkStealingPool.h"
+#include "fmt/include/fmt/core.h"
+
+namespace {
+
+struct BatchJob {
+  std::filesystem::path inFilePath;
+  std::filesystem::path outFilePath;
+  uintmax_t size;
+};
+
+// the options that change the content of an output file, stored next to it so that a conversion with other options
+// is not mistaken for up to date
+std::string describeOutputOptions(const FlightDataRecorderConversionOptions& options) {
+  return fmt::format("format={}\ndelimiter={}\nno-compression={}\nfrom={}\nto={}\ncolumns={}\nfilter={}\n",
+                     FlightDataRecorderFileConverter::getOutputFileExtension(options.outputFormat), options.delimiter,
+                     options.noCompression, options.fromSimulationTime, options.toSimulationTime, options.columnPatterns,
+                     options.conditions);
+}
+
+std::filesystem::path getOptionsFilePath(const std::filesystem::path& outFilePath) {
+  auto optionsFilePath = outFilePath;
+  optionsFilePath += ".options";
+  return optionsFilePath;
+}
+
+bool hasSameOptions(const std::filesystem::path& outFilePath, const std::string& outputOptions) {
+  std::ifstream optionsFile(getOptionsFilePath(outFilePath), std::ios::binary);
+  if (!optionsFile) {
+    return false;
+  }
+  std::string storedOptions((std::istreambuf_iterator<char>(optionsFile)), std::istreambuf_iterator<char>());
+  return storedOptions == outputOptions;
+}
+
+// an output file that is newer than its fdr file, not empty and was written with the same options is considered
+// converted, partial results are never left behind as they are written to a temporary file first
+bool isConverted(const std::filesystem::path& inFilePath, const std::filesystem::path& outFilePath, const std::string& outputOptions) {
+  if (!hasSameOptions(outFilePath, outputOptions)) {
+    return false;
+  }
+  std::error_code error;
+  auto outSize = std::filesystem::file_size(outFilePath, error);
+  if (error || outSize == 0) {
+    return false;
+  }
+  auto outTime = std::filesystem::last_write_time(outFilePath, error);
+  if (error) {
+    return false;
+  }
+  auto inTime = std::filesystem::last_write_time(inFilePath, error);
+  return !error && outTime >= inTime;
+}
+
+}  // namespace
+
+std::vector<std::string> FlightDataRecorderBatchConverter::findInputFiles(const std::string& input) {
+  std::vector<std::string> result;
+  std::error_code error;
+
+  // a directory selects all fdr files in it, otherwise the file name may contain wildcards
+  std::filesystem::path directory = input;
+  std::string pattern = "*.fdr";
+  if (!std::filesystem::is_directory(directory, error)) {
+    pattern = directory.filename().string();
+    directory = directory.parent_path().empty() ? "." : directory.parent_path();
+  }
+
+  for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+    if (entry.is_regular_file(error) && matchesWildcard(entry.path().filename().string(), pattern)) {
+      result.push_back(entry.path().string());
+    }
+  }
+  std::sort(result.begin(), result.end());
+
+  return result;
+}
+
+bool FlightDataRecorderBatchConverter::convert(const FlightDataRecorderBatchOptions& batchOptions,
+                                               const FlightDataRecorderConversionOptions& options) {
+  auto start = std::chrono::steady_clock::now();
+
+  auto inputFiles = findInputFiles(batchOptions.input);
+  if (inputFiles.empty()) {
+    fmt::print("No input files found for '{}'!\n", batchOptions.input);
+    return false;
+  }
+
+  if (!batchOptions.outputDirectory.empty()) {
+    std::error_code error;
+    std::filesystem::create_directories(batchOptions.outputDirectory, error);
+    if (error) {
+      fmt::print("ERROR: failed to create output directory '{}'!\n", batchOptions.outputDirectory);
+      return false;
+    }
+  }
+
+  // collect files that need a conversion
+  std::vector<BatchJob> jobs;
+  size_t skippedFiles = 0;
+  const std::string outputOptions = describeOutputOptions(options);
+  for (const auto& inputFile : inputFiles) {
+    std::filesystem::path inFilePath = inputFile;
+    std::filesystem::path outFilePath = inFilePath;
+    outFilePath.replace_extension(FlightDataRecorderFileConverter::getOutputFileExtension(options.outputFormat));
+    if (!batchOptions.outputDirectory.empty()) {
+      outFilePath = std::filesystem::path(batchOptions.outputDirectory) / outFilePath.filename();
+    }
+
+    if (!batchOptions.force && isConverted(inFilePath, outFilePath, outputOptions)) {
+      skippedFiles++;
+      continue;
+    }
+
+    std::error_code error;
+    auto size = std::filesystem::file_size(inFilePath, error);
+    jobs.push_back({inFilePath, outFilePath, error ? 0 : size});
+  }
+
+  // largest files first so that they do not end up last on a single thread
+  std::sort(jobs.begin(), jobs.end(), [](const BatchJob& a, const BatchJob& b) { return a.size > b.size; });
+
+  unsigned int threadCount = batchOptions.threadCount > 0 ? batchOptions.threadCount : std::thread::hardware_concurrency();
+  threadCount = std::max(1u, std::min(threadCount, static_cast<unsigned int>(std::max<size_t>(1, jobs.size()))));
+  fmt::print("Converting {} of {} files with {} threads ({} up to date)\n", jobs.size(), inputFiles.size(), threadCount, skippedFiles);
+
+  // per file progress and totals are shared between the threads
+  std::mutex printMutex;
+  std::atomic<size_t> finishedFiles = 0;
+  std::atomic<size_t> failedFiles = 0;
+  std::atomic<uint64_t> totalEntries = 0;
+  std::atomic<uint64_t> totalInputBytes = 0;
+  std::atomic<uint64_t> totalOutputBytes = 0;
+
+  FlightDataRecorderConversionOptions fileOptions = options;
+  fileOptions.isVerbose = false;
+
+  std::vector<std::function<void()>> tasks;
+  tasks.reserve(jobs.size());
+  for (const auto& job : jobs) {
+    tasks.emplace_back([&, job]() {
+      auto fileStart = std::chrono::steady_clock::now();
+
+      // the output file only gets its final name when it is complete
+      auto temporaryFilePath = job.outFilePath;
+      temporaryFilePath += ".tmp";
+      FlightDataRecorderConversionResult result;
+      bool isSuccess = FlightDataRecorderFileConverter::convert(job.inFilePath.string(), temporaryFilePath.string(), fileOptions, result);
+      std::error_code error;
+      if (isSuccess) {
+        // the options of a previous output must not be paired with the new one
+        std::filesystem::remove(getOptionsFilePath(job.outFilePath), error);
+        std::filesystem::rename(temporaryFilePath, job.outFilePath, error);
+        isSuccess = !error;
+      }
+      if (isSuccess) {
+        // without the options file the output is converted again in the next batch, it is not an error
+        std::ofstream optionsFile(getOptionsFilePath(job.outFilePath), std::ios::binary | std::ios::trunc);
+        optionsFile << outputOptions;
+      }
+      if (!isSuccess) {
+        std::filesystem::remove(temporaryFilePath, error);
+        failedFiles++;
+      } else {
+        totalEntries += result.entries;
+        totalInputBytes += result.inputBytes;
+        totalOutputBytes += result.outputBytes;
+      }
+
+      double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - fileStart).count();
+      std::lock_guard<std::mutex> lock(printMutex);
+      size_t index = ++finishedFiles;
+      if (isSuccess) {
+        fmt::print("[{}/{}] {} -> {}: {} entries in {:.2f} s\n", index, jobs.size(), job.inFilePath.string(), job.outFilePath.string(),
+                   result.entries, seconds);
+      } else {
+        fmt::print("[{}/{}] {}: FAILED\n", index, jobs.size(), job.inFilePath.string());
+      }
+    });
+  }
+
+  WorkStealingPool pool(threadCount);
+  pool.run(tasks);
+
+  // print summary
+  double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  double rate = seconds > 0 ? 1.0 / seconds : 0;
+  fmt::print("Converted {} files, skipped {} and failed {} in {:.2f} s\n", jobs.size() - failedFiles, skippedFiles, failedFiles.load(),
+             seconds);
+  fmt::print("Throughput: {:.0f} entries/s, {:.2f} MB/s read, {:.2f} MB/s written\n", totalEntries * rate,
+             totalInputBytes * rate / 1e6, totalOutputBytes * rate / 1e6);
+
+  return failedFiles == 0;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "FlightDataRecorderFileConverter.h"
+
+struct FlightDataRecorderBatchOptions {
+  // directory containing fdr files or a wildcard pattern for the file name like "recordings/*.fdr"
+  std::string input;
+  // directory for the converted files, empty means next to the input files
+  std::string outputDirectory;
+  // number of conversion threads, zero means one per hardware thread
+  unsigned int threadCount = 0;
+  // convert files even if the converted file is up to date, i.e. newer than the fdr file and written with the same
+  // output options as recorded in the options file next to it
+  bool force = false;
+};
+
+// converts many fdr files in parallel
+class FlightDataRecorderBatchConverter {
+ public:
+  FlightDataRecorderBatchConverter() = delete;
+  ~FlightDataRecorderBatchConverter() = delete;
+
+  // returns the fdr files of a directory or the files matching a wildcard pattern
+  static std::vector<std::string> findInputFiles(const std::string& input);
+
+  // returns true if all files were converted or skipped
+  static bool convert(const FlightDataRecorderBatchOptions& batchOptions, const FlightDataRecorderConversionOptions& options);
+};
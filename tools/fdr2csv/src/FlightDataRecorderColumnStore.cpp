@@ -0,0 +1,139 @@
+#include <algorithm>
+#include <filesystem>
+
+#include "FlightDataRecorderColumnStore.h"
+
+namespace {
+
+constexpr uint64_t COLUMN_ALIGNMENT = 8;
+
+uint64_t alignColumn(uint64_t offset) {
+  return (offset + COLUMN_ALIGNMENT - 1) / COLUMN_ALIGNMENT * COLUMN_ALIGNMENT;
+}
+
+template <typename T>
+void writeValue(std::ostream& out, const T& value) {
+  out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+}  // namespace
+
+FlightDataRecorderColumnStoreWriter::FlightDataRecorderColumnStoreWriter(const std::vector<FdrColumn>& schemaColumns,
+                                                                         std::string spillPath)
+    : columns(schemaColumns), values(schemaColumns.size()), spillFilePath(std::move(spillPath)) {
+  widths.reserve(columns.size());
+  uint64_t rowSize = 0;
+  for (const auto& column : columns) {
+    widths.push_back(static_cast<uint32_t>(fdrFieldTypeSize(column.type)));
+    rowSize += widths.back();
+  }
+
+  // the buffer is allocated once and reused for every chunk
+  rowsPerChunk = std::max<uint64_t>(1, FDR_COLUMN_STORE_BUFFER_SIZE / std::max<uint64_t>(1, rowSize));
+  for (size_t i = 0; i < columns.size(); i++) {
+    values[i].reserve(rowsPerChunk * widths[i]);
+  }
+}
+
+FlightDataRecorderColumnStoreWriter::~FlightDataRecorderColumnStoreWriter() {
+  removeSpillFile();
+}
+
+bool FlightDataRecorderColumnStoreWriter::addFrame(const char* frame) {
+  if (bufferedRowCount >= rowsPerChunk && !spillChunk()) {
+    return false;
+  }
+
+  for (size_t i = 0; i < columns.size(); i++) {
+    const char* value = frame + columns[i].offset;
+    values[i].insert(values[i].end(), value, value + widths[i]);
+  }
+  bufferedRowCount++;
+  rowCount++;
+  return true;
+}
+
+bool FlightDataRecorderColumnStoreWriter::spillChunk() {
+  if (!spillFile.is_open()) {
+    spillFile.open(spillFilePath, std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!spillFile.is_open()) {
+      return false;
+    }
+  }
+
+  spillFile.seekp(0, std::ios::end);
+  spilledChunks.push_back({static_cast<uint64_t>(spillFile.tellp()), bufferedRowCount});
+  for (auto& columnValues : values) {
+    spillFile.write(columnValues.data(), static_cast<std::streamsize>(columnValues.size()));
+    columnValues.clear();
+  }
+  bufferedRowCount = 0;
+
+  return spillFile.good();
+}
+
+void FlightDataRecorderColumnStoreWriter::removeSpillFile() {
+  if (spillFile.is_open()) {
+    spillFile.close();
+    std::error_code error;
+    std::filesystem::remove(spillFilePath, error);
+  }
+}
+
+bool FlightDataRecorderColumnStoreWriter::write(std::ostream& out) {
+  // the rows of the last chunk stay in memory unless earlier chunks were spilled
+  if (!spilledChunks.empty() && bufferedRowCount > 0 && !spillChunk()) {
+    removeSpillFile();
+    return false;
+  }
+
+  // the values follow the column directory, so its size is needed to place them
+  uint32_t columnCount = static_cast<uint32_t>(columns.size());
+  uint64_t directorySize = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint32_t);
+  for (const auto& column : columns) {
+    directorySize += sizeof(uint16_t) + column.name.size() + sizeof(uint8_t) + sizeof(uint64_t);
+  }
+
+  writeValue(out, FDR_COLUMN_STORE_MAGIC);
+  writeValue(out, FDR_COLUMN_STORE_FORMAT_VERSION);
+  writeValue(out, rowCount);
+  writeValue(out, columnCount);
+  uint64_t offset = alignColumn(directorySize);
+  for (size_t i = 0; i < columns.size(); i++) {
+    writeValue(out, static_cast<uint16_t>(columns[i].name.size()));
+    out.write(columns[i].name.data(), static_cast<std::streamsize>(columns[i].name.size()));
+    writeValue(out, static_cast<uint8_t>(columns[i].type));
+    writeValue(out, offset);
+    offset = alignColumn(offset + rowCount * widths[i]);
+  }
+
+  // values of every column padded to the alignment
+  const char padding[COLUMN_ALIGNMENT] = {};
+  out.write(padding, static_cast<std::streamsize>(alignColumn(directorySize) - directorySize));
+  for (size_t i = 0; i < columns.size(); i++) {
+    if (spilledChunks.empty()) {
+      out.write(values[i].data(), static_cast<std::streamsize>(values[i].size()));
+    } else {
+      // gather the column from all chunks, within a chunk it follows the preceding columns
+      uint64_t columnOffset = 0;
+      for (size_t j = 0; j < i; j++) {
+        columnOffset += widths[j];
+      }
+      for (const auto& chunk : spilledChunks) {
+        copyBuffer.resize(chunk.rowCount * widths[i]);
+        spillFile.seekg(static_cast<std::streamoff>(chunk.offset + columnOffset * chunk.rowCount));
+        spillFile.read(copyBuffer.data(), static_cast<std::streamsize>(copyBuffer.size()));
+        if (!spillFile.good()) {
+          removeSpillFile();
+          return false;
+        }
+        out.write(copyBuffer.data(), static_cast<std::streamsize>(copyBuffer.size()));
+      }
+    }
+    uint64_t columnSize = rowCount * widths[i];
+    out.write(padding, static_cast<std::streamsize>(alignColumn(columnSize) - columnSize));
+  }
+
+  removeSpillFile();
+  return out.good();
+}
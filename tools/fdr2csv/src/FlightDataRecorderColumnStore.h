@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "FlightDataRecorderFileSchema.h"
+
+// Typed binary export of a recording with all values of a column stored next to each other. The file is meant to be
+// loaded without parsing, e.g. with numpy.frombuffer(data, dtype, count=rows, offset=column_offset).
+//
+// Layout of the file (all values little endian):
+//   uint32  magic (FDR_COLUMN_STORE_MAGIC)
+//   uint32  format version (FDR_COLUMN_STORE_FORMAT_VERSION)
+//   uint64  number of rows
+//   uint32  number of columns
+//   per column:
+//     uint16  length of the name
+//     char[]  name as in the csv header
+//     uint8   type (FdrFieldType: 1 bool, 2 int8, 3 uint8, 4 int16, 5 uint16, 6 int32, 7 uint32, 8 int64,
+//             9 uint64, 10 float32, 11 float64)
+//     uint64  offset of the values in the file, aligned to 8 bytes
+//   per column:
+//     values of all rows, zero padded to a multiple of 8 bytes
+
+constexpr uint32_t FDR_COLUMN_STORE_MAGIC = 0x54524446;  // "FDRT"
+constexpr uint32_t FDR_COLUMN_STORE_FORMAT_VERSION = 1;
+
+// Maximum size of the values buffered in memory. As the number of rows is only known at the end of a recording, larger
+// recordings are collected in chunks of rows in a temporary spill file and copied column by column into the output.
+constexpr size_t FDR_COLUMN_STORE_BUFFER_SIZE = 16 * 1024 * 1024;
+
+class FlightDataRecorderColumnStoreWriter {
+ public:
+  // the spill file is only created if the recording does not fit into the buffer and is removed by write()
+  FlightDataRecorderColumnStoreWriter(const std::vector<FdrColumn>& columns, std::string spillFilePath);
+  ~FlightDataRecorderColumnStoreWriter();
+
+  // appends the values of a frame to the columns, returns false if the spill file could not be written
+  bool addFrame(const char* frame);
+
+  [[nodiscard]] uint64_t getRowCount() const { return rowCount; }
+
+  // writes all collected rows
+  bool write(std::ostream& out);
+
+ private:
+  // rows of all columns moved from the buffer to the spill file, the columns are stored one after the other
+  struct SpilledChunk {
+    uint64_t offset;
+    uint64_t rowCount;
+  };
+
+  bool spillChunk();
+  void removeSpillFile();
+
+  const std::vector<FdrColumn>& columns;
+  std::vector<uint32_t> widths;
+  std::vector<std::vector<char>> values;
+  uint64_t rowCount = 0;
+  uint64_t rowsPerChunk = 0;
+  uint64_t bufferedRowCount = 0;
+
+  std::string spillFilePath;
+  std::fstream spillFile;
+  std::vector<SpilledChunk> spilledChunks;
+  std::vector<char> copyBuffer;
+};
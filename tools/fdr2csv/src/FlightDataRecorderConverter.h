@@ -1,24 +1,22 @@
 #pragma once
 
 #include <fstream>
+#include <string>
+#include <vector>
 
-#include "AdditionalData.h"
-#include "AutopilotLaws_types.h"
-#include "AutopilotStateMachine_types.h"
-#include "Autothrust_types.h"
-#include "EngineData.h"
+#include "FlightDataRecorderFileSchema.h"
+#include "fmt/include/fmt/format.h"
 
+// formats frames as csv using the columns of the schema
 class FlightDataRecorderConverter {
  public:
   FlightDataRecorderConverter() = delete;
   ~FlightDataRecorderConverter() = delete;
 
-  static void writeHeader(std::ofstream& out, const std::string& delimiter);
-  static void writeStruct(std::ofstream& out,
+  static void writeHeader(std::ofstream& out, const std::string& delimiter, const std::vector<FdrColumn>& columns);
+  // appends the csv row of a frame to the buffer
+  static void formatFrame(fmt::memory_buffer& buffer,
                           const std::string& delimiter,
-                          const ap_sm_output& ap_sm,
-                          const ap_raw_output& ap_law,
-                          const athr_out& athr,
-                          const EngineData& engine,
-                          const AdditionalData& data);
+                          const std::vector<FdrColumn>& columns,
+                          const char* frame);
 };
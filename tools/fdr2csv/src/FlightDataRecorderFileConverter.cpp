@@ -0,0 +1,189 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <vector>
+
+#include "FlightDataRecorderColumnStore.h"
+#include "FlightDataRecorderConverter.h"
+#include "FlightDataRecorderFileConverter.h"
+#include "FlightDataRecorderFilter.h"
+#include "FlightDataRecorderPipeline.h"
+#include "FlightDataRecorderReader.h"
+#include "fmt/include/fmt/core.h"
+#include "zfstream.h"
+
+namespace {
+
+std::unique_ptr<std::istream> openInputStream(const std::string& filePath, bool noCompression) {
+  // files in the columnar layout are not compressed as a whole
+  if (!noCompression && FlightDataRecorderFileConverter::isGzipFile(filePath)) {
+    return std::make_unique<gzifstream>(filePath.c_str());
+  }
+  return std::make_unique<std::ifstream>(filePath.c_str(), std::ios::in | std::ios::binary);
+}
+
+}  // namespace
+
+bool FlightDataRecorderFileConverter::parseOutputFormat(const std::string& name, FlightDataRecorderOutputFormat& format) {
+  if (name == "csv") {
+    format = FlightDataRecorderOutputFormat::Csv;
+  } else if (name == "columns") {
+    format = FlightDataRecorderOutputFormat::ColumnStore;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+const char* FlightDataRecorderFileConverter::getOutputFileExtension(FlightDataRecorderOutputFormat format) {
+  return format == FlightDataRecorderOutputFormat::ColumnStore ? ".fdrcol" : ".csv";
+}
+
+bool FlightDataRecorderFileConverter::isGzipFile(const std::string& filePath) {
+  std::ifstream file(filePath, std::ios::in | std::ios::binary);
+  unsigned char magic[2] = {};
+  file.read(reinterpret_cast<char*>(magic), sizeof(magic));
+  return file.good() && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+bool FlightDataRecorderFileConverter::readInterfaceVersion(const std::string& filePath, bool noCompression, uint64_t& interfaceVersion) {
+  auto in = openInputStream(filePath, noCompression);
+  in->read(reinterpret_cast<char*>(&interfaceVersion), sizeof(interfaceVersion));
+  return in->good();
+}
+
+bool FlightDataRecorderFileConverter::convert(const std::string& inFilePath,
+                                              const std::string& outFilePath,
+                                              const FlightDataRecorderConversionOptions& options,
+                                              FlightDataRecorderConversionResult& result) {
+  result = {};
+
+  // read file version
+  uint64_t fileFormatVersion = {};
+  if (!readInterfaceVersion(inFilePath, options.noCompression, fileFormatVersion)) {
+    fmt::print("ERROR: failed to open input file '{}'!\n", inFilePath);
+    return false;
+  }
+  if (fileFormatVersion < LEGACY_INTERFACE_VERSION) {
+    fmt::print("ERROR: file version {} of '{}' is not supported (expected {} or newer for A32NX and {} or newer for A380X)\n",
+               fileFormatVersion, inFilePath, LEGACY_INTERFACE_VERSION, FIRST_SELF_DESCRIBING_INTERFACE_VERSION);
+    return false;
+  }
+
+  // files are read with their schema and seek index
+  FlightDataRecorderReader reader;
+  if (!reader.open(inFilePath, !options.noCompression && isGzipFile(inFilePath))) {
+    fmt::print("ERROR: failed to read schema from input file '{}'!\n", inFilePath);
+    return false;
+  }
+  const auto& schema = reader.getSchema();
+
+  // a time window needs the simulation time of every frame
+  bool isTimeWindow = options.fromSimulationTime > std::numeric_limits<double>::lowest() ||
+                      options.toSimulationTime < std::numeric_limits<double>::max();
+  if (isTimeWindow && !reader.hasSimulationTime()) {
+    fmt::print("ERROR: selecting a time window requires a file with simulation time!\n");
+    return false;
+  }
+
+  // columns and conditions are selected by their names in the schema
+  FlightDataRecorderFilter filter;
+  if (!filter.initialize(schema.getColumns(), options.columnPatterns, options.conditions)) {
+    return false;
+  }
+  reader.setSelectedColumns(filter.getRequiredColumns());
+
+  // print information on convert
+  if (options.isVerbose) {
+    fmt::print("Converting from '{}' to '{}' with interface version '{}' and delimiter '{}'\n", inFilePath, outFilePath, fileFormatVersion,
+               options.delimiter);
+    fmt::print("Using schema of aircraft '{}' with {} columns, frame size {} and {} layout\n", schema.getAircraft(),
+               schema.getColumns().size(), schema.getFrameSize(), schema.getLayout() == FdrLayout::Columnar ? "columnar" : "row");
+  }
+
+  // output stream
+  bool isColumnStore = options.outputFormat == FlightDataRecorderOutputFormat::ColumnStore;
+  std::ofstream out;
+  // open the output file
+  out.open(outFilePath, isColumnStore ? std::ios::out | std::ios::trunc | std::ios::binary : std::ios::out | std::ios::trunc);
+  // check if file is open
+  if (!out.is_open()) {
+    fmt::print("ERROR: failed to create output file '{}'!\n", outFilePath);
+    return false;
+  }
+
+  // calculate number of entries
+  uint64_t counter = 0;
+
+  // skip to the indexed position closest to the start of the time window
+  if (isTimeWindow && options.fromSimulationTime > std::numeric_limits<double>::lowest() && !reader.seek(options.fromSimulationTime) &&
+      options.isVerbose) {
+    fmt::print("No seek index found, reading from the beginning of the file\n");
+  }
+
+  // frames outside of the time window or not fulfilling the conditions are dropped while reading, simulation time
+  // jumps back on a reset so reading only stops early when the index proves no later frame is within the window
+  auto readFrame = [&reader, &filter, &options, isTimeWindow](char* frame) {
+    while (reader.readFrame(frame)) {
+      if (isTimeWindow) {
+        double simulationTime = reader.getSimulationTime(frame);
+        if (simulationTime > options.toSimulationTime && reader.isPastSimulationTime(options.toSimulationTime)) {
+          return false;
+        }
+        if (simulationTime < options.fromSimulationTime || simulationTime > options.toSimulationTime) {
+          continue;
+        }
+      }
+      if (filter.matches(frame)) {
+        return true;
+      }
+    }
+    return false;
+  };
+
+  if (isColumnStore) {
+    // collect the values of every column in bounded chunks and write them column by column
+    FlightDataRecorderColumnStoreWriter writer(filter.getOutputColumns(), outFilePath + ".tmp");
+    std::vector<char> frame(schema.getFrameSize());
+    while (readFrame(frame.data())) {
+      if (!writer.addFrame(frame.data())) {
+        fmt::print("ERROR: failed to write temporary file '{}.tmp'!\n", outFilePath);
+        return false;
+      }
+      // print progress
+      if (++counter % 1000 == 0 && options.isVerbose) {
+        fmt::print("Processed {} entries...\r", counter);
+      }
+    }
+    if (!writer.write(out)) {
+      fmt::print("ERROR: failed to write output file '{}'!\n", outFilePath);
+      return false;
+    }
+  } else {
+    // write header
+    FlightDataRecorderConverter::writeHeader(out, options.delimiter, filter.getOutputColumns());
+    // decode and format frames in parallel, the output is written in order
+    FlightDataRecorderPipeline pipeline(filter.getOutputColumns(), schema.getFrameSize(), options.delimiter, options.formatThreadCount);
+    counter = pipeline.run(out, readFrame, options.isVerbose);
+  }
+
+  // print final value
+  if (options.isVerbose) {
+    fmt::print("Processed {} entries...\n", counter);
+  }
+
+  out.close();
+  if (out.fail()) {
+    fmt::print("ERROR: failed to write output file '{}'!\n", outFilePath);
+    return false;
+  }
+
+  std::error_code error;
+  result.entries = counter;
+  result.inputBytes = std::filesystem::file_size(inFilePath, error);
+  result.inputBytes = error ? 0 : result.inputBytes;
+  result.outputBytes = std::filesystem::file_size(outFilePath, error);
+  result.outputBytes = error ? 0 : result.outputBytes;
+
+  return true;
+}
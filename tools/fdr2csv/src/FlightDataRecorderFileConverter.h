@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <string>
+
+enum class FlightDataRecorderOutputFormat {
+  // text file with one row per entry
+  Csv,
+  // typed binary file with one block per column, see FlightDataRecorderColumnStore.h
+  ColumnStore,
+};
+
+struct FlightDataRecorderConversionOptions {
+  FlightDataRecorderOutputFormat outputFormat = FlightDataRecorderOutputFormat::Csv;
+  std::string delimiter = ",";
+  bool noCompression = false;
+  double fromSimulationTime = std::numeric_limits<double>::lowest();
+  double toSimulationTime = std::numeric_limits<double>::max();
+  // comma separated name patterns of the columns to write, empty means all columns
+  std::string columnPatterns;
+  // comma separated conditions a frame has to fulfill to be written like "ap_sm.data.H_radio_ft<100"
+  std::string conditions;
+  // number of threads formatting csv rows of a single file
+  unsigned int formatThreadCount = 1;
+  // print information and progress of the conversion, errors are always printed
+  bool isVerbose = true;
+};
+
+struct FlightDataRecorderConversionResult {
+  uint64_t entries = 0;
+  uint64_t inputBytes = 0;
+  uint64_t outputBytes = 0;
+};
+
+// converts a single fdr file to csv
+class FlightDataRecorderFileConverter {
+ public:
+  FlightDataRecorderFileConverter() = delete;
+  ~FlightDataRecorderFileConverter() = delete;
+
+  // parses the name of an output format, returns false if it is unknown
+  static bool parseOutputFormat(const std::string& name, FlightDataRecorderOutputFormat& format);
+  // file extension used for an output format
+  static const char* getOutputFileExtension(FlightDataRecorderOutputFormat format);
+
+  // checks for the gzip magic bytes at the beginning of the file
+  static bool isGzipFile(const std::string& filePath);
+
+  // reads the interface version of the file, returns false if the file cannot be read
+  static bool readInterfaceVersion(const std::string& filePath, bool noCompression, uint64_t& interfaceVersion);
+
+  static bool convert(const std::string& inFilePath,
+                      const std::string& outFilePath,
+                      const FlightDataRecorderConversionOptions& options,
+                      FlightDataRecorderConversionResult& result);
+};
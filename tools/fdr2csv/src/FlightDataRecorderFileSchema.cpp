@@ -0,0 +1,107 @@
+#include "FlightDataRecorderFileSchema.h"
+
+namespace {
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return in.good();
+}
+
+bool readString(std::istream& in, std::string& value) {
+  uint16_t length = 0;
+  if (!readValue(in, length)) {
+    return false;
+  }
+  value.resize(length);
+  in.read(value.data(), length);
+  return in.good();
+}
+
+}  // namespace
+
+bool FlightDataRecorderFileSchema::read(std::istream& in) {
+  aircraft.clear();
+  layout = FdrLayout::Row;
+  columns.clear();
+  frameSize = 0;
+
+  uint32_t magic = 0;
+  uint32_t formatVersion = 0;
+  if (!readValue(in, magic) || magic != FDR_SCHEMA_MAGIC) {
+    return false;
+  }
+  if (!readValue(in, formatVersion) || formatVersion == 0 || formatVersion > FDR_SCHEMA_FORMAT_VERSION) {
+    return false;
+  }
+  if (!readString(in, aircraft)) {
+    return false;
+  }
+
+  // the layout was added with format version 2, older files always use the row layout
+  if (formatVersion >= 2) {
+    uint8_t layoutValue = 0;
+    if (!readValue(in, layoutValue) || layoutValue > static_cast<uint8_t>(FdrLayout::Columnar)) {
+      return false;
+    }
+    layout = static_cast<FdrLayout>(layoutValue);
+  }
+
+  uint16_t structCount = 0;
+  if (!readValue(in, structCount)) {
+    return false;
+  }
+
+  for (uint16_t s = 0; s < structCount; s++) {
+    std::string structName;
+    uint32_t structSize = 0;
+    uint32_t fieldCount = 0;
+    if (!readString(in, structName) || !readValue(in, structSize) || !readValue(in, fieldCount)) {
+      return false;
+    }
+
+    for (uint32_t f = 0; f < fieldCount; f++) {
+      std::string fieldName;
+      uint32_t offset = 0;
+      uint8_t type = 0;
+      if (!readString(in, fieldName) || !readValue(in, offset) || !readValue(in, type)) {
+        return false;
+      }
+      // reject fields that do not fit into their struct or that have an unknown type
+      size_t typeSize = fdrFieldTypeSize(static_cast<FdrFieldType>(type));
+      if (typeSize == 0 || offset + typeSize > structSize) {
+        return false;
+      }
+      columns.push_back({structName + "." + fieldName, static_cast<uint32_t>(frameSize + offset), static_cast<FdrFieldType>(type)});
+    }
+
+    frameSize += structSize;
+  }
+
+  return frameSize > 0;
+}
+
+void FlightDataRecorderFileSchema::load(std::string_view aircraftName, const FdrStruct* structs, size_t structCount) {
+  aircraft = aircraftName;
+  layout = FdrLayout::Row;
+  columns.clear();
+  frameSize = 0;
+
+  for (size_t s = 0; s < structCount; s++) {
+    for (uint32_t f = 0; f < structs[s].fieldCount; f++) {
+      const auto& field = structs[s].fields[f];
+      columns.push_back({std::string(structs[s].name) + "." + std::string(field.name), static_cast<uint32_t>(frameSize + field.offset),
+                         field.type});
+    }
+    frameSize += structs[s].size;
+  }
+}
+
+std::vector<FdrColumnLayout> FlightDataRecorderFileSchema::getColumnLayouts() const {
+  std::vector<FdrColumnLayout> result;
+  result.reserve(columns.size());
+  for (const auto& column : columns) {
+    result.push_back({column.offset, static_cast<uint32_t>(fdrFieldTypeSize(column.type))});
+  }
+  return result;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "FlightDataRecorderColumnar.h"
+#include "FlightDataRecorderSchema.h"
+
+// a single decodable value within a frame
+struct FdrColumn {
+  std::string name;
+  uint32_t offset;
+  FdrFieldType type;
+};
+
+// runtime representation of the schema block written by the flight data recorder
+class FlightDataRecorderFileSchema {
+ public:
+  // reads the schema block from the stream, returns false if the block is malformed
+  bool read(std::istream& in);
+  // uses compiled-in struct tables for files without schema block
+  void load(std::string_view aircraftName, const FdrStruct* structs, size_t structCount);
+
+  [[nodiscard]] const std::string& getAircraft() const { return aircraft; }
+  [[nodiscard]] FdrLayout getLayout() const { return layout; }
+  [[nodiscard]] const std::vector<FdrColumn>& getColumns() const { return columns; }
+  [[nodiscard]] size_t getFrameSize() const { return frameSize; }
+
+  // position and size of every column within a frame as used by the columnar layout
+  [[nodiscard]] std::vector<FdrColumnLayout> getColumnLayouts() const;
+
+ private:
+  std::string aircraft;
+  FdrLayout layout = FdrLayout::Row;
+  std::vector<FdrColumn> columns;
+  size_t frameSize = 0;
+};
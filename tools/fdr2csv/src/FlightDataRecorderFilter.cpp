@@ -0,0 +1,170 @@
+#include <cstring>
+#include <sstream>
+
+#include "FlightDataRecorderFilter.h"
+#include "WildcardMatch.h"
+#include "fmt/include/fmt/core.h"
+
+namespace {
+
+std::string trim(const std::string& text) {
+  auto first = text.find_first_not_of(' ');
+  auto last = text.find_last_not_of(' ');
+  return first != std::string::npos ? text.substr(first, last - first + 1) : std::string();
+}
+
+std::vector<std::string> splitList(const std::string& list) {
+  std::vector<std::string> result;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    item = trim(item);
+    if (!item.empty()) {
+      result.push_back(item);
+    }
+  }
+  return result;
+}
+
+template <typename T>
+double readValue(const char* frame, uint32_t offset) {
+  T value;
+  std::memcpy(&value, frame + offset, sizeof(T));
+  return static_cast<double>(value);
+}
+
+double readColumn(const char* frame, const FdrColumn& column) {
+  switch (column.type) {
+    case FdrFieldType::Boolean:
+      return readValue<bool>(frame, column.offset);
+    case FdrFieldType::Int8:
+      return readValue<int8_t>(frame, column.offset);
+    case FdrFieldType::UInt8:
+      return readValue<uint8_t>(frame, column.offset);
+    case FdrFieldType::Int16:
+      return readValue<int16_t>(frame, column.offset);
+    case FdrFieldType::UInt16:
+      return readValue<uint16_t>(frame, column.offset);
+    case FdrFieldType::Int32:
+      return readValue<int32_t>(frame, column.offset);
+    case FdrFieldType::UInt32:
+      return readValue<uint32_t>(frame, column.offset);
+    case FdrFieldType::Int64:
+      return readValue<int64_t>(frame, column.offset);
+    case FdrFieldType::UInt64:
+      return readValue<uint64_t>(frame, column.offset);
+    case FdrFieldType::Float:
+      return readValue<float>(frame, column.offset);
+    case FdrFieldType::Double:
+      return readValue<double>(frame, column.offset);
+  }
+  return 0;
+}
+
+}  // namespace
+
+bool FlightDataRecorderFilter::initialize(const std::vector<FdrColumn>& columns,
+                                          const std::string& columnPatterns,
+                                          const std::string& conditions) {
+  outputColumns.clear();
+  requiredColumns.assign(columns.size(), false);
+  predicates.clear();
+
+  // select columns, no pattern selects all of them
+  auto patterns = splitList(columnPatterns);
+  for (size_t i = 0; i < columns.size(); i++) {
+    bool isSelected = patterns.empty();
+    for (const auto& pattern : patterns) {
+      isSelected = isSelected || matchesWildcard(columns[i].name, pattern);
+    }
+    if (isSelected) {
+      outputColumns.push_back(columns[i]);
+      requiredColumns[i] = true;
+    }
+  }
+  if (outputColumns.empty()) {
+    fmt::print("ERROR: no column matches '{}'!\n", columnPatterns);
+    return false;
+  }
+
+  // parse conditions, two character operators have to be checked first
+  const std::pair<const char*, Comparison> operators[] = {{"<=", Comparison::LessEqual}, {">=", Comparison::GreaterEqual},
+                                                           {"==", Comparison::Equal},     {"!=", Comparison::NotEqual},
+                                                           {"<", Comparison::Less},       {">", Comparison::Greater}};
+  for (const auto& condition : splitList(conditions)) {
+    size_t position = std::string::npos;
+    size_t operatorLength = 0;
+    Comparison comparison = Comparison::Equal;
+    for (const auto& [symbol, value] : operators) {
+      position = condition.find(symbol);
+      if (position != std::string::npos) {
+        operatorLength = std::strlen(symbol);
+        comparison = value;
+        break;
+      }
+    }
+    if (position == std::string::npos) {
+      fmt::print("ERROR: condition '{}' has no comparison operator!\n", condition);
+      return false;
+    }
+
+    auto name = trim(condition.substr(0, position));
+    auto valueText = trim(condition.substr(position + operatorLength));
+    size_t column = 0;
+    while (column < columns.size() && columns[column].name != name) {
+      column++;
+    }
+    if (column >= columns.size()) {
+      fmt::print("ERROR: column of condition '{}' does not exist!\n", condition);
+      return false;
+    }
+
+    double value = 0;
+    size_t parsedLength = 0;
+    try {
+      value = std::stod(valueText, &parsedLength);
+    } catch (const std::exception&) {
+      parsedLength = 0;
+    }
+    if (parsedLength == 0 || parsedLength != valueText.size()) {
+      fmt::print("ERROR: value of condition '{}' is not a number!\n", condition);
+      return false;
+    }
+
+    predicates.push_back({columns[column], comparison, value});
+    requiredColumns[column] = true;
+  }
+
+  return true;
+}
+
+bool FlightDataRecorderFilter::matches(const char* frame) const {
+  for (const auto& predicate : predicates) {
+    double value = readColumn(frame, predicate.column);
+    bool isMatch = false;
+    switch (predicate.comparison) {
+      case Comparison::Less:
+        isMatch = value < predicate.value;
+        break;
+      case Comparison::LessEqual:
+        isMatch = value <= predicate.value;
+        break;
+      case Comparison::Greater:
+        isMatch = value > predicate.value;
+        break;
+      case Comparison::GreaterEqual:
+        isMatch = value >= predicate.value;
+        break;
+      case Comparison::Equal:
+        isMatch = value == predicate.value;
+        break;
+      case Comparison::NotEqual:
+        isMatch = value != predicate.value;
+        break;
+    }
+    if (!isMatch) {
+      return false;
+    }
+  }
+  return true;
+}
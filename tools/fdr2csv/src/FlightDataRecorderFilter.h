@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "FlightDataRecorderFileSchema.h"
+
+// Selects the columns that are written and the frames that are converted. Columns are selected with a comma
+// separated list of name patterns like "ap_sm.output.*,athr.*" and frames with a comma separated list of conditions
+// like "ap_sm.data.H_radio_ft<100,athr.output.mode==2" that all have to be true.
+class FlightDataRecorderFilter {
+ public:
+  // prepares the filter for the columns of a file, returns false if a pattern or condition is invalid
+  bool initialize(const std::vector<FdrColumn>& columns, const std::string& columnPatterns, const std::string& conditions);
+
+  // columns to write in the order of the file
+  [[nodiscard]] const std::vector<FdrColumn>& getOutputColumns() const { return outputColumns; }
+  // columns that have to be decoded to write and filter the frames
+  [[nodiscard]] const std::vector<bool>& getRequiredColumns() const { return requiredColumns; }
+
+  [[nodiscard]] bool hasConditions() const { return !predicates.empty(); }
+  // returns true if the frame fulfills all conditions
+  [[nodiscard]] bool matches(const char* frame) const;
+
+ private:
+  enum class Comparison { Less, LessEqual, Greater, GreaterEqual, Equal, NotEqual };
+
+  struct Predicate {
+    FdrColumn column;
+    Comparison comparison;
+    double value;
+  };
+
+  std::vector<FdrColumn> outputColumns;
+  std::vector<bool> requiredColumns;
+  std::vector<Predicate> predicates;
+};
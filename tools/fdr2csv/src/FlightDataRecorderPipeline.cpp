@@ -0,0 +1,177 @@
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FlightDataRecorderConverter.h"
+#include "FlightDataRecorderPipeline.h"
+#include "fmt/include/fmt/core.h"
+
+namespace {
+
+// number of frames that are formatted as one piece of work
+constexpr size_t FRAMES_PER_BLOCK = 1024;
+// formatted text is written in pieces of this size when not running in parallel
+constexpr size_t SERIAL_WRITE_SIZE = 1024 * 1024;
+
+enum class BlockState { Free, Filled, Formatted };
+
+struct Block {
+  BlockState state = BlockState::Free;
+  size_t frameCount = 0;
+  std::vector<char> frames;
+  fmt::memory_buffer text;
+};
+
+void printProgress(uint64_t previousEntries, uint64_t entries) {
+  if (entries / 1000 != previousEntries / 1000) {
+    fmt::print("Processed {} entries...\r", entries - entries % 1000);
+  }
+}
+
+}  // namespace
+
+FlightDataRecorderPipeline::FlightDataRecorderPipeline(const std::vector<FdrColumn>& outputColumns,
+                                                       size_t frameSizeInBytes,
+                                                       std::string csvDelimiter,
+                                                       unsigned int formatThreadCount)
+    : columns(outputColumns), frameSize(frameSizeInBytes), delimiter(std::move(csvDelimiter)), threadCount(formatThreadCount) {}
+
+uint64_t FlightDataRecorderPipeline::run(std::ostream& out, const FrameReader& readFrame, bool isVerbose) {
+  if (threadCount <= 1) {
+    return runSerial(out, readFrame, isVerbose);
+  }
+
+  // every block is filled, formatted and written in this order, a block is only refilled after it was written
+  std::vector<Block> blocks(threadCount * 2 + 2);
+  for (auto& block : blocks) {
+    block.frames.resize(FRAMES_PER_BLOCK * frameSize);
+  }
+  auto getBlock = [&blocks](uint64_t sequence) -> Block& { return blocks[sequence % blocks.size()]; };
+
+  std::mutex mutex;
+  std::condition_variable stateChanged;
+  uint64_t filledBlocks = 0;
+  uint64_t nextBlockToFormat = 0;
+  bool isInputDone = false;
+
+  // format stage, any worker takes the next filled block
+  auto formatBlocks = [&]() {
+    while (true) {
+      uint64_t sequence = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        stateChanged.wait(lock, [&]() { return nextBlockToFormat < filledBlocks || isInputDone; });
+        if (nextBlockToFormat >= filledBlocks) {
+          return;
+        }
+        sequence = nextBlockToFormat++;
+      }
+
+      Block& block = getBlock(sequence);
+      block.text.clear();
+      for (size_t i = 0; i < block.frameCount; i++) {
+        FlightDataRecorderConverter::formatFrame(block.text, delimiter, columns, block.frames.data() + i * frameSize);
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        block.state = BlockState::Formatted;
+      }
+      stateChanged.notify_all();
+    }
+  };
+
+  // write stage, blocks are written strictly in the order they were read
+  uint64_t entries = 0;
+  auto writeBlocks = [&]() {
+    for (uint64_t sequence = 0;; sequence++) {
+      Block& block = getBlock(sequence);
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        stateChanged.wait(lock, [&]() { return block.state == BlockState::Formatted || (isInputDone && sequence >= filledBlocks); });
+        if (block.state != BlockState::Formatted) {
+          return;
+        }
+      }
+
+      out.write(block.text.data(), static_cast<std::streamsize>(block.text.size()));
+      if (isVerbose) {
+        printProgress(entries, entries + block.frameCount);
+      }
+      entries += block.frameCount;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        block.state = BlockState::Free;
+      }
+      stateChanged.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(threadCount + 1);
+  for (unsigned int i = 0; i < threadCount; i++) {
+    threads.emplace_back(formatBlocks);
+  }
+  threads.emplace_back(writeBlocks);
+
+  // read stage runs on the calling thread
+  for (uint64_t sequence = 0;; sequence++) {
+    Block& block = getBlock(sequence);
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      stateChanged.wait(lock, [&]() { return block.state == BlockState::Free; });
+    }
+
+    block.frameCount = 0;
+    while (block.frameCount < FRAMES_PER_BLOCK && readFrame(block.frames.data() + block.frameCount * frameSize)) {
+      block.frameCount++;
+    }
+
+    if (block.frameCount > 0) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        block.state = BlockState::Filled;
+        filledBlocks = sequence + 1;
+      }
+      stateChanged.notify_all();
+    }
+    if (block.frameCount < FRAMES_PER_BLOCK) {
+      break;
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    isInputDone = true;
+  }
+  stateChanged.notify_all();
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  return entries;
+}
+
+uint64_t FlightDataRecorderPipeline::runSerial(std::ostream& out, const FrameReader& readFrame, bool isVerbose) {
+  std::vector<char> frame(frameSize);
+  fmt::memory_buffer text;
+  uint64_t entries = 0;
+
+  while (readFrame(frame.data())) {
+    FlightDataRecorderConverter::formatFrame(text, delimiter, columns, frame.data());
+    if (text.size() >= SERIAL_WRITE_SIZE) {
+      out.write(text.data(), static_cast<std::streamsize>(text.size()));
+      text.clear();
+    }
+    if (isVerbose) {
+      printProgress(entries, entries + 1);
+    }
+    entries++;
+  }
+  out.write(text.data(), static_cast<std::streamsize>(text.size()));
+
+  return entries;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "FlightDataRecorderFileSchema.h"
+
+// Converts frames to csv rows in three stages: the calling thread reads and inflates frames into blocks, a number of
+// worker threads format whole blocks into private text buffers and a writer thread writes the formatted blocks in
+// their original order. The output is identical to formatting the frames one after the other.
+class FlightDataRecorderPipeline {
+ public:
+  // reads the next frame into the buffer, returns false at the end of the input
+  using FrameReader = std::function<bool(char* frame)>;
+
+  FlightDataRecorderPipeline(const std::vector<FdrColumn>& columns,
+                             size_t frameSize,
+                             std::string delimiter,
+                             unsigned int formatThreadCount);
+
+  // converts all frames returned by the reader, returns the number of entries written
+  uint64_t run(std::ostream& out, const FrameReader& readFrame, bool isVerbose);
+
+ private:
+  const std::vector<FdrColumn>& columns;
+  size_t frameSize;
+  std::string delimiter;
+  unsigned int threadCount;
+
+  uint64_t runSerial(std::ostream& out, const FrameReader& readFrame, bool isVerbose);
+};
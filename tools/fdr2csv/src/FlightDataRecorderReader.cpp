@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "FlightDataRecorderFields.h"
+#include "FlightDataRecorderReader.h"
+
+namespace {
+
+// column holding the simulation time of a frame
+const std::string SIMULATION_TIME_COLUMN = "ap_sm.time.simulation_time";
+
+constexpr size_t INFLATE_BUFFER_SIZE = 64 * 1024;
+constexpr size_t INDEX_ENTRY_SIZE = sizeof(uint64_t) + 2 * sizeof(double) + sizeof(uint64_t);
+
+template <typename T>
+bool readValue(std::istream& in, T& value) {
+  in.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return in.good();
+}
+
+}  // namespace
+
+FlightDataRecorderInflateBuffer::FlightDataRecorderInflateBuffer() : input(INFLATE_BUFFER_SIZE), output(INFLATE_BUFFER_SIZE) {}
+
+FlightDataRecorderInflateBuffer::~FlightDataRecorderInflateBuffer() {
+  if (isStreamInitialized) {
+    inflateEnd(&stream);
+  }
+}
+
+bool FlightDataRecorderInflateBuffer::reset(std::istream* sourceStream, bool isRawDeflate) {
+  if (isStreamInitialized) {
+    inflateEnd(&stream);
+  }
+  source = sourceStream;
+  stream = {};
+  isStreamInitialized = inflateInit2(&stream, isRawDeflate ? -MAX_WBITS : MAX_WBITS + 16) == Z_OK;
+  isStreamEnd = false;
+  setg(output.data(), output.data(), output.data());
+  return isStreamInitialized;
+}
+
+FlightDataRecorderInflateBuffer::int_type FlightDataRecorderInflateBuffer::underflow() {
+  if (gptr() < egptr()) {
+    return traits_type::to_int_type(*gptr());
+  }
+
+  // anything behind the end of the deflate stream (e.g. the seek index) is not part of the data
+  while (isStreamInitialized && !isStreamEnd) {
+    if (stream.avail_in == 0) {
+      source->read(input.data(), static_cast<std::streamsize>(input.size()));
+      if (source->gcount() == 0) {
+        return traits_type::eof();
+      }
+      stream.next_in = reinterpret_cast<Bytef*>(input.data());
+      stream.avail_in = static_cast<uInt>(source->gcount());
+    }
+
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+    int result = inflate(&stream, Z_NO_FLUSH);
+    if (result == Z_STREAM_END) {
+      isStreamEnd = true;
+    } else if (result != Z_OK && result != Z_BUF_ERROR) {
+      return traits_type::eof();
+    }
+
+    size_t produced = output.size() - stream.avail_out;
+    if (produced > 0) {
+      setg(output.data(), output.data(), output.data() + produced);
+      return traits_type::to_int_type(*gptr());
+    }
+  }
+
+  return traits_type::eof();
+}
+
+bool FlightDataRecorderReader::open(const std::string& filePath, bool isCompressedFile) {
+  file.open(filePath, std::ios::in | std::ios::binary);
+  if (!file.good()) {
+    return false;
+  }
+  isCompressed = isCompressedFile;
+
+  // the index is optional, files that were not closed properly are read sequentially
+  if (!readIndex()) {
+    index.clear();
+    remainingMinimumSimulationTime.clear();
+  }
+  file.clear();
+  file.seekg(0);
+
+  if (isCompressed) {
+    inflateBuffer.reset(&file, false);
+    in = &inflateStream;
+  } else {
+    in = &file;
+  }
+
+  // read version and schema, files without schema block are decoded with the compiled-in struct tables
+  if (!readValue(*in, interfaceVersion)) {
+    return false;
+  }
+  if (interfaceVersion == LEGACY_INTERFACE_VERSION) {
+    schema.load("A32NX", FDR_STRUCTS, FDR_STRUCT_COUNT_WITHOUT_INPUTS);
+  } else if (interfaceVersion < FIRST_SELF_DESCRIBING_INTERFACE_VERSION || !schema.read(*in)) {
+    return false;
+  }
+
+  const auto& columns = schema.getColumns();
+  auto timeColumn = std::find_if(columns.begin(), columns.end(), [](const FdrColumn& column) {
+    return column.name == SIMULATION_TIME_COLUMN && column.type == FdrFieldType::Double;
+  });
+  simulationTimeColumn = timeColumn != columns.end() ? &*timeColumn : nullptr;
+  simulationTimeColumnIndex = static_cast<size_t>(timeColumn - columns.begin());
+
+  decoder.initialize(schema.getColumnLayouts());
+  selectedColumns.assign(columns.size(), true);
+  nextFrameInChunk = 0;
+  nextFrame = 0;
+
+  return true;
+}
+
+bool FlightDataRecorderReader::readIndex() {
+  file.seekg(0, std::ios::end);
+  auto fileSize = static_cast<uint64_t>(file.tellg());
+  if (fileSize < FDR_INDEX_FOOTER_SIZE) {
+    return false;
+  }
+
+  // the footer points to the beginning of the index
+  uint64_t indexOffset = 0;
+  uint32_t magic = 0;
+  file.seekg(static_cast<std::streamoff>(fileSize - FDR_INDEX_FOOTER_SIZE));
+  if (!readValue(file, indexOffset) || !readValue(file, magic) || magic != FDR_INDEX_MAGIC) {
+    return false;
+  }
+
+  uint32_t entryCount = 0;
+  file.seekg(static_cast<std::streamoff>(indexOffset));
+  if (!readValue(file, magic) || magic != FDR_INDEX_MAGIC || !readValue(file, entryCount)) {
+    return false;
+  }
+  if (indexOffset + sizeof(magic) + sizeof(entryCount) + entryCount * INDEX_ENTRY_SIZE + FDR_INDEX_FOOTER_SIZE != fileSize) {
+    return false;
+  }
+
+  index.resize(entryCount);
+  for (auto& entry : index) {
+    if (!readValue(file, entry.frame) || !readValue(file, entry.minimumSimulationTime) ||
+        !readValue(file, entry.maximumSimulationTime) || !readValue(file, entry.offset)) {
+      return false;
+    }
+  }
+
+  // smallest simulation time from every entry to the end of the file
+  remainingMinimumSimulationTime.resize(entryCount);
+  double minimumSimulationTime = std::numeric_limits<double>::max();
+  for (size_t i = entryCount; i > 0; i--) {
+    minimumSimulationTime = std::min(minimumSimulationTime, index[i - 1].minimumSimulationTime);
+    remainingMinimumSimulationTime[i - 1] = minimumSimulationTime;
+  }
+
+  return true;
+}
+
+double FlightDataRecorderReader::getSimulationTime(const char* frame) const {
+  double simulationTime = 0;
+  std::memcpy(&simulationTime, frame + simulationTimeColumn->offset, sizeof(simulationTime));
+  return simulationTime;
+}
+
+void FlightDataRecorderReader::setSelectedColumns(const std::vector<bool>& columns) {
+  selectedColumns = columns;
+  selectedColumns.resize(schema.getColumns().size(), false);
+  if (simulationTimeColumn != nullptr) {
+    selectedColumns[simulationTimeColumnIndex] = true;
+  }
+}
+
+bool FlightDataRecorderReader::seek(double simulationTime) {
+  // the offsets of the row layout point into the compressed stream
+  bool isSeekable = schema.getLayout() == FdrLayout::Columnar || isCompressed;
+  if (index.empty() || !isSeekable) {
+    return false;
+  }
+
+  // first entry that can contain the given time, simulation time jumps back on a reset so the index is not sorted by it
+  auto entry = std::find_if(index.begin(), index.end(), [simulationTime](const FdrIndexEntry& indexEntry) {
+    return indexEntry.maximumSimulationTime >= simulationTime;
+  });
+  if (entry == index.begin()) {
+    return true;
+  }
+  if (entry == index.end()) {
+    --entry;
+  }
+
+  file.clear();
+  file.seekg(static_cast<std::streamoff>(entry->offset));
+  if (schema.getLayout() == FdrLayout::Row) {
+    inflateBuffer.reset(&file, true);
+    inflateStream.clear();
+  }
+  nextFrameInChunk = decoder.getFrameCount();
+  nextFrame = entry->frame;
+
+  return file.good();
+}
+
+bool FlightDataRecorderReader::isPastSimulationTime(double simulationTime) const {
+  // the entry containing the next frame, its remaining frames are covered by its range
+  auto entry = std::upper_bound(index.begin(), index.end(), nextFrame,
+                                [](uint64_t frame, const FdrIndexEntry& indexEntry) { return frame < indexEntry.frame; });
+  if (entry == index.begin()) {
+    return false;
+  }
+  return remainingMinimumSimulationTime[static_cast<size_t>(entry - index.begin()) - 1] > simulationTime;
+}
+
+bool FlightDataRecorderReader::readFrame(char* frame) {
+  if (schema.getLayout() == FdrLayout::Row) {
+    if (!in->read(frame, static_cast<std::streamsize>(schema.getFrameSize()))) {
+      return false;
+    }
+    nextFrame++;
+    return true;
+  }
+
+  // read the next chunk when all frames of the current one are consumed, the index ends the chunks
+  while (nextFrameInChunk >= decoder.getFrameCount()) {
+    if (in->peek() == EOF || !decoder.readChunk(*in, selectedColumns)) {
+      return false;
+    }
+    nextFrameInChunk = 0;
+  }
+  decoder.getFrame(nextFrameInChunk++, frame);
+  nextFrame++;
+
+  return true;
+}
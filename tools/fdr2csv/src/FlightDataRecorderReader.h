@@ -0,0 +1,89 @@
+#pragma once
+
+#include <fstream>
+#include <istream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include "FlightDataRecorderColumnar.h"
+#include "FlightDataRecorderFileSchema.h"
+#include "FlightDataRecorderIndex.h"
+#include "zlib.h"
+
+// IMPORTANT: last interface version without schema block, it is decoded with the compiled-in A32NX struct tables and
+// has to be dropped as soon as these structs change (A380X files without schema block are not supported)
+constexpr uint64_t LEGACY_INTERFACE_VERSION = 25;
+// files starting with this interface version contain a schema block and can be decoded without matching structs
+constexpr uint64_t FIRST_SELF_DESCRIBING_INTERFACE_VERSION = 26;
+
+// stream buffer inflating a gzip stream or a raw deflate stream starting at a full flush point
+class FlightDataRecorderInflateBuffer : public std::streambuf {
+ public:
+  FlightDataRecorderInflateBuffer();
+  FlightDataRecorderInflateBuffer(const FlightDataRecorderInflateBuffer&) = delete;
+  FlightDataRecorderInflateBuffer& operator=(const FlightDataRecorderInflateBuffer&) = delete;
+  ~FlightDataRecorderInflateBuffer() override;
+
+  // starts inflating at the current position of the source stream
+  bool reset(std::istream* sourceStream, bool isRawDeflate);
+
+ protected:
+  int_type underflow() override;
+
+ private:
+  std::istream* source = nullptr;
+  bool isStreamInitialized = false;
+  bool isStreamEnd = false;
+  z_stream stream = {};
+  std::vector<char> input;
+  std::vector<char> output;
+};
+
+// reads the frames of a flight data recorder file and uses the seek index if present
+class FlightDataRecorderReader {
+ public:
+  // opens the file and reads version, schema and seek index, returns false if the version is not supported
+  bool open(const std::string& filePath, bool isCompressed);
+
+  [[nodiscard]] uint64_t getInterfaceVersion() const { return interfaceVersion; }
+  [[nodiscard]] const FlightDataRecorderFileSchema& getSchema() const { return schema; }
+  [[nodiscard]] const std::vector<FdrIndexEntry>& getIndex() const { return index; }
+
+  // simulation time is needed to select a time window
+  [[nodiscard]] bool hasSimulationTime() const { return simulationTimeColumn != nullptr; }
+  [[nodiscard]] double getSimulationTime(const char* frame) const;
+
+  // only the selected columns of the columnar layout are decoded, the simulation time is always decoded
+  void setSelectedColumns(const std::vector<bool>& columns);
+
+  // continues reading at the first indexed position that can be followed by the given time, returns false if there is no index
+  bool seek(double simulationTime);
+
+  // returns true if the index proves that all frames not read yet are later than the given time
+  [[nodiscard]] bool isPastSimulationTime(double simulationTime) const;
+
+  // reads the next frame, returns false at the end of the file
+  bool readFrame(char* frame);
+
+ private:
+  std::ifstream file;
+  FlightDataRecorderInflateBuffer inflateBuffer;
+  std::istream inflateStream{&inflateBuffer};
+  std::istream* in = nullptr;
+  bool isCompressed = false;
+
+  uint64_t interfaceVersion = 0;
+  FlightDataRecorderFileSchema schema;
+  const FdrColumn* simulationTimeColumn = nullptr;
+  size_t simulationTimeColumnIndex = 0;
+  std::vector<FdrIndexEntry> index;
+  std::vector<double> remainingMinimumSimulationTime;
+
+  FlightDataRecorderColumnarDecoder decoder;
+  std::vector<bool> selectedColumns;
+  uint32_t nextFrameInChunk = 0;
+  uint64_t nextFrame = 0;
+
+  bool readIndex();
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+// matches a text against a pattern with '*' (any sequence) and '?' (any character) wildcards
+inline bool matchesWildcard(std::string_view text, std::string_view pattern) {
+  size_t t = 0;
+  size_t p = 0;
+  size_t starPattern = std::string_view::npos;
+  size_t starText = 0;
+  while (t < text.size()) {
+    if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+      t++;
+      p++;
+    } else if (p < pattern.size() && pattern[p] == '*') {
+      starPattern = p++;
+      starText = t;
+    } else if (starPattern != std::string_view::npos) {
+      p = starPattern + 1;
+      t = ++starText;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '*') {
+    p++;
+  }
+  return p == pattern.size();
+}